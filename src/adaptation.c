@@ -0,0 +1,274 @@
+/*
+ * adaptation.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "adaptation.h"
+#include "errorHandler.h"
+
+/* (intern function) Decreases the level of the entry at @position of @levels by up to alpha levels (bounded by boostMax and ADAPTATION_MIN_LEVEL) and notes it as changed. Returns the new level decrease of the entry by this adaptation_apply. */
+int adapt_boostEntry (adaptation_struct * adaptation, int *levels, unsigned char *boosted, unsigned char *dropped, int position, int *changed, int *sizeOf_changed)
+{
+  int level = (levels[position] > adaptation->maxLevel - 1) ? adaptation->maxLevel - 1 : levels[position];
+  int reduce = adaptation->alpha;
+
+  if (reduce > adaptation->boostMax - boosted[position])
+    reduce = adaptation->boostMax - boosted[position];
+  if (reduce > level - ADAPTATION_MIN_LEVEL)
+    reduce = level - ADAPTATION_MIN_LEVEL;
+  if (reduce <= 0)
+    return dropped[position];
+
+  levels[position] = level - reduce;
+  boosted[position] += reduce;
+  if (dropped[position] == 0)
+    changed[(*sizeOf_changed)++] = position;
+  dropped[position] += reduce;
+  adaptation->movedCount++;
+  return dropped[position];
+}                               // (intern) adapt_boostEntry
+
+/* (intern function) Boosts the n-grams of the given cracked @password (initialProb, conditionalProbs and endProb) */
+void adapt_boostPassword (adaptation_struct * adaptation, const char *password, int length)
+{
+  int sizeOf_N = adaptation->nGrams->sizeOf_N;
+  int sizeOf_alphabet = adaptation->alphabet->sizeOf_alphabet;
+  const char *alphabet = adaptation->alphabet->alphabet;
+  int positionIP = 0;
+  int positionEP = 0;
+  int positionCP[MAX_PASSWORD_LENGTH];
+  int drop = 0;
+
+  // look up all n-grams first: passwords with chars not in the alphabet are ignored completely
+  if (length < sizeOf_N || !get_positionFromNGram (&positionIP, password, sizeOf_N - 1, sizeOf_alphabet, alphabet) || !get_positionFromNGram (&positionEP, password + length - (sizeOf_N - 1), sizeOf_N - 1, sizeOf_alphabet, alphabet))
+  {
+    adaptation->ignoredCount++;
+    return;
+  }
+  for (int i = 0; i <= length - sizeOf_N; i++)
+  {
+    if (!get_positionFromNGram (positionCP + i, password + i, sizeOf_N, sizeOf_alphabet, alphabet))
+    {
+      adaptation->ignoredCount++;
+      return;
+    }
+  }
+
+  drop = adapt_boostEntry (adaptation, adaptation->nGrams->iP, adaptation->boostedIP, adaptation->droppedIP, positionIP, adaptation->changedIP, &adaptation->sizeOf_changedIP);
+  if (drop > adaptation->dropIP)
+    adaptation->dropIP = drop;
+  for (int i = 0; i <= length - sizeOf_N; i++)
+  {
+    drop = adapt_boostEntry (adaptation, adaptation->nGrams->cP, adaptation->boostedCP, adaptation->droppedCP, positionCP[i], adaptation->changedCP, &adaptation->sizeOf_changedCP);
+    if (drop > adaptation->dropCP)
+      adaptation->dropCP = drop;
+  }
+  if (!adaptation->ignoreEP)
+  {
+    drop = adapt_boostEntry (adaptation, adaptation->nGrams->eP, adaptation->boostedEP, adaptation->droppedEP, positionEP, adaptation->changedEP, &adaptation->sizeOf_changedEP);
+    if (drop > adaptation->dropEP)
+      adaptation->dropEP = drop;
+  }
+  adaptation->appliedCount++;
+}                               // (intern) adapt_boostPassword
+
+/* (intern function) Compares two positions (qsort) */
+int adapt_comparePosition (const void *a, const void *b)
+{
+  return *(const int *) a - *(const int *) b;
+}                               // (intern) adapt_comparePosition
+
+/* (intern function) Rebuilds the lastGrams of the given @level after entries have been moved from or to it. Only the mGrams of changed entries are sorted again, the lastGrams of all other mGrams are copied. */
+void adapt_mergeLevel (const adaptation_struct * adaptation, sortedLastGram_struct * sortedLastGram, int level)
+{
+  int sizeOf_alphabet = adaptation->alphabet->sizeOf_alphabet;
+  const int *cP = adaptation->nGrams->cP;
+  int *lastGrams = NULL;
+  int indexOld = 0;             // start of the current mGram in the old lastGrams
+  int indexNew = 0;             // start of the current mGram in the new lastGrams
+  int sizeOf_lastGrams = sortedLastGram->indexStart[sortedLastGram->sizeOf_mGram];
+  int changed = 0;
+  int position = 0;
+
+  // the new amount of lastGrams differs at most by the amount of changed entries
+  lastGrams = (int *) malloc ((sizeOf_lastGrams + adaptation->sizeOf_changedCP + 1) * sizeof (int));
+  EXIT_IF_NULL (lastGrams);
+  for (int mGram = 0; mGram < sortedLastGram->sizeOf_mGram; mGram++)
+  {
+    indexOld = sortedLastGram->indexStart[mGram];
+    sortedLastGram->indexStart[mGram] = indexNew;
+    if (changed < adaptation->sizeOf_changedCP && adaptation->changedCP[changed] / sizeOf_alphabet == mGram)
+    {
+      // collect the lastGrams of the mGram with the level again (ascending like struct_sortedLastGram_fill)
+      for (int lastGram = 0; lastGram < sizeOf_alphabet; lastGram++)
+      {
+        position = mGram * sizeOf_alphabet + lastGram;
+        if (((cP[position] > adaptation->maxLevel - 1) ? adaptation->maxLevel - 1 : cP[position]) == level)
+          lastGrams[indexNew++] = lastGram;
+      }
+      while (changed < adaptation->sizeOf_changedCP && adaptation->changedCP[changed] / sizeOf_alphabet == mGram)
+        changed++;
+    }
+    else
+    {
+      memcpy (lastGrams + indexNew, sortedLastGram->lastGrams + indexOld, (sortedLastGram->indexStart[mGram + 1] - indexOld) * sizeof (int));
+      indexNew += sortedLastGram->indexStart[mGram + 1] - indexOld;
+    }
+  }
+  sortedLastGram->indexStart[sortedLastGram->sizeOf_mGram] = indexNew;
+  free (sortedLastGram->lastGrams);
+  sortedLastGram->lastGrams = lastGrams;
+}                               // (intern) adapt_mergeLevel
+
+// initializes the adaptation
+void adaptation_initialize (adaptation_struct ** adaptation, nGram_struct * nGrams, const alphabet_struct * alphabet, int maxLevel, int alpha, int boostMax, bool ignoreEP)
+{
+  (*adaptation) = (adaptation_struct *) calloc (1, sizeof (adaptation_struct));
+  EXIT_IF_NULL ((*adaptation));
+  (*adaptation)->nGrams = nGrams;
+  (*adaptation)->alphabet = alphabet;
+  (*adaptation)->maxLevel = maxLevel;
+  (*adaptation)->alpha = alpha;
+  (*adaptation)->boostMax = boostMax;
+  (*adaptation)->ignoreEP = ignoreEP;
+
+  (*adaptation)->boostedIP = (unsigned char *) calloc (nGrams->sizeOf_iP, sizeof (unsigned char));
+  EXIT_IF_NULL ((*adaptation)->boostedIP);
+  (*adaptation)->boostedCP = (unsigned char *) calloc (nGrams->sizeOf_cP, sizeof (unsigned char));
+  EXIT_IF_NULL ((*adaptation)->boostedCP);
+  (*adaptation)->boostedEP = (unsigned char *) calloc (nGrams->sizeOf_eP, sizeof (unsigned char));
+  EXIT_IF_NULL ((*adaptation)->boostedEP);
+  (*adaptation)->droppedIP = (unsigned char *) calloc (nGrams->sizeOf_iP, sizeof (unsigned char));
+  EXIT_IF_NULL ((*adaptation)->droppedIP);
+  (*adaptation)->droppedCP = (unsigned char *) calloc (nGrams->sizeOf_cP, sizeof (unsigned char));
+  EXIT_IF_NULL ((*adaptation)->droppedCP);
+  (*adaptation)->droppedEP = (unsigned char *) calloc (nGrams->sizeOf_eP, sizeof (unsigned char));
+  EXIT_IF_NULL ((*adaptation)->droppedEP);
+
+  // each pending password changes at most one initialProb and endProb and MAX_PASSWORD_LENGTH conditionalProbs
+  (*adaptation)->changedIP = (int *) malloc (ADAPTATION_PENDING * sizeof (int));
+  EXIT_IF_NULL ((*adaptation)->changedIP);
+  (*adaptation)->changedCP = (int *) malloc (ADAPTATION_PENDING * MAX_PASSWORD_LENGTH * sizeof (int));
+  EXIT_IF_NULL ((*adaptation)->changedCP);
+  (*adaptation)->changedEP = (int *) malloc (ADAPTATION_PENDING * sizeof (int));
+  EXIT_IF_NULL ((*adaptation)->changedEP);
+}                               // adaptation_initialize
+
+// adds a cracked password
+void adaptation_addCracked (adaptation_struct * adaptation, const char *password, int length)
+{
+  if (adaptation->sizeOf_pending == ADAPTATION_PENDING || length > MAX_PASSWORD_LENGTH)
+  {
+    adaptation->ignoredCount++;
+    return;
+  }
+  memcpy (adaptation->pendingPasswords[adaptation->sizeOf_pending], password, length);
+  adaptation->pendingLengths[adaptation->sizeOf_pending] = length;
+  adaptation->sizeOf_pending++;
+}                               // adaptation_addCracked
+
+// checks if the next adaptation should be applied
+bool adaptation_isDue (const adaptation_struct * adaptation)
+{
+  return adaptation->sizeOf_pending > 0 && clock () >= adaptation->clockNext;
+}                               // adaptation_isDue
+
+// applies the pending cracked passwords
+bool adaptation_apply (adaptation_struct * adaptation, sortedLastGram_struct * sortedLastGram, sortedIP_struct * sortedIP)
+{
+  bool levelChanged[adaptation->maxLevel];
+  int position = 0;
+
+  adaptation->clockApply = clock ();
+  for (int i = 0; i < adaptation->sizeOf_pending; i++)
+    adapt_boostPassword (adaptation, adaptation->pendingPasswords[i], adaptation->pendingLengths[i]);
+  adaptation->sizeOf_pending = 0;
+  if (adaptation->sizeOf_changedIP + adaptation->sizeOf_changedCP + adaptation->sizeOf_changedEP == 0)
+    return false;
+  adaptation->boundaryCount++;
+
+  // move the lastGrams: each changed entry leaves its old level (level + dropped) for its new one
+  if (adaptation->sizeOf_changedCP > 0)
+  {
+    qsort (adaptation->changedCP, adaptation->sizeOf_changedCP, sizeof (int), adapt_comparePosition);
+    memset (levelChanged, 0, sizeof (levelChanged));
+    for (int i = 0; i < adaptation->sizeOf_changedCP; i++)
+    {
+      position = adaptation->changedCP[i];
+      levelChanged[adaptation->nGrams->cP[position]] = true;
+      levelChanged[adaptation->nGrams->cP[position] + adaptation->droppedCP[position]] = true;
+    }
+    for (int level = 0; level < adaptation->maxLevel; level++)
+    {
+      if (levelChanged[level])
+        adapt_mergeLevel (adaptation, sortedLastGram + level, level);
+    }
+  }
+
+  // the initialProbs are few, sort them again
+  if (adaptation->sizeOf_changedIP > 0)
+  {
+    for (int level = 0; level < adaptation->maxLevel; level++)
+      sortedIP[level].indexCur = 0;
+    struct_sortedIP_fill (adaptation->maxLevel, sortedIP, adaptation->nGrams->iP, adaptation->nGrams->sizeOf_iP);
+  }
+  return true;
+}                               // adaptation_apply
+
+// returns the maximal level decrease of a password
+int adaptation_maxDrop (const adaptation_struct * adaptation, int length)
+{
+  return adaptation->dropIP + (length - (adaptation->nGrams->sizeOf_N - 1)) * adaptation->dropCP + adaptation->dropEP;
+}                               // adaptation_maxDrop
+
+// resets the level decrease of the last adaptation
+void adaptation_finish (adaptation_struct * adaptation)
+{
+  for (int i = 0; i < adaptation->sizeOf_changedIP; i++)
+    adaptation->droppedIP[adaptation->changedIP[i]] = 0;
+  for (int i = 0; i < adaptation->sizeOf_changedCP; i++)
+    adaptation->droppedCP[adaptation->changedCP[i]] = 0;
+  for (int i = 0; i < adaptation->sizeOf_changedEP; i++)
+    adaptation->droppedEP[adaptation->changedEP[i]] = 0;
+  adaptation->sizeOf_changedIP = 0;
+  adaptation->sizeOf_changedCP = 0;
+  adaptation->sizeOf_changedEP = 0;
+  adaptation->dropIP = 0;
+  adaptation->dropCP = 0;
+  adaptation->dropEP = 0;
+  // amortize the adaptation (and its catch-up) before adapting again
+  adaptation->clockNext = 2 * clock () - adaptation->clockApply;
+}                               // adaptation_finish
+
+// prints the results of the adaptation
+void adaptation_printResults (const adaptation_struct * adaptation, FILE * fp)
+{
+  fprintf (fp, "adaptation: %" PRIu64 " cracked passwords applied, %" PRIu64 " levels decreased at %" PRIu64 " level boundaries", adaptation->appliedCount, adaptation->movedCount, adaptation->boundaryCount);
+  if (adaptation->ignoredCount > 0)
+    fprintf (fp, " (%" PRIu64 " cracked passwords ignored)", adaptation->ignoredCount);
+  fprintf (fp, "\n");
+}                               // adaptation_printResults
+
+// frees the adaptation
+void adaptation_free (adaptation_struct ** adaptation)
+{
+  if (*adaptation == NULL)
+    return;
+  CHECKED_FREE ((*adaptation)->boostedIP);
+  CHECKED_FREE ((*adaptation)->boostedCP);
+  CHECKED_FREE ((*adaptation)->boostedEP);
+  CHECKED_FREE ((*adaptation)->droppedIP);
+  CHECKED_FREE ((*adaptation)->droppedCP);
+  CHECKED_FREE ((*adaptation)->droppedEP);
+  CHECKED_FREE ((*adaptation)->changedIP);
+  CHECKED_FREE ((*adaptation)->changedCP);
+  CHECKED_FREE ((*adaptation)->changedEP);
+  free (*adaptation);
+  (*adaptation) = NULL;
+}                               // adaptation_free
@@ -0,0 +1,139 @@
+/*
+ * adaptation.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Online adaptation of the model used by enumNG (--adapt): the n-grams of
+ * each cracked password (simulated attack, hash checking or feedback file)
+ * are boosted like boost() does for hints, i.e. their level is decreased by
+ * alpha. The cracked passwords are collected during the enumeration and
+ * applied at the next level boundary, moving the boosted entries to their new
+ * bucket of the sorted arrays (sortedIP and sortedLastGram).
+ * The overall boost of a single entry is bounded (--adaptMax) and no entry
+ * is boosted below ADAPTATION_MIN_LEVEL: the n-grams of cracked passwords are
+ * mostly common ones already, lowering them further reorders most passwords
+ * and decreased the crack rate of simulated attacks. Only rare n-grams (e.g.
+ * site-specific words) are boosted.
+ * Lowering a level only moves passwords to lower levels: passwords enumerated
+ * before are never repeated. Passwords moved below the current level of
+ * their length are enumerated once right after the boundary (see
+ * adaptation_maxDrop and the @dropped arrays). Since this catch-up
+ * enumerates the lower levels again, the next adaptation is applied only
+ * once the enumeration took at least as much time as the last adaptation
+ * (see adaptation_isDue), keeping the overhead below 50 %.
+ *
+ */
+
+#ifndef ADAPTATION_H_
+#define ADAPTATION_H_
+
+#include <stdint.h>
+#include <time.h>
+
+#include "common.h"
+
+// === Defines ===
+#define ADAPTATION_PENDING 4096 // cracked passwords kept until the next level boundary
+#define ADAPTATION_MAX_BOOST 255  // maximal value of --adaptMax (the boosts are stored as bytes)
+#define ADAPTATION_MIN_LEVEL 3  // entries are never boosted below this level
+
+/*
+ * State of the online adaptation. The @dropped arrays store the level
+ * decrease of each entry by the last adaptation_apply (0 for all entries
+ * after adaptation_finish).
+ */
+typedef struct adaptation_struct
+{
+  nGram_struct *nGrams;         // levels of the model (adapted in place)
+  const alphabet_struct *alphabet;
+  int maxLevel;
+  int alpha;                    // level decrease per n-gram of a cracked password
+  int boostMax;                 // maximal overall level decrease of a single entry
+  bool ignoreEP;                // TRUE, if the endProbs are not used
+
+  unsigned char *boostedIP;     // overall level decrease of each entry
+  unsigned char *boostedCP;
+  unsigned char *boostedEP;
+  unsigned char *droppedIP;     // level decrease of each entry by the last adaptation_apply
+  unsigned char *droppedCP;
+  unsigned char *droppedEP;
+  int dropIP;                   // maximal level decrease of a single entry by the last adaptation_apply
+  int dropCP;
+  int dropEP;
+  int *changedCP;               // entries changed by the last adaptation_apply (sorted for the merge)
+  int sizeOf_changedCP;
+  int *changedIP;
+  int sizeOf_changedIP;
+  int *changedEP;
+  int sizeOf_changedEP;
+
+  char pendingPasswords[ADAPTATION_PENDING][MAX_PASSWORD_LENGTH]; // cracked passwords not applied yet
+  int pendingLengths[ADAPTATION_PENDING];
+  int sizeOf_pending;
+
+  clock_t clockApply;           // start of the last adaptation_apply
+  clock_t clockNext;            // earliest start of the next adaptation_apply
+  uint64_t appliedCount;        // amount of cracked passwords applied
+  uint64_t ignoredCount;        // amount of cracked passwords dropped (queue full or chars not in the alphabet)
+  uint64_t movedCount;          // amount of entries moved to a lower level
+  uint64_t boundaryCount;       // amount of level boundaries with any moved entry
+} adaptation_struct;
+
+/*
+ * Initializes the adaptation of the given model @nGrams, boosting each
+ * n-gram of a cracked password by @alpha levels, but any entry by
+ * at most @boostMax levels overall.
+ */
+void adaptation_initialize (adaptation_struct ** adaptation, // adaptation to be initialized
+                            nGram_struct * nGrams,  // model to be adapted
+                            const alphabet_struct * alphabet, // alphabet of the model
+                            int maxLevel, // amount of levels
+                            int alpha,  // level decrease per cracked password
+                            int boostMax, // maximal level decrease of an entry
+                            bool ignoreEP); // endProbs are not used
+
+/*
+ * Adds the given cracked @password (of @length) to the passwords applied at
+ * the next level boundary.
+ */
+void adaptation_addCracked (adaptation_struct * adaptation, const char *password, int length);
+
+/*
+ * Returns TRUE if there are pending cracked passwords and the time of the
+ * last adaptation (including its catch-up) is amortized.
+ */
+bool adaptation_isDue (const adaptation_struct * adaptation);
+
+/*
+ * Applies the pending cracked passwords, updating the levels of the model as
+ * well as the sorted arrays @sortedLastGram and @sortedIP.
+ * Returns TRUE if any entry has been moved, the passwords moved below the
+ * current levels must be enumerated (see adaptation_maxDrop) before calling
+ * adaptation_finish.
+ */
+bool adaptation_apply (adaptation_struct * adaptation, sortedLastGram_struct * sortedLastGram, sortedIP_struct * sortedIP);
+
+/*
+ * Returns the maximal level decrease of a password of @length by the last
+ * adaptation_apply.
+ */
+int adaptation_maxDrop (const adaptation_struct * adaptation, int length);
+
+/*
+ * Resets the @dropped arrays after the last adaptation_apply (and its
+ * catch-up).
+ */
+void adaptation_finish (adaptation_struct * adaptation);
+
+/*
+ * Prints the amount of applied cracked passwords and moved entries
+ * to the given file pointer @fp.
+ */
+void adaptation_printResults (const adaptation_struct * adaptation, FILE * fp);
+
+/*
+ * Frees the given adaptation (if not NULL).
+ */
+void adaptation_free (adaptation_struct ** adaptation);
+
+#endif /* ADAPTATION_H_ */
@@ -12,9 +12,12 @@
 #include <inttypes.h>
 #include <time.h>
 #include <string.h>
+#include <pthread.h>
 #include "uthash.h"
 
 #include "common.h"
+#include "errorHandler.h"
+#include "commonStructs.h"
 #include "enumNG.h"
 #include "attackSimulator.h"
 
@@ -28,9 +31,46 @@ typedef struct passwordSet_struct
   UT_hash_handle hh;            // makes this structure hashable
 } passwordSet_struct;
 
+/*
+ * Password of the testing set of a simulated attack, stored in the flat
+ * index (its key is stored at the same index of the key arena).
+ */
+typedef struct simAtt_entry
+{
+  int cracked;
+  int count;                    // counts the number of occurrences of the password in the DB
+} simAtt_entry;
+
+/*
+ * Slot of the flat index of the testing set. The @hash is compared before
+ * the key, so the key arena is only accessed for (almost) certain hits.
+ */
+typedef struct simAtt_slot
+{
+  uint32_t hash;                // hash of the key
+  uint32_t entry;               // index of the entry + 1 (0 marks an empty slot)
+} simAtt_slot;
+
+/*
+ * Candidates looked up by the checking threads at once (pipelined attack).
+ * A batch is either filled by enumNG or checked by the threads, never both.
+ * Skipped candidates (see simAtt_skipCandidates) are kept in order as
+ * records with @skipped > 0, so the graphs are written as without threads.
+ */
+typedef struct simAtt_batch
+{
+  char passwords[SIMATT_BATCH_SIZE][SIMATT_SIZEOF_KEY + 1];  // candidates (padded with '\0', see index_findBatch)
+  unsigned char lengths[SIMATT_BATCH_SIZE]; // length of each record
+  uint64_t skipped[SIMATT_BATCH_SIZE];  // amount of skipped candidates (0: the record is a candidate)
+  simAtt_entry *found[SIMATT_BATCH_SIZE]; // password of the testing set (set by the threads, NULL if none)
+  int count;                    // amount of records in the batch
+  uint64_t firstAttempt;        // guess number before the first record
+  int next;                     // index of the next record handed to a thread (accessed atomically)
+} simAtt_batch;
+
 // === Global Variables ===
 // struct containing the testing set
-passwordSet_struct *glbl_testingSet = NULL; // testingSet containing PWs for a simulated attack
+passwordSet_struct *glbl_testingSet = NULL; // testingSet containing PWs for a simulated attack (boosting)
 uint64_t glbl_sizeOf_testingSet = 0;  // total number of passwords in the testing set
 
 uint64_t glbl_crackedCount = 0; // Number of passwords cracked
@@ -41,6 +81,36 @@ FILE *glbl_FP_graphLengths = NULL;  // file pointer storing the length values
 FILE *glbl_FP_graphCracked = NULL;  // file pointer storing the graph values
 int glbl_outputCylce = 0;       // add every x created value to graph
 
+// prefix trie of the testing set (open addressing hash map: (node, alphabet position) -> child node)
+uint64_t *glbl_trieKeys = NULL; // key of each slot: node * sizeOf_alphabet + position + 1 (0 marks an empty slot)
+int *glbl_trieChilds = NULL;    // child node stored in each slot
+uint64_t glbl_trieSlots = 0;    // number of slots (always a power of 2)
+uint64_t glbl_trieNodes = 1;    // number of nodes (including the root)
+int glbl_trieAlphabetSize = 0;  // size of the alphabet used to build the trie
+
+// flat index of the testing set (open addressing hash map: key -> password of the testing set)
+char *glbl_indexKeys = NULL;    // key arena: the passwords padded with '\0' to SIMATT_SIZEOF_KEY chars, one after another
+simAtt_entry *glbl_indexEntries = NULL; // passwords of the testing set (in the order of their keys)
+uint64_t glbl_indexEntriesCount = 0;  // number of (distinct) passwords
+uint64_t glbl_indexEntriesSize = 0; // number of allocated entries and keys
+simAtt_slot *glbl_indexSlots = NULL;
+uint64_t glbl_indexSlotsCount = 0;  // number of slots (always a power of 2)
+
+// pipelined attack: the threads look up a batch while enumNG fills the other one
+simAtt_batch *glbl_simAttBatches[2] = { NULL, NULL }; // filled and checked alternately
+int glbl_simAttBatchCur = 0;    // batch filled by enumNG
+bool glbl_simAttChecking = false; // TRUE, while the other batch is checked by the threads
+bool glbl_simAttFinished = false; // TRUE, once all passwords have been cracked (the remaining records are dropped)
+void (*glbl_simAttCracked) (const char *, int, uint64_t) = NULL;  // called for each cracked password (in order of the guess numbers)
+pthread_t *glbl_simAttThreads = NULL;
+int glbl_sizeOf_simAttThreads = 0;
+pthread_mutex_t glbl_simAttMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t glbl_simAttCondStart = PTHREAD_COND_INITIALIZER; // signaled, once a batch is handed to the threads
+pthread_cond_t glbl_simAttCondDone = PTHREAD_COND_INITIALIZER;  // signaled, once all threads are done with the batch
+uint64_t glbl_simAttGeneration = 0; // increased for each batch handed to the threads
+int glbl_simAttThreadsDone = 0; // amount of threads done with the current batch
+bool glbl_simAttShutdown = false; // TRUE, if the threads should exit
+
 /* (intern function) Returns the passwordSetStruct to the given @password if any or NULL */
 passwordSet_struct *find_testSetPassword (const char *const password)
 {
@@ -75,14 +145,259 @@ void add_testSetPassword (const char *const password)
   }
 }
 
+/* (intern function) Returns the slot index of the given @key in the trie hash map. The returned slot either contains the key or is empty. */
+uint64_t trie_findSlot (uint64_t key)
+{
+  uint64_t slot = (key * 0x9E3779B97F4A7C15ULL) & (glbl_trieSlots - 1);
+
+  while (glbl_trieKeys[slot] != 0 && glbl_trieKeys[slot] != key)
+  {
+    slot = (slot + 1) & (glbl_trieSlots - 1);
+  }
+  return slot;
+}
+
+/* (intern function) Doubles the number of slots of the trie hash map (or allocates the initial slots) */
+void trie_grow ()
+{
+  uint64_t *oldKeys = glbl_trieKeys;
+  int *oldChilds = glbl_trieChilds;
+  uint64_t oldSlots = glbl_trieSlots;
+
+  glbl_trieSlots = (oldSlots == 0) ? 1024 : (oldSlots * 2);
+  glbl_trieKeys = (uint64_t *) calloc (glbl_trieSlots, sizeof (uint64_t));
+  EXIT_IF_NULL (glbl_trieKeys);
+  glbl_trieChilds = (int *) malloc (glbl_trieSlots * sizeof (int));
+  EXIT_IF_NULL (glbl_trieChilds);
+
+  // reinsert all existing entries
+  for (uint64_t i = 0; i < oldSlots; i++)
+  {
+    if (oldKeys[i] != 0)
+    {
+      uint64_t slot = trie_findSlot (oldKeys[i]);
+
+      glbl_trieKeys[slot] = oldKeys[i];
+      glbl_trieChilds[slot] = oldChilds[i];
+    }
+  }
+  CHECKED_FREE (oldKeys);
+  CHECKED_FREE (oldChilds);
+}
+
+/* (intern function) Adds all prefixes of the given @password to the trie. Passwords containing characters not included in the @alphabet (or being too long) can't be created by enumNG and are therefore ignored. */
+void trie_addPassword (const char *const password, int length, const alphabet_struct * alphabet)
+{
+  int positions[MAX_PASSWORD_LENGTH];
+  int node = SIMATT_TRIE_ROOT;
+
+  if (length < 1 || length > MAX_PASSWORD_LENGTH)
+    return;
+
+  for (int i = 0; i < length; i++)
+  {
+    if (!get_positionInAlphabet (positions + i, password[i], alphabet->alphabet, alphabet->sizeOf_alphabet))
+      return;
+  }
+
+  for (int i = 0; i < length; i++)
+  {
+    uint64_t key = (uint64_t) node * glbl_trieAlphabetSize + positions[i] + 1;
+    uint64_t slot;
+
+    // keep the load factor below 1/2
+    if (2 * (glbl_trieNodes + 1) > glbl_trieSlots)
+      trie_grow ();
+
+    slot = trie_findSlot (key);
+    if (glbl_trieKeys[slot] == 0)
+    {
+      glbl_trieKeys[slot] = key;
+      glbl_trieChilds[slot] = (int) glbl_trieNodes;
+      glbl_trieNodes++;
+    }
+    node = glbl_trieChilds[slot];
+  }
+}
+
+// returns the child of the given trie node
+int simAtt_trieChild (int node, int position)
+{
+  uint64_t slot = trie_findSlot ((uint64_t) node * glbl_trieAlphabetSize + position + 1);
+
+  if (glbl_trieKeys[slot] == 0)
+    return SIMATT_TRIE_NONE;
+  return glbl_trieChilds[slot];
+}
+
+/* (intern function) Hashes the SIMATT_LANES padded @keys at once (multi-buffer: each step is done for all lanes, which the compiler vectorizes) */
+void index_hashLanes (const char *keys[SIMATT_LANES], uint32_t hashes[SIMATT_LANES])
+{
+  uint32_t words[SIMATT_SIZEOF_KEY / 4][SIMATT_LANES];
+  uint32_t h[SIMATT_LANES];
+
+  for (int l = 0; l < SIMATT_LANES; l++)
+    for (int w = 0; w < SIMATT_SIZEOF_KEY / 4; w++)
+      memcpy (&(words[w][l]), keys[l] + 4 * w, 4);
+
+  // MurmurHash3 (x86, 32 bit) of the words
+  for (int l = 0; l < SIMATT_LANES; l++)
+    h[l] = SIMATT_SIZEOF_KEY;
+  for (int w = 0; w < SIMATT_SIZEOF_KEY / 4; w++)
+  {
+    for (int l = 0; l < SIMATT_LANES; l++)
+    {
+      uint32_t k = words[w][l] * 0xCC9E2D51U;
+
+      k = (k << 15) | (k >> 17);
+      h[l] ^= k * 0x1B873593U;
+      h[l] = (h[l] << 13) | (h[l] >> 19);
+      h[l] = h[l] * 5 + 0xE6546B64U;
+    }
+  }
+  for (int l = 0; l < SIMATT_LANES; l++)
+  {
+    h[l] ^= h[l] >> 16;
+    h[l] *= 0x85EBCA6BU;
+    h[l] ^= h[l] >> 13;
+    h[l] *= 0xC2B2AE35U;
+    hashes[l] = h[l] ^ (h[l] >> 16);
+  }
+}
+
+/* (intern function) Returns the slot index of the padded @key with the given @hash in the index. The returned slot either contains the key or is empty. */
+uint64_t index_findSlot (uint32_t hash, const char *key)
+{
+  uint64_t slot = hash & (glbl_indexSlotsCount - 1);
+
+  while (glbl_indexSlots[slot].entry != 0 && (glbl_indexSlots[slot].hash != hash || memcmp (glbl_indexKeys + (uint64_t) (glbl_indexSlots[slot].entry - 1) * SIMATT_SIZEOF_KEY, key, SIMATT_SIZEOF_KEY) != 0))
+  {
+    slot = (slot + 1) & (glbl_indexSlotsCount - 1);
+  }
+  return slot;
+}
+
+/* (intern function) Doubles the number of slots of the index (or allocates the initial slots) */
+void index_grow ()
+{
+  simAtt_slot *oldSlots = glbl_indexSlots;
+  uint64_t oldCount = glbl_indexSlotsCount;
+
+  glbl_indexSlotsCount = (oldCount == 0) ? 1024 : (oldCount * 2);
+  glbl_indexSlots = (simAtt_slot *) calloc (glbl_indexSlotsCount, sizeof (simAtt_slot));
+  EXIT_IF_NULL (glbl_indexSlots);
+
+  // reinsert all existing entries (all keys differ, so only the hashes are compared)
+  for (uint64_t i = 0; i < oldCount; i++)
+  {
+    if (oldSlots[i].entry != 0)
+    {
+      uint64_t slot = oldSlots[i].hash & (glbl_indexSlotsCount - 1);
+
+      while (glbl_indexSlots[slot].entry != 0)
+        slot = (slot + 1) & (glbl_indexSlotsCount - 1);
+      glbl_indexSlots[slot] = oldSlots[i];
+    }
+  }
+  CHECKED_FREE (oldSlots);
+}
+
+/* (intern function) Adds the given @password to the index (or adjusts the count of an existing one). Passwords not shorter than MAX_PASSWORD_LENGTH can't be created by enumNG and are therefore ignored. Returns FALSE if the index is full. */
+bool index_addPassword (const char *const password, int length)
+{
+  char key[SIMATT_SIZEOF_KEY] = { 0 };
+  const char *lanes[SIMATT_LANES];
+  uint32_t hashes[SIMATT_LANES];
+  uint64_t slot;
+
+  if (length >= MAX_PASSWORD_LENGTH)
+    return true;
+  memcpy (key, password, length);
+  for (int l = 0; l < SIMATT_LANES; l++)
+    lanes[l] = key;
+  index_hashLanes (lanes, hashes);
+
+  // keep the load factor below 1/2
+  if (2 * (glbl_indexEntriesCount + 1) > glbl_indexSlotsCount)
+    index_grow ();
+
+  slot = index_findSlot (hashes[0], key);
+  if (glbl_indexSlots[slot].entry != 0)
+  {
+    glbl_indexEntries[glbl_indexSlots[slot].entry - 1].count++;
+    return true;
+  }
+
+  if (glbl_indexEntriesCount == UINT32_MAX - 1)
+  {
+    errorHandler_print (errorType_Error, "Too many distinct passwords in the testing set\n");
+    return false;
+  }
+  if (glbl_indexEntriesCount == glbl_indexEntriesSize)
+  {
+    glbl_indexEntriesSize = (glbl_indexEntriesSize == 0) ? 1024 : (glbl_indexEntriesSize * 2);
+    glbl_indexKeys = (char *) realloc (glbl_indexKeys, glbl_indexEntriesSize * SIMATT_SIZEOF_KEY);
+    EXIT_IF_NULL (glbl_indexKeys);
+    glbl_indexEntries = (simAtt_entry *) realloc (glbl_indexEntries, glbl_indexEntriesSize * sizeof (simAtt_entry));
+    EXIT_IF_NULL (glbl_indexEntries);
+  }
+  memcpy (glbl_indexKeys + glbl_indexEntriesCount * SIMATT_SIZEOF_KEY, key, SIMATT_SIZEOF_KEY);
+  glbl_indexEntries[glbl_indexEntriesCount].cracked = 0;
+  glbl_indexEntries[glbl_indexEntriesCount].count = 1;
+  glbl_indexEntriesCount++;
+  glbl_indexSlots[slot].hash = hashes[0];
+  glbl_indexSlots[slot].entry = (uint32_t) glbl_indexEntriesCount;
+  return true;
+}
+
+/* (intern function) Looks up the @count (at most SIMATT_LANES) padded @keys at once: all of them are hashed and their slots prefetched before any slot is compared. Sets @found to the passwords of the testing set (NULL if none). */
+void index_findLanes (const char *const *keys, int count, simAtt_entry ** found)
+{
+  const char *lanes[SIMATT_LANES];
+  uint32_t hashes[SIMATT_LANES];
+
+  // unused lanes are hashed as well (repeating the first key)
+  for (int l = 0; l < SIMATT_LANES; l++)
+    lanes[l] = keys[(l < count) ? l : 0];
+  index_hashLanes (lanes, hashes);
+
+  for (int l = 0; l < count; l++)
+    __builtin_prefetch (glbl_indexSlots + (hashes[l] & (glbl_indexSlotsCount - 1)));
+
+  for (int l = 0; l < count; l++)
+  {
+    uint64_t slot = index_findSlot (hashes[l], lanes[l]);
+
+    found[l] = (glbl_indexSlots[slot].entry == 0) ? NULL : glbl_indexEntries + (glbl_indexSlots[slot].entry - 1);
+  }
+}
+
+/* (intern function) Looks up the first @count padded @passwords (SIMATT_LANES at once) and sets @found to the according passwords of the testing set (NULL if none) */
+void index_findBatch (char (*passwords)[SIMATT_SIZEOF_KEY + 1], int count, simAtt_entry ** found)
+{
+  const char *keys[SIMATT_LANES];
+
+  for (int i = 0; i < count; i += SIMATT_LANES)
+  {
+    int lanes = (count - i < SIMATT_LANES) ? count - i : SIMATT_LANES;
+
+    for (int l = 0; l < lanes; l++)
+      keys[l] = passwords[i + l];
+    index_findLanes (keys, lanes, found + i);
+  }
+}
+
 // generates a testing Set with the passwords found in the file filename
-bool simAtt_generateTestingSet (const char *filename, const char *resultFolder, int outputCycle)
+bool simAtt_generateTestingSet (const char *filename, const char *resultFolder, int outputCycle, const alphabet_struct * alphabet)
 {
   FILE *fp = NULL;
   char curLine[MAX_LINE_LENGTH + 1];
   int length = 0;
 
   glbl_outputCylce = outputCycle;
+  glbl_trieAlphabetSize = alphabet->sizeOf_alphabet;
+  trie_grow ();
+  index_grow ();
 
   // open file
   if (!open_file (&fp, filename, NULL, "r"))
@@ -100,8 +415,14 @@ bool simAtt_generateTestingSet (const char *filename, const char *resultFolder,
     }
     // adjust the size counter
     glbl_sizeOf_testingSet++;
-    // store the PW in the hashmap (or adjust existing PW count)
-    add_testSetPassword (curLine);
+    // store the PW in the index (or adjust existing PW count)
+    if (!index_addPassword (curLine, strlen (curLine)))
+    {
+      fclose (fp);
+      return false;
+    }
+    // add the PW to the prefix trie
+    trie_addPassword (curLine, strlen (curLine), alphabet);
   }
   // clean up
   if (fp != NULL)
@@ -126,37 +447,19 @@ bool simAtt_generateTestingSet (const char *filename, const char *resultFolder,
   return true;
 }
 
-// free allocated memory
-void simAtt_freeTestingSet ()
+/* (intern function) Adds the cracked status at the guess number @attempt (a candidate of the given @length) to the graphs */
+void graph_addPoint (uint64_t attempt, int length)
 {
-  passwordSet_struct *current, *tmp;
-
-  HASH_ITER (hh, glbl_testingSet, current, tmp)
-  {
-    HASH_DEL (glbl_testingSet, current);  // delete; users advances to next
-    free (current);             // optional- if you want to free
-  }
-
-  if (glbl_FP_graphCracked != NULL)
-  {
-    fclose (glbl_FP_graphCracked);
-    glbl_FP_graphCracked = NULL;
-  }
-  if (glbl_FP_graphLengths != NULL)
-  {
-    fclose (glbl_FP_graphLengths);
-    glbl_FP_graphLengths = NULL;
-  }
+  glbl_crackedRatio = ((float) glbl_crackedCount) / ((float) glbl_sizeOf_testingSet);
+  fprintf (glbl_FP_graphCracked, "%" PRIu64 " %f\n", attempt, glbl_crackedRatio);
+  fprintf (glbl_FP_graphLengths, "%" PRIu64 " %i\n", attempt, length);
 }
 
-// checks if given password is in the tesingSet
-bool simAtt_checkCandidate (const char *const password, int length)
+/* (intern function) Marks the password @s of the testing set (NULL if the candidate isn't part of it) as cracked by the candidate of the given @length with the guess number @attempt and adds the graph points. Returns TRUE, if it hasn't been cracked before. */
+bool check_found (simAtt_entry * s, uint64_t attempt, int length)
 {
   bool crackSuccessful = false;
-  passwordSet_struct *s = NULL;
 
-  // try to find the given password in the hashmap ...
-  s = find_testSetPassword (password);
   // if the password has been found ...
   if (s != NULL)
   {
@@ -174,28 +477,305 @@ bool simAtt_checkCandidate (const char *const password, int length)
   }
 
   // the cracked status after every 'x' attempt is added to the graph (x = glbl_outputCycle)
-  if (glbl_attemptsCount % glbl_outputCylce == 0)
+  if (attempt % glbl_outputCylce == 0)
   {
-    glbl_crackedRatio = ((float) glbl_crackedCount) / ((float) glbl_sizeOf_testingSet);
-    fprintf (glbl_FP_graphCracked, "%" PRIu64 " %f\n", glbl_attemptsCount, glbl_crackedRatio);
-    fprintf (glbl_FP_graphLengths, "%" PRIu64 " %i\n", glbl_attemptsCount, length);
+    graph_addPoint (attempt, length);
     fflush (glbl_FP_graphCracked);
     fflush (glbl_FP_graphLengths);
   }
 
   if (glbl_crackedCount == glbl_sizeOf_testingSet)
   {
-    glbl_crackedRatio = ((float) glbl_crackedCount) / ((float) glbl_sizeOf_testingSet);
-    fprintf (glbl_FP_graphCracked, "%" PRIu64 " %f\n", glbl_attemptsCount, glbl_crackedRatio);
-    fprintf (glbl_FP_graphLengths, "%" PRIu64 " %i\n", glbl_attemptsCount, length);
+    graph_addPoint (attempt, length);
     fflush (glbl_FP_graphCracked);
     fflush (glbl_FP_graphLengths);
-    exit (EXIT_SUCCESS);
   }
 
   return crackSuccessful;
 }
 
+/* (intern function) Adds the graph points of the @count skipped candidates of the given @length, the last one with the guess number @attempt */
+void graph_addSkipped (uint64_t attempt, uint64_t count, int length)
+{
+  uint64_t point;
+
+  // first multiple of the output cycle within the skipped attempts
+  point = attempt - count + 1;
+  point = ((point + glbl_outputCylce - 1) / glbl_outputCylce) * glbl_outputCylce;
+
+  // none of the skipped candidates cracks a password, so only the graph points need to be added
+  if (point <= attempt)
+  {
+    for (; point <= attempt; point += glbl_outputCylce)
+      graph_addPoint (point, length);
+    fflush (glbl_FP_graphCracked);
+    fflush (glbl_FP_graphLengths);
+  }
+}
+
+// checks if given password is in the tesingSet
+bool simAtt_checkCandidate (const char *const password, int length)
+{
+  char key[SIMATT_SIZEOF_KEY + 1] = { 0 };
+  const char *keys[1] = { key };
+  simAtt_entry *s = NULL;
+  bool crackSuccessful = false;
+
+  // try to find the given password in the index ...
+  if (length < MAX_PASSWORD_LENGTH)
+  {
+    memcpy (key, password, length);
+    index_findLanes (keys, 1, &s);
+  }
+  crackSuccessful = check_found (s, glbl_attemptsCount, length);
+
+  if (glbl_crackedCount == glbl_sizeOf_testingSet)
+    exit (EXIT_SUCCESS);
+
+  return crackSuccessful;
+}
+
+/* (intern function) Drops the records of both batches following the one at @index of the collected @batch (the last password of the testing set has been cracked by it with the guess number @attempt), so enumNG reports the same results as without threads. */
+void drop_checkRecords (simAtt_batch * batch, int index, uint64_t attempt)
+{
+  simAtt_batch *batchCur = glbl_simAttBatches[glbl_simAttBatchCur];
+
+  glbl_attemptsCount = attempt;
+  for (int i = index + 1; i < batch->count; i++)
+    glbl_createdLengths[batch->lengths[i] - 1] -= (batch->skipped[i] > 0) ? batch->skipped[i] : 1;
+  for (int i = 0; i < batchCur->count; i++)
+    glbl_createdLengths[batchCur->lengths[i] - 1] -= (batchCur->skipped[i] > 0) ? batchCur->skipped[i] : 1;
+  glbl_simAttFinished = true;
+}
+
+/* (intern function) Waits until the threads are done with the batch they check and accounts its records in order of their guess numbers */
+void collect_checkedBatch ()
+{
+  simAtt_batch *batch = glbl_simAttBatches[glbl_simAttBatchCur ^ 1];
+  uint64_t attempt = batch->firstAttempt;
+
+  if (!glbl_simAttChecking)
+    return;
+
+  pthread_mutex_lock (&glbl_simAttMutex);
+  while (glbl_simAttThreadsDone < glbl_sizeOf_simAttThreads)
+    pthread_cond_wait (&glbl_simAttCondDone, &glbl_simAttMutex);
+  pthread_mutex_unlock (&glbl_simAttMutex);
+  glbl_simAttChecking = false;
+
+  for (int i = 0; i < batch->count; i++)
+  {
+    if (batch->skipped[i] > 0)
+    {
+      attempt += batch->skipped[i];
+      graph_addSkipped (attempt, batch->skipped[i], batch->lengths[i]);
+      continue;
+    }
+    attempt++;
+    if (check_found (batch->found[i], attempt, batch->lengths[i]) && glbl_crackedCount != glbl_sizeOf_testingSet)
+      glbl_simAttCracked (batch->passwords[i], batch->lengths[i], attempt);
+    // stop like simAtt_checkCandidate, with the guess number of the cracking candidate (the caller exits, see glbl_simAttFinished)
+    if (glbl_crackedCount == glbl_sizeOf_testingSet)
+    {
+      drop_checkRecords (batch, i, attempt);
+      return;
+    }
+  }
+  batch->count = 0;
+}
+
+/* (intern function) Hands the current batch to the threads and switches to the other one */
+void dispatch_checkBatch ()
+{
+  simAtt_batch *batch = glbl_simAttBatches[glbl_simAttBatchCur];
+
+  // the other batch must be done before it is filled again
+  collect_checkedBatch ();
+  if (batch->count == 0 || glbl_simAttFinished)
+    return;
+
+  batch->next = 0;
+  pthread_mutex_lock (&glbl_simAttMutex);
+  glbl_simAttBatchCur ^= 1;
+  glbl_simAttThreadsDone = 0;
+  glbl_simAttGeneration++;
+  glbl_simAttChecking = true;
+  pthread_cond_broadcast (&glbl_simAttCondStart);
+  pthread_mutex_unlock (&glbl_simAttMutex);
+}
+
+/* (intern function) Adds a record (candidate or @skipped candidates) of the given @length to the batch filled by enumNG, handing it to the threads once it is full. */
+void add_checkRecord (const char *password, int length, uint64_t skipped)
+{
+  simAtt_batch *batch = glbl_simAttBatches[glbl_simAttBatchCur];
+
+  // glbl_attemptsCount already includes the record
+  if (batch->count == 0)
+    batch->firstAttempt = glbl_attemptsCount - ((skipped > 0) ? skipped : 1);
+  if (skipped == 0)
+  {
+    memcpy (batch->passwords[batch->count], password, length);
+    memset (batch->passwords[batch->count] + length, 0, SIMATT_SIZEOF_KEY + 1 - length);
+  }
+  batch->lengths[batch->count] = (unsigned char) length;
+  batch->skipped[batch->count] = skipped;
+  batch->count++;
+
+  if (batch->count == SIMATT_BATCH_SIZE)
+  {
+    dispatch_checkBatch ();
+    // only called while enumerating, so it ends like simAtt_checkCandidate
+    if (glbl_simAttFinished)
+      exit (EXIT_SUCCESS);
+  }
+}
+
+// accounts skipped candidates
+void simAtt_skipCandidates (uint64_t count, int length)
+{
+  // pipelined attack: the graph points are added once the candidates before have been checked
+  if (glbl_simAttThreads != NULL)
+  {
+    add_checkRecord (NULL, length, count);
+    return;
+  }
+  graph_addSkipped (glbl_attemptsCount, count, length);
+}
+
+/* (intern function) Main function of each checking thread: looks up the candidates of the batch handed to the threads */
+void *run_checkingThread (void *arg)
+{
+  simAtt_batch *batch = NULL;
+  uint64_t generation = 0;
+  int start = 0;
+
+  (void) arg;
+  for (;;)
+  {
+    pthread_mutex_lock (&glbl_simAttMutex);
+    while (!glbl_simAttShutdown && glbl_simAttGeneration == generation)
+      pthread_cond_wait (&glbl_simAttCondStart, &glbl_simAttMutex);
+    if (glbl_simAttShutdown)
+    {
+      pthread_mutex_unlock (&glbl_simAttMutex);
+      break;
+    }
+    generation = glbl_simAttGeneration;
+    batch = glbl_simAttBatches[glbl_simAttBatchCur ^ 1];
+    pthread_mutex_unlock (&glbl_simAttMutex);
+
+    // the testing set is only read while a batch is checked (marking the cracked passwords is up to enumNG)
+    while ((start = __atomic_fetch_add (&(batch->next), SIMATT_CHUNK_SIZE, __ATOMIC_RELAXED)) < batch->count)
+    {
+      int end = (batch->count - start < SIMATT_CHUNK_SIZE) ? batch->count : start + SIMATT_CHUNK_SIZE;
+
+      // the records of skipped candidates are looked up as well (with the key left in the record) and dropped afterwards
+      index_findBatch (batch->passwords + start, end - start, batch->found + start);
+      for (int i = start; i < end; i++)
+        if (batch->skipped[i] > 0)
+          batch->found[i] = NULL;
+    }
+
+    pthread_mutex_lock (&glbl_simAttMutex);
+    glbl_simAttThreadsDone++;
+    if (glbl_simAttThreadsDone == glbl_sizeOf_simAttThreads)
+      pthread_cond_signal (&glbl_simAttCondDone);
+    pthread_mutex_unlock (&glbl_simAttMutex);
+  }
+  return NULL;
+}
+
+// starts the checking threads
+bool simAtt_startThreads (int threads, void (*cracked) (const char *, int, uint64_t))
+{
+  glbl_simAttCracked = cracked;
+  for (int i = 0; i < 2; i++)
+  {
+    glbl_simAttBatches[i] = (simAtt_batch *) calloc (1, sizeof (simAtt_batch));
+    EXIT_IF_NULL (glbl_simAttBatches[i]);
+  }
+  glbl_simAttThreads = (pthread_t *) malloc (sizeof (pthread_t) * threads);
+  EXIT_IF_NULL (glbl_simAttThreads);
+  for (int i = 0; i < threads; i++)
+  {
+    if (pthread_create (glbl_simAttThreads + i, NULL, run_checkingThread, NULL) != 0)
+    {
+      errorHandler_print (errorType_Error, "Unable to create the checking threads\n");
+      return false;
+    }
+    glbl_sizeOf_simAttThreads++;
+  }
+  return true;
+}
+
+// adds a candidate to the current batch
+void simAtt_addCandidate (const char *const password, int length)
+{
+  add_checkRecord (password, length, 0);
+}
+
+// checks the remaining candidates
+bool simAtt_flush ()
+{
+  if (glbl_simAttThreads == NULL)
+    return true;
+  if (!glbl_simAttFinished)
+  {
+    dispatch_checkBatch ();
+    collect_checkedBatch ();
+  }
+  return !glbl_simAttFinished;
+}
+
+// free allocated memory
+void simAtt_freeTestingSet ()
+{
+  passwordSet_struct *current, *tmp;
+
+  HASH_ITER (hh, glbl_testingSet, current, tmp)
+  {
+    HASH_DEL (glbl_testingSet, current);  // delete; users advances to next
+    free (current);             // optional- if you want to free
+  }
+  // stop the checking threads (idle once the last batch has been collected)
+  if (glbl_simAttThreads != NULL)
+  {
+    collect_checkedBatch ();
+    pthread_mutex_lock (&glbl_simAttMutex);
+    glbl_simAttShutdown = true;
+    pthread_cond_broadcast (&glbl_simAttCondStart);
+    pthread_mutex_unlock (&glbl_simAttMutex);
+    for (int i = 0; i < glbl_sizeOf_simAttThreads; i++)
+      pthread_join (glbl_simAttThreads[i], NULL);
+    CHECKED_FREE (glbl_simAttThreads);
+    CHECKED_FREE (glbl_simAttBatches[0]);
+    CHECKED_FREE (glbl_simAttBatches[1]);
+  }
+  // free the index
+  CHECKED_FREE (glbl_indexSlots);
+  CHECKED_FREE (glbl_indexKeys);
+  CHECKED_FREE (glbl_indexEntries);
+  glbl_indexSlotsCount = 0;
+  glbl_indexEntriesCount = 0;
+  glbl_indexEntriesSize = 0;
+  // free the prefix trie
+  CHECKED_FREE (glbl_trieKeys);
+  CHECKED_FREE (glbl_trieChilds);
+  glbl_trieSlots = 0;
+  glbl_trieNodes = 1;
+
+  if (glbl_FP_graphCracked != NULL)
+  {
+    fclose (glbl_FP_graphCracked);
+    glbl_FP_graphCracked = NULL;
+  }
+  if (glbl_FP_graphLengths != NULL)
+  {
+    fclose (glbl_FP_graphLengths);
+    glbl_FP_graphLengths = NULL;
+  }
+}
+
 bool simAtt_boostInit (const char *const resultFolder, int output_cycle)
 {
   glbl_crackedCount = 0;
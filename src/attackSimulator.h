@@ -6,25 +6,62 @@
  * Used by enumNG to perform a simulated attack. Reads a list of plain-text
  * passwords, referred to as training set, and provides function to check, if a
  * certain password created by enumNG is part of the training set.
+ * The candidates are either checked one by one by enumNG or, pipelined,
+ * collected in batches which are looked up by a pool of threads while
+ * enumNG creates the next batch (see simAtt_startThreads). The results of
+ * a batch are accounted in order of the guess numbers, so the graphs and
+ * results equal those of checking the candidates one by one.
+ * Candidates are looked up in a flat index of the testing set (open
+ * addressing, the keys stored one after another in a single arena) instead
+ * of the hashmap: SIMATT_LANES candidates are hashed at once (multi-buffer,
+ * vectorized by the compiler), the slots of all of them are prefetched and
+ * only then compared, so the cache misses of the lookups overlap.
  *
  */
 
 #ifndef ATTACKSIMULATOR_H_
 #define ATTACKSIMULATOR_H_
 
+#include "commonStructs.h"
+
+// node ids of the testing set prefix trie
+#define SIMATT_TRIE_ROOT 0      // empty prefix
+#define SIMATT_TRIE_NONE -1     // no password of the testing set starts with the prefix
+
+// pipelined attack
+#define SIMATT_BATCH_SIZE 16384 // candidates (or records of skipped candidates) per batch
+#define SIMATT_CHUNK_SIZE 256   // candidates looked up by a thread at once
+#define SIMATT_MAX_THREADS 256
+
+// flat index of the testing set
+#define SIMATT_LANES 8          // candidates looked up at once
+#define SIMATT_SIZEOF_KEY (((MAX_PASSWORD_LENGTH + 3) / 4) * 4) // chars of a key (password padded with '\0' to whole words)
+
 extern uint64_t glbl_crackedCount;
 extern float glbl_crackedRatio;
 
 /*
  * Generates a "testing set" based on the passwords found in the
  * given @filename. If an error occurs FALSE is returned.
- * The passwords of the "testing set" are stored in the global variable
- * "glbl_testingSet". One can check if a password is part of the "testing Set"
- * using the function find_testSetingPassword(password).
+ * The passwords of the "testing set" (shorter than MAX_PASSWORD_LENGTH,
+ * enumNG doesn't create longer ones) are stored in the flat index looked up
+ * by simAtt_checkCandidate and simAtt_addCandidate.
+ * Additionally, all prefixes of the passwords (given as positions in the
+ * @alphabet) are stored in a prefix trie, see simAtt_trieChild.
  */
 bool simAtt_generateTestingSet (const char *filename, // filename to the file containing the testing set passwords
                                 const char *resultFolder, // folder for the result files
-                                int outputCycle); // every x crack try should be added to the graph
+                                int outputCycle,  // every x crack try should be added to the graph
+                                const alphabet_struct * alphabet);  // alphabet used by enumNG
+
+/*
+ * Returns the node of the testing set prefix trie reached by appending the
+ * char at @position of the alphabet to the prefix represented by @node.
+ * If no password of the testing set starts with the new prefix,
+ * SIMATT_TRIE_NONE is returned. The empty prefix is SIMATT_TRIE_ROOT.
+ */
+int simAtt_trieChild (int node, // node of the current prefix
+                      int position);  // position of the next char in the alphabet
 
 /*
  * Frees any memory allocated by the attack simulator
@@ -38,6 +75,44 @@ void simAtt_freeTestingSet ();
 bool simAtt_checkCandidate (const char *const password, // the password to be checked out
                             int length);  // the length of the password
 
+/*
+ * Starts @threads threads checking the candidates of the pipelined attack
+ * (see simAtt_addCandidate). @cracked is called for each cracked password
+ * (except the last one of the testing set, like simAtt_checkCandidate) with
+ * its guess number, in order of the guess numbers.
+ * Returns FALSE if the threads can't be created.
+ */
+bool simAtt_startThreads (int threads, // amount of checking threads
+                          void (*cracked) (const char *, int, uint64_t)); // called for each cracked password
+
+/*
+ * Adds the given @password (with the guess number glbl_attemptsCount) to
+ * the current batch, which is handed to the threads once it is full and
+ * accounted once the next one is. Once all passwords of the testing set
+ * have been cracked, the application ends like simAtt_checkCandidate does
+ * (glbl_attemptsCount is set back to the cracking candidate).
+ */
+void simAtt_addCandidate (const char *const password, // the password to be checked out
+                          int length);  // the length of the password
+
+/*
+ * Checks all candidates added so far (pipelined attack only), so
+ * glbl_crackedCount and the graphs include all of them.
+ * Returns FALSE once all passwords of the testing set have been cracked
+ * (glbl_attemptsCount is set back to the cracking candidate); unlike
+ * simAtt_addCandidate it never exits, so the enumeration has to stop then.
+ */
+bool simAtt_flush ();
+
+/*
+ * Accounts @count candidates of the given @length, which have been skipped
+ * since none of them is part of the testing set. glbl_attemptsCount must
+ * already include the skipped candidates. Any graph point within the
+ * skipped attempts is added, so the graphs equal those of a full run.
+ */
+void simAtt_skipCandidates (uint64_t count, // number of skipped candidates
+                            int length);  // the length of the skipped candidates
+
 /*
  * This functions prints the results of a simulated attack
  * to the given file pointer (i.e. stdout or log-file).
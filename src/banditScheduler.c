@@ -0,0 +1,222 @@
+/*
+ * banditScheduler.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "banditScheduler.h"
+#include "errorHandler.h"
+
+/* (intern function) Sets the index of the given @arm: upper quantile of its Gamma(cracked + 1, exposure + priorExposure) posterior of theta times e^-level */
+void update_armIndex (const banditScheduler_struct * scheduler, banditScheduler_arm * arm)
+{
+  double shape = arm->cracked + 1;
+  double rate = arm->exposure + scheduler->priorExposure;
+  double root = 1 - 1 / (9 * shape) + scheduler->confidence * sqrt (1 / (9 * shape));
+
+  arm->index = shape / rate * root * root * root * exp (-(arm->level + arm->lengthLevel));
+}                               // (intern) update_armIndex
+
+/* (intern function) Returns TRUE if arm @a should be pulled before arm @b (ties: lower level, then shorter length) */
+bool arm_isBefore (const banditScheduler_arm * a, const banditScheduler_arm * b)
+{
+  if (a->index != b->index)
+    return a->index > b->index;
+  if (a->level + a->lengthLevel != b->level + b->lengthLevel)
+    return a->level + a->lengthLevel < b->level + b->lengthLevel;
+  return a->length < b->length;
+}                               // (intern) arm_isBefore
+
+/* (intern function) Stores the arm @arm at the position @index of the heap */
+void arm_setHeap (banditScheduler_struct * scheduler, int index, int arm)
+{
+  scheduler->heap[index] = arm;
+  scheduler->arms[arm].heapIndex = index;
+}                               // (intern) arm_setHeap
+
+/* (intern function) moves the arm at @index up until the heap property is restored */
+void arm_siftUp (banditScheduler_struct * scheduler, int index)
+{
+  int arm = scheduler->heap[index];
+
+  while (index > 0 && arm_isBefore (scheduler->arms + arm, scheduler->arms + scheduler->heap[(index - 1) / 2]))
+  {
+    arm_setHeap (scheduler, index, scheduler->heap[(index - 1) / 2]);
+    index = (index - 1) / 2;
+  }
+  arm_setHeap (scheduler, index, arm);
+}                               // (intern) arm_siftUp
+
+/* (intern function) moves the arm at @index down until the heap property is restored */
+void arm_siftDown (banditScheduler_struct * scheduler, int index)
+{
+  int arm = scheduler->heap[index];
+  int child;
+
+  while ((child = 2 * index + 1) < scheduler->sizeOf_heap)
+  {
+    // select the child to be pulled first
+    if (child + 1 < scheduler->sizeOf_heap && arm_isBefore (scheduler->arms + scheduler->heap[child + 1], scheduler->arms + scheduler->heap[child]))
+      child++;
+    if (!arm_isBefore (scheduler->arms + scheduler->heap[child], scheduler->arms + arm))
+      break;
+    arm_setHeap (scheduler, index, scheduler->heap[child]);
+    index = child;
+  }
+  arm_setHeap (scheduler, index, arm);
+}                               // (intern) arm_siftDown
+
+/* (intern function) Recalculates the index of the given @arm and restores the heap property */
+void arm_reorder (banditScheduler_struct * scheduler, banditScheduler_arm * arm)
+{
+  if (arm->heapIndex < 0)
+    return;
+  update_armIndex (scheduler, arm);
+  arm_siftUp (scheduler, arm->heapIndex);
+  arm_siftDown (scheduler, arm->heapIndex);
+}                               // (intern) arm_reorder
+
+/* (intern function) Adjusts the prior and the confidence to all arms and recalculates all indices, rebuilding the heap */
+void rebuild_armHeap (banditScheduler_struct * scheduler)
+{
+  double exposure = 0;
+  double cracked = 0;
+  int sizeOf_arms = scheduler->sizeOf_lengths * scheduler->sizeOf_levels;
+
+  for (int i = 0; i < sizeOf_arms; i++)
+  {
+    exposure += scheduler->arms[i].exposure;
+    cracked += scheduler->arms[i].cracked;
+  }
+  // any positive prior ranks arms without observations by their level
+  scheduler->priorExposure = (exposure > 0) ? exposure / (cracked + 1) : 1;
+  scheduler->confidence = sqrt (2 * log ((double) scheduler->pulls + 1));
+  for (int i = 0; i < scheduler->sizeOf_heap; i++)
+    update_armIndex (scheduler, scheduler->arms + scheduler->heap[i]);
+  for (int i = scheduler->sizeOf_heap / 2 - 1; i >= 0; i--)
+    arm_siftDown (scheduler, i);
+  scheduler->pullsRebuild = 2 * scheduler->pulls + 1;
+}                               // (intern) rebuild_armHeap
+
+// creates the arms
+void banditScheduler_initialize (banditScheduler_struct ** scheduler, int lengthMin, int lengthMax, int maxLevel, int lengthLCModifier, const int lengthLevel[MAX_PASSWORD_LENGTH])
+{
+  banditScheduler_arm *arm = NULL;
+  int sizeOf_arms = (lengthMax - lengthMin + 1) * maxLevel;
+
+  (*scheduler) = (banditScheduler_struct *) calloc (1, sizeof (banditScheduler_struct));
+  EXIT_IF_NULL ((*scheduler));
+  (*scheduler)->arms = (banditScheduler_arm *) calloc (sizeOf_arms, sizeof (banditScheduler_arm));
+  EXIT_IF_NULL ((*scheduler)->arms);
+  (*scheduler)->heap = (int *) malloc (sizeOf_arms * sizeof (int));
+  EXIT_IF_NULL ((*scheduler)->heap);
+  (*scheduler)->lengthMin = lengthMin;
+  (*scheduler)->sizeOf_lengths = lengthMax - lengthMin + 1;
+  (*scheduler)->sizeOf_levels = maxLevel;
+
+  for (int i = 0; i < sizeOf_arms; i++)
+  {
+    arm = (*scheduler)->arms + i;
+    arm->length = lengthMin + i / maxLevel;
+    arm->lengthLevel = lengthLevel[arm->length];
+    arm->iPLevel = i % maxLevel;
+    arm->level = arm->iPLevel;  // all further levels of the levelChain are 0
+    arm->levelMax = arm->iPLevel + (maxLevel - 1) * (arm->length + lengthLCModifier - 1);
+    arm->newChain = true;
+    arm->heapIndex = i;
+    (*scheduler)->heap[i] = i;
+  }
+  (*scheduler)->sizeOf_heap = sizeOf_arms;
+  rebuild_armHeap (*scheduler);
+}                               // banditScheduler_initialize
+
+// returns the arm of the given length and iPLevel
+banditScheduler_arm *banditScheduler_getArm (banditScheduler_struct * scheduler, int length, int iPLevel)
+{
+  if (length < scheduler->lengthMin || length >= scheduler->lengthMin + scheduler->sizeOf_lengths || iPLevel < 0 || iPLevel >= scheduler->sizeOf_levels)
+    return NULL;
+  return scheduler->arms + (length - scheduler->lengthMin) * scheduler->sizeOf_levels + iPLevel;
+}                               // banditScheduler_getArm
+
+// returns the arm to be pulled next
+banditScheduler_arm *banditScheduler_select (banditScheduler_struct * scheduler)
+{
+  if (scheduler->sizeOf_heap == 0)
+    return NULL;
+  return scheduler->arms + scheduler->heap[0];
+}                               // banditScheduler_select
+
+// adds the attempts at the current level
+void banditScheduler_addAttempts (banditScheduler_arm * arm, uint64_t attempts)
+{
+  arm->attempts += attempts;
+  // an empty levelChain still takes time, so it counts as a single attempt
+  arm->exposure += ((attempts > 0) ? attempts : 1) * exp (-(arm->level + arm->lengthLevel));
+}                               // banditScheduler_addAttempts
+
+// completes a pull
+void banditScheduler_update (banditScheduler_struct * scheduler, banditScheduler_arm * arm, uint64_t cracked)
+{
+  arm->cracked += cracked;
+  arm->pulls++;
+  scheduler->pulls++;
+  if (scheduler->pulls >= scheduler->pullsRebuild)
+    rebuild_armHeap (scheduler);
+  else
+    arm_reorder (scheduler, arm);
+}                               // banditScheduler_update
+
+// adds passwords cracked later
+void banditScheduler_credit (banditScheduler_struct * scheduler, banditScheduler_arm * arm, uint64_t cracked)
+{
+  arm->cracked += cracked;
+  arm_reorder (scheduler, arm);
+}                               // banditScheduler_credit
+
+// moves the arm to its next level
+bool banditScheduler_nextLevel (banditScheduler_struct * scheduler, banditScheduler_arm * arm)
+{
+  arm->level++;
+  arm->newChain = true;
+  if (arm->level > arm->levelMax)
+  {
+    banditScheduler_finish (scheduler, arm);
+    return false;
+  }
+  return true;
+}                               // banditScheduler_nextLevel
+
+// removes the arm from the heap
+void banditScheduler_finish (banditScheduler_struct * scheduler, banditScheduler_arm * arm)
+{
+  int index = arm->heapIndex;
+  int moved = 0;
+
+  if (index < 0)
+    return;
+  arm->heapIndex = -1;
+  scheduler->sizeOf_heap--;
+  if (index == scheduler->sizeOf_heap)
+    return;
+  // move the last arm to the free position
+  moved = scheduler->heap[scheduler->sizeOf_heap];
+  arm_setHeap (scheduler, index, moved);
+  arm_siftUp (scheduler, index);
+  arm_siftDown (scheduler, scheduler->arms[moved].heapIndex);
+}                               // banditScheduler_finish
+
+// frees the scheduler
+void banditScheduler_free (banditScheduler_struct ** scheduler)
+{
+  if (*scheduler == NULL)
+    return;
+  CHECKED_FREE ((*scheduler)->arms);
+  CHECKED_FREE ((*scheduler)->heap);
+  free (*scheduler);
+  (*scheduler) = NULL;
+}                               // banditScheduler_free
@@ -0,0 +1,132 @@
+/*
+ * banditScheduler.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Multi-armed bandit scheduling the enumeration of enumNG (--scheduler bandit).
+ * Each arm enumerates the levelChains of a single password length starting
+ * with a single initialProb level, level by level. Every pull of an arm
+ * enumerates a bounded amount of passwords (--pullSize, a levelChain is
+ * never split, an empty levelChain counts as a single password), so the scheduler reacts quickly to the cracks it observes.
+ *
+ * Since a level corresponds to a factor of e in probability, the crack rate
+ * of an arm is modeled as theta * e^-level (level including the level of the
+ * length): without any crack, the arms are pulled in the order of their
+ * levels, i.e. the order of the normal enumeration. Each arm learns its own
+ * theta: the cracks are modeled as a Poisson process with the exposure
+ * sum(attempts * e^-level), giving a Gamma posterior for theta. The prior is
+ * a single crack at the exposure per crack of all arms.
+ * The next arm is chosen by an upper confidence bound (Bayes-UCB): the index
+ * of an arm is an upper quantile of its posterior (Wilson-Hilferty
+ * approximation) times e^-level of its current level.
+ * The arms are kept in a max-heap ordered by their index. The prior and the
+ * confidence depend on all arms, so they are updated and the heap is rebuilt
+ * whenever the overall amount of pulls doubles; in between only the changed
+ * arm is moved.
+ *
+ */
+
+#ifndef BANDITSCHEDULER_H_
+#define BANDITSCHEDULER_H_
+
+#include <stdint.h>
+
+#include "common.h"
+
+/*
+ * Single arm: levelChains of @length starting with @iPLevel.
+ */
+typedef struct banditScheduler_arm
+{
+  int length;                   // length of the passwords
+  int lengthLevel;              // level of the length
+  int iPLevel;                  // level of the initialProb (first level of the levelChains)
+  int level;                    // current level of the levelChains (without @lengthLevel)
+  int levelMax;                 // highest level of the levelChains
+  int levelChain[MAX_PASSWORD_LENGTH + 1];  // last levelChain enumerated (used by enumNG)
+  bool newChain;                // TRUE, if no levelChain of @level has been enumerated yet
+
+  uint64_t attempts;            // created passwords
+  uint64_t cracked;             // cracked passwords
+  double exposure;              // sum of the attempts weighted by e^-level
+  uint64_t pulls;               // amount of pulls
+  double index;                 // upper confidence bound of the crack rate at the current level
+  int heapIndex;                // position in the heap (-1 if finished)
+} banditScheduler_arm;
+
+/*
+ * Arms of all lengths and initialProb levels.
+ */
+typedef struct banditScheduler_struct
+{
+  banditScheduler_arm *arms;    // arms ordered by length and iPLevel
+  int lengthMin;                // length of the first arm
+  int sizeOf_lengths;           // amount of lengths
+  int sizeOf_levels;            // amount of initialProb levels per length
+
+  int *heap;                    // max-heap of the arms (by index) not finished
+  int sizeOf_heap;
+  uint64_t pulls;               // overall amount of pulls
+  uint64_t pullsRebuild;        // amount of pulls the heap is rebuilt at
+  double priorExposure;         // exposure per crack of all arms (prior of theta)
+  double confidence;            // z-score of the upper quantile (grows with @pulls)
+} banditScheduler_struct;
+
+/*
+ * Creates an arm for each length in [@lengthMin, @lengthMax] and each
+ * initialProb level in [0, @maxLevel - 1]. The levelChains of each arm
+ * have a length of @length + @lengthLCModifier.
+ */
+void banditScheduler_initialize (banditScheduler_struct ** scheduler, // scheduler to be initialized
+                                 int lengthMin, // shortest password length
+                                 int lengthMax, // longest password length
+                                 int maxLevel,  // amount of levels
+                                 int lengthLCModifier,  // difference between the length of the levelChains and passwords
+                                 const int lengthLevel[MAX_PASSWORD_LENGTH]); // level of each length
+
+/*
+ * Returns the arm of the given @length and @iPLevel (NULL if there is none).
+ */
+banditScheduler_arm *banditScheduler_getArm (banditScheduler_struct * scheduler, int length, int iPLevel);
+
+/*
+ * Returns the arm with the highest index (NULL if all arms are finished).
+ */
+banditScheduler_arm *banditScheduler_select (banditScheduler_struct * scheduler);
+
+/*
+ * Adds @attempts passwords created by a levelChain of the given @arm at its
+ * current level. An empty levelChain is counted as a single attempt, so arms
+ * scanning many empty levelChains lose their index as well.
+ */
+void banditScheduler_addAttempts (banditScheduler_arm * arm, uint64_t attempts);
+
+/*
+ * Completes a pull of the given @arm, adding the passwords @cracked during
+ * the pull.
+ */
+void banditScheduler_update (banditScheduler_struct * scheduler, banditScheduler_arm * arm, uint64_t cracked);
+
+/*
+ * Adds passwords cracked later (e.g. by an external password cracker) to
+ * the given @arm.
+ */
+void banditScheduler_credit (banditScheduler_struct * scheduler, banditScheduler_arm * arm, uint64_t cracked);
+
+/*
+ * Moves the given @arm to its next level.
+ * Returns FALSE (and finishes the arm) if its highest level is reached.
+ */
+bool banditScheduler_nextLevel (banditScheduler_struct * scheduler, banditScheduler_arm * arm);
+
+/*
+ * Removes the given @arm from the scheduling.
+ */
+void banditScheduler_finish (banditScheduler_struct * scheduler, banditScheduler_arm * arm);
+
+/*
+ * Frees the given scheduler (if not NULL).
+ */
+void banditScheduler_free (banditScheduler_struct ** scheduler);
+
+#endif /* BANDITSCHEDULER_H_ */
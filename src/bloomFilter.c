@@ -0,0 +1,217 @@
+/*
+ * bloomFilter.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <math.h>
+
+#include "bloomFilter.h"
+#include "defines.h"
+#include "errorHandler.h"
+
+/* (intern function) Returns the finalizer of splitmix64 of @value, spreading its bits. */
+uint64_t bloom_mix (uint64_t value)
+{
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}                               // (intern) bloom_mix
+
+/* (intern function) Returns the 64 bit hash of the given @password (FNV-1a, followed by the finalizer of splitmix64 to spread the bits). */
+uint64_t bloom_hash (const char *password, size_t length)
+{
+  uint64_t hash = 14695981039346656037ULL;
+
+  for (size_t i = 0; i < length; i++)
+  {
+    hash ^= (unsigned char) password[i];
+    hash *= 1099511628211ULL;
+  }
+  return bloom_mix (hash);
+}                               // (intern) bloom_hash
+
+// initializes the filter
+void bloomFilter_initialize (bloomFilter_struct ** filter, uint64_t elements, int bitsPerElement, uint64_t bytesMax)
+{
+  uint64_t blockBytes = BLOOMFILTER_BLOCK_WORDS * sizeof (uint64_t);
+  uint64_t sizeOf_blocks = 1;
+  double bitsAvailable = 0.0;
+
+  // smallest power of two holding bitsPerElement bits per password (but not exceeding bytesMax)
+  while (sizeOf_blocks * blockBytes * 8 / bitsPerElement < elements && sizeOf_blocks * blockBytes * 2 <= bytesMax)
+    sizeOf_blocks *= 2;
+
+  *filter = (bloomFilter_struct *) malloc (sizeof (bloomFilter_struct));
+  EXIT_IF_NULL (*filter);
+  (*filter)->blocks = (uint64_t *) calloc (sizeOf_blocks * BLOOMFILTER_BLOCK_WORDS, sizeof (uint64_t));
+  EXIT_IF_NULL ((*filter)->blocks);
+  (*filter)->sizeOf_blocks = sizeOf_blocks;
+  (*filter)->insertedCount = 0;
+  (*filter)->seenCount = 0;
+
+  // optimal amount of hash functions (bits set per password): k = ln(2) * bits of the filter per password
+  bitsAvailable = (double) (sizeOf_blocks * blockBytes * 8) / (double) (elements > 0 ? elements : 1);
+  (*filter)->sizeOf_hashes = (int) (0.693 * bitsAvailable + 0.5);
+  if ((*filter)->sizeOf_hashes < 1)
+    (*filter)->sizeOf_hashes = 1;
+  else if ((*filter)->sizeOf_hashes > BLOOMFILTER_MAX_HASHES)
+    (*filter)->sizeOf_hashes = BLOOMFILTER_MAX_HASHES;
+}                               // bloomFilter_initialize
+
+/* (intern function) Returns TRUE if all bits of the given @password are set, setting them if @insert is TRUE (the filter is only read otherwise). */
+bool bloom_lookup (const bloomFilter_struct * filter, const char *password, size_t length, bool insert)
+{
+  uint64_t hash = bloom_hash (password, length);
+  uint64_t *block = filter->blocks + (hash & (filter->sizeOf_blocks - 1)) * BLOOMFILTER_BLOCK_WORDS;
+  /* the bits inside the block are taken from the splitmix64 sequence seeded by the hash, 9 bits per index (7 indices per value), so
+     passwords of the same block only share all bits by chance (instead of sharing a few bits of the hash, like double hashing) */
+  uint64_t state = hash;
+  uint64_t bits = 0;
+  bool seen = true;
+
+  for (int i = 0; i < filter->sizeOf_hashes; i++)
+  {
+    int index = 0;
+    uint64_t mask = 0;
+
+    if (i % 7 == 0)
+      bits = bloom_mix (state += 0x9e3779b97f4a7c15ULL);
+    index = bits & (BLOOMFILTER_BLOCK_WORDS * 64 - 1);
+    mask = 1ULL << (index & 63);
+    bits >>= 9;
+
+    if ((block[index >> 6] & mask) == 0)
+    {
+      if (!insert)
+        return false;
+      seen = false;
+      block[index >> 6] |= mask;
+    }
+  }
+  return seen;
+}                               // (intern) bloom_lookup
+
+// inserts the password into the filter
+bool bloomFilter_insert (bloomFilter_struct * filter, const char *password, size_t length)
+{
+  bool seen = bloom_lookup (filter, password, length, true);
+
+  if (seen)
+    filter->seenCount++;
+  else
+    filter->insertedCount++;
+  return seen;
+}                               // bloomFilter_insert
+
+// checks the password without inserting it
+bool bloomFilter_contains (const bloomFilter_struct * filter, const char *password, size_t length)
+{
+  return bloom_lookup (filter, password, length, false);
+}                               // bloomFilter_contains
+
+// returns the probability of a false positive
+double bloomFilter_falsePositiveRate (const bloomFilter_struct * filter)
+{
+  double perBlock = (double) filter->insertedCount / (double) filter->sizeOf_blocks;
+  double probability = exp (-perBlock); // of a block holding j passwords (Poisson distributed)
+  double rate = 0.0;
+  int jMax = (int) (perBlock + 12 * sqrt (perBlock)) + 12;
+
+  // a new password is reported as seen if all of its bits are set in its block
+  for (int j = 0; j <= jMax; j++)
+  {
+    double bitSet = 1.0 - pow (1.0 - 1.0 / (BLOOMFILTER_BLOCK_WORDS * 64), (double) filter->sizeOf_hashes * j);
+
+    rate += probability * pow (bitSet, filter->sizeOf_hashes);
+    probability *= perBlock / (j + 1);
+  }
+  return rate;
+}                               // bloomFilter_falsePositiveRate
+
+// removes all passwords from the filter
+void bloomFilter_clear (bloomFilter_struct * filter)
+{
+  memset (filter->blocks, 0, filter->sizeOf_blocks * BLOOMFILTER_BLOCK_WORDS * sizeof (uint64_t));
+  filter->insertedCount = 0;
+}                               // bloomFilter_clear
+
+// prints the size of the filter and the amount of duplicates
+void bloomFilter_printResults (const bloomFilter_struct * filter, FILE * fp)
+{
+  fprintf (fp, " - filter: %" PRIu64 " KiB, %i bits set per password\n", filter->sizeOf_blocks * BLOOMFILTER_BLOCK_WORDS * sizeof (uint64_t) / 1024, filter->sizeOf_hashes);
+  fprintf (fp, " - passwords: %" PRIu64 " new, %" PRIu64 " dropped as seen\n", filter->insertedCount, filter->seenCount);
+}                               // bloomFilter_printResults
+
+// writes the filter to the file
+bool bloomFilter_write (const bloomFilter_struct * filter, FILE * fp)
+{
+  uint64_t head[4] = { BLOOMFILTER_BYTE_ORDER, filter->sizeOf_blocks, (uint64_t) filter->sizeOf_hashes, filter->insertedCount };
+  size_t sizeOf_words = filter->sizeOf_blocks * BLOOMFILTER_BLOCK_WORDS;
+
+  if (fwrite (BLOOMFILTER_MAGIC, 1, BLOOMFILTER_SIZEOF_MAGIC, fp) != BLOOMFILTER_SIZEOF_MAGIC)
+    return false;
+  if (fwrite (head, sizeof (uint64_t), 4, fp) != 4)
+    return false;
+  return fwrite (filter->blocks, sizeof (uint64_t), sizeOf_words, fp) == sizeOf_words;
+}                               // bloomFilter_write
+
+// reads a filter from the file
+bool bloomFilter_read (bloomFilter_struct ** filter, FILE * fp)
+{
+  char magic[BLOOMFILTER_SIZEOF_MAGIC];
+  uint64_t head[4];
+  size_t sizeOf_words = 0;
+
+  if (fread (magic, 1, BLOOMFILTER_SIZEOF_MAGIC, fp) != BLOOMFILTER_SIZEOF_MAGIC || memcmp (magic, BLOOMFILTER_MAGIC, BLOOMFILTER_SIZEOF_MAGIC) != 0 || fread (head, sizeof (uint64_t), 4, fp) != 4)
+  {
+    errorHandler_print (errorType_Error, "The file is not a filter created by createFilter.\n");
+    return false;
+  }
+  if (head[0] != BLOOMFILTER_BYTE_ORDER)
+  {
+    errorHandler_print (errorType_Error, "The filter has been created on a host of another byte order.\n");
+    return false;
+  }
+  // the amount of blocks must be a power of two (selected by the lower bits of the hash)
+  if (head[1] == 0 || (head[1] & (head[1] - 1)) != 0 || head[2] < 1 || head[2] > BLOOMFILTER_MAX_HASHES)
+  {
+    errorHandler_print (errorType_Error, "The header of the filter is invalid.\n");
+    return false;
+  }
+
+  *filter = (bloomFilter_struct *) malloc (sizeof (bloomFilter_struct));
+  EXIT_IF_NULL (*filter);
+  sizeOf_words = head[1] * BLOOMFILTER_BLOCK_WORDS;
+  (*filter)->blocks = (uint64_t *) malloc (sizeOf_words * sizeof (uint64_t));
+  EXIT_IF_NULL ((*filter)->blocks);
+  (*filter)->sizeOf_blocks = head[1];
+  (*filter)->sizeOf_hashes = (int) head[2];
+  (*filter)->insertedCount = head[3];
+  (*filter)->seenCount = 0;
+  if (fread ((*filter)->blocks, sizeof (uint64_t), sizeOf_words, fp) != sizeOf_words)
+  {
+    errorHandler_print (errorType_Error, "The filter is truncated.\n");
+    bloomFilter_free (filter);
+    return false;
+  }
+  return true;
+}                               // bloomFilter_read
+
+// frees the filter
+void bloomFilter_free (bloomFilter_struct ** filter)
+{
+  if (*filter != NULL)
+  {
+    CHECKED_FREE ((*filter)->blocks);
+    free (*filter);
+    *filter = NULL;
+  }
+}                               // bloomFilter_free
@@ -0,0 +1,108 @@
+/*
+ * bloomFilter.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Compact filter of the passwords seen so far, e.g. to drop duplicates when
+ * merging several enumerations. A blocked Bloom filter is used: all bits of
+ * a password are set in a single block of 512 bits (one cache line), so each
+ * lookup touches a single cache line. Passwords are never reported as new if
+ * they have been inserted before, but a new password is reported as seen
+ * with a small probability (below 0.1 % for BLOOMFILTER_BITS_PER_ELEMENT, if
+ * the filter is not limited by its maximal size).
+ * A filter can be written to a file and read again, e.g. to exclude the
+ * passwords of earlier attacks from enumNG (see createFilter). Its words are
+ * stored in the byte order of the host, the file is rejected on a host of
+ * another byte order. Lookups (bloomFilter_contains) only read the filter,
+ * so any amount of threads may check passwords at the same time.
+ *
+ */
+
+#ifndef BLOOMFILTER_H_
+#define BLOOMFILTER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// === Defines ===
+#define BLOOMFILTER_BLOCK_WORDS 8 // 64 bit words per block (512 bits)
+#define BLOOMFILTER_BITS_PER_ELEMENT 16
+#define BLOOMFILTER_MAX_HASHES 16
+#define BLOOMFILTER_MAGIC "OMENBF01"
+#define BLOOMFILTER_SIZEOF_MAGIC 8
+#define BLOOMFILTER_BYTE_ORDER 0x0102030405060708ULL  // written after the magic to detect another byte order
+
+/*
+ * Blocks of the filter and the amount of bits set per password.
+ */
+typedef struct bloomFilter_struct
+{
+  uint64_t *blocks;             // BLOOMFILTER_BLOCK_WORDS words per block
+  uint64_t sizeOf_blocks;       // amount of blocks (power of two)
+  int sizeOf_hashes;            // bits set per password
+  uint64_t insertedCount;       // amount of passwords inserted
+  uint64_t seenCount;           // amount of passwords reported as seen
+} bloomFilter_struct;
+
+/*
+ * Initializes a filter for @elements passwords with @bitsPerElement bits
+ * each (usually BLOOMFILTER_BITS_PER_ELEMENT), using at most @bytesMax bytes
+ * (rounded down to a power of two, at least one block).
+ */
+void bloomFilter_initialize (bloomFilter_struct ** filter, // filter to be initialized
+                             uint64_t elements, // expected amount of passwords
+                             int bitsPerElement,  // bits of the filter per password
+                             uint64_t bytesMax);  // maximal size of the filter
+
+/*
+ * Inserts the given @password of @length into the filter.
+ * Returns TRUE if the password has (probably) been inserted before.
+ */
+bool bloomFilter_insert (bloomFilter_struct * filter, const char *password, size_t length);
+
+/*
+ * Returns TRUE if the given @password of @length has (probably) been
+ * inserted before, without inserting it.
+ */
+bool bloomFilter_contains (const bloomFilter_struct * filter, const char *password, size_t length);
+
+/*
+ * Returns the probability of a new password being reported as seen (a false
+ * positive), given the amount of passwords inserted so far.
+ */
+double bloomFilter_falsePositiveRate (const bloomFilter_struct * filter);
+
+/*
+ * Removes all passwords from the filter (resetting the amount of inserted
+ * passwords, but not the amount of passwords reported as seen).
+ */
+void bloomFilter_clear (bloomFilter_struct * filter);
+
+/*
+ * Prints the size of the filter and the amount of passwords reported as seen
+ * to the given file pointer @fp.
+ */
+void bloomFilter_printResults (const bloomFilter_struct * filter, FILE * fp);
+
+/*
+ * Writes the given filter to @fp.
+ * Returns FALSE if it can't be written.
+ */
+bool bloomFilter_write (const bloomFilter_struct * filter, FILE * fp);
+
+/*
+ * Reads a filter written by bloomFilter_write from @fp into the given
+ * struct (allocated by this function).
+ * Returns FALSE (printing an error) if @fp doesn't contain a filter.
+ * If the allocation fails, the application is aborted.
+ */
+bool bloomFilter_read (bloomFilter_struct ** filter, FILE * fp);
+
+/*
+ * Frees the given filter (if not NULL).
+ */
+void bloomFilter_free (bloomFilter_struct ** filter);
+
+#endif /* BLOOMFILTER_H_ */
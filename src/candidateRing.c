@@ -0,0 +1,413 @@
+/*
+ * candidateRing.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <sched.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "candidateRing.h"
+#include "common.h"
+#include "errorHandler.h"
+
+#define CANDIDATERING_CACHE_LINE 64 // the shared counters are kept on separate cache lines
+#define CANDIDATERING_SPINS 64  // busy polls before yielding
+#define CANDIDATERING_YIELDS 1024 // yields before sleeping
+#define CANDIDATERING_SLEEP 100 // microseconds slept per poll afterwards
+
+// === Global Variables ===
+volatile sig_atomic_t glbl_candidateRingStop = 0; // set by candidateRing_stop (producer only)
+
+/*
+ * Header stored at the beginning of the segment, followed by the slots and
+ * the batches.
+ */
+typedef struct candidateRing_header
+{
+  uint32_t magic;               // CANDIDATERING_MAGIC
+  uint32_t version;             // CANDIDATERING_VERSION
+  uint32_t slots;               // amount of slots
+  uint32_t batchSize;           // bytes per batch
+  int ready;                    // set once the ring is initialized (accessed atomically)
+  int finished;                 // set once the producer is done (accessed atomically)
+  char padding1[CANDIDATERING_CACHE_LINE - 24];
+
+  uint64_t tail;                // position of the next batch taken by a consumer (accessed atomically)
+  char padding2[CANDIDATERING_CACHE_LINE - 8];
+} candidateRing_header;
+
+/*
+ * State of a single slot. For the batch at position x (stored in slot
+ * x % slots), @sequence equals x while the slot is free for the producer,
+ * x + 1 once the batch is published, and x + slots once the consumer
+ * released it (i.e. the slot is free for the batch at x + slots).
+ */
+typedef struct candidateRing_slot
+{
+  uint64_t sequence;            // see above (accessed atomically)
+  uint32_t size;                // bytes used in the batch
+  uint32_t count;               // amount of passwords in the batch
+  char padding[CANDIDATERING_CACHE_LINE - 16];
+} candidateRing_slot;
+
+/* (intern function) returns the header of the given ring */
+candidateRing_header *get_header (candidateRing_struct * ring)
+{
+  return (candidateRing_header *) ring->segment;
+}                               // get_header
+
+/* (intern function) returns the slot of the batch at @position */
+candidateRing_slot *get_slot (candidateRing_struct * ring, uint64_t position)
+{
+  candidateRing_header *header = get_header (ring);
+
+  return ((candidateRing_slot *) (header + 1)) + (position % header->slots);
+}                               // get_slot
+
+/* (intern function) returns the batch at @position */
+unsigned char *get_batch (candidateRing_struct * ring, uint64_t position)
+{
+  candidateRing_header *header = get_header (ring);
+  unsigned char *batches = (unsigned char *) (((candidateRing_slot *) (header + 1)) + header->slots);
+
+  return batches + (position % header->slots) * (size_t) header->batchSize;
+}                               // get_batch
+
+/* (intern function) waits before polling again: busy at first, then yielding, then sleeping */
+void wait_backoff (unsigned int *polls)
+{
+  struct timespec interval = { 0, CANDIDATERING_SLEEP * 1000L };
+
+  if (*polls < CANDIDATERING_SPINS)
+    (*polls)++;
+  else if (*polls < CANDIDATERING_SPINS + CANDIDATERING_YIELDS)
+  {
+    (*polls)++;
+    sched_yield ();
+  }
+  else
+    nanosleep (&interval, NULL);
+}                               // wait_backoff
+
+/* (intern function) waits until the slot of the current batch is free and takes it (producer only). Returns FALSE (printing an error on timeout) if the producer has been stopped or the slot isn't released within the timeout. */
+bool acquire_slot (candidateRing_struct * ring)
+{
+  candidateRing_slot *slot = get_slot (ring, ring->position);
+  struct timespec start = { 0, 0 };
+  struct timespec now = { 0, 0 };
+  unsigned int polls = 0;
+
+  while (__atomic_load_n (&(slot->sequence), __ATOMIC_ACQUIRE) != ring->position)
+  {
+    if (glbl_candidateRingStop)
+      return false;
+    wait_backoff (&polls);
+    // the clock is only read once the producer sleeps between the polls
+    if (ring->timeout > 0 && polls == CANDIDATERING_SPINS + CANDIDATERING_YIELDS)
+    {
+      clock_gettime (CLOCK_MONOTONIC, &now);
+      if (start.tv_sec == 0 && start.tv_nsec == 0)
+        start = now;
+      else if (now.tv_sec - start.tv_sec >= ring->timeout)
+      {
+        errorHandler_print (errorType_Error, "No batch of the ring %s has been released for %i seconds (no consumer attached?)\n", ring->name, ring->timeout);
+        return false;
+      }
+    }
+  }
+  ring->batchAcquired = true;
+  ring->batchSize = 0;
+  ring->batchCount = 0;
+  return true;
+}                               // acquire_slot
+
+/* (intern function) publishes the current batch (producer only, the slot must be acquired) */
+void publish_slot (candidateRing_struct * ring)
+{
+  candidateRing_slot *slot = get_slot (ring, ring->position);
+
+  slot->size = ring->batchSize;
+  slot->count = ring->batchCount;
+  // the batch must be visible before the sequence
+  __atomic_store_n (&(slot->sequence), ring->position + 1, __ATOMIC_RELEASE);
+  ring->position++;
+  ring->batchAcquired = false;
+}                               // publish_slot
+
+/* (intern function) allocates an empty ring struct */
+void initialize_ring (candidateRing_struct ** ring)
+{
+  (*ring) = (candidateRing_struct *) malloc (sizeof (candidateRing_struct));
+  EXIT_IF_NULL ((*ring));
+  (*ring)->segment = NULL;
+  (*ring)->sizeOf_segment = 0;
+  (*ring)->name = NULL;
+  (*ring)->producer = false;
+  (*ring)->timeout = 0;
+  (*ring)->position = 0;
+  (*ring)->batchAcquired = false;
+  (*ring)->batchSize = 0;
+  (*ring)->batchCount = 0;
+}                               // initialize_ring
+
+/* (intern function) unmaps the segment and frees the given ring */
+void free_ring (candidateRing_struct ** ring)
+{
+  if ((*ring)->segment != NULL)
+    munmap ((*ring)->segment, (*ring)->sizeOf_segment);
+  CHECKED_FREE ((*ring)->name);
+  free (*ring);
+  (*ring) = NULL;
+}                               // free_ring
+
+// === producer ===
+
+// creates the ring
+bool candidateRing_create (candidateRing_struct ** ring, const char *name, int slots, int timeout)
+{
+  candidateRing_header *header = NULL;
+  candidateRing_slot *slot = NULL;
+  int fd = -1;
+
+  if (slots < 1 || slots > CANDIDATERING_MAX_SLOTS)
+  {
+    errorHandler_print (errorType_Error, "The amount of slots must be in range %i to %i.\n", 1, CANDIDATERING_MAX_SLOTS);
+    return false;
+  }
+
+  initialize_ring (ring);
+  (*ring)->producer = true;
+  (*ring)->timeout = timeout;
+  if (!str_allocCpy (&((*ring)->name), name))
+  {
+    printf ("Error: Out of Memory\n");
+    exit (1);
+  }
+  (*ring)->sizeOf_segment = sizeof (candidateRing_header) + (size_t) slots *(sizeof (candidateRing_slot) + CANDIDATERING_BATCH_SIZE);
+
+  // a ring left over by a previous producer can't be used anymore
+  shm_unlink (name);
+  fd = shm_open (name, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd == -1)
+  {
+    errorHandler_print (errorType_Error, "Unable to create the ring %s (%s)\n", name, strerror (errno));
+    free_ring (ring);
+    return false;
+  }
+  if (ftruncate (fd, (off_t) (*ring)->sizeOf_segment) != 0 || ((*ring)->segment = mmap (NULL, (*ring)->sizeOf_segment, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+  {
+    errorHandler_print (errorType_Error, "Unable to map the ring %s (%s)\n", name, strerror (errno));
+    (*ring)->segment = NULL;
+    close (fd);
+    shm_unlink (name);
+    free_ring (ring);
+    return false;
+  }
+  close (fd);
+
+  // the segment is zero initialized
+  header = get_header (*ring);
+  header->magic = CANDIDATERING_MAGIC;
+  header->version = CANDIDATERING_VERSION;
+  header->slots = (uint32_t) slots;
+  header->batchSize = CANDIDATERING_BATCH_SIZE;
+  for (int i = 0; i < slots; i++)
+  {
+    slot = get_slot (*ring, i);
+    slot->sequence = (uint64_t) i;
+  }
+  __atomic_store_n (&(header->ready), 1, __ATOMIC_RELEASE);
+
+  return true;
+}                               // candidateRing_create
+
+// appends a password to the current batch
+bool candidateRing_push (candidateRing_struct * ring, const char *password, int length)
+{
+  unsigned char *batch = NULL;
+
+  if (glbl_candidateRingStop)
+    return false;
+  if (ring->batchAcquired && ring->batchSize + 1 + length > CANDIDATERING_BATCH_SIZE)
+    publish_slot (ring);
+  if (!ring->batchAcquired && !acquire_slot (ring))
+    return false;
+
+  batch = get_batch (ring, ring->position) + ring->batchSize;
+  batch[0] = (unsigned char) length;
+  memcpy (batch + 1, password, length);
+  ring->batchSize += 1 + length;
+  ring->batchCount++;
+  return true;
+}                               // candidateRing_push
+
+// stops the producer
+void candidateRing_stop ()
+{
+  glbl_candidateRingStop = 1;
+}                               // candidateRing_stop
+
+// publishes the current batch
+void candidateRing_flush (candidateRing_struct * ring)
+{
+  if (ring->batchAcquired && ring->batchCount > 0)
+    publish_slot (ring);
+}                               // candidateRing_flush
+
+// finishes and frees the ring
+void candidateRing_close (candidateRing_struct ** ring)
+{
+  if ((*ring) == NULL)
+    return;
+
+  if ((*ring)->segment != NULL)
+  {
+    // never waits (the slot of the current batch is already acquired)
+    candidateRing_flush (*ring);
+    __atomic_store_n (&(get_header (*ring)->finished), 1, __ATOMIC_RELEASE);
+    // attached consumers keep their mapping
+    shm_unlink ((*ring)->name);
+  }
+  free_ring (ring);
+}                               // candidateRing_close
+
+// === consumer ===
+
+// attaches the ring
+bool candidateRing_attach (candidateRing_struct ** ring, const char *name, int timeout)
+{
+  candidateRing_header *header = NULL;
+  struct stat segmentStat;
+  struct timespec interval = { 0, 10 * 1000000L };
+  long polls = (long) timeout * 100;
+  int fd = -1;
+
+  initialize_ring (ring);
+
+  // wait for the producer to create the segment (and resize it)
+  for (;;)
+  {
+    if (fd == -1)
+      fd = shm_open (name, O_RDWR, 0);
+    if (fd != -1 && fstat (fd, &segmentStat) == 0 && (size_t) segmentStat.st_size >= sizeof (candidateRing_header))
+      break;
+    if (fd == -1 && errno != ENOENT)
+      break;
+    if (polls-- <= 0)
+      break;
+    nanosleep (&interval, NULL);
+  }
+  if (fd == -1 || (size_t) segmentStat.st_size < sizeof (candidateRing_header))
+  {
+    errorHandler_print (errorType_Error, "Unable to open the ring %s (%s)\n", name, (fd == -1) ? strerror (errno) : "not created in time");
+    if (fd != -1)
+      close (fd);
+    free_ring (ring);
+    return false;
+  }
+
+  (*ring)->sizeOf_segment = (size_t) segmentStat.st_size;
+  (*ring)->segment = mmap (NULL, (*ring)->sizeOf_segment, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close (fd);
+  if ((*ring)->segment == MAP_FAILED)
+  {
+    errorHandler_print (errorType_Error, "Unable to map the ring %s (%s)\n", name, strerror (errno));
+    (*ring)->segment = NULL;
+    free_ring (ring);
+    return false;
+  }
+
+  header = get_header (*ring);
+  while (!__atomic_load_n (&(header->ready), __ATOMIC_ACQUIRE) && polls-- > 0)
+    nanosleep (&interval, NULL);
+  if (!__atomic_load_n (&(header->ready), __ATOMIC_ACQUIRE) || header->magic != CANDIDATERING_MAGIC || header->version != CANDIDATERING_VERSION || header->batchSize != CANDIDATERING_BATCH_SIZE || sizeof (candidateRing_header) + (size_t) header->slots * (sizeof (candidateRing_slot) + header->batchSize) != (*ring)->sizeOf_segment)
+  {
+    errorHandler_print (errorType_Error, "The shared memory segment %s is not a valid ring\n", name);
+    free_ring (ring);
+    return false;
+  }
+  return true;
+}                               // candidateRing_attach
+
+// takes the next published batch
+bool candidateRing_acquire (candidateRing_struct * ring, candidateRing_batch * batch)
+{
+  candidateRing_header *header = get_header (ring);
+  candidateRing_slot *slot = NULL;
+  uint64_t position = __atomic_load_n (&(header->tail), __ATOMIC_RELAXED);
+  uint64_t sequence = 0;
+  unsigned int polls = 0;
+
+  for (;;)
+  {
+    slot = get_slot (ring, position);
+    sequence = __atomic_load_n (&(slot->sequence), __ATOMIC_ACQUIRE);
+    if (sequence == position + 1)
+    {
+      // published: claim it (on failure, @position is set to the current tail)
+      if (__atomic_compare_exchange_n (&(header->tail), &position, position + 1, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        break;
+    }
+    else if ((int64_t) (sequence - (position + 1)) < 0)
+    {
+      // empty: all batches are published before the producer sets finished
+      if (__atomic_load_n (&(header->finished), __ATOMIC_ACQUIRE) && __atomic_load_n (&(slot->sequence), __ATOMIC_ACQUIRE) != position + 1)
+        return false;
+      wait_backoff (&polls);
+      position = __atomic_load_n (&(header->tail), __ATOMIC_RELAXED);
+    }
+    else
+    {
+      // taken by another consumer
+      position = __atomic_load_n (&(header->tail), __ATOMIC_RELAXED);
+    }
+  }
+
+  batch->data = get_batch (ring, position);
+  batch->size = slot->size;
+  batch->count = slot->count;
+  batch->offset = 0;
+  batch->position = position;
+  return true;
+}                               // candidateRing_acquire
+
+// returns the next password of the batch
+const char *candidateRing_nextCandidate (candidateRing_batch * batch, int *length)
+{
+  const char *password = NULL;
+
+  if (batch->offset >= batch->size)
+    return NULL;
+  *length = batch->data[batch->offset];
+  password = (const char *) (batch->data + batch->offset + 1);
+  batch->offset += 1 + *length;
+  return password;
+}                               // candidateRing_nextCandidate
+
+// releases the batch
+void candidateRing_release (candidateRing_struct * ring, candidateRing_batch * batch)
+{
+  candidateRing_slot *slot = get_slot (ring, batch->position);
+
+  __atomic_store_n (&(slot->sequence), batch->position + get_header (ring)->slots, __ATOMIC_RELEASE);
+  batch->data = NULL;
+  batch->size = 0;
+  batch->count = 0;
+}                               // candidateRing_release
+
+// detaches the ring
+void candidateRing_detach (candidateRing_struct ** ring)
+{
+  if ((*ring) != NULL)
+    free_ring (ring);
+}                               // candidateRing_detach
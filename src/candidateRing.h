@@ -0,0 +1,144 @@
+/*
+ * candidateRing.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Ring buffer in a named POSIX shared memory segment passing the passwords
+ * created by enumNG (--ring) to any amount of consumers running on the same
+ * host, without copying them through a pipe.
+ * The passwords are collected in batches of up to CANDIDATERING_BATCH_SIZE
+ * bytes, each password stored as uint8 length followed by @length chars (no
+ * '\0'). The ring consists of a fixed amount of slots holding one batch each.
+ * The single producer fills the next free slot in place and publishes it;
+ * each published batch is taken by exactly one consumer, which reads it in
+ * place and releases the slot afterwards. No locks are used: every slot
+ * carries a sequence number telling whether it is free, published, or taken
+ * (the consumers claim the next batch using compare-and-swap).
+ * If the ring is full, the producer waits for the consumers; if it is empty,
+ * the consumers wait for the producer. The producer gives up if no slot gets
+ * free within its timeout (no consumer attached, or a consumer died holding a
+ * batch) or once it is stopped (candidateRing_stop, e.g. on SIGTERM). Once
+ * the producer is done, it marks the ring finished and removes its name, so
+ * consumers must be attached before the enumeration ends.
+ *
+ * Consumer side (also part of libomen):
+ *   candidateRing_attach (&ring, "/omen", 60);
+ *   while (candidateRing_acquire (ring, &batch))
+ *   {
+ *     while ((password = candidateRing_nextCandidate (&batch, &length)) != NULL)
+ *       ...
+ *     candidateRing_release (ring, &batch);
+ *   }
+ *   candidateRing_detach (&ring);
+ *
+ */
+
+#ifndef CANDIDATERING_H_
+#define CANDIDATERING_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// === Defines ===
+#define CANDIDATERING_MAGIC 0x474e4952  // "RING"
+#define CANDIDATERING_VERSION 1
+#define CANDIDATERING_BATCH_SIZE 65536  // bytes per batch
+#define CANDIDATERING_DEFAULT_SLOTS 64
+#define CANDIDATERING_MAX_SLOTS 65536
+
+/*
+ * Ring attached by the producer (candidateRing_create) or a consumer
+ * (candidateRing_attach).
+ */
+typedef struct candidateRing_struct
+{
+  void *segment;                // mapped segment
+  size_t sizeOf_segment;        // size of the mapped segment
+  char *name;                   // name of the segment (producer only, removed on close)
+  bool producer;                // TRUE, if created by candidateRing_create
+  int timeout;                  // seconds the producer waits for a free slot (0: no limit)
+
+  // producer only: batch currently filled
+  uint64_t position;            // position of the batch (slot = position % slots)
+  bool batchAcquired;           // TRUE, if the slot of @position is owned by the producer
+  uint32_t batchSize;           // bytes used in the batch
+  uint32_t batchCount;          // amount of passwords in the batch
+} candidateRing_struct;
+
+/*
+ * Batch taken by a consumer (see candidateRing_acquire). @data points into
+ * the ring and stays valid until the batch is released.
+ */
+typedef struct candidateRing_batch
+{
+  const unsigned char *data;    // passwords (uint8 length, chars)
+  uint32_t size;                // bytes used in @data
+  uint32_t count;               // amount of passwords in @data
+  uint32_t offset;              // offset of the next password (see candidateRing_nextCandidate)
+  uint64_t position;            // position of the batch in the ring
+} candidateRing_batch;
+
+/*
+ * Creates the ring @name (e.g. "/omen") with @slots batches, replacing any
+ * ring left over by a previous producer. The producer waits up to @timeout
+ * seconds (0: no limit) for a slot released by the consumers.
+ * Returns FALSE if the segment can't be created.
+ */
+bool candidateRing_create (candidateRing_struct ** ring, const char *name, int slots, int timeout);
+
+/*
+ * Appends the password to the current batch, publishing the batch once it
+ * is full (waits while all slots are used by the consumers).
+ * Returns FALSE if the producer has been stopped or no slot got free within
+ * the timeout (printing an error); the ring should be closed then.
+ */
+bool candidateRing_push (candidateRing_struct * ring, const char *password, int length);
+
+/*
+ * Stops the producer: any waiting or further candidateRing_push returns
+ * FALSE. Async-signal-safe, so it can be called from a signal handler.
+ */
+void candidateRing_stop ();
+
+/*
+ * Publishes the current batch (if not empty).
+ */
+void candidateRing_flush (candidateRing_struct * ring);
+
+/*
+ * Publishes the current batch, marks the ring finished, removes its name and
+ * frees the given ring (if not NULL). Used by the producer only.
+ */
+void candidateRing_close (candidateRing_struct ** ring);
+
+/*
+ * Attaches the ring @name, waiting up to @timeout seconds until the producer
+ * has created it.
+ * Returns FALSE if the ring doesn't exist (in time) or is invalid.
+ */
+bool candidateRing_attach (candidateRing_struct ** ring, const char *name, int timeout);
+
+/*
+ * Takes the next published batch (waiting until the producer publishes one).
+ * Returns FALSE if the producer is done and all batches have been taken.
+ */
+bool candidateRing_acquire (candidateRing_struct * ring, candidateRing_batch * batch);
+
+/*
+ * Returns the next password of the given @batch (setting @length) or NULL if
+ * all passwords have been read. The password is not null terminated.
+ */
+const char *candidateRing_nextCandidate (candidateRing_batch * batch, int *length);
+
+/*
+ * Releases the given @batch, so its slot can be filled again.
+ */
+void candidateRing_release (candidateRing_struct * ring, candidateRing_batch * batch);
+
+/*
+ * Detaches and frees the given ring (if not NULL). Used by the consumers only.
+ */
+void candidateRing_detach (candidateRing_struct ** ring);
+
+#endif /* CANDIDATERING_H_ */
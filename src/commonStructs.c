@@ -90,6 +90,15 @@ void struct_alphabet_allocateDefaults (alphabet_struct * alphabet)
   (alphabet->sizeOf_alphabet) = DEFAULT_ALPHABET_SIZE;  // +1
 }                               // struct_allocateDefaults_alphabet
 
+// fills the lookup table of the alphabet positions
+void struct_alphabet_fillPositions (const alphabet_struct * alphabet, int charPosition[256])
+{
+  for (int i = 0; i < 256; i++)
+    charPosition[i] = -1;
+  for (int i = 0; i < alphabet->sizeOf_alphabet; i++)
+    charPosition[(unsigned char) alphabet->alphabet[i]] = i;
+}                               // struct_alphabet_fillPositions
+
 // === nGrams functions ===
 
 // initializes given nGramStruct
@@ -194,40 +203,61 @@ void struct_nGrams_copyArrays (nGram_struct * dest, nGram_struct * src)
   memcpy ((dest->len), (src->len), sizeof (int) * (src->sizeOf_len));
 }                               // struct_copy_nGrams_enumNG
 
+// calculates the level of the password
+bool struct_nGrams_level (const nGram_struct * nGrams, const int charPosition[256], int sizeOf_alphabet, const char *password, int length, bool ignoreEP, bool addLength, int *level)
+{
+  int sizeOf_N = nGrams->sizeOf_N;
+  int position = 0;
+  int c = 0;
+
+  // enumNG creates passwords of length n to MAX_PASSWORD_LENGTH - 1
+  if (length < sizeOf_N || length >= MAX_PASSWORD_LENGTH)
+    return false;
+
+  // position of the first (n-1) chars
+  for (int i = 0; i < sizeOf_N - 1; i++)
+  {
+    c = charPosition[(unsigned char) password[i]];
+    if (c < 0)
+      return false;
+    position = position * sizeOf_alphabet + c;
+  }
+  *level = nGrams->iP[position];
+
+  // add the conditionalProb of each further char
+  for (int i = sizeOf_N - 1; i < length; i++)
+  {
+    c = charPosition[(unsigned char) password[i]];
+    if (c < 0)
+      return false;
+    *level += nGrams->cP[position * sizeOf_alphabet + c];
+    position = (position % (nGrams->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet + c;
+  }
+  if (!ignoreEP)
+    *level += nGrams->eP[position];
+  if (addLength)
+    *level += nGrams->len[length];
+  return true;
+}                               // struct_nGrams_level
+
 // === sortedLastGram functions ===
 
 // initializes given sortedLastGramStruct
-void struct_sortedLastGram_initialize (int maxLevel, sortedLastGram_struct ** sortedLastGram, int sizeOf_N, int sizeOf_alphabet, int indexMax_default)
+void struct_sortedLastGram_initialize (int maxLevel, sortedLastGram_struct ** sortedLastGram, int sizeOf_N, int sizeOf_alphabet)
 {
   // calculate sizeOf_mGram
-  int sizeOf_lastGram = 1;
+  int sizeOf_mGram = 1;
 
   for (int i = 0; i < sizeOf_N - 1; i++)
-    sizeOf_lastGram *= sizeOf_alphabet;
+    sizeOf_mGram *= sizeOf_alphabet;
   (*sortedLastGram) = (sortedLastGram_struct *) malloc (sizeof (sortedLastGram_struct) * maxLevel);
   EXIT_IF_NULL ((*sortedLastGram)) for (int i = 0; i < maxLevel; i++)
   {
-    ((*sortedLastGram)[i].lastGrams) = NULL;
-    ((*sortedLastGram)[i].indexCur) = NULL;
-    ((*sortedLastGram)[i].indexMax) = NULL;
-    ((*sortedLastGram)[i].lastGrams) = (int **) realloc (((*sortedLastGram)[i].lastGrams), sizeof (int *) * sizeOf_lastGram);
-    ((*sortedLastGram)[i].indexCur) = (int *) realloc (((*sortedLastGram)[i].indexCur), sizeof (int) * sizeOf_lastGram);
-    ((*sortedLastGram)[i].indexMax) = (int *) realloc (((*sortedLastGram)[i].indexMax), sizeof (int) * sizeOf_lastGram);
-    if ((*sortedLastGram)[i].lastGrams == NULL || (*sortedLastGram)[i].indexCur == NULL || (*sortedLastGram)[i].indexMax == NULL)
-    {
-      printf ("Error: Out of Memory\n");
-      exit (1);
-    }
-    (*sortedLastGram)[i].sizeOf_mGram = sizeOf_lastGram;
-    for (int j = 0; j < sizeOf_lastGram; j++)
-    {
-      ((*sortedLastGram)[i].lastGrams)[j] = NULL;
-      ((*sortedLastGram)[i].lastGrams)[j] = (int *) realloc (((*sortedLastGram)[i].lastGrams)[j], sizeof (int) * indexMax_default);
-      ((*sortedLastGram)[i].indexCur)[j] = 0;
-      ((*sortedLastGram)[i].indexMax)[j] = indexMax_default;
-      // check reallocation
-      EXIT_IF_NULL (((*sortedLastGram)[i].lastGrams)[j]) memset (((*sortedLastGram)[i].lastGrams)[j], 0, sizeof (int) * indexMax_default);
-    }
+    // the lastGrams are allocated once their amount is known (see struct_sortedLastGram_fill)
+    (*sortedLastGram)[i].lastGrams = NULL;
+    (*sortedLastGram)[i].indexStart = (int *) calloc (sizeOf_mGram + 1, sizeof (int));
+    EXIT_IF_NULL ((*sortedLastGram)[i].indexStart);
+    (*sortedLastGram)[i].sizeOf_mGram = sizeOf_mGram;
   }
 }                               // struct_initialize_sortedLastGram
 
@@ -238,17 +268,8 @@ void struct_sortedLastGram_free (int maxLevel, sortedLastGram_struct ** sortedLa
   {
     for (int i = 0; i < maxLevel; i++)
     {
-      if ((*sortedLastGram)[i].lastGrams != NULL)
-      {
-        for (int j = 0; j < (*sortedLastGram)[i].sizeOf_mGram; j++)
-        {
-          CHECKED_FREE (((*sortedLastGram)[i].lastGrams)[j]);
-        }
-
-        CHECKED_FREE (((*sortedLastGram)[i].indexCur));
-        CHECKED_FREE (((*sortedLastGram)[i].indexMax));
-        CHECKED_FREE (((*sortedLastGram)[i].lastGrams));
-      }
+      CHECKED_FREE ((*sortedLastGram)[i].lastGrams);
+      CHECKED_FREE ((*sortedLastGram)[i].indexStart);
     }
     CHECKED_FREE ((*sortedLastGram));
   }
@@ -257,40 +278,34 @@ void struct_sortedLastGram_free (int maxLevel, sortedLastGram_struct ** sortedLa
 // fills the sortedLastGramStruct based on source
 void struct_sortedLastGram_fill (int maxLevel, sortedLastGram_struct * sortedLastGram, int *source, int source_size, int sizeOf_N, int sizeOf_alphabet)
 {
-  // int k = 0;
   int level = 0;
   int position_mGram = 0;
-  int position_lastGram = 0;
-  int index = 0;
-  int nGramAsInt[sizeOf_N];
+  int index[maxLevel];          // next free index in the lastGrams of each level
 
+  // count the lastGrams of each mGram and level (stored at the index of the next mGram)
   for (int i = 0; i < source_size; i++)
   {
-    // get current level (at positive i)
-    level = source[i];
-    if (level > maxLevel - 1)
-      level = maxLevel - 1;
-    // get the nGram as int from the current position
-    get_nGramAsIntFromPosition (nGramAsInt, i, sizeOf_N, sizeOf_alphabet);
-    // the lastGram position equals the last char of nGram
-    position_lastGram = nGramAsInt[sizeOf_N - 1];
-    // get the position of the prior chars (all but the lastGram, the so called mGram)
-    get_positionFromNGramAsInt (&position_mGram, nGramAsInt, sizeOf_N - 1, sizeOf_alphabet);
-
-    // get current index for the mGram and add the lastGram
-    index = (sortedLastGram[level]).indexCur[position_mGram];
-    (sortedLastGram[level]).lastGrams[position_mGram][index] = position_lastGram;
-    // increase current index and check, if a reallocation must be done
-    (sortedLastGram[level]).indexCur[position_mGram]++;
-    if ((sortedLastGram[level]).indexCur[position_mGram] == (sortedLastGram[level]).indexMax[position_mGram])
-    {
-      // k++;
-      // double maximal index and reallocate
-      (sortedLastGram[level]).indexMax[position_mGram] *= 2;
-      (sortedLastGram[level]).lastGrams[position_mGram] = (int *) realloc ((sortedLastGram[level]).lastGrams[position_mGram], (sortedLastGram[level]).indexMax[position_mGram] * sizeof (int));
-      // check allocation
-      EXIT_IF_NULL ((sortedLastGram[level]).lastGrams[position_mGram]);
-    }
+    level = (source[i] > maxLevel - 1) ? maxLevel - 1 : source[i];
+    // the nGram at position i consists of the mGram i / sizeOf_alphabet and the lastGram i % sizeOf_alphabet
+    (sortedLastGram[level]).indexStart[i / sizeOf_alphabet + 1]++;
+  }
+
+  // sum up the counts to the start indices and allocate the lastGrams
+  for (level = 0; level < maxLevel; level++)
+  {
+    for (position_mGram = 0; position_mGram < (sortedLastGram[level]).sizeOf_mGram; position_mGram++)
+      (sortedLastGram[level]).indexStart[position_mGram + 1] += (sortedLastGram[level]).indexStart[position_mGram];
+    (sortedLastGram[level]).lastGrams = (int *) malloc (((sortedLastGram[level]).indexStart[(sortedLastGram[level]).sizeOf_mGram] + 1) * sizeof (int));
+    EXIT_IF_NULL ((sortedLastGram[level]).lastGrams);
+    index[level] = 0;
+  }
+
+  // the nGrams are ascending by mGram, so appending them keeps the lastGrams of each mGram together
+  for (int i = 0; i < source_size; i++)
+  {
+    level = (source[i] > maxLevel - 1) ? maxLevel - 1 : source[i];
+    (sortedLastGram[level]).lastGrams[index[level]] = i % sizeOf_alphabet;
+    index[level]++;
   }
 }                               // struct_fill_sortedLastGram
 
@@ -428,17 +443,10 @@ void struct_sortedLength_fill (sortedLength_struct * sortedLength, int *source,
 // returns max index for given level
 int struct_sortedLength_getMaxIndexForLevel (sortedLength_struct * sortedLength, int level)
 {
-  static int index = 0;
+  int index = 0;
 
-  // this works since it begins at the static field @index
-  // and therefore always checks the next possible lengths
-  for (int i = index; i < MAX_PASSWORD_LENGTH - sortedLength->lengthMin; i++)
-  {
-    // if the level of the length at i is smaller or equal level...
-    if (sortedLength->level[i] <= level)
-      index++;                  // ...increase index
-    else
-      return index;             // ... return level
-  }
+  // the lengths are sorted by level, so count all lengths with a level smaller or equal @level
+  while (index < MAX_PASSWORD_LENGTH - sortedLength->lengthMin && sortedLength->level[index] <= level)
+    index++;
   return index;
 }                               // struct_getMaxIndexForLevel
@@ -69,20 +69,20 @@ typedef struct alphabet_struct
 } alphabet_struct;
 
 /*
- * Contains a 2 dimensional array @lastGram where any last gram is sorted by
- * the leading gram (the so called mGram). Once set, the 1st dimension equals
- * the first (n-1) of a cP and the 2nd dimension increases dynamically
- * (using @indexCur and @indexMax), pointing to the n's char of this nGram.
+ * Contains the lastGrams of all mGrams (with m = (n-1)) in a single array
+ * @lastGrams, mGram by mGram: the lastGrams of the mGram at position x are
+ * stored from index @indexStart[x] up to (excluding) @indexStart[x + 1].
+ * The flat layout needs no pointer per mGram, so it can be stored in a shared
+ * memory segment as it is (see sharedModel).
  * The struct is used to store the lastGrams sorted by level (using an array of
  * this struct with the dimension [MAX_LEVEL]).
  */
 typedef struct sortedLastGram_struct
 {
-  int **lastGrams;              // lastGram by mGram (with m = (n-1))
+  int *lastGrams;               // lastGrams of all mGrams (ascending by mGram)
+  int *indexStart;              // index of the first lastGram of each mGram in @lastGrams (sizeOf_mGram + 1 entries)
 
-  int sizeOf_mGram;             // 1st dimension of @lastGrams (equals amount of possible mGrams)
-  int *indexCur;                // 2nd dimensions of @lastGrams (current value, increases dynamically)
-  int *indexMax;                // max value for 2nd dimensions of @lastGrams ( (if indexCur == indexMax) -> reallocate lastGrams[i])
+  int sizeOf_mGram;             // amount of possible mGrams
 } sortedLastGram_struct;
 
 /*
@@ -126,8 +126,7 @@ void struct_filenames_initialize (struct filename_struct **filenames);
 void struct_alphabet_initialize (struct alphabet_struct **alphabet);
 
 void struct_sortedLastGram_initialize (int maxLevel, struct sortedLastGram_struct **sortedLastGram, int sizeOf_N, // size of the nGram n
-                                       int sizeOf_alphabet, // size of the used alphabet
-                                       int indexMax_default); // buffer for the dynamic array
+                                       int sizeOf_alphabet);  // size of the used alphabet
 
 void struct_sortedIP_initialize (int maxLevel, struct sortedIP_struct **sortedIP, int indexMax_default);  // buffer for the dynamic array
 
@@ -160,6 +159,22 @@ void struct_nGrams_allocate (struct nGram_struct *nGrams, struct alphabet_struct
 void struct_nGrams_copyArrays (struct nGram_struct *dest, // destination (must be initialized)
                                struct nGram_struct *src); // source
 
+/*
+ * Fills the lookup table @charPosition with the position of each char in
+ * the @alphabet (-1 for chars not part of the alphabet).
+ */
+void struct_alphabet_fillPositions (const struct alphabet_struct *alphabet, int charPosition[256]);
+
+/*
+ * Calculates the @level of the @password with the given @length based on the
+ * level arrays @nGrams, using the lookup table @charPosition (see
+ * struct_alphabet_fillPositions). The endProb is skipped if @ignoreEP is set,
+ * the level of the length is only added if @addLength is set.
+ * Returns FALSE if the length can't be created by enumNG or the password
+ * contains a char not part of the alphabet.
+ */
+bool struct_nGrams_level (const struct nGram_struct *nGrams, const int charPosition[256], int sizeOf_alphabet, const char *password, int length, bool ignoreEP, bool addLength, int *level);
+
 /*
  * These functions free any memory allocated by the structs (including the struct)
  */
@@ -214,9 +229,8 @@ void struct_sortedLength_fill (struct sortedLength_struct *sortedLength,  // des
  * This functions returns the index of the first item stored in @sortedLength
  * with a level larger then @level. The lengths stored in @sortedLength must be sorted
  * by level before calling this function (using struct_fill_sortedLength).
- * The returned index isn't reseted, there for this functions returns the same index
- * again (or 0, since @index is initialized with 0) if the level stored in
- * @sortedLength->level[index] is larger then @level.
+ * The function keeps no state, so it can be used for any amount of
+ * enumerations (and levels in any order).
  */
 int struct_sortedLength_getMaxIndexForLevel (struct sortedLength_struct *sortedLength,  // target array
                                              int level);  // level
@@ -0,0 +1,428 @@
+/*
+ * constraint.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "constraint.h"
+#include "errorHandler.h"
+
+// charsets of the mask
+#define CONSTRAINT_CHARSET_LOWER "abcdefghijklmnopqrstuvwxyz"
+#define CONSTRAINT_CHARSET_UPPER "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+#define CONSTRAINT_CHARSET_DIGIT "0123456789"
+#define CONSTRAINT_CHARSET_SPECIAL " !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~"
+
+/* (intern function) Returns the allowed symbols at @position of a password of @length (writable). */
+bool *constraint_allowed (constraint_struct * constraint, int length, int position)
+{
+  return constraint->allowed + ((size_t) length * MAX_PASSWORD_LENGTH + position) * constraint->sizeOf_alphabet;
+}                               // (intern) constraint_allowed
+
+/* (intern function) Allows each char of @charset (which are part of the @alphabet) in @allowed. */
+void constraint_allowCharset (bool *allowed, const char *charset, const alphabet_struct * alphabet)
+{
+  int symbol = 0;
+
+  for (size_t i = 0; i < strlen (charset); i++)
+  {
+    if (get_positionInAlphabet (&symbol, charset[i], alphabet->alphabet, alphabet->sizeOf_alphabet))
+      allowed[symbol] = true;
+  }
+}                               // (intern) constraint_allowCharset
+
+/* (intern function) Parses the @mask, setting the allowed symbols of each of its positions in @maskAllowed (MAX_PASSWORD_LENGTH * alphabet size entries) and its length. Returns FALSE if the mask is invalid. */
+bool constraint_parseMask (constraint_struct * constraint, bool *maskAllowed, const char *mask, const alphabet_struct * alphabet)
+{
+  int position = 0;
+  int symbol = 0;
+
+  for (size_t i = 0; i < strlen (mask); i++, position++)
+  {
+    bool *allowed = maskAllowed + (size_t) position * constraint->sizeOf_alphabet;
+    bool empty = true;
+
+    if (position >= MAX_PASSWORD_LENGTH - 1)
+    {
+      errorHandler_print (errorType_Error, "The mask is longer than %i chars.\n", MAX_PASSWORD_LENGTH - 1);
+      return false;
+    }
+
+    if (mask[i] == '?')
+    {
+      i++;
+      switch (mask[i])
+      {
+      case 'l':
+        constraint_allowCharset (allowed, CONSTRAINT_CHARSET_LOWER, alphabet);
+        break;
+      case 'u':
+        constraint_allowCharset (allowed, CONSTRAINT_CHARSET_UPPER, alphabet);
+        break;
+      case 'd':
+        constraint_allowCharset (allowed, CONSTRAINT_CHARSET_DIGIT, alphabet);
+        break;
+      case 's':
+        constraint_allowCharset (allowed, CONSTRAINT_CHARSET_SPECIAL, alphabet);
+        break;
+      case 'a':
+        constraint_allowCharset (allowed, CONSTRAINT_CHARSET_LOWER CONSTRAINT_CHARSET_UPPER CONSTRAINT_CHARSET_DIGIT CONSTRAINT_CHARSET_SPECIAL, alphabet);
+        break;
+      case 'b':
+        memset (allowed, true, constraint->sizeOf_alphabet * sizeof (bool));
+        break;
+      case '?':
+        constraint_allowCharset (allowed, "?", alphabet);
+        break;
+      default:
+        errorHandler_print (errorType_Error, "Unknown charset '?%c' in the mask (supported: ?l ?u ?d ?s ?a ?b ?\?).\n", mask[i]);
+        return false;
+      }
+    }
+    else if (get_positionInAlphabet (&symbol, mask[i], alphabet->alphabet, alphabet->sizeOf_alphabet))
+      allowed[symbol] = true;
+
+    for (int j = 0; j < constraint->sizeOf_alphabet && empty; j++)
+      empty = !allowed[j];
+    if (empty)
+    {
+      errorHandler_print (errorType_Error, "No char of the alphabet matches position %i of the mask.\n", position + 1);
+      return false;
+    }
+  }
+  constraint->maskLength = position;
+  return true;
+}                               // (intern) constraint_parseMask
+
+/* (intern function) Converts the given @fragment to symbols of the @alphabet. Returns FALSE if any char isn't part of the alphabet. */
+bool constraint_parseFragment (int *symbols, const char *fragment, const char *name, const alphabet_struct * alphabet)
+{
+  if (strlen (fragment) >= MAX_PASSWORD_LENGTH)
+  {
+    errorHandler_print (errorType_Error, "The %s is longer than %i chars.\n", name, MAX_PASSWORD_LENGTH - 1);
+    return false;
+  }
+  for (size_t i = 0; i < strlen (fragment); i++)
+  {
+    if (!get_positionInAlphabet (symbols + i, fragment[i], alphabet->alphabet, alphabet->sizeOf_alphabet))
+    {
+      errorHandler_print (errorType_Error, "The char '%c' of the %s is not part of the alphabet.\n", fragment[i], name);
+      return false;
+    }
+  }
+  return true;
+}                               // (intern) constraint_parseFragment
+
+/* (intern function) Restricts the position @position of all lengths to the given @symbol (@fromEnd: the position is counted from the end of the password). */
+void constraint_fixSymbol (constraint_struct * constraint, int position, int symbol, bool fromEnd)
+{
+  for (int length = 1; length < MAX_PASSWORD_LENGTH; length++)
+  {
+    // the fragment doesn't fit into passwords of this length: allow nothing
+    int positionCur = fromEnd ? length - 1 - position : position;
+    int from = (positionCur >= 0 && positionCur < length) ? positionCur : 0;
+    int to = (positionCur >= 0 && positionCur < length) ? positionCur + 1 : length;
+
+    for (int i = from; i < to; i++)
+    {
+      bool *allowed = constraint_allowed (constraint, length, i);
+      bool keep = (positionCur == i) && allowed[symbol];
+
+      memset (allowed, false, constraint->sizeOf_alphabet * sizeof (bool));
+      allowed[symbol] = keep;
+    }
+  }
+}                               // (intern) constraint_fixSymbol
+
+/* (intern function) Builds the automaton matching the @infix of @sizeOf_infix symbols. */
+void constraint_buildInfix (constraint_struct * constraint, const int *infix, int sizeOf_infix)
+{
+  int sizeOf_alphabet = constraint->sizeOf_alphabet;
+  int fallback = 0;             // state reached by the matched chars without their first one
+
+  constraint->sizeOf_infix = sizeOf_infix;
+  constraint->infixNext = (int *) calloc ((size_t) (sizeOf_infix + 1) * sizeOf_alphabet, sizeof (int));
+  EXIT_IF_NULL (constraint->infixNext);
+
+  constraint->infixNext[infix[0]] = 1;
+  for (int state = 1; state < sizeOf_infix; state++)
+  {
+    memcpy (constraint->infixNext + state * sizeOf_alphabet, constraint->infixNext + fallback * sizeOf_alphabet, sizeOf_alphabet * sizeof (int));
+    constraint->infixNext[state * sizeOf_alphabet + infix[state]] = state + 1;
+    fallback = constraint->infixNext[fallback * sizeOf_alphabet + infix[state]];
+  }
+  // once the infix has been matched, it stays matched
+  for (int i = 0; i < sizeOf_alphabet; i++)
+    constraint->infixNext[sizeOf_infix * sizeOf_alphabet + i] = sizeOf_infix;
+}                               // (intern) constraint_buildInfix
+
+/* (intern function) Returns the state after appending @symbol to a prefix in @state, ignoring whether all constraints can still be matched. */
+int constraint_nextState (const constraint_struct * constraint, int state, int symbol)
+{
+  int sizeOf_matched = constraint->sizeOf_infix + 1;
+  int matched = state % sizeOf_matched;
+  int counts = state / sizeOf_matched;
+  int radix = 1;
+  int class = constraint->classOf[symbol];
+
+  if (constraint->sizeOf_infix > 0)
+    matched = constraint->infixNext[matched * constraint->sizeOf_alphabet + symbol];
+  // the chars of each class are only counted up to its minimum
+  for (int i = 0; i < class; i++)
+    radix *= constraint->classMin[i] + 1;
+  if ((counts / radix) % (constraint->classMin[class] + 1) < constraint->classMin[class])
+    counts += radix;
+  return matched + sizeOf_matched * counts;
+}                               // (intern) constraint_nextState
+
+/* (intern function) Builds the transitions of the states and checks backwards for each length, amount of chars and state whether all constraints can still be matched, counting the matching passwords of each length. */
+void constraint_buildStates (constraint_struct * constraint)
+{
+  int sizeOf_states = constraint->sizeOf_states;
+  uint64_t *count = (uint64_t *) malloc (sizeOf_states * sizeof (uint64_t));  // completions of a prefix by state
+  uint64_t *countPrev = (uint64_t *) malloc (sizeOf_states * sizeof (uint64_t));
+
+  EXIT_IF_NULL (count);
+  EXIT_IF_NULL (countPrev);
+  constraint->next = (int *) malloc ((size_t) sizeOf_states * constraint->sizeOf_alphabet * sizeof (int));
+  EXIT_IF_NULL (constraint->next);
+  constraint->viable = (bool *) calloc ((size_t) MAX_PASSWORD_LENGTH * (MAX_PASSWORD_LENGTH + 1) * sizeOf_states, sizeof (bool));
+  EXIT_IF_NULL (constraint->viable);
+
+  for (int state = 0; state < sizeOf_states; state++)
+    for (int symbol = 0; symbol < constraint->sizeOf_alphabet; symbol++)
+      constraint->next[state * constraint->sizeOf_alphabet + symbol] = constraint_nextState (constraint, state, symbol);
+
+  for (int length = 1; length < MAX_PASSWORD_LENGTH; length++)
+  {
+    // only the last state has matched the infix and the minimum of each class
+    memset (count, 0, sizeOf_states * sizeof (uint64_t));
+    count[sizeOf_states - 1] = 1;
+    constraint->viable[((size_t) length * (MAX_PASSWORD_LENGTH + 1) + length) * sizeOf_states + sizeOf_states - 1] = true;
+
+    for (int position = length - 1; position >= 0; position--)
+    {
+      const bool *allowed = constraint_getAllowed (constraint, length, position);
+      bool *viable = constraint->viable + ((size_t) length * (MAX_PASSWORD_LENGTH + 1) + position) * sizeOf_states;
+
+      memcpy (countPrev, count, sizeOf_states * sizeof (uint64_t));
+      memset (count, 0, sizeOf_states * sizeof (uint64_t));
+      for (int state = 0; state < sizeOf_states; state++)
+      {
+        for (int symbol = 0; symbol < constraint->sizeOf_alphabet; symbol++)
+        {
+          uint64_t completions = countPrev[constraint->next[state * constraint->sizeOf_alphabet + symbol]];
+
+          if (allowed[symbol])
+            count[state] = (count[state] > UINT64_MAX - completions) ? UINT64_MAX : count[state] + completions;
+        }
+        viable[state] = (count[state] > 0);
+      }
+    }
+    constraint->candidateCount[length] = count[0];
+  }
+  free (count);
+  free (countPrev);
+}                               // (intern) constraint_buildStates
+
+// allocates the struct and parses the constraints
+bool constraint_initialize (constraint_struct ** constraint, const alphabet_struct * alphabet, const char *mask, const char *prefix, const char *suffix, const char *infix, const int classMin[CONSTRAINT_SIZEOF_CLASSES], int lengthMin, int lengthMax)
+{
+  int symbols[MAX_PASSWORD_LENGTH];
+  int sizeOf_classMin = 0;
+  size_t sizeOf_allowed = (size_t) MAX_PASSWORD_LENGTH * MAX_PASSWORD_LENGTH * alphabet->sizeOf_alphabet;
+
+  *constraint = (constraint_struct *) malloc (sizeof (constraint_struct));
+  EXIT_IF_NULL (*constraint);
+  memset (*constraint, 0, sizeof (constraint_struct));
+  (*constraint)->sizeOf_alphabet = alphabet->sizeOf_alphabet;
+
+  // allow any symbol at any position
+  (*constraint)->allowed = (bool *) malloc (sizeOf_allowed * sizeof (bool));
+  EXIT_IF_NULL ((*constraint)->allowed);
+  memset ((*constraint)->allowed, true, sizeOf_allowed * sizeof (bool));
+
+  // the mask fixes the length, any other length allows nothing
+  if (mask != NULL)
+  {
+    bool *maskAllowed = (bool *) calloc ((size_t) MAX_PASSWORD_LENGTH * alphabet->sizeOf_alphabet, sizeof (bool));
+
+    EXIT_IF_NULL (maskAllowed);
+    if (!constraint_parseMask (*constraint, maskAllowed, mask, alphabet))
+    {
+      free (maskAllowed);
+      constraint_free (constraint);
+      return false;
+    }
+    memset ((*constraint)->allowed, false, sizeOf_allowed * sizeof (bool));
+    memcpy (constraint_allowed (*constraint, (*constraint)->maskLength, 0), maskAllowed, (size_t) (*constraint)->maskLength * alphabet->sizeOf_alphabet * sizeof (bool));
+    free (maskAllowed);
+  }
+
+  // prefix and suffix fix the symbols at the start and the end
+  if (prefix != NULL)
+  {
+    if (!constraint_parseFragment (symbols, prefix, "prefix", alphabet))
+    {
+      constraint_free (constraint);
+      return false;
+    }
+    for (size_t i = 0; i < strlen (prefix); i++)
+      constraint_fixSymbol (*constraint, i, symbols[i], false);
+  }
+  if (suffix != NULL)
+  {
+    if (!constraint_parseFragment (symbols, suffix, "suffix", alphabet))
+    {
+      constraint_free (constraint);
+      return false;
+    }
+    for (size_t i = 0; i < strlen (suffix); i++)
+      constraint_fixSymbol (*constraint, strlen (suffix) - 1 - i, symbols[i], true);
+  }
+
+  // the infix may be at any position
+  if (infix != NULL && infix[0] != '\0')
+  {
+    if (!constraint_parseFragment (symbols, infix, "infix", alphabet))
+    {
+      constraint_free (constraint);
+      return false;
+    }
+    constraint_buildInfix (*constraint, symbols, strlen (infix));
+  }
+
+  // the length bounds of the policy allow nothing for any other length
+  for (int length = 1; length < MAX_PASSWORD_LENGTH; length++)
+  {
+    if (length < lengthMin || (lengthMax != 0 && length > lengthMax))
+      memset (constraint_allowed (*constraint, length, 0), false, (size_t) MAX_PASSWORD_LENGTH * alphabet->sizeOf_alphabet * sizeof (bool));
+  }
+
+  // the class of each symbol and the minimal amount of each class
+  (*constraint)->classOf = (int *) malloc (alphabet->sizeOf_alphabet * sizeof (int));
+  EXIT_IF_NULL ((*constraint)->classOf);
+  for (int i = 0; i < alphabet->sizeOf_alphabet; i++)
+  {
+    unsigned char c = (unsigned char) alphabet->alphabet[i];
+
+    (*constraint)->classOf[i] = islower (c) ? 0 : isupper (c) ? 1 : isdigit (c) ? 2 : 3;
+  }
+  (*constraint)->sizeOf_states = (*constraint)->sizeOf_infix + 1;
+  for (int i = 0; i < CONSTRAINT_SIZEOF_CLASSES; i++)
+  {
+    (*constraint)->classMin[i] = (classMin != NULL) ? classMin[i] : 0;
+    (*constraint)->sizeOf_states *= (*constraint)->classMin[i] + 1;
+    sizeOf_classMin += (*constraint)->classMin[i];
+  }
+  if (sizeOf_classMin >= MAX_PASSWORD_LENGTH)
+  {
+    errorHandler_print (errorType_Error, "The policy requires more than %i chars.\n", MAX_PASSWORD_LENGTH - 1);
+    constraint_free (constraint);
+    return false;
+  }
+
+  constraint_buildStates (*constraint);
+  return true;
+}                               // constraint_initialize
+
+// frees the struct
+void constraint_free (constraint_struct ** constraint)
+{
+  if (*constraint != NULL)
+  {
+    CHECKED_FREE ((*constraint)->allowed);
+    CHECKED_FREE ((*constraint)->infixNext);
+    CHECKED_FREE ((*constraint)->classOf);
+    CHECKED_FREE ((*constraint)->next);
+    CHECKED_FREE ((*constraint)->viable);
+    for (size_t i = 0; i < MAX_PASSWORD_LENGTH; i++)
+    {
+      CHECKED_FREE ((*constraint)->iP[i]);
+      CHECKED_FREE ((*constraint)->iPStart[i]);
+    }
+    free (*constraint);
+    *constraint = NULL;
+  }
+}                               // constraint_free
+
+// returns the allowed symbols of the position
+const bool *constraint_getAllowed (const constraint_struct * constraint, int length, int position)
+{
+  return constraint->allowed + ((size_t) length * MAX_PASSWORD_LENGTH + position) * constraint->sizeOf_alphabet;
+}                               // constraint_getAllowed
+
+// appends a symbol to the prefix
+int constraint_next (const constraint_struct * constraint, int state, int symbol, int length, int position)
+{
+  int stateNext = constraint->next[state * constraint->sizeOf_alphabet + symbol];
+
+  if (!constraint->viable[((size_t) length * (MAX_PASSWORD_LENGTH + 1) + position + 1) * constraint->sizeOf_states + stateNext])
+    return -1;
+  return stateNext;
+}                               // constraint_next
+
+// checks the first chars of a password
+bool constraint_checkPrefix (const constraint_struct * constraint, const int *passwordAsInt, int lengthCur, int lengthMax, int state[MAX_PASSWORD_LENGTH + 1])
+{
+  state[0] = 0;
+  for (int i = 0; i < lengthCur; i++)
+  {
+    if (!constraint_getAllowed (constraint, lengthMax, i)[passwordAsInt[i]])
+      return false;
+    state[i + 1] = constraint_next (constraint, state[i], passwordAsInt[i], lengthMax, i);
+    if (state[i + 1] < 0)
+      return false;
+  }
+  return true;
+}                               // constraint_checkPrefix
+
+// returns the allowed initialProbs of the level
+const int *constraint_getIP (constraint_struct * constraint, const sortedIP_struct * sortedIP, int maxLevel, int sizeOf_N, int length, int level, int *sizeOf_iP)
+{
+  int passwordAsInt[MAX_PASSWORD_LENGTH];
+  int state[MAX_PASSWORD_LENGTH + 1];
+
+  // filter the initialProbs of all levels
+  if (constraint->iPStart[length] == NULL)
+  {
+    int sizeOf_sorted = 0;
+
+    for (int i = 0; i < maxLevel; i++)
+      sizeOf_sorted += sortedIP[i].indexCur;
+    constraint->iP[length] = (int *) malloc ((sizeOf_sorted + 1) * sizeof (int));
+    EXIT_IF_NULL (constraint->iP[length]);
+    constraint->iPStart[length] = (int *) malloc ((maxLevel + 1) * sizeof (int));
+    EXIT_IF_NULL (constraint->iPStart[length]);
+
+    constraint->iPStart[length][0] = 0;
+    for (int i = 0; i < maxLevel; i++)
+    {
+      constraint->iPStart[length][i + 1] = constraint->iPStart[length][i];
+      for (int j = 0; j < sortedIP[i].indexCur; j++)
+      {
+        get_nGramAsIntFromPosition (passwordAsInt, sortedIP[i].iP[j], sizeOf_N - 1, constraint->sizeOf_alphabet);
+        if (constraint_checkPrefix (constraint, passwordAsInt, sizeOf_N - 1, length, state))
+          constraint->iP[length][constraint->iPStart[length][i + 1]++] = sortedIP[i].iP[j];
+      }
+    }
+  }
+
+  *sizeOf_iP = constraint->iPStart[length][level + 1] - constraint->iPStart[length][level];
+  return constraint->iP[length] + constraint->iPStart[length][level];
+}                               // constraint_getIP
+
+// sums the counts of the lengths
+uint64_t constraint_getCount (const constraint_struct * constraint, int lengthMin, int lengthMax)
+{
+  uint64_t count = 0;
+
+  for (int length = lengthMin; length <= lengthMax; length++)
+    count = (count > UINT64_MAX - constraint->candidateCount[length]) ? UINT64_MAX : count + constraint->candidateCount[length];
+  return count;
+}                               // constraint_getCount
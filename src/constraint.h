@@ -0,0 +1,117 @@
+/*
+ * constraint.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Constraints of a targeted attack, used by enumNG to only create passwords
+ * of a known structure: a hashcat-style mask (one charset or literal char
+ * per position, fixing the length), a known prefix, suffix and infix, and a
+ * password policy (minimal amount of chars of each class, length bounds).
+ * The constraints are checked while the password is created: the symbols
+ * allowed at each position are stored per password length, so any
+ * initialProb or lastGram not allowed at its position is skipped together
+ * with its whole subtree. The initialProbs of each level are filtered once
+ * per length, since they are checked for every levelChain.
+ * The infix is matched by a finite automaton (like Knuth-Morris-Pratt) and
+ * the chars of each class are counted up to the minimum of the policy. Both
+ * form the state of a prefix, which is checked against a table computed
+ * backwards for each length: any prefix whose state can't reach the state
+ * matching the infix and the policy within the remaining positions is cut.
+ * Therefore each visited prefix leads to at least one matching password.
+ * The level order is not changed, only the passwords not matching the
+ * constraints are left out.
+ *
+ * Supported charsets of the mask:
+ *   ?l lower case letters, ?u upper case letters, ?d digits,
+ *   ?s special chars (printable ASCII), ?a ?l?u?d?s, ?b any symbol, ?? '?'
+ * Any symbol not part of the alphabet is ignored.
+ *
+ */
+
+#ifndef CONSTRAINT_H_
+#define CONSTRAINT_H_
+
+#include <stdint.h>
+
+#include "common.h"
+#include "commonStructs.h"
+
+// === Defines ===
+#define CONSTRAINT_SIZEOF_CLASSES 4 // classes of the policy: lower case letters, upper case letters, digits and any other char
+
+/*
+ * Contains the allowed symbols of each position, the automaton matching the
+ * infix and the amount of passwords matching all constraints.
+ */
+typedef struct constraint_struct
+{
+  bool *allowed;                // allowed symbols by password length and position (see constraint_getAllowed)
+  int *infixNext;               // matched length of the infix after appending a symbol, by matched length and symbol
+  int sizeOf_infix;             // length of the infix (0 if none)
+  int classMin[CONSTRAINT_SIZEOF_CLASSES];  // minimal amount of chars of each class
+  int *classOf;                 // class of each symbol
+  int sizeOf_states;            // amount of states (matched length of the infix and counted chars of each class)
+  int *next;                    // state after appending a symbol, by state and symbol
+  bool *viable;                 // TRUE if the constraints can still be matched, by password length, prefix length and state
+  int maskLength;               // length of the mask (0 if none)
+  int sizeOf_alphabet;          // size of the alphabet
+  uint64_t candidateCount[MAX_PASSWORD_LENGTH]; // amount of passwords of each length matching all constraints
+
+  int *iP[MAX_PASSWORD_LENGTH]; // allowed initialProbs by password length, sorted by level (filtered on first use)
+  int *iPStart[MAX_PASSWORD_LENGTH];  // index of the first allowed initialProb of each level (maxLevel + 1 entries)
+} constraint_struct;
+
+/*
+ * Allocates the given struct based on the @mask, @prefix, @suffix and
+ * @infix (each NULL if not given), the minimal amount of chars of each
+ * class @classMin (NULL if none) and the length bounds @lengthMin and
+ * @lengthMax (0 if none) and counts the passwords of each length matching
+ * them.
+ * Returns FALSE (printing an error) if the mask is invalid, a fragment
+ * contains a char not part of the @alphabet or the policy requires too
+ * many chars.
+ * If the allocation fails, the application is aborted.
+ */
+bool constraint_initialize (constraint_struct ** constraint, const alphabet_struct * alphabet, const char *mask, const char *prefix, const char *suffix, const char *infix, const int classMin[CONSTRAINT_SIZEOF_CLASSES], int lengthMin, int lengthMax);
+
+/*
+ * Frees the given struct (if not NULL).
+ */
+void constraint_free (constraint_struct ** constraint);
+
+/*
+ * Returns the symbols allowed at @position of a password of @length
+ * (TRUE at the index of each allowed symbol).
+ */
+const bool *constraint_getAllowed (const constraint_struct * constraint, int length, int position);
+
+/*
+ * Returns the state after appending @symbol (allowed at @position) to a
+ * prefix in @state of a password of @length, or -1 if no password matching
+ * the constraints starts with the new prefix. The empty prefix has state 0.
+ */
+int constraint_next (const constraint_struct * constraint, int state, int symbol, int length, int position);
+
+/*
+ * Checks the first @lengthCur symbols of @passwordAsInt (a password of
+ * @lengthMax), storing the state of each prefix in @state (@state[i] for
+ * the first i symbols).
+ * Returns FALSE if no password matching the constraints starts with them.
+ */
+bool constraint_checkPrefix (const constraint_struct * constraint, const int *passwordAsInt, int lengthCur, int lengthMax, int state[MAX_PASSWORD_LENGTH + 1]);
+
+/*
+ * Returns the initialProbs of @level allowed at the start of a password of
+ * @length, storing their amount in @sizeOf_iP. The initialProbs of
+ * @sortedIP are filtered on first use of each length, so @sortedIP must not
+ * change afterwards.
+ */
+const int *constraint_getIP (constraint_struct * constraint, const sortedIP_struct * sortedIP, int maxLevel, int sizeOf_N, int length, int level, int *sizeOf_iP);
+
+/*
+ * Returns the amount of passwords with a length between @lengthMin and
+ * @lengthMax matching all constraints (UINT64_MAX on overflow).
+ */
+uint64_t constraint_getCount (const constraint_struct * constraint, int lengthMin, int lengthMax);
+
+#endif /* CONSTRAINT_H_ */
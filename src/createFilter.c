@@ -0,0 +1,238 @@
+/*
+ * createFilter.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "cmdlineCreateFilter.h"
+#include "common.h"
+#include "errorHandler.h"
+#include "bloomFilter.h"
+#include "createFilter.h"
+
+#define CREATEFILTER_SIZEOF_LINE 1024 // lines of the password lists are read in chunks of this size
+
+char *glbl_filenameOutput = NULL; // filter file [-o <filename>]
+bool glbl_verboseMode = false;  // print the results to stderr [-v]
+bloomFilter_struct *glbl_filter = NULL;
+
+uint64_t glbl_readCount = 0;    // amount of passwords read from the lists
+uint64_t glbl_ignoredCount = 0; // amount of passwords not inserted (too long for enumNG)
+
+struct gengetopt_args_info glbl_args_info;
+
+int main (int argc, char **argv)
+{
+  // let's call our cmdline parser
+  if (cmdline_parser (argc, argv, &glbl_args_info) != 0)
+  {
+    printf ("failed parsing command line arguments\n");
+    exit (EXIT_FAILURE);
+  }
+  // set exit_routine so thats automatically called
+  atexit (exit_routine);
+
+  initialize ();
+
+  if (!evaluate_arguments (&glbl_args_info))
+    exit (EXIT_FAILURE);
+
+  if (!apply_settings ())
+    exit (EXIT_FAILURE);
+
+  if (!run_creation ())
+    exit (EXIT_FAILURE);
+
+  exit (EXIT_SUCCESS);
+}
+
+void initialize ()
+{
+  glbl_readCount = 0;
+  glbl_ignoredCount = 0;
+}
+
+// exit routine, frees any allocated memory (for global variables)
+void exit_routine ()
+{
+  if (glbl_verboseMode && glbl_filter != NULL)
+    print_results (stderr);
+
+  bloomFilter_free (&glbl_filter);
+  CHECKED_FREE (glbl_filenameOutput);
+
+  errorHandler_finalize ();
+  cmdline_parser_free (&glbl_args_info);  // release allocated memory
+}                               // exit_routine
+
+// evaluates command line parameters
+bool evaluate_arguments (struct gengetopt_args_info *args_info)
+{
+  bool result = true;
+
+  errorHandler_init (args_info->printWarnings_flag);
+
+  glbl_verboseMode = args_info->verbose_flag;
+
+  result &= changeFilename (&glbl_filenameOutput, FILENAME_MAX, "output", args_info->output_arg);
+
+  if (args_info->size_arg < 1)
+  {
+    errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "size", 1);
+    result = false;
+  }
+
+  if (args_info->bits_arg < 1 || args_info->bits_arg > 64)
+  {
+    errorHandler_print (errorType_Error, "The minimum value for the %s should be %i, the maximum %i\n", "bits", 1, 64);
+    result = false;
+  }
+
+  if (args_info->elements_given && args_info->elements_arg < 1)
+  {
+    errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "elements", 1);
+    result = false;
+  }
+
+  // the lists are read twice to count the passwords
+  for (size_t i = 0; i < args_info->input_given && !args_info->elements_given; i++)
+  {
+    if (strcmp (args_info->input_arg[i], "-") == 0)
+    {
+      errorHandler_print (errorType_Error, "The amount of passwords (--elements) must be given to read a list from stdin.\n");
+      result = false;
+      break;
+    }
+  }
+  return result;
+}                               // evaluate_arguments
+
+/* (intern function) Opens the given list (stdin for -), returns FALSE (printing an error) if it can't be opened. */
+bool filter_openList (FILE ** fp, const char *filename)
+{
+  if (strcmp (filename, "-") == 0)
+    *fp = stdin;
+  else if (!open_file (fp, filename, NULL, "r"))
+  {
+    errorHandler_print (errorType_Error, "Can't open input file %s.\n", filename);
+    return false;
+  }
+  return true;
+}                               // (intern) filter_openList
+
+/* (intern function) Closes the given list (unless stdin). */
+void filter_closeList (FILE * fp)
+{
+  if (fp != stdin)
+    fclose (fp);
+}                               // (intern) filter_closeList
+
+/* (intern function) Reads the next line of @fp into @line (without the line break), storing its @length (-1 if the line doesn't fit into @line). Returns FALSE at the end of the file. */
+bool filter_readLine (FILE * fp, char line[CREATEFILTER_SIZEOF_LINE], int *length)
+{
+  size_t lengthCur = 0;
+
+  if (fgets (line, CREATEFILTER_SIZEOF_LINE, fp) == NULL)
+    return false;
+  lengthCur = strlen (line);
+
+  // the line doesn't fit: skip the rest of it
+  if (lengthCur > 0 && line[lengthCur - 1] != '\n' && !feof (fp))
+  {
+    int c = 0;
+
+    while ((c = fgetc (fp)) != EOF && c != '\n');
+    *length = -1;
+    return true;
+  }
+
+  // remove the line break (LF or CRLF)
+  if (lengthCur > 0 && line[lengthCur - 1] == '\n')
+    lengthCur--;
+  if (lengthCur > 0 && line[lengthCur - 1] == '\r')
+    lengthCur--;
+  line[lengthCur] = '\0';
+  *length = (int) lengthCur;
+  return true;
+}                               // (intern) filter_readLine
+
+bool apply_settings ()
+{
+  uint64_t elements = 0;
+  char line[CREATEFILTER_SIZEOF_LINE];
+  int length = 0;
+
+  if (glbl_args_info.elements_given)
+    elements = (uint64_t) glbl_args_info.elements_arg;
+  else
+  {
+    // count the passwords to size the filter
+    for (size_t i = 0; i < glbl_args_info.input_given; i++)
+    {
+      FILE *fp = NULL;
+
+      if (!filter_openList (&fp, glbl_args_info.input_arg[i]))
+        return false;
+      while (filter_readLine (fp, line, &length))
+        elements += (length > 0 && length < MAX_PASSWORD_LENGTH);
+      filter_closeList (fp);
+    }
+  }
+
+  bloomFilter_initialize (&glbl_filter, elements, glbl_args_info.bits_arg, (uint64_t) glbl_args_info.size_arg << 20);
+  return true;
+}                               // apply_settings
+
+// inserts the passwords of all lists and writes the filter
+bool run_creation ()
+{
+  FILE *fpOutput = NULL;
+  char line[CREATEFILTER_SIZEOF_LINE];
+  int length = 0;
+
+  for (size_t i = 0; i < glbl_args_info.input_given; i++)
+  {
+    FILE *fp = NULL;
+
+    if (!filter_openList (&fp, glbl_args_info.input_arg[i]))
+      return false;
+    while (filter_readLine (fp, line, &length))
+    {
+      glbl_readCount++;
+      // enumNG never creates empty passwords or passwords of MAX_PASSWORD_LENGTH (or more) chars
+      if (length < 1 || length >= MAX_PASSWORD_LENGTH)
+        glbl_ignoredCount++;
+      else
+        bloomFilter_insert (glbl_filter, line, length);
+    }
+    filter_closeList (fp);
+  }
+
+  if (!open_file (&fpOutput, glbl_filenameOutput, NULL, "wb"))
+  {
+    errorHandler_print (errorType_Error, "Can't open output file.\n");
+    return false;
+  }
+  if (!bloomFilter_write (glbl_filter, fpOutput))
+  {
+    errorHandler_print (errorType_Error, "Can't write the filter.\n");
+    fclose (fpOutput);
+    return false;
+  }
+  fclose (fpOutput);
+  return true;
+}                               // run_creation
+
+// prints the amount of passwords and the size of the filter
+void print_results (FILE * fp)
+{
+  fprintf (fp, "\nResults:\n");
+  fprintf (fp, "read: %" PRIu64 ", not inserted (empty or longer than %i chars): %" PRIu64 "\n", glbl_readCount, MAX_PASSWORD_LENGTH - 1, glbl_ignoredCount);
+  bloomFilter_printResults (glbl_filter, fp);
+}                               // print_results
@@ -0,0 +1,57 @@
+/*
+ * createFilter.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Creates a filter (see bloomFilter.h) of the passwords already tried by
+ * earlier attacks, e.g. the output of wordlists and rules, and writes it to
+ * a file. enumNG loads the filter (--exclude) and drops any password found
+ * in it, so the time to hash them is not spent again. Passwords longer than
+ * enumNG can create are not inserted.
+ */
+
+#ifndef CREATEFILTER_H_
+#define CREATEFILTER_H_
+
+#include <stdint.h>
+
+/*
+ * initializes all global parameters, setting them to their default value
+ * !! this function must be called before any other operation !!
+ */
+void initialize ();
+
+/*
+ *  clears the allocated memory of the global variables, prints the results
+ *  (if verbose) and ends the application
+ *  !! this function is set via atexit() !!
+ */
+void exit_routine ();
+
+/*
+ * Evaluates the given command line arguments.
+ * Returns TRUE, if the evaluation was successful.
+ */
+bool evaluate_arguments (struct gengetopt_args_info *args_info);
+
+/*
+ * Counts the passwords of the input lists (unless their amount is given)
+ * and initializes the filter.
+ * Returns TRUE on success and FALSE if something went wrong.
+ */
+bool apply_settings ();
+
+/*
+ * Inserts the passwords of all input lists into the filter and writes it to
+ * the output file.
+ * Returns FALSE if any list can't be read or the filter can't be written.
+ */
+bool run_creation ();
+
+/*
+ * Prints the amount of passwords read from the lists and the size of the
+ * filter to the given file pointer @fp.
+ */
+void print_results (FILE * fp);
+
+#endif /* CREATEFILTER_H_ */
@@ -36,13 +36,15 @@ struct filename_struct *glbl_filenames = NULL;  // each should not be larger the
 // Alphabet and size of Alphabet
 struct alphabet_struct *glbl_alphabet = NULL;
 
-char glbl_maxLevel = MAX_LEVEL;
+int glbl_maxLevel = MAX_LEVEL;
+double glbl_levelScale = DEFAULT_LEVEL_SCALE; // levels per unit of -ln(p), increase for fine-grained levels (use together with a larger maxLevel)
 
 // Modes:
 bool glbl_verboseFileMode = false;  // write additional information to output files (the actual nGrams are written to the files as well)
 bool glbl_verboseMode = false;  // print information to stdout during run time
 bool glbl_countedPasswordList = false;  // if TRUE the password list read is interpreted as counted one
 bool glbl_storeWarnings = false;  // if TRUE all occurring warnings are saved to HD
+bool glbl_exactMode = false;    // if TRUE the fixed point log-probabilities are written as well (.prob files)
 
 struct gengetopt_args_info glbl_args_info;
 
@@ -204,6 +206,21 @@ bool evaluate_arguments (struct gengetopt_args_info *args_info)
   if (args_info->maxLevel_given)
   {
     glbl_maxLevel = args_info->maxLevel_arg;
+    if (glbl_maxLevel < 2 || glbl_maxLevel > MAX_MAX_LEVEL)
+    {
+      errorHandler_print (errorType_Error, "The maximum level must be in range 2 to %i.\n", MAX_MAX_LEVEL);
+      return false;
+    }
+  }
+
+  if (args_info->levelScale_given)
+  {
+    glbl_levelScale = args_info->levelScale_arg;
+    if (glbl_levelScale <= 0 || glbl_levelScale > MAX_LEVEL_SCALE)
+    {
+      errorHandler_print (errorType_Error, "The level scale must be larger than 0 and at most %i.\n", MAX_LEVEL_SCALE);
+      return false;
+    }
   }
 
   if (args_info->alphabet_given)
@@ -246,6 +263,11 @@ bool evaluate_arguments (struct gengetopt_args_info *args_info)
     glbl_countedPasswordList = true;
   }
 
+  if (args_info->exact_flag)
+  {
+    glbl_exactMode = true;
+  }
+
   if (!result)
   {
     return result;
@@ -515,22 +537,32 @@ void write_headerToFile (char *title, FILE * fp)
   fprintf (fp, "# -alphabetsize %i \n", (glbl_alphabet->sizeOf_alphabet));
   fprintf (fp, "# -ngram %i \n", (glbl_nGramCount->sizeOf_N));
   fprintf (fp, "# -maxLevel %i \n", (glbl_maxLevel));
+  fprintf (fp, "# -levelScale %g \n", (glbl_levelScale));
   fprintf (fp, "# -verbose %i \n", glbl_verboseFileMode);
   smoo_printSelection (fp, true);
 }                               // (intern) write_header_ToFile
 
-/* (intern function) Writes all counts and level in @nGramArray (array with a size of @sizeOf_nGramArray) into the FILE fp. The levels are calculated from @nGramArray, using the smoothing function defined by @smooFunct. The function is able to write the counts into a file regardlessly of nGram Size! The @writeMode should be set accordingly to the verbose-mode. */
+/* (intern function) Converts the given probability @p into a fixed point log-probability (-ln(p) * PROB_FIXED_POINT_SCALE) */
+int get_fixedPointLogProb (double p)
+{
+  // avoid -infinity for log (like the smoothing does)
+  return (int) lround (-log (p + 0.0000000001) * PROB_FIXED_POINT_SCALE);
+}                               // (intern) get_fixedPointLogProb
+
+/* (intern function) Writes all counts and level in @nGramArray (array with a size of @sizeOf_nGramArray) into the FILE fp. The levels are calculated from @nGramArray, using the smoothing function defined by @smooFunct. The function is able to write the counts into a file regardlessly of nGram Size! The @writeMode should be set accordingly to the verbose-mode. If @fp_prob is not NULL, the fixed point log-probabilities calculated by @probCaller are written to this file. */
 bool write_arrayToFile (const int *nGramArray,  // containing the nGrams
                         int sizeOf_nGramArray,  // size of the given array
                         int sizeOf_N, // must be equal to the nGram-size of the nGrams stored in array
                         unsigned long long int totalSum,  // total sum of all counts in the given array
                         enum writeModes writeMode,  // write Mode - numeric, nGram or nonVerbose
                         SMOOTHING_CALLER (smoothingCaller), // selected smoothing function (pointer to one smothingCaller)
+                        SMOOTHING_PROB_CALLER (probCaller), // selected smoothing probability function
                         FILE * fp_count,  // file pointer (must point to an opened file) for count
-                        FILE * fp_level)  // file pointer (must point to an opened file) for level
+                        FILE * fp_level,  // file pointer (must point to an opened file) for level
+                        FILE * fp_prob) // file pointer for the fixed point log-probabilities (or NULL)
 {
   char nGram[sizeOf_N];         // current nGram determined by get_nGramFromPosition
-  char level;                   // level calculated depending on smooth function
+  int level;                    // level calculated depending on smooth function
 
   nGram[sizeOf_N] = '\0';
 
@@ -543,7 +575,7 @@ bool write_arrayToFile (const int *nGramArray,  // containing the nGrams
       // get the actual nGram based on the current position to print to the file
       get_nGramFromPosition (nGram, i, sizeOf_N, (glbl_alphabet->sizeOf_alphabet), (glbl_alphabet->alphabet));
       // smooth the level using the current smoothing function
-      smoothingCaller (&level, i, nGramArray, sizeOf_nGramArray, sizeOf_N, (glbl_alphabet->sizeOf_alphabet), glbl_maxLevel, totalSum);
+      smoothingCaller (&level, i, nGramArray, sizeOf_nGramArray, sizeOf_N, (glbl_alphabet->sizeOf_alphabet), glbl_maxLevel, glbl_levelScale, totalSum);
       fprintf (fp_level, "%i\t%s\n", level, nGram);
       fprintf (fp_count, "%i\t%s\n", nGramArray[i], nGram);
     }
@@ -551,7 +583,7 @@ bool write_arrayToFile (const int *nGramArray,  // containing the nGrams
   case writeMode_numeric:      // write array index as well
     for (size_t i = 0; i < sizeOf_nGramArray; i++)
     {
-      smoothingCaller (&level, i, nGramArray, sizeOf_nGramArray, sizeOf_N, (glbl_alphabet->sizeOf_alphabet), glbl_maxLevel, totalSum);
+      smoothingCaller (&level, i, nGramArray, sizeOf_nGramArray, sizeOf_N, (glbl_alphabet->sizeOf_alphabet), glbl_maxLevel, glbl_levelScale, totalSum);
       fprintf (fp_level, "%i\t%lu\n", level, i + 1);
       fprintf (fp_count, "%i\t%lu\n", nGramArray[i], i + 1);
     }
@@ -559,12 +591,21 @@ bool write_arrayToFile (const int *nGramArray,  // containing the nGrams
   default:                     // writeMode_nonVerbose or any other, just write level
     for (size_t i = 0; i < sizeOf_nGramArray; i++)
     {
-      smoothingCaller (&level, i, nGramArray, sizeOf_nGramArray, sizeOf_N, (glbl_alphabet->sizeOf_alphabet), glbl_maxLevel, totalSum);
+      smoothingCaller (&level, i, nGramArray, sizeOf_nGramArray, sizeOf_N, (glbl_alphabet->sizeOf_alphabet), glbl_maxLevel, glbl_levelScale, totalSum);
       fprintf (fp_level, "%i\n", level);
     }
     break;
   }
 
+  // write the fixed point log-probabilities (if needed)
+  if (fp_prob != NULL)
+  {
+    for (size_t i = 0; i < sizeOf_nGramArray; i++)
+      fprintf (fp_prob, "%i\n", get_fixedPointLogProb (probCaller (i, nGramArray, sizeOf_nGramArray, sizeOf_N, (glbl_alphabet->sizeOf_alphabet), totalSum)));
+    if (ferror (fp_prob))
+      return false;
+  }
+
   if (fp_count != NULL && ferror (fp_count))
     return false;
   if (fp_level != NULL && ferror (fp_level))
@@ -609,6 +650,7 @@ bool write_array (const char *filename, enum arrayTypes arrayType)
 {
   FILE *fp_count = NULL;
   FILE *fp_level = NULL;
+  FILE *fp_prob = NULL;
   enum writeModes writeMode = writeMode_nonVerbose;
 
   // open files
@@ -625,6 +667,14 @@ bool write_array (const char *filename, enum arrayTypes arrayType)
       return false;
     }
   }
+  if (glbl_exactMode)
+  {
+    if (!(open_file (&fp_prob, filename, DEFAULT_FILE_ATTACHMENT_PROB, "w")))
+    {
+      errorHandler_print (errorType_Error, "file not found %s\n", filename);
+      return false;
+    }
+  }
 
   switch (arrayType)
   {
@@ -636,7 +686,9 @@ bool write_array (const char *filename, enum arrayTypes arrayType)
       write_headerToFile ("CP-LEVELS", fp_level);
       writeMode = writeMode_nGram;
     }
-    write_arrayToFile ((glbl_nGramCount->cP), (glbl_nGramCount->sizeOf_cP), (glbl_nGramCount->sizeOf_N), glbl_countSums[arrayType_conditionalProb], writeMode, smoo_selection.nG, fp_count, fp_level);
+    if (glbl_exactMode)
+      write_headerToFile ("CP-PROBS", fp_prob);
+    write_arrayToFile ((glbl_nGramCount->cP), (glbl_nGramCount->sizeOf_cP), (glbl_nGramCount->sizeOf_N), glbl_countSums[arrayType_conditionalProb], writeMode, smoo_selection.nG, smoo_selection.nG_prob, fp_count, fp_level, fp_prob);
 
     break;
   case arrayType_initialProb:
@@ -647,7 +699,9 @@ bool write_array (const char *filename, enum arrayTypes arrayType)
       write_headerToFile ("IP-LEVELS", fp_level);
       writeMode = writeMode_nGram;
     }
-    write_arrayToFile ((glbl_nGramCount->iP), (glbl_nGramCount->sizeOf_iP), (glbl_nGramCount->sizeOf_N) - 1, glbl_countSums[arrayType_initialProb], writeMode, smoo_selection.iP, fp_count, fp_level);
+    if (glbl_exactMode)
+      write_headerToFile ("IP-PROBS", fp_prob);
+    write_arrayToFile ((glbl_nGramCount->iP), (glbl_nGramCount->sizeOf_iP), (glbl_nGramCount->sizeOf_N) - 1, glbl_countSums[arrayType_initialProb], writeMode, smoo_selection.iP, smoo_selection.iP_prob, fp_count, fp_level, fp_prob);
     break;
   case arrayType_endProb:
     // if verboseMode is active, set writeMode accordingly and write header to files
@@ -657,8 +711,10 @@ bool write_array (const char *filename, enum arrayTypes arrayType)
       write_headerToFile ("EP-LEVELS", fp_level);
       writeMode = writeMode_nGram;
     }
+    if (glbl_exactMode)
+      write_headerToFile ("EP-PROBS", fp_prob);
 
-    write_arrayToFile ((glbl_nGramCount->eP), (glbl_nGramCount->sizeOf_eP), (glbl_nGramCount->sizeOf_N) - 1, glbl_countSums[arrayType_endProb], writeMode, smoo_selection.eP, fp_count, fp_level);
+    write_arrayToFile ((glbl_nGramCount->eP), (glbl_nGramCount->sizeOf_eP), (glbl_nGramCount->sizeOf_N) - 1, glbl_countSums[arrayType_endProb], writeMode, smoo_selection.eP, smoo_selection.eP_prob, fp_count, fp_level, fp_prob);
     break;
   case arrayType_length:
     // if verboseMode is active, set writeMode accordingly and write header to count file
@@ -668,8 +724,10 @@ bool write_array (const char *filename, enum arrayTypes arrayType)
       write_headerToFile ("LN-LEVELS", fp_level);
       writeMode = writeMode_numeric;
     }
+    if (glbl_exactMode)
+      write_headerToFile ("LN-PROBS", fp_prob);
     // write header and levels to file
-    write_arrayToFile ((glbl_nGramCount->len), (glbl_nGramCount->sizeOf_len), 1, glbl_countSums[arrayType_length], writeMode, smoo_selection.len, fp_count, fp_level);
+    write_arrayToFile ((glbl_nGramCount->len), (glbl_nGramCount->sizeOf_len), 1, glbl_countSums[arrayType_length], writeMode, smoo_selection.len, smoo_selection.len_prob, fp_count, fp_level, fp_prob);
     break;
 
   default:
@@ -684,6 +742,11 @@ bool write_array (const char *filename, enum arrayTypes arrayType)
       fclose (fp_level);
       fp_level = NULL;
     }
+    if (fp_prob != NULL)
+    {
+      fclose (fp_prob);
+      fp_prob = NULL;
+    }
     return false;
   }
 
@@ -698,6 +761,11 @@ bool write_array (const char *filename, enum arrayTypes arrayType)
     fclose (fp_level);
     fp_level = NULL;
   }
+  if (fp_prob != NULL)
+  {
+    fclose (fp_prob);
+    fp_prob = NULL;
+  }
   return true;
 }                               // write_array
 
@@ -720,6 +788,12 @@ void print_settings_createNG (FILE * fp)
   if (glbl_storeWarnings)
     fprintf (fp, " - store warnings (createError.log)\n");
 
+  if (glbl_exactMode)
+    fprintf (fp, " - write fixed point log-probabilities (%s)\n", DEFAULT_FILE_ATTACHMENT_PROB);
+
+  if (glbl_levelScale != DEFAULT_LEVEL_SCALE)
+    fprintf (fp, " - level scale: %g levels per unit of -ln(p)\n", glbl_levelScale);
+
   print_settings_default (fp, glbl_nGramCount->sizeOf_N, glbl_alphabet, glbl_filenames, glbl_maxLevel, glbl_verboseFileMode);
   smoo_printSelection (fp, false);
   fprintf (fp, "\n");
@@ -48,6 +48,10 @@ extern int exit_status;
 #define DEFAULT_FILE_ATTACHMENT_LEVEL ".level"
 // define file attachment for count
 #define DEFAULT_FILE_ATTACHMENT_COUNT ".count"
+// define file attachment for fixed point log-probabilities
+#define DEFAULT_FILE_ATTACHMENT_PROB ".prob"
+// fixed point scale of the log-probabilities (stored as -ln(p) * scale)
+#define PROB_FIXED_POINT_SCALE 1000
 // define default config filename
 #define DEFAULT_FILENAME_CONFIG "createConfig"
 // define file attachment for config
@@ -79,6 +83,12 @@ extern int exit_status;
 #define MAX_PASSWORD_LENGTH 20
 // maximum level
 #define MAX_LEVEL 11            // 0, 1, ..., 9, 10
+// upper bound for the maximum level (fine-grained level scales)
+#define MAX_MAX_LEVEL 1001
+// default amount of levels per unit of -ln(p)
+#define DEFAULT_LEVEL_SCALE 1.0
+// upper bound for the level scale
+#define MAX_LEVEL_SCALE 100
 // maximum line length while reading input files
 #define MAX_LINE_LENGTH 512
 
@@ -0,0 +1,147 @@
+/*
+ * ensemble.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h>
+
+#include "ensemble.h"
+#include "errorHandler.h"
+
+// loads the models and starts their enumerations
+bool ensemble_initialize (ensemble_struct ** ensemble, char **configFilenames, const double *weights, int sizeOf_models, const omen_enum_options * options, uint64_t attemptsMax, uint64_t filterBytes)
+{
+  *ensemble = (ensemble_struct *) malloc (sizeof (ensemble_struct));
+  EXIT_IF_NULL (*ensemble);
+  memset (*ensemble, 0, sizeof (ensemble_struct));
+  if (options != NULL)
+    (*ensemble)->options = *options;
+
+  for (int i = 0; i < sizeOf_models; i++)
+  {
+    (*ensemble)->models[i] = omen_model_load (configFilenames[i]);
+    if ((*ensemble)->models[i] == NULL)
+    {
+      ensemble_free (ensemble);
+      return false;
+    }
+    (*ensemble)->sizeOf_models++;
+    (*ensemble)->enums[i] = omen_enum_new ((*ensemble)->models[i], options);
+    if ((*ensemble)->enums[i] == NULL)
+    {
+      ensemble_free (ensemble);
+      return false;
+    }
+    (*ensemble)->levelShift[i] = (weights != NULL) ? log (weights[i]) : 0.0;
+    (*ensemble)->buffers[i] = (omen_candidate *) malloc (ENSEMBLE_BATCH_SIZE * sizeof (omen_candidate));
+    EXIT_IF_NULL ((*ensemble)->buffers[i]);
+  }
+  bloomFilter_initialize (&((*ensemble)->filter), attemptsMax, BLOOMFILTER_BITS_PER_ELEMENT, filterBytes);
+  return true;
+}                               // ensemble_initialize
+
+/* (intern function) Returns TRUE if the given model has a next password, fetching the next batch if its buffer is empty. */
+bool ensemble_hasNext (ensemble_struct * ensemble, int model)
+{
+  if (ensemble->index[model] == ensemble->sizeOf_buffers[model] && ensemble->enums[model] != NULL)
+  {
+    ensemble->sizeOf_buffers[model] = omen_next_batch (ensemble->enums[model], ensemble->buffers[model], ENSEMBLE_BATCH_SIZE);
+    ensemble->index[model] = 0;
+    // free the enumeration once all its passwords have been created
+    if (ensemble->sizeOf_buffers[model] < ENSEMBLE_BATCH_SIZE)
+    {
+      omen_enum_free (ensemble->enums[model]);
+      ensemble->enums[model] = NULL;
+    }
+  }
+  return ensemble->index[model] < ensemble->sizeOf_buffers[model];
+}                               // (intern) ensemble_hasNext
+
+/* (intern function) Returns TRUE if the @candidate of @model with the weighted level @levelCandidate has been taken from another model before (the merge takes the passwords by weighted level, on equal levels from the first model). */
+bool ensemble_isDuplicate (const ensemble_struct * ensemble, int model, const omen_candidate * candidate, double levelCandidate)
+{
+  int levelModel = 0;
+
+  for (int i = 0; i < ensemble->sizeOf_models; i++)
+  {
+    if (i != model && omen_model_level (ensemble->models[i], &(ensemble->options), candidate->password, candidate->length, &levelModel))
+    {
+      double level = levelModel - ensemble->levelShift[i];
+
+      if (level < levelCandidate || (level == levelCandidate && i < model))
+        return true;
+    }
+  }
+  return false;
+}                               // (intern) ensemble_isDuplicate
+
+// returns the next new password in weighted level order
+bool ensemble_next (ensemble_struct * ensemble, omen_candidate * candidate)
+{
+  while (true)
+  {
+    int next = -1;
+    double levelNext = 0.0;
+
+    // k-way merge: take the password with the smallest weighted level (the amount of models is small, so no heap is needed)
+    for (int i = 0; i < ensemble->sizeOf_models; i++)
+    {
+      if (ensemble_hasNext (ensemble, i))
+      {
+        double level = ensemble->buffers[i][ensemble->index[i]].level - ensemble->levelShift[i];
+
+        if (next == -1 || level < levelNext)
+        {
+          next = i;
+          levelNext = level;
+        }
+      }
+    }
+    if (next == -1)
+      return false;
+
+    *candidate = ensemble->buffers[next][ensemble->index[next]];
+    ensemble->index[next]++;
+    // the filter never misses a duplicate, but may report a new password as seen
+    if (bloomFilter_insert (ensemble->filter, candidate->password, candidate->length))
+    {
+      if (ensemble_isDuplicate (ensemble, next, candidate, levelNext))
+        continue;
+      ensemble->falsePositiveCount++;
+    }
+    candidate->level = (int) floor (levelNext);
+    ensemble->createdCount[next]++;
+    return true;
+  }
+}                               // ensemble_next
+
+// prints the passwords taken from each model
+void ensemble_printResults (const ensemble_struct * ensemble, char **configFilenames, FILE * fp)
+{
+  for (int i = 0; i < ensemble->sizeOf_models; i++)
+    fprintf (fp, " - model %i (%s, weight %g): %" PRIu64 " passwords\n", i + 1, configFilenames[i], exp (ensemble->levelShift[i]), ensemble->createdCount[i]);
+  bloomFilter_printResults (ensemble->filter, fp);
+  fprintf (fp, " - false positives of the filter: %" PRIu64 " (new passwords reported as seen, kept)\n", ensemble->falsePositiveCount);
+}                               // ensemble_printResults
+
+// frees the ensemble
+void ensemble_free (ensemble_struct ** ensemble)
+{
+  if (*ensemble != NULL)
+  {
+    for (int i = 0; i < (*ensemble)->sizeOf_models; i++)
+    {
+      omen_enum_free ((*ensemble)->enums[i]);
+      omen_model_free ((*ensemble)->models[i]);
+      CHECKED_FREE ((*ensemble)->buffers[i]);
+    }
+    bloomFilter_free (&((*ensemble)->filter));
+    free (*ensemble);
+    *ensemble = NULL;
+  }
+}                               // ensemble_free
@@ -0,0 +1,87 @@
+/*
+ * ensemble.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Ensemble enumeration of enumNG (-C given multiple times): each model is
+ * enumerated on its own (see libomen.h) and the passwords of all models are
+ * merged in ascending weighted level. The weighted level of a password is
+ * its overall level decreased by ln(weight) of its model, i.e. the weight
+ * multiplies the probabilities of the model (levels are -ln(p) at the default
+ * level scale, so all models should use the same level scale). Passwords of
+ * the same weighted level are taken from the models in the order given.
+ * Duplicates (passwords already created by any model) are dropped using a
+ * Bloom filter (see bloomFilter.h). Each model creates a password at most
+ * once, so a password reported as seen by the filter has been created
+ * before only if another model assigns it a smaller weighted level (or the
+ * same one and comes first). This is checked for each password reported as
+ * seen, so false positives of the filter never drop a new password (they
+ * are counted instead).
+ *
+ */
+
+#ifndef ENSEMBLE_H_
+#define ENSEMBLE_H_
+
+#include <stdint.h>
+
+#include "libomen.h"
+#include "bloomFilter.h"
+
+// === Defines ===
+#define ENSEMBLE_MAX_MODELS 16
+#define ENSEMBLE_BATCH_SIZE 1024  // passwords fetched from a single model at once
+
+/*
+ * Enumerations of the models and their next passwords.
+ */
+typedef struct ensemble_struct
+{
+  int sizeOf_models;
+  omen_model *models[ENSEMBLE_MAX_MODELS];
+  omen_enum_ctx *enums[ENSEMBLE_MAX_MODELS];
+  double levelShift[ENSEMBLE_MAX_MODELS]; // ln(weight) of each model
+  omen_candidate *buffers[ENSEMBLE_MAX_MODELS]; // next passwords of each model
+  size_t sizeOf_buffers[ENSEMBLE_MAX_MODELS];
+  size_t index[ENSEMBLE_MAX_MODELS];  // index of the next password in each buffer
+  omen_enum_options options;    // settings of all enumerations
+  bloomFilter_struct *filter;   // passwords already created
+
+  uint64_t createdCount[ENSEMBLE_MAX_MODELS]; // amount of new passwords taken from each model
+  uint64_t falsePositiveCount;  // new passwords reported as seen by the filter (kept)
+} ensemble_struct;
+
+/*
+ * Loads the models of the configs @configFilenames with the given @weights
+ * (1.0 for each model if NULL) and starts their enumerations with the given
+ * @options. The duplicate filter is sized for @attemptsMax passwords, but
+ * uses at most @filterBytes bytes.
+ * Returns FALSE if any model can't be read.
+ */
+bool ensemble_initialize (ensemble_struct ** ensemble, // ensemble to be initialized
+                          char **configFilenames, // configs of the models
+                          const double *weights,  // weights of the models
+                          int sizeOf_models,  // amount of models
+                          const omen_enum_options * options,  // settings of all enumerations
+                          uint64_t attemptsMax, // expected amount of passwords
+                          uint64_t filterBytes);  // maximal size of the duplicate filter
+
+/*
+ * Stores the next password (not created by any model yet) in @candidate, its
+ * level is the weighted level rounded down.
+ * Returns FALSE if all enumerations are finished.
+ */
+bool ensemble_next (ensemble_struct * ensemble, omen_candidate * candidate);
+
+/*
+ * Prints the amount of passwords taken from each model, the duplicates and
+ * the false positives of the filter to the given file pointer @fp.
+ */
+void ensemble_printResults (const ensemble_struct * ensemble, char **configFilenames, FILE * fp);
+
+/*
+ * Frees the given ensemble (if not NULL).
+ */
+void ensemble_free (ensemble_struct ** ensemble);
+
+#endif /* ENSEMBLE_H_ */
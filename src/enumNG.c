@@ -12,23 +12,43 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 
+#include "adaptation.h"
 #include "attackSimulator.h"
+#include "banditScheduler.h"
+#include "bloomFilter.h"
 #include "boosting.h"
+#include "candidateRing.h"
 #include "cmdlineEnumNG.h"
 #include "common.h"
 #include "commonStructs.h"
+#include "constraint.h"
+#include "ensemble.h"
 #include "enumNG.h"
 #include "errorHandler.h"
+#include "feedback.h"
+#include "hashChecker.h"
+#include "hybridAttack.h"
+#include "ruleEngine.h"
+#include "levelChain.h"
+#include "levelRange.h"
 #include "nGramReader.h"
+#include "probQueue.h"
+#include "scoredStream.h"
+#include "sharedModel.h"
 #include "smoothing.h"
+#include "usernameAttack.h"
+#include "workUnit.h"
 
 // nGram array for the level
 nGram_struct *glbl_nGramLevel = NULL; // struct for nGram, initalProb and length array for the level
 
 // nGram_struct *glbl_nGramLevel_user = NULL; // same as above for usernameMode
+nGram_struct *glbl_nGramProb = NULL;  // fixed point log-probabilities (only read in exactOrderMode and sortedLevelMode)
 
 // alphabet
 alphabet_struct *glbl_alphabet = NULL;  // struct containing the current alphabet and alphabet size
@@ -43,12 +63,16 @@ sortedLastGram_struct *glbl_sortedLastGram = NULL;  // stores lastGrams sorted b
 sortedIP_struct *glbl_sortedIP = NULL;  // stores iP sorted by level
 sortedLength_struct *glbl_sortedLength = NULL;  // stores length sorted by level
 
+// shared model (used in sharedModelMode only)
+char *glbl_sharedModelName = NULL;  // name of the shared memory segment [--shm <name>]
+sharedModel_struct *glbl_sharedModel = NULL;  // attached segment containing the nGram arrays and (if set) the sorted arrays
+
 // defines modification for the lengths level (used for the struct_fill_sortedLength function)
 // default value (-1/0.0) equals disabled length-level-set/-factor
 int glbl_lengthLevelSet = -1;   // set all length level to this value before applieing the length level factor
 float glbl_lengthLevelFactor = 0.0; // add length times this factor to each length level
 
-char glbl_maxLevel = MAX_LEVEL;
+int glbl_maxLevel = MAX_LEVEL;
 
 // attempt counter, storing maximum attempts and attempts done
 uint64_t glbl_attemptsCount = 0;  // counts amounts of attempts (extern, declared in enumNG.h)
@@ -57,14 +81,27 @@ uint64_t glbl_progressStep = (uint64_t) (DEFAULT_MAX_ATTEMPTS / 100);
 
 // modes (set by arguments [-argument])
 bool glbl_simulatedAttMode = false; // start a simulated attack and print results to the graph-file [-s <filename>]
-bool glbl_usernameMode = false; // usermode activated (TODO: implement username mode) [-u <filename>]
+bool glbl_usernameMode = false; // targeted guessing of the passwords of the given users [-u <filename>]
 bool glbl_verboseFileMode = false;  // write a file containing all cracked PWs [-F]
 bool glbl_verboseMode = false;  // printout information about settings [-v]
 bool glbl_pipeMode = false;     // printout generated to stdout only (printing nothing else!) [-p]
 bool glbl_ignoreEPMode = false; // ignore endProbs [-E]
 bool glbl_endlessMode = false;  // ignore endProbs [-e]
 bool glbl_optimizedLengthMode = false;
+bool glbl_banditMode = false;   // optimized scheduling by a multi-armed bandit [--scheduler bandit]
 bool glbl_alphaBoostingMode = false;  // enumerates passwords using boosting
+bool glbl_exactOrderMode = false;  // enumerate in exact descending probability [--order exact]
+bool glbl_sortedLevelMode = false;  // sort the passwords of each level by probability [--order sorted]
+bool glbl_subtreeSkipMode = false;  // skip candidates not matching any prefix of the testing set during a simulated attack (disable using [--noSkip])
+int glbl_simThreads = 0;        // amount of threads checking the candidates of the simulated attack (0: checked while enumerating) [--simThreads]
+bool glbl_hashCheckMode = false;  // check the generated passwords against a list of hashes [--hashes <filename>]
+bool glbl_ringMode = false;     // write the generated passwords to a ring buffer in shared memory [--ring <name>]
+bool glbl_levelRangeMode = false;  // fine-grained levels (maxLevel > MAX_LEVEL): enumerate without explicit levelChains, pruning by level ranges
+bool glbl_ensembleMode = false; // merge the enumerations of multiple models [-C <config> given multiple times]
+bool glbl_scoredMode = false;   // write the generated PWs as binary records with their level [--scored]
+bool glbl_hybridMode = false;   // combine the words of a wordlist with prefixes and suffixes [--hybrid]
+bool glbl_constraintMode = false; // only create PWs matching a mask, fragments or a password policy [--mask, --prefix, --minLength, ...]
+bool glbl_workerMode = false;   // enumerate the work units handed out by a coordinator [--worker]
 
 unsigned int glbl_fixedLenght = 0;  // if fixedLength != 0 -> only create PWs of this length
 
@@ -73,12 +110,99 @@ char glbl_resultsFolder[256] = { '\0' };
 
 FILE *glbl_FP_generatedPasswords = NULL;  // generated PWs (based on selected mode either all or only cracked ones are stored)
 
+// hash checking (used in hashCheckMode only)
+char *glbl_filenameHashes = NULL; // file containing the hashes [--hashes <filename>]
+char *glbl_filenamePotfile = NULL;  // file the cracked hashes are appended to [--potfile <filename>]
+hashType glbl_hashType = hashType_MD5;  // type of the hashes [--hashType]
+int glbl_hashThreads = 0;       // amount of threads hashing the passwords [--hashThreads]
+hashChecker_struct *glbl_hashChecker = NULL;  // checks the generated passwords in batches
+FILE *glbl_FP_potfile = NULL;   // cracked hashes (hash:password)
+
+// feedback of an external password cracker (used in optimizedLengthMode only)
+char *glbl_filenameFeedback = NULL; // file or FIFO containing the cracked passwords [--feedback <filename>]
+feedback_struct *glbl_feedback = NULL;  // cracked passwords read from the feedback file
+
+// bandit scheduling (used in banditMode only)
+int glbl_pullSize = 0;          // passwords per pull of an arm [--pullSize]
+banditScheduler_struct *glbl_bandit = NULL; // arms of the lengths and initialProb levels
+
+// online adaptation of the model (used in adaptMode only)
+int glbl_adaptAlpha = 0;        // level decrease of the n-grams of each cracked password, 0 if not active [--adapt]
+adaptation_struct *glbl_adaptation = NULL;  // boosted levels and the cracked passwords not applied yet
+
+// merged enumerations (used in ensembleMode only)
+ensemble_struct *glbl_ensemble = NULL;  // enumerations of all models and the filter of the passwords created so far
+
+// targeted guessing (used in usernameMode only)
+usernameAttack_struct *glbl_usernameAttack = NULL; // boosts the hints of each user and counts the guesses of its password
+
+// ring buffer (used in ringMode only)
+char *glbl_ringName = NULL;     // name of the shared memory segment [--ring <name>]
+int glbl_ringSlots = 0;         // amount of batches held by the ring [--ringSlots]
+int glbl_ringTimeout = 0;       // seconds to wait for a free batch of the ring [--ringTimeout]
+volatile sig_atomic_t glbl_ringSignal = 0;      // signal stopping the ring producer (ringMode)
+candidateRing_struct *glbl_ring = NULL; // ring the generated PWs are written to
+
 // information stored in the log
 uint64_t glbl_createdLengths[MAX_PASSWORD_LENGTH];  // counts length of the created PWs (extern, declared in enumNG.h)
 
 // control variable to avoid segmentation faults during log file creation
 bool glbl_inputFiles_read = false;  // is set to true if the input files have been read successful
 
+// candidate counts of skipped subtrees (used in subtreeSkipMode only)
+uint64_t *glbl_subtreeCount[MAX_PASSWORD_LENGTH] = { NULL };  // candidates by prefix length and position of the last (n-1) chars of the prefix
+uint32_t *glbl_subtreeStamp[MAX_PASSWORD_LENGTH] = { NULL };  // stamp of the levelChain the count has been calculated for
+uint32_t glbl_subtreeStampCur = 0;  // stamp of the current levelChain
+int *glbl_subtreeIPNode = NULL; // testing set prefix trie node of each initialProb position
+
+// exact order enumeration (used in exactOrderMode only)
+probQueue_struct *glbl_exactQueue = NULL; // priority queue storing the partial passwords
+int glbl_queueSize = 0;         // maximal amount of entries kept in memory by the queue [--queueSize]
+int *glbl_exactRest[MAX_PASSWORD_LENGTH] = { NULL };  // minimal log-probability to add x more chars (and the endProb) by position of the last (n-1) chars
+int *glbl_exactIP[MAX_PASSWORD_LENGTH] = { NULL };  // initialProbs sorted by the most probable password of each length (sorted on first use)
+
+// sorted level order (used in sortedLevelMode only)
+probQueue_struct *glbl_levelQueue = NULL; // passwords of the current level sorted by log-probability
+bool glbl_levelQueueFlushing = false; // TRUE, while the passwords of the level are handled
+
+// level range enumeration (used in levelRangeMode only, i.e. for fine-grained levels)
+levelRange_struct *glbl_levelRange = NULL;  // lastGrams sorted by level and the level ranges of all subtrees (replaces glbl_sortedLastGram)
+
+// constrained enumeration (used in constraintMode only)
+constraint_struct *glbl_constraint = NULL;  // allowed symbols of each position and the states of the infix and policy
+int glbl_constraintState[MAX_PASSWORD_LENGTH + 1];  // state of the current prefix by its length
+uint64_t glbl_constraintCount = 0;  // amount of passwords matching the constraints (of all enumerated lengths)
+
+// hybrid attack (used in hybridMode only)
+char *glbl_filenameHybrid = NULL; // wordlist [--hybrid <filename>]
+int glbl_hybridAffix = 0;       // maximal length of the prefixes and suffixes [--hybridAffix]
+hybridAttack_struct *glbl_hybridAttack = NULL;  // words and the queue of their next affix level
+
+// exclusion of the passwords of earlier attacks (used with --exclude only)
+char *glbl_filenameExclude = NULL;  // filter created by createFilter [--exclude <filename>]
+bloomFilter_struct *glbl_excludeFilter = NULL;  // passwords dropped before being handled (only read)
+uint64_t glbl_excludedCount = 0;  // amount of dropped passwords (not counted as attempts)
+
+// mangling rules (used with --rules only)
+char *glbl_filenameRules = NULL;  // hashcat-style rules [--rules <filename>]
+int glbl_rulesBatch = 0;        // amount of passwords each rule is applied to at once [--rulesBatch]
+ruleEngine_struct *glbl_ruleEngine = NULL;  // compiled rules and the current batch
+
+// distributed enumeration (used in workerMode only)
+char *glbl_workerAddress = NULL;  // address of the coordinator [--worker <address>]
+int glbl_workerSocket = -1;     // connection to the coordinator
+uint64_t glbl_workerUnits = 0;  // amount of completed work units
+uint64_t glbl_workerSplits = 0; // amount of parts split off the units (work stealing)
+workUnit_reader glbl_workerReader;  // lines received from the coordinator
+workUnit_struct glbl_workerUnit;  // current work unit (without the parts split off)
+uint64_t glbl_workerChain = 0;  // index of the current levelChain in the unit
+int glbl_workerIndex[MAX_PASSWORD_LENGTH];  // current index at each depth of the subtree (0: initialProbs)
+int glbl_workerEnd[MAX_PASSWORD_LENGTH];  // index following the last one at each depth (lowered by splits)
+uint64_t glbl_workerSteps = 0;  // visited nodes (the split requests are checked regularly)
+uint64_t glbl_workerStart = 0;  // glbl_attemptsCount at the start of the current unit
+uint64_t glbl_workerProgress = 0; // passwords of the current unit last reported by PROGRESS
+bool glbl_workerStopped = false;  // TRUE, if the current unit has been stopped (budget used up or STOP)
+
 int glbl_boostPwdCount = 0;     // saves current line in password file
 FILE *glbl_boostTestSetFile = NULL; // filedescriptor to file with passwords (one per line) that should be guessed.
 
@@ -110,8 +234,16 @@ int main (int argc, char **argv)
     exit (EXIT_FAILURE);
   }
 
+  // check if username mode
+  if (glbl_usernameMode)
+  {
+    if (!usernameMode ())
+    {
+      exit (EXIT_FAILURE);
+    }
+  }
   // check if boosting
-  if (glbl_alphaBoostingMode && glbl_simulatedAttMode)
+  else if (glbl_alphaBoostingMode && glbl_simulatedAttMode)
   {
     if (!boostingMode ())
     {
@@ -156,7 +288,23 @@ int main (int argc, char **argv)
     }
 
     // run password creation
-    if (glbl_fixedLenght != 0)
+    if (glbl_exactOrderMode)
+    {
+      run_enumeration_exact ();
+    }
+    else if (glbl_ensembleMode)
+    {
+      run_enumeration_ensemble ();
+    }
+    else if (glbl_hybridMode)
+    {
+      run_enumeration_hybrid ();
+    }
+    else if (glbl_workerMode)
+    {
+      run_enumeration_worker ();
+    }
+    else if (glbl_fixedLenght != 0)
     {
       run_enumeration_fixedLenghts ();
     }
@@ -170,6 +318,10 @@ int main (int argc, char **argv)
     }
   }
 
+  // apply the rules to the passwords of the last batch
+  if (glbl_ruleEngine != NULL)
+    handle_ruleBatch ();
+
   exit (EXIT_SUCCESS);
 }
 
@@ -217,6 +369,10 @@ void initialize ()
 // exit routine, frees any allocated memory (for global variables)
 void exit_routine ()
 {
+  // check the passwords of the last batch (before printing the results)
+  hashChecker_finish (glbl_hashChecker);
+  simAtt_flush ();              // never exits, even if it cracks the last password
+
   if (exit_status != -1)
   {                             // -1 = exit after printing help text
     // and log file to HD (filename: log/<date>.log)
@@ -256,9 +412,14 @@ void exit_routine ()
   // free all pointer using the CHECKED_FREE
   // and struct_free operation (defined in commonStructs.h)
 
+  // arrays of the shared model are only detached
+  sharedModel_detach (&glbl_sharedModel, glbl_nGramLevel, glbl_maxLevel, glbl_sortedLastGram, glbl_sortedIP);
+  CHECKED_FREE (glbl_sharedModelName);
+
   // level and count arrays
   struct_nGrams_free (&glbl_nGramLevel);
   // struct_nGrams_free(&glbl_nGramLevel_user);
+  struct_nGrams_free (&glbl_nGramProb);
 
   // alphabet
   struct_alphabet_free (&glbl_alphabet);
@@ -269,6 +430,25 @@ void exit_routine ()
     struct_sortedLastGram_free (glbl_maxLevel, &glbl_sortedLastGram);
   struct_sortedIP_free (glbl_maxLevel, &glbl_sortedIP);
   struct_sortedLength_free (&glbl_sortedLength);
+  // subtree counts
+  for (size_t i = 0; i < MAX_PASSWORD_LENGTH; i++)
+  {
+    CHECKED_FREE (glbl_subtreeCount[i]);
+    CHECKED_FREE (glbl_subtreeStamp[i]);
+  }
+  CHECKED_FREE (glbl_subtreeIPNode);
+  // exact order arrays and queue
+  for (size_t i = 0; i < MAX_PASSWORD_LENGTH; i++)
+  {
+    CHECKED_FREE (glbl_exactRest[i]);
+    CHECKED_FREE (glbl_exactIP[i]);
+  }
+  probQueue_free (&glbl_exactQueue);
+  probQueue_free (&glbl_levelQueue);
+  // level range arrays
+  levelRange_free (&glbl_levelRange);
+  // constraints
+  constraint_free (&glbl_constraint);
 
   // free testing set (if simulated attack mode is active)
   if (glbl_simulatedAttMode)
@@ -276,6 +456,51 @@ void exit_routine ()
     simAtt_freeTestingSet ();
   }
 
+  // stop the hashing threads
+  hashChecker_free (&glbl_hashChecker);
+  CHECKED_FREE (glbl_filenameHashes);
+  CHECKED_FREE (glbl_filenamePotfile);
+  if (glbl_FP_potfile != NULL)
+  {
+    fclose (glbl_FP_potfile);
+    glbl_FP_potfile = NULL;
+  }
+
+  // bandit scheduling
+  banditScheduler_free (&glbl_bandit);
+
+  // online adaptation
+  adaptation_free (&glbl_adaptation);
+
+  // username mode
+  usernameAttack_free (&glbl_usernameAttack);
+
+  // ensemble
+  ensemble_free (&glbl_ensemble);
+
+  // stop reading the feedback
+  feedback_close (&glbl_feedback);
+  CHECKED_FREE (glbl_filenameFeedback);
+
+  // hybrid mode
+  hybridAttack_free (&glbl_hybridAttack);
+  CHECKED_FREE (glbl_filenameHybrid);
+
+  // exclusion filter
+  bloomFilter_free (&glbl_excludeFilter);
+  CHECKED_FREE (glbl_filenameExclude);
+  ruleEngine_free (&glbl_ruleEngine);
+  CHECKED_FREE (glbl_filenameRules);
+
+  // close the connection to the coordinator (a unit not reported is handed out again)
+  if (glbl_workerSocket >= 0)
+    close (glbl_workerSocket);
+  CHECKED_FREE (glbl_workerAddress);
+
+  // publish the remaining passwords and mark the ring finished
+  candidateRing_close (&glbl_ring);
+  CHECKED_FREE (glbl_ringName);
+
   // close global file pointer
   if (glbl_FP_generatedPasswords != NULL)
   {
@@ -311,6 +536,19 @@ bool evaluate_arguments (struct gengetopt_args_info *args_info)
   {
     result &= changeFilename (&glbl_filenameTestingSet, FILENAME_MAX, "password", args_info->simAtt_arg);
     glbl_simulatedAttMode = true;
+    glbl_subtreeSkipMode = !args_info->noSkip_flag;
+    glbl_simThreads = args_info->simThreads_arg;
+    if (glbl_simThreads < 0 || glbl_simThreads > SIMATT_MAX_THREADS)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i, the maximum %i\n", "simThreads", 0, SIMATT_MAX_THREADS);
+      result = false;
+    }
+    // boosting removes the cracked passwords from the testing set
+    if (glbl_simThreads > 0 && args_info->alpha_given)
+    {
+      errorHandler_print (errorType_Error, "The checking threads (--simThreads) can't be combined with boosting.\n");
+      result = false;
+    }
   }
 
   if (args_info->pipeMode_flag)
@@ -318,6 +556,26 @@ bool evaluate_arguments (struct gengetopt_args_info *args_info)
     glbl_pipeMode = true;
   }
 
+  if (args_info->hashes_given)
+  {
+    result &= changeFilename (&glbl_filenameHashes, FILENAME_MAX, "hashes", args_info->hashes_arg);
+    glbl_hashCheckMode = true;
+    hashChecker_parseType (args_info->hashType_arg, &glbl_hashType);
+    glbl_hashThreads = args_info->hashThreads_arg;
+    if (glbl_hashThreads < 1 || glbl_hashThreads > HASHCHECKER_MAX_THREADS)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i, the maximum %i\n", "hashThreads", 1, HASHCHECKER_MAX_THREADS);
+      result = false;
+    }
+    if (args_info->potfile_given)
+      result &= changeFilename (&glbl_filenamePotfile, FILENAME_MAX, "potfile", args_info->potfile_arg);
+    if (glbl_pipeMode || glbl_simulatedAttMode || args_info->ring_given || args_info->alpha_given)
+    {
+      errorHandler_print (errorType_Error, "Checking hashes can't be combined with the pipe mode, a simulated attack, the ring, or boosting.\n");
+      result = false;
+    }
+  }
+
   if (args_info->llFactor_given)
   {
     glbl_lengthLevelFactor = args_info->llFactor_arg;
@@ -338,6 +596,76 @@ bool evaluate_arguments (struct gengetopt_args_info *args_info)
     glbl_optimizedLengthMode = true;
   }
 
+  if (args_info->feedback_given)
+  {
+    result &= changeFilename (&glbl_filenameFeedback, FILENAME_MAX, "feedback", args_info->feedback_arg);
+    glbl_optimizedLengthMode = true;
+    if (glbl_simulatedAttMode)
+    {
+      errorHandler_print (errorType_Error, "The feedback can't be combined with a simulated attack (which provides its own feedback).\n");
+      result = false;
+    }
+  }
+
+  if (strcmp (args_info->scheduler_arg, "bandit") == 0)
+  {
+    glbl_banditMode = true;
+    glbl_optimizedLengthMode = true;
+    glbl_pullSize = args_info->pullSize_arg;
+    if (glbl_pullSize < 1)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "pullSize", 1);
+      result = false;
+    }
+    if (!((glbl_simulatedAttMode && !glbl_pipeMode) || glbl_hashCheckMode || args_info->feedback_given))
+    {
+      errorHandler_print (errorType_Error, "The bandit scheduler needs cracked passwords (a simulated attack, --hashes or --feedback).\n");
+      result = false;
+    }
+  }
+
+  if (strcmp (args_info->order_arg, "exact") == 0)
+  {
+    glbl_exactOrderMode = true;
+  }
+  else if (strcmp (args_info->order_arg, "sorted") == 0)
+  {
+    glbl_sortedLevelMode = true;
+    glbl_subtreeSkipMode = false; // skipped candidates can't be sorted
+  }
+
+  glbl_queueSize = args_info->queueSize_arg;
+  if (glbl_queueSize < 2)
+  {
+    errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "queueSize", 2);
+    result = false;
+  }
+
+  if (args_info->adapt_given)
+  {
+    glbl_adaptAlpha = args_info->adapt_arg;
+    if (glbl_adaptAlpha < 1)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "adapt", 1);
+      result = false;
+    }
+    if (args_info->adaptMax_arg < 1 || args_info->adaptMax_arg > ADAPTATION_MAX_BOOST)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i, the maximum %i\n", "adaptMax", 1, ADAPTATION_MAX_BOOST);
+      result = false;
+    }
+    if (!((glbl_simulatedAttMode && !glbl_pipeMode) || glbl_hashCheckMode || args_info->feedback_given))
+    {
+      errorHandler_print (errorType_Error, "The online adaptation needs cracked passwords (a simulated attack, --hashes or --feedback).\n");
+      result = false;
+    }
+    if (glbl_banditMode || glbl_exactOrderMode || args_info->alpha_given || args_info->shm_given)
+    {
+      errorHandler_print (errorType_Error, "The online adaptation can't be combined with the bandit scheduler, the exact order, boosting, or the shared model.\n");
+      result = false;
+    }
+  }
+
   if (args_info->fixedLength_given)
   {
     glbl_fixedLenght = args_info->fixedLength_arg;
@@ -377,13 +705,210 @@ bool evaluate_arguments (struct gengetopt_args_info *args_info)
 
   if (args_info->config_given)
   {
-    result &= changeFilename (&(glbl_filenames->cfg), FILENAME_MAX, "config", args_info->config_arg);
+    result &= changeFilename (&(glbl_filenames->cfg), FILENAME_MAX, "config", args_info->config_arg[0]);
+  }
+
+  if (args_info->ring_given)
+  {
+    result &= changeFilename (&glbl_ringName, FILENAME_MAX, "ring", args_info->ring_arg);
+    glbl_ringMode = true;
+    glbl_ringSlots = args_info->ringSlots_arg;
+    if (glbl_ringSlots < 1 || glbl_ringSlots > CANDIDATERING_MAX_SLOTS)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i, the maximum %i\n", "ringSlots", 1, CANDIDATERING_MAX_SLOTS);
+      result = false;
+    }
+    glbl_ringTimeout = args_info->ringTimeout_arg;
+    if (glbl_ringTimeout < 0)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "ringTimeout", 0);
+      result = false;
+    }
+    if (glbl_pipeMode || glbl_simulatedAttMode)
+    {
+      errorHandler_print (errorType_Error, "The ring replaces the output of the passwords, it can't be combined with the pipe mode or a simulated attack.\n");
+      result = false;
+    }
+  }
+
+  if (args_info->scored_flag)
+  {
+    glbl_scoredMode = true;
+    if (glbl_simulatedAttMode || glbl_hashCheckMode || args_info->ring_given || glbl_usernameMode)
+    {
+      errorHandler_print (errorType_Error, "The scored output replaces the password file or stdout, it can't be combined with a simulated attack, hash checking, the ring or the username mode.\n");
+      result = false;
+    }
+  }
+
+  if (args_info->shm_given)
+  {
+    result &= changeFilename (&glbl_sharedModelName, FILENAME_MAX, "shared memory", args_info->shm_arg);
   }
 
   // if username mode was set
   if (glbl_usernameMode)
   {
-    // TODO: implement username mode
+    if (args_info->userAlpha_arg < 0)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "userAlpha", 0);
+      result = false;
+    }
+    if (args_info->userThreads_arg < 1 || args_info->userThreads_arg > USERNAMEATTACK_MAX_THREADS)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i, the maximum %i\n", "userThreads", 1, USERNAMEATTACK_MAX_THREADS);
+      result = false;
+    }
+    if (glbl_simulatedAttMode || glbl_hashCheckMode || glbl_ringMode || glbl_endlessMode || args_info->alpha_given || args_info->hint_given)
+    {
+      errorHandler_print (errorType_Error, "The username mode can't be combined with a simulated attack, hash checking, the ring, the endless mode or boosting (the hints are derived from the usernames).\n");
+      result = false;
+    }
+    if (glbl_optimizedLengthMode || glbl_exactOrderMode || glbl_sortedLevelMode || glbl_adaptAlpha > 0)
+    {
+      errorHandler_print (errorType_Error, "The username mode only supports the default and fixed length order (no optimized scheduling, exact or sorted order, or online adaptation).\n");
+      result = false;
+    }
+  }
+
+  // if multiple configs are given, the models are merged (ensemble)
+  if (args_info->config_given > 1)
+  {
+    glbl_ensembleMode = true;
+    glbl_subtreeSkipMode = false; // the subtrees are counted using the sorted arrays of a single model
+    if (args_info->config_given > ENSEMBLE_MAX_MODELS)
+    {
+      errorHandler_print (errorType_Error, "The maximum amount of models of the ensemble is %i\n", ENSEMBLE_MAX_MODELS);
+      result = false;
+    }
+    if (args_info->weight_given != 0 && args_info->weight_given != args_info->config_given)
+    {
+      errorHandler_print (errorType_Error, "The weight must be given for each config (or for none of them).\n");
+      result = false;
+    }
+    for (size_t i = 0; i < args_info->weight_given; i++)
+    {
+      if (args_info->weight_arg[i] <= 0.0)
+      {
+        errorHandler_print (errorType_Error, "The weight of each model must be larger than 0.\n");
+        result = false;
+        break;
+      }
+    }
+    if (args_info->ensembleFilter_arg < 1)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "ensembleFilter", 1);
+      result = false;
+    }
+    if (glbl_usernameMode || args_info->alpha_given || args_info->hint_given || args_info->shm_given)
+    {
+      errorHandler_print (errorType_Error, "The ensemble can't be combined with the username mode, boosting or the shared model.\n");
+      result = false;
+    }
+    if (glbl_optimizedLengthMode || glbl_exactOrderMode || glbl_sortedLevelMode || glbl_adaptAlpha > 0 || args_info->llFactor_given || args_info->llSet_given)
+    {
+      errorHandler_print (errorType_Error, "The ensemble only supports the default and fixed length order (no optimized scheduling, exact or sorted order, online adaptation or changed length levels).\n");
+      result = false;
+    }
+  }
+  else if (args_info->weight_given)
+  {
+    errorHandler_print (errorType_Error, "The weight requires multiple configs (ensemble).\n");
+    result = false;
+  }
+
+  // if a mask, fragment or password policy is given, only passwords matching them are created
+  if (args_info->mask_given || args_info->prefix_given || args_info->suffix_given || args_info->infix_given || args_info->minLength_given || args_info->maxLength_given || args_info->minLower_arg > 0 || args_info->minUpper_arg > 0 || args_info->minDigits_arg > 0 || args_info->minSpecial_arg > 0)
+  {
+    glbl_constraintMode = true;
+    glbl_subtreeSkipMode = false; // the skipped subtrees are counted without the constraints
+    if (glbl_ensembleMode || glbl_usernameMode || glbl_exactOrderMode || glbl_adaptAlpha > 0 || args_info->alpha_given || args_info->hint_given)
+    {
+      errorHandler_print (errorType_Error, "The mask, fragments and password policy can't be combined with the ensemble, the username mode, the exact order, the online adaptation or boosting.\n");
+      result = false;
+    }
+    if (args_info->minLower_arg < 0 || args_info->minUpper_arg < 0 || args_info->minDigits_arg < 0 || args_info->minSpecial_arg < 0)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "minimal amount of chars of a class", 0);
+      result = false;
+    }
+    if ((args_info->minLength_given && (args_info->minLength_arg < 1 || args_info->minLength_arg >= MAX_PASSWORD_LENGTH)) || (args_info->maxLength_given && (args_info->maxLength_arg < 1 || args_info->maxLength_arg >= MAX_PASSWORD_LENGTH)))
+    {
+      errorHandler_print (errorType_Error, "The length bounds must be in range %i to %i\n", 1, MAX_PASSWORD_LENGTH - 1);
+      result = false;
+    }
+  }
+
+  // if a wordlist is given, its words are combined with prefixes and suffixes
+  if (args_info->hybrid_given)
+  {
+    result &= changeFilename (&glbl_filenameHybrid, FILENAME_MAX, "hybrid", args_info->hybrid_arg);
+    glbl_hybridMode = true;
+    glbl_subtreeSkipMode = false; // the skipped subtrees are counted for levelChains
+    glbl_hybridAffix = args_info->hybridAffix_arg;
+    if (glbl_hybridAffix < 1 || glbl_hybridAffix > MAX_PASSWORD_LENGTH - 2)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i, the maximum %i\n", "hybridAffix", 1, MAX_PASSWORD_LENGTH - 2);
+      result = false;
+    }
+    if (glbl_usernameMode || glbl_ensembleMode || glbl_constraintMode || glbl_adaptAlpha > 0 || args_info->alpha_given || args_info->hint_given)
+    {
+      errorHandler_print (errorType_Error, "The hybrid mode can't be combined with the username mode, the ensemble, the mask, fragments and password policy, the online adaptation or boosting.\n");
+      result = false;
+    }
+    if (glbl_fixedLenght != 0 || glbl_optimizedLengthMode || glbl_exactOrderMode || glbl_sortedLevelMode)
+    {
+      errorHandler_print (errorType_Error, "The hybrid mode creates the candidates in its own order (no fixed length, optimized scheduling, exact or sorted order).\n");
+      result = false;
+    }
+  }
+
+  // if a filter of earlier attacks is given, any password found in it is dropped
+  if (args_info->exclude_given)
+  {
+    result &= changeFilename (&glbl_filenameExclude, FILENAME_MAX, "exclude", args_info->exclude_arg);
+    glbl_subtreeSkipMode = false; // the skipped subtrees are counted without the dropped passwords
+    if (glbl_usernameMode)
+    {
+      errorHandler_print (errorType_Error, "The exclusion filter can't be combined with the username mode.\n");
+      result = false;
+    }
+  }
+
+  // if a rule file is given, the rules are applied to each created password
+  if (args_info->rules_given)
+  {
+    result &= changeFilename (&glbl_filenameRules, FILENAME_MAX, "rules", args_info->rules_arg);
+    glbl_rulesBatch = args_info->rulesBatch_arg;
+    glbl_subtreeSkipMode = false; // the skipped subtrees are counted without the results of the rules
+    if (glbl_rulesBatch < 1 || glbl_rulesBatch > RULEENGINE_MAX_BATCH)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i, the maximum %i\n", "rulesBatch", 1, RULEENGINE_MAX_BATCH);
+      result = false;
+    }
+    if (glbl_usernameMode || glbl_constraintMode)
+    {
+      errorHandler_print (errorType_Error, "The rules can't be combined with the username mode or the mask, fragments and password policy (which describe the created passwords).\n");
+      result = false;
+    }
+  }
+
+  // if a coordinator is given, only the work units handed out by it are enumerated
+  if (args_info->worker_given)
+  {
+    result &= changeFilename (&glbl_workerAddress, FILENAME_MAX, "worker", args_info->worker_arg);
+    glbl_workerMode = true;
+    glbl_subtreeSkipMode = false; // the skipped subtrees are counted for whole levelChains
+    if (glbl_usernameMode || glbl_ensembleMode || glbl_hybridMode || glbl_constraintMode || glbl_adaptAlpha > 0 || args_info->alpha_given || args_info->hint_given)
+    {
+      errorHandler_print (errorType_Error, "The worker mode can't be combined with the username mode, the ensemble, the hybrid mode, the mask, fragments and password policy, the online adaptation or boosting.\n");
+      result = false;
+    }
+    if (glbl_fixedLenght != 0 || glbl_optimizedLengthMode || glbl_banditMode || glbl_exactOrderMode || glbl_sortedLevelMode)
+    {
+      errorHandler_print (errorType_Error, "The worker mode enumerates the work units in the order of the coordinator (no fixed length, optimized scheduling, exact or sorted order).\n");
+      result = false;
+    }
   }
 
   // check if both of alpha and hint file are given
@@ -392,9 +917,20 @@ bool evaluate_arguments (struct gengetopt_args_info *args_info)
     fprintf (stderr, "ERROR:\tThe alpha and hint arguments require each other.\n");
     return false;
   }
+  else if (args_info->alpha_given && args_info->hint_given && (glbl_exactOrderMode || glbl_sortedLevelMode))
+  {
+    fprintf (stderr, "ERROR:\tBoosting is not supported by the exact and sorted order.\n");
+    return false;
+  }
+  else if (args_info->alpha_given && args_info->hint_given && args_info->shm_given)
+  {
+    fprintf (stderr, "ERROR:\tBoosting is not supported by the shared model.\n");
+    return false;
+  }
   else if (args_info->alpha_given && args_info->hint_given)
   {
     glbl_alphaBoostingMode = true;
+    glbl_subtreeSkipMode = false;  // the testing set is read password by password
   }
   return result;
 }                               // evaluate_arguments
@@ -402,8 +938,13 @@ bool evaluate_arguments (struct gengetopt_args_info *args_info)
 // reads all needed input files and fills the sorted arrays
 bool apply_settings ()
 {
-  // read input files
-  if (!read_inputFiles (glbl_nGramLevel, glbl_alphabet, glbl_filenames, &glbl_maxLevel))
+  // read input files (or attach them from the shared memory segment, including the sorted arrays)
+  if (glbl_sharedModelName != NULL)
+  {
+    if (!sharedModel_attach (&glbl_sharedModel, glbl_sharedModelName, glbl_nGramLevel, glbl_alphabet, glbl_filenames, &glbl_maxLevel, &glbl_sortedLastGram, &glbl_sortedIP))
+      return false;
+  }
+  else if (!read_inputFiles (glbl_nGramLevel, glbl_alphabet, glbl_filenames, &glbl_maxLevel))
   {
     // TODO print help here?
     return false;
@@ -415,46 +956,210 @@ bool apply_settings ()
       return false;
     }
   }
+  // fine-grained levels: explicit levelChains (and per level storage) become too expensive
+  if (glbl_maxLevel > MAX_LEVEL && !glbl_exactOrderMode)
+  {
+    glbl_levelRangeMode = true;
+    glbl_subtreeSkipMode = false;
+  }
 
-  // if pipeMode is not active...
-  if (!glbl_pipeMode)
+  // worker mode: the work units contain levelChains (see workUnit.h)
+  if (glbl_workerMode)
   {
-    // .. try to create the basic result file
-    if (!open_file (&glbl_FP_generatedPasswords, glbl_resultsFolder, "/createdPWs.txt", "w"))
+    if (glbl_levelRangeMode)
     {
-      errorHandler_print (errorType_Error, "Unable to create result file\n");
+      errorHandler_print (errorType_Error, "The worker mode doesn't support fine-grained levels (maxLevel larger than %i).\n", MAX_LEVEL);
       return false;
     }
+    glbl_workerSocket = workUnit_connect (glbl_workerAddress);
+    if (glbl_workerSocket < 0)
+      return false;
+  }
 
-    // ... and if simulated attack mode is active ...
-    if ((glbl_simulatedAttMode) && (!glbl_alphaBoostingMode))
+  // hybrid mode: read the wordlist, the affixes are created from the levels of the model
+  if (glbl_hybridMode)
+  {
+    if (glbl_levelRangeMode)
     {
-      int output_cycle = (int) (glbl_attemptsMax / DEFAULT_OUTPUT_CYCLE_FACTOR);
+      errorHandler_print (errorType_Error, "The hybrid mode doesn't support fine-grained levels (maxLevel larger than %i).\n", MAX_LEVEL);
+      return false;
+    }
+    if (!hybridAttack_initialize (&glbl_hybridAttack, glbl_filenameHybrid, glbl_nGramLevel, glbl_alphabet->sizeOf_alphabet, glbl_maxLevel, glbl_ignoreEPMode, glbl_hybridAffix))
+      return false;
+  }
 
-      if (output_cycle == 0)
+  // constrained enumeration: the mask fixes the length
+  if (glbl_constraintMode)
+  {
+    int classMin[CONSTRAINT_SIZEOF_CLASSES] = { glbl_args_info.minLower_arg, glbl_args_info.minUpper_arg, glbl_args_info.minDigits_arg, glbl_args_info.minSpecial_arg };
+
+    if (!constraint_initialize (&glbl_constraint, glbl_alphabet, glbl_args_info.mask_arg, glbl_args_info.prefix_arg, glbl_args_info.suffix_arg, glbl_args_info.infix_arg, classMin, glbl_args_info.minLength_given ? glbl_args_info.minLength_arg : 0, glbl_args_info.maxLength_given ? glbl_args_info.maxLength_arg : 0))
+      return false;
+    if (glbl_constraint->maskLength != 0)
+    {
+      if (glbl_fixedLenght != 0 && glbl_fixedLenght != glbl_constraint->maskLength)
       {
-        output_cycle = 1;
+        errorHandler_print (errorType_Error, "The fixed length (%i) doesn't match the length of the mask (%i).\n", glbl_fixedLenght, glbl_constraint->maskLength);
+        return false;
       }
-      // ... try to generate testing set based on input file
-      if (!simAtt_generateTestingSet (glbl_filenameTestingSet, glbl_resultsFolder, output_cycle))
+      if (glbl_constraint->maskLength < glbl_nGramLevel->sizeOf_N)
       {
-        errorHandler_print (errorType_Error, "Unable to create testing Set (source: %s)\n", glbl_filenameTestingSet);
+        errorHandler_print (errorType_Error, "The mask must be at least %i chars long.\n", glbl_nGramLevel->sizeOf_N);
         return false;
       }
+      glbl_fixedLenght = glbl_constraint->maskLength;
     }
-  }
-  else
-  {                             // pipe mode active
-    glbl_FP_generatedPasswords = stdout;
-    glbl_verboseMode = false;
-    glbl_simulatedAttMode = false;
+    // the enumeration ends once all matching passwords have been created, so the progress is based on their amount
+    glbl_constraintCount = (glbl_fixedLenght != 0) ? constraint_getCount (glbl_constraint, glbl_fixedLenght, glbl_fixedLenght) : constraint_getCount (glbl_constraint, glbl_nGramLevel->sizeOf_N, MAX_PASSWORD_LENGTH - 1);
+    if (glbl_constraintCount == 0)
+    {
+      errorHandler_print (errorType_Error, "No password matches the mask, fragments and password policy.\n");
+      return false;
+    }
+    if (glbl_constraintCount < glbl_attemptsMax)
+      glbl_progressStep = glbl_constraintCount / 100;
   }
 
-  return true;
-}
+  // ensemble: load the model of each config (the first one has been read above as well, e.g. for the alphabet of the testing set)
+  if (glbl_ensembleMode)
+  {
+    omen_enum_options options = { glbl_fixedLenght, glbl_ignoreEPMode };
 
-bool sort_ngrams ()
-{
+    if (!ensemble_initialize (&glbl_ensemble, glbl_args_info.config_arg, glbl_args_info.weight_given ? glbl_args_info.weight_arg : NULL, glbl_args_info.config_given, &options, glbl_endlessMode ? UINT64_MAX : glbl_attemptsMax, (uint64_t) glbl_args_info.ensembleFilter_arg << 20))
+      return false;
+  }
+
+  // read the log-probabilities for the exact and sorted order
+  if (glbl_exactOrderMode || glbl_sortedLevelMode)
+  {
+    struct_nGrams_initialize (&glbl_nGramProb);
+    if (!read_probFiles (glbl_nGramProb, glbl_alphabet, glbl_filenames, glbl_nGramLevel->sizeOf_N))
+    {
+      errorHandler_print (errorType_Error, "Unable to read the log-probabilities (%s), create them using createNG --exact\n", DEFAULT_FILE_ATTACHMENT_PROB);
+      return false;
+    }
+  }
+  if (glbl_exactOrderMode)
+  {
+    if (glbl_fixedLenght != 0 && (glbl_fixedLenght < glbl_nGramLevel->sizeOf_N || glbl_fixedLenght >= MAX_PASSWORD_LENGTH))
+    {
+      errorHandler_print (errorType_Error, "The fixed length must be in range %i to %i for the exact order.\n", glbl_nGramLevel->sizeOf_N, MAX_PASSWORD_LENGTH - 1);
+      return false;
+    }
+  }
+
+  // read the filter of the passwords to be dropped
+  if (glbl_filenameExclude != NULL)
+  {
+    FILE *fp = NULL;
+    bool readResult = false;
+
+    if (!open_file (&fp, glbl_filenameExclude, NULL, "rb"))
+    {
+      errorHandler_print (errorType_Error, "Can't open the exclusion filter (%s)\n", glbl_filenameExclude);
+      return false;
+    }
+    readResult = bloomFilter_read (&glbl_excludeFilter, fp);
+    fclose (fp);
+    if (!readResult)
+      return false;
+  }
+
+  // compile the rules applied to the created passwords
+  if (glbl_filenameRules != NULL)
+  {
+    if (!ruleEngine_initialize (&glbl_ruleEngine, glbl_filenameRules, glbl_rulesBatch))
+      return false;
+  }
+
+  // if a feedback file is given, start reading the cracked passwords
+  if (glbl_filenameFeedback != NULL)
+  {
+    if (!feedback_open (&glbl_feedback, glbl_filenameFeedback, glbl_args_info.feedbackPotfile_flag))
+      return false;
+  }
+
+  // if ringMode is active, the passwords are only written to the ring
+  if (glbl_ringMode)
+  {
+    if (!candidateRing_create (&glbl_ring, glbl_ringName, glbl_ringSlots, glbl_ringTimeout))
+    {
+      errorHandler_print (errorType_Error, "Unable to create the ring (%s)\n", glbl_ringName);
+      return false;
+    }
+    // SIGTERM stops the producer as well, so the segment is removed on exit
+    struct sigaction sigTermHandler;
+
+    sigTermHandler.sa_handler = sigint_handler;
+    sigemptyset (&sigTermHandler.sa_mask);
+    sigTermHandler.sa_flags = 0;
+    sigaction (SIGTERM, &sigTermHandler, NULL);
+  }
+  // if pipeMode is not active...
+  else if (!glbl_pipeMode)
+  {
+    // .. try to create the basic result file
+    if (!open_file (&glbl_FP_generatedPasswords, glbl_resultsFolder, glbl_usernameMode ? "/guessNumbers.txt" : "/createdPWs.txt", "w"))
+    {
+      errorHandler_print (errorType_Error, "Unable to create result file\n");
+      return false;
+    }
+
+    // ... and if hashCheckMode is active, open the potfile and read the hashes ...
+    if (glbl_hashCheckMode)
+    {
+      if (!open_file (&glbl_FP_potfile, (glbl_filenamePotfile != NULL) ? glbl_filenamePotfile : glbl_resultsFolder, (glbl_filenamePotfile != NULL) ? NULL : "/potfile.txt", "a"))
+      {
+        errorHandler_print (errorType_Error, "Unable to open the potfile\n");
+        return false;
+      }
+      if (!hashChecker_initialize (&glbl_hashChecker, glbl_filenameHashes, glbl_hashType, glbl_hashThreads, glbl_FP_potfile, glbl_verboseFileMode ? glbl_FP_generatedPasswords : NULL))
+      {
+        errorHandler_print (errorType_Error, "Unable to check the hashes (source: %s)\n", glbl_filenameHashes);
+        return false;
+      }
+    }
+
+    // ... and if simulated attack mode is active ...
+    if ((glbl_simulatedAttMode) && (!glbl_alphaBoostingMode))
+    {
+      int output_cycle = (int) (glbl_attemptsMax / DEFAULT_OUTPUT_CYCLE_FACTOR);
+
+      if (output_cycle == 0)
+      {
+        output_cycle = 1;
+      }
+      // ... try to generate testing set based on input file
+      if (!simAtt_generateTestingSet (glbl_filenameTestingSet, glbl_resultsFolder, output_cycle, glbl_alphabet))
+      {
+        errorHandler_print (errorType_Error, "Unable to create testing Set (source: %s)\n", glbl_filenameTestingSet);
+        return false;
+      }
+      // ... and start the threads checking the candidates in batches (if given)
+      if (glbl_simThreads > 0 && !simAtt_startThreads (glbl_simThreads, handle_crackedPassword))
+        return false;
+    }
+  }
+  else
+  {                             // pipe mode active
+    glbl_FP_generatedPasswords = stdout;
+    glbl_verboseMode = false;
+    glbl_simulatedAttMode = false;
+    glbl_subtreeSkipMode = false;
+  }
+
+  // the scored output starts with its magic
+  if (glbl_scoredMode && !scoredStream_writeHeader (glbl_FP_generatedPasswords))
+  {
+    errorHandler_print (errorType_Error, "Unable to write the scored output\n");
+    return false;
+  }
+
+  return true;
+}
+
+bool sort_ngrams ()
+{
 
   int initialBuffer = 1;        // buffer for the dynamic sorted arrays
 
@@ -464,20 +1169,41 @@ bool sort_ngrams ()
     print_settings_enumNG (stdout);
   }
 
-  // initialize sorted nGram struct
-  struct_sortedLastGram_initialize (glbl_maxLevel, &glbl_sortedLastGram, glbl_nGramLevel->sizeOf_N, glbl_alphabet->sizeOf_alphabet, initialBuffer);
+  // the sorted nGram and iP structs may have been attached from the shared model
+  bool sortedAttached = (glbl_sharedModel != NULL && glbl_sharedModel->sortedAttached);
+
+  // initialize sorted nGram struct (the level range mode uses a single array independent of maxLevel instead)
+  if (!glbl_levelRangeMode && !sortedAttached)
+    struct_sortedLastGram_initialize (glbl_maxLevel, &glbl_sortedLastGram, glbl_nGramLevel->sizeOf_N, glbl_alphabet->sizeOf_alphabet);
   // initialize sortedIP struct
-  struct_sortedIP_initialize (glbl_maxLevel, &glbl_sortedIP, initialBuffer);
+  if (!sortedAttached)
+    struct_sortedIP_initialize (glbl_maxLevel, &glbl_sortedIP, initialBuffer);
   // initialize sortedLength struct
   struct_sortedLength_initialize (&glbl_sortedLength);
 
   // sort the given nGram array
-  struct_sortedLastGram_fill (glbl_maxLevel, glbl_sortedLastGram, glbl_nGramLevel->cP, glbl_nGramLevel->sizeOf_cP, glbl_nGramLevel->sizeOf_N, glbl_alphabet->sizeOf_alphabet);
+  if (glbl_levelRangeMode)
+    levelRange_initialize (&glbl_levelRange, glbl_nGramLevel, glbl_alphabet->sizeOf_alphabet, glbl_ignoreEPMode);
+  else if (!sortedAttached)
+    struct_sortedLastGram_fill (glbl_maxLevel, glbl_sortedLastGram, glbl_nGramLevel->cP, glbl_nGramLevel->sizeOf_cP, glbl_nGramLevel->sizeOf_N, glbl_alphabet->sizeOf_alphabet);
   // sort the given iP array
-  struct_sortedIP_fill (glbl_maxLevel, glbl_sortedIP, glbl_nGramLevel->iP, glbl_nGramLevel->sizeOf_iP);
+  if (!sortedAttached)
+    struct_sortedIP_fill (glbl_maxLevel, glbl_sortedIP, glbl_nGramLevel->iP, glbl_nGramLevel->sizeOf_iP);
   // sort given length array
   struct_sortedLength_fill (glbl_sortedLength, glbl_nGramLevel->len, (glbl_nGramLevel->sizeOf_N), glbl_lengthLevelFactor, glbl_lengthLevelSet);
 
+  // the online adaptation moves the entries between the buckets of the sorted arrays
+  if (glbl_adaptAlpha > 0)
+  {
+    if (glbl_levelRangeMode)
+    {
+      errorHandler_print (errorType_Warning, "The online adaptation needs levelChains, which are not used for fine-grained levels. The model is not adapted.\n");
+      glbl_adaptAlpha = 0;
+    }
+    else
+      adaptation_initialize (&glbl_adaptation, glbl_nGramLevel, glbl_alphabet, glbl_maxLevel, glbl_adaptAlpha, glbl_args_info.adaptMax_arg, glbl_ignoreEPMode);
+  }
+
   // input files have been successfully read
   glbl_inputFiles_read = true;
 
@@ -500,7 +1226,7 @@ void progress_init ()
   }
 }
 
-void progress_update ()
+void progress_update (uint64_t attempts)
 {
   static uint64_t counter = 0;  // counter to perform one step
   static int progress = 1;      // steps taken
@@ -509,10 +1235,10 @@ void progress_update ()
 
   if (glbl_verboseMode && !glbl_endlessMode)
   {
-    counter++;
-    if (counter == glbl_progressStep)
+    counter += attempts;
+    while (glbl_progressStep != 0 && counter >= glbl_progressStep)
     {
-      counter = 0;
+      counter -= glbl_progressStep;
       if (glbl_simulatedAttMode)
       {
         printf ("\r<%s%s> %3i %% created (%.1f %% cracked)", progressBar + (20 - (int) (progress / 5)), progressBlank + (int) (progress / 5), progress, glbl_crackedRatio * 100);
@@ -567,12 +1293,10 @@ void run_enumeration ()
   int levelOverall = 0;         // counting the overall level
   int levelOverallMax = 0;      // max value for overall level (maxLevel-1) * MAX_LENGTH + lengthFactos
   int lengthIndex = 0;          // current max index in sortedLength array
+  int frontier[MAX_PASSWORD_LENGTH];  // next level of each length (online adaptation)
 
   int level = 0;                // stores level for current length
 
-  int levelChain[MAX_PASSWORD_LENGTH + 1];  // stores current levelChain
-
-  bool newChain = true;         // true: create a new levelChain, false: create next one based on a given levelChain
   bool runCreation = true;      // control variable to break enumeration loop
 
   /* Length for leveChain and password The levelChain length differs from password length since iP uses one length for N-1 characters in the actual password (and EP uses 1 length in the levelChain as well). */
@@ -596,6 +1320,16 @@ void run_enumeration ()
     // get max index of sorted lengths
     lengthIndex = struct_sortedLength_getMaxIndexForLevel (glbl_sortedLength, levelOverall);
 
+    // adapt the model to the passwords cracked so far (if adaptMode is active)
+    if (glbl_adaptation != NULL)
+    {
+      memset (frontier, 0, sizeof (frontier));
+      for (size_t i = 0; i < lengthIndex; i++)
+        frontier[glbl_sortedLength->length[i]] = levelOverall - glbl_sortedLength->level[i];
+      if (!adapt_levelBoundary (frontier))
+        break;
+    }
+
     // for all lengths with current or smaller level ...
     for (size_t i = 0; i < lengthIndex; i++)
     {
@@ -603,29 +1337,23 @@ void run_enumeration ()
       lengthLC = glbl_sortedLength->length[i] + lengthLCModifier;
       lengthPW = glbl_sortedLength->length[i];
 
+      // constrained enumeration: skip any length outside of the length bounds (or without matching passwords)
+      if (glbl_constraint != NULL && glbl_constraint->candidateCount[lengthPW] == 0)
+        continue;
+
       // get actual level (overall level - level of current length)
       level = levelOverall - glbl_sortedLength->level[i];
 
-      // reset levelChain
-      reset_levelChain (levelChain, lengthLC);
-
-      // new length & level -> new chain
-      newChain = true;
-
-      // get all levelChains for current length and level
-      while (getNext_levelChain (levelChain, lengthLC, level, newChain))
+      // enumerate all PWs for current length and level, returns false if max attempts has been reached
+      if (!enumerate_level (lengthLC, lengthPW, level))
       {
-        newChain = false;
-
-        // enumerate all PWs returns false if max attempts has been reached
-        if (!enumerate_password (levelChain, lengthPW))
-        {
-          i = MAX_PASSWORD_LENGTH;  // jump out of lengthIndex loop
-          runCreation = false;  // stop enumeration loop
-          break;                // break levelChain loop
-        }
+        runCreation = false;    // stop enumeration loop
+        break;                  // break lengthIndex loop
       }
     }
+    // sorted order: handle the passwords of all lengths with the current level
+    if (runCreation && glbl_sortedLevelMode && !flush_sortedLevel ())
+      runCreation = false;
     // increase overall level and check if max possible level is reached
     levelOverall++;
     if (levelOverall > levelOverallMax)
@@ -644,14 +1372,12 @@ void run_enumeration_fixedLenghts ()
   int level = 0;                // counting the overall level
   int levelMax = 0;             // max value for overall level (glbl_maxLevel-1) * MAX_LENGTH + lengthFactos
 
-  int levelChain[MAX_PASSWORD_LENGTH + 1];  // stores current levelChain
-
-  bool newChain = true;         // true: create a new levelChain, false: create next one based on a given levelChain
   bool runCreation = true;      // control variable to break enumeration loop
 
   /* Length for leveChain and password The levelChain length differs from password length since iP uses one length for N-1 characters in the actual password (and EP uses 1 length in the levelChain as well). */
   int lengthLC = 0;             // length of the levelChain
   int lengthPW = 0;             // length of the actual Password
+  int frontier[MAX_PASSWORD_LENGTH] = { 0 };  // next level of each length (online adaptation)
 
   int lengthLCModifier = 3 - glbl_nGramLevel->sizeOf_N; // N-3 if using endProbs, N-2 if not
 
@@ -671,21 +1397,16 @@ void run_enumeration_fixedLenghts ()
 
   while (runCreation)
   {
-    // reset levelChain
-    reset_levelChain (levelChain, lengthLC);
-
-    // new level -> new chain
-    newChain = true;
+    // adapt the model to the passwords cracked so far (if adaptMode is active)
+    frontier[lengthPW] = level;
+    if (!adapt_levelBoundary (frontier))
+      break;
 
-    while (getNext_levelChain (levelChain, lengthLC, level, newChain))
+    // enumerate_level returns false if max attempts has been reached
+    if (!enumerate_level (lengthLC, lengthPW, level) || (glbl_sortedLevelMode && !flush_sortedLevel ()))
     {
-      newChain = false;
-      // enumerate_password returns false if max attempts has been reached
-      if (!enumerate_password (levelChain, lengthPW))
-      {
-        runCreation = false;
-        break;
-      }
+      runCreation = false;
+      break;
     }
 
     // increase level and check if max level has been reached
@@ -701,13 +1422,176 @@ void run_enumeration_fixedLenghts ()
   progress_finish ();
 }                               // run_enumeration_fixedLenghts()
 
+/* (intern function) Sets @crackedLengths to the amount of passwords cracked by length (index: length - 1), reported by the hash checking or the feedback file */
+void get_crackedLengths (uint64_t crackedLengths[MAX_PASSWORD_LENGTH])
+{
+  if (glbl_feedback != NULL)
+    feedback_poll (glbl_feedback);
+  for (int i = 0; i < MAX_PASSWORD_LENGTH; i++)
+  {
+    crackedLengths[i] = 0;
+    if (glbl_feedback != NULL)
+      crackedLengths[i] += glbl_feedback->crackedLengths[i];
+    if (glbl_hashChecker != NULL)
+      crackedLengths[i] += hashChecker_crackedLength (glbl_hashChecker, i + 1);
+  }
+}                               // get_crackedLengths
+
+/* (intern function) Keeps the given crack rate in range ]0, 1[ */
+double limit_crackRate (double crackRate)
+{
+  if (crackRate < 0.0000001)    // should not get too small
+    return 0.0000001;
+  if (crackRate >= 1)           // should not get too large
+    return 0.999999;
+  return crackRate;
+}                               // limit_crackRate
+
+/* (intern function) Credits the given cracked password to the arm which created it (found by its length and initialProb level) */
+void bandit_creditPassword (const char *password, int length)
+{
+  banditScheduler_arm *arm = NULL;
+  int position = 0;
+
+  if (length < glbl_nGramLevel->sizeOf_N)
+    return;
+  // passwords with chars not in the alphabet can't have been created
+  if (!get_positionFromNGram (&position, password, glbl_nGramLevel->sizeOf_N - 1, glbl_alphabet->sizeOf_alphabet, glbl_alphabet->alphabet))
+    return;
+  arm = banditScheduler_getArm (glbl_bandit, length, glbl_nGramLevel->iP[position]);
+  if (arm != NULL)
+    banditScheduler_credit (glbl_bandit, arm, 1);
+}                               // (intern) bandit_creditPassword
+
+/* (intern function) Credits the passwords cracked by the hash checking or the external password cracker (since the last call) */
+void bandit_creditCracked ()
+{
+  char password[MAX_PASSWORD_LENGTH];
+  int length = 0;
+
+  if (glbl_feedback != NULL)
+  {
+    feedback_poll (glbl_feedback);
+    while (feedback_nextCracked (glbl_feedback, password, &length))
+      bandit_creditPassword (password, length);
+  }
+  if (glbl_hashChecker != NULL)
+  {
+    while (hashChecker_nextCracked (glbl_hashChecker, password, &length))
+      bandit_creditPassword (password, length);
+  }
+}                               // (intern) bandit_creditCracked
+
+/* (intern function) Enumerates the levelChains (of length @lengthLC) of the given @arm, until at least glbl_pullSize passwords have been created or the arm is finished. Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool bandit_pullArm (banditScheduler_arm * arm, int lengthLC)
+{
+  uint64_t work = 0;            // created passwords, an empty levelChain counts as one
+  uint64_t old_attemptsCount = 0;
+  bool result = true;
+
+  while (work < (uint64_t) glbl_pullSize)
+  {
+    if (arm->newChain)
+    {
+      reset_levelChain (arm->levelChain, lengthLC);
+      arm->levelChain[0] = arm->iPLevel;
+    }
+    // the levelChains are created in ascending order of their first level
+    if (!getNext_levelChain (arm->levelChain, lengthLC, arm->level, arm->newChain) || arm->levelChain[0] != arm->iPLevel)
+    {
+      if (!banditScheduler_nextLevel (glbl_bandit, arm))
+        return true;            // arm finished
+      continue;
+    }
+    arm->newChain = false;
+
+    old_attemptsCount = glbl_attemptsCount;
+    result = enumerate_password (arm->levelChain, arm->length);
+    banditScheduler_addAttempts (arm, glbl_attemptsCount - old_attemptsCount);
+    work += (glbl_attemptsCount > old_attemptsCount) ? glbl_attemptsCount - old_attemptsCount : 1;
+    if (!result)
+      return false;
+  }
+  return true;
+}                               // (intern) bandit_pullArm
+
+// Main process: enumerates the passwords pulling the arms chosen by the bandit
+void run_enumeration_bandit ()
+{
+  banditScheduler_arm *arm = NULL;
+  uint64_t old_crackedCount;
+  int lengthLevel[MAX_PASSWORD_LENGTH] = { 0 };
+  bool runCreation = true;      // control variable to break enumeration loop
+  int lengthLCModifier = (glbl_ignoreEPMode ? 2 : 3) - glbl_nGramLevel->sizeOf_N; // N-3 if using endProbs, N-2 if not
+
+  if (glbl_levelRangeMode)
+  {
+    errorHandler_print (errorType_Warning, "The bandit scheduler needs levelChains, which are not used for fine-grained levels. Using the optimized length scheduling instead.\n");
+    glbl_banditMode = false;
+    run_enumeration_optimizedLengths ();
+    return;
+  }
+
+  // the arms start in the order of the normal enumeration (levelChain and length level)
+  for (int i = 0; i < MAX_PASSWORD_LENGTH - glbl_sortedLength->lengthMin; i++)
+    lengthLevel[glbl_sortedLength->length[i]] = glbl_sortedLength->level[i];
+  banditScheduler_initialize (&glbl_bandit, glbl_nGramLevel->sizeOf_N, MAX_PASSWORD_LENGTH - 1, glbl_maxLevel, lengthLCModifier, lengthLevel);
+  // arms without any (allowed) initialProb of their level can't create any password
+  for (int iPLevel = 0; iPLevel < glbl_maxLevel; iPLevel++)
+  {
+    for (int length = glbl_nGramLevel->sizeOf_N; length < MAX_PASSWORD_LENGTH; length++)
+    {
+      int sizeOf_iP = glbl_sortedIP[iPLevel].indexCur;
+
+      if (glbl_constraint != NULL && glbl_constraint->candidateCount[length] == 0)
+        sizeOf_iP = 0;
+      else if (glbl_constraint != NULL)
+        constraint_getIP (glbl_constraint, glbl_sortedIP, glbl_maxLevel, glbl_nGramLevel->sizeOf_N, length, iPLevel, &sizeOf_iP);
+      if (sizeOf_iP == 0)
+        banditScheduler_finish (glbl_bandit, banditScheduler_getArm (glbl_bandit, length, iPLevel));
+    }
+  }
+
+  progress_init ();
+  while (runCreation)
+  {
+    arm = banditScheduler_select (glbl_bandit);
+    if (arm == NULL)
+    {
+      // no more levelChains, stop enumeration
+      errorHandler_print (errorType_Warning, "All possible LevelChains have been created.\n");
+      break;
+    }
+
+    // store old cracked count
+    old_crackedCount = glbl_crackedCount;
+
+    // enumerate a bounded amount of PWs of the arm, returns false if max attempts has been reached
+    if (!bandit_pullArm (arm, arm->length + lengthLCModifier) || (glbl_sortedLevelMode && !flush_sortedLevel ()))
+    {
+      runCreation = false;      // stop enumeration loop
+    }
+
+    // the simulated attack cracks immediately (once its checking threads are done), hash checking and external password crackers report later
+    if (!simAtt_flush ())
+      exit (EXIT_SUCCESS);    // all passwords cracked, like simAtt_checkCandidate
+    banditScheduler_update (glbl_bandit, arm, glbl_crackedCount - old_crackedCount);
+    bandit_creditCracked ();
+  }
+
+  progress_finish ();
+}                               // run_enumeration_bandit
+
 // Main process: calculates levelChains and generates passwords
 void run_enumeration_optimizedLengths ()
 {
-  // int level = 0; // stores level for current length
-  int levelChain[MAX_PASSWORD_LENGTH + 1];  // stores current levelChain
+  if (glbl_banditMode)
+  {
+    run_enumeration_bandit ();
+    return;
+  }
 
-  bool newChain = true;         // true: create a new levelChain, false: create next one based on a given levelChain
+  // int level = 0; // stores level for current length
   bool runCreation = true;      // control variable to break enumeration loop
 
   // variables for old length scheduling
@@ -716,6 +1600,13 @@ void run_enumeration_optimizedLengths ()
   int old_attemptsCount, old_crackedCount, cur_attemptsCount;
   int lengthsReachedMax = 0;
 
+  // variables for cracks reported with a delay (hash checking, feedback file)
+  bool reportedCracks = (glbl_hashChecker != NULL || glbl_feedback != NULL);
+  uint64_t crackedLengths[MAX_PASSWORD_LENGTH]; // cracked passwords by length (index: length - 1)
+  uint64_t lengthCrackedStart[MAX_PASSWORD_LENGTH] = { 0 };  // cracked passwords when the last step of the length started
+  int lengthAttempts[MAX_PASSWORD_LENGTH] = { 0 }; // attempts of the last step of the length
+  int frontier[MAX_PASSWORD_LENGTH];  // next level of each length (online adaptation)
+
   /* Length for leveChain and password The levelChain length differs from password length since iP uses one length for N-1 characters in the actual password (and EP uses 1 length in the levelChain as well). */
   int lengthLC = 0;             // length of the levelChain
   int lengthPW = 0;             // length of the actual Password
@@ -731,6 +1622,9 @@ void run_enumeration_optimizedLengths ()
   {
     lenghtLevel[i] = 0;
     lengthCrackRate[i] = 1;     // schedule each at least once...
+    // ... unless it is outside of the length bounds (constrained enumeration)
+    if (glbl_constraint != NULL && glbl_constraint->candidateCount[i] == 0)
+      lengthCrackRate[i] = 0;
   }
   lengthCrackRate[0] = 0;
 
@@ -748,261 +1642,1495 @@ void run_enumeration_optimizedLengths ()
     }
     lengthLC = lengthPW + lengthLCModifier;
 
+    // adapt the model to the passwords cracked so far (if adaptMode is active, finished lengths are skipped)
+    if (glbl_adaptation != NULL)
+    {
+      for (size_t i = 0; i < MAX_PASSWORD_LENGTH; i++)
+        frontier[i] = (lengthCrackRate[i] != 0) ? lenghtLevel[i] : 0;
+      if (!adapt_levelBoundary (frontier))
+        break;
+    }
+
     // store old cracked and attempt counts
     old_attemptsCount = glbl_attemptsCount;
     old_crackedCount = glbl_crackedCount;
-
-    // reset levelChain
-    reset_levelChain (levelChain, lengthLC);
-
-    // new length and/or level -> new chain
-    newChain = true;
-
-    // get all levelChains for current length and level
-    while (getNext_levelChain (levelChain, lengthLC, lenghtLevel[lengthPW], newChain))
+    if (reportedCracks)
     {
-      newChain = false;
+      get_crackedLengths (crackedLengths);
+      lengthCrackedStart[lengthPW] = crackedLengths[lengthPW - 1];
+    }
 
-      // enumerate all PWs returns false if max attempts has been reached
-      if (!enumerate_password (levelChain, lengthPW))
-      {
-        runCreation = false;    // stop enumeration loop
-        break;                  // break levelChain loop
-      }
+    // enumerate all PWs for current length and level, returns false if max attempts has been reached
+    if (!enumerate_level (lengthLC, lengthPW, lenghtLevel[lengthPW]) || (glbl_sortedLevelMode && !flush_sortedLevel ()))
+    {
+      runCreation = false;      // stop enumeration loop
     }
-    // adjust crack rate
+    // adjust crack rate (including the candidates still checked by the threads of the simulated attack)
+    if (!simAtt_flush ())
+      exit (EXIT_SUCCESS);    // all passwords cracked, like simAtt_checkCandidate
     cur_attemptsCount = (glbl_attemptsCount - old_attemptsCount);
     if (cur_attemptsCount == 0)
     {
       cur_attemptsCount = 1;
     }
-    lengthCrackRate[lengthPW] = (float) (glbl_crackedCount - old_crackedCount) / (float) (cur_attemptsCount);
-    if (lengthCrackRate[lengthPW] < 0.0000001)  // should not get too small
+    if (reportedCracks)
+    {
+      // the cracks are reported with a delay (hashing threads, external cracker):
+      // credit every crack to the last enumeration step of its length
+      lengthAttempts[lengthPW] = cur_attemptsCount;
+      get_crackedLengths (crackedLengths);
+      for (size_t i = glbl_nGramLevel->sizeOf_N; i < MAX_PASSWORD_LENGTH; i++)
+      {
+        if (lengthAttempts[i] != 0 && lengthCrackRate[i] != 0)  // already scheduled and not finished
+          lengthCrackRate[i] = limit_crackRate ((float) (crackedLengths[i - 1] - lengthCrackedStart[i]) / (float) (lengthAttempts[i]));
+      }
+    }
+    else
+    {
+      lengthCrackRate[lengthPW] = limit_crackRate ((float) (glbl_crackedCount - old_crackedCount) / (float) (cur_attemptsCount));
+    }
+
+    if (lenghtLevel[lengthPW] >= ((glbl_maxLevel - 1) * lengthPW))
+    {                           // reached highest supported level
+      errorHandler_print (errorType_Warning, "All possible LevelChains for length %i have been created.\n", lengthPW);
+      lengthCrackRate[lengthPW] = 0;  // prevent it from getting scheduled again
+      lengthsReachedMax++;
+    }
+    else
+    {
+      lenghtLevel[lengthPW]++;
+    }
+
+    if (lengthsReachedMax >= MAX_PASSWORD_LENGTH)
+    {
+      // no more levelChains, stop enumeration
+      errorHandler_print (errorType_Warning, "All possible LevelChains have been created.\n");
+      runCreation = false;
+    }
+  }
+
+  progress_finish ();
+}                               // run_enumeration
+
+// set levelChain to the next one
+bool getNext_levelChain (int levelChain[MAX_PASSWORD_LENGTH], int length, int levelMax, bool newChain)
+{
+  return levelChain_getNext (levelChain, length, levelMax, glbl_maxLevel, newChain);
+}                               // getNext_levelChains
+
+/* (intern function) Returns the fixed point log-probability of the given password of length @length (length, initialProb, conditionalProbs and endProb) */
+int sorted_logProb (int passwordAsInt[MAX_PASSWORD_LENGTH], int length)
+{
+  int sizeOf_alphabet = glbl_alphabet->sizeOf_alphabet;
+  int position = 0;
+  int cost = 0;
+
+  get_positionFromNGramAsInt (&position, passwordAsInt, (glbl_nGramLevel->sizeOf_N - 1), sizeOf_alphabet);
+  cost = glbl_nGramProb->len[length] + glbl_nGramProb->iP[position];
+  for (size_t i = glbl_nGramLevel->sizeOf_N - 1; i < length; i++)
+  {
+    cost += glbl_nGramProb->cP[position * sizeOf_alphabet + passwordAsInt[i]];
+    // the position of the next mGram drops the first char and appends the lastGram
+    position = (position % (glbl_nGramLevel->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet + passwordAsInt[i];
+  }
+  if (!glbl_ignoreEPMode)
+    cost += glbl_nGramProb->eP[position];
+  return cost;
+}                               // (intern) sorted_logProb
+
+/* (intern function) Adds the given password to the queue of the current level (see flush_sortedLevel). Returns false if the queue can't be spilled. */
+bool sorted_bufferPassword (int passwordAsInt[MAX_PASSWORD_LENGTH], int length)
+{
+  probQueue_entry entry;
+
+  if (glbl_levelQueue == NULL)
+    probQueue_initialize (&glbl_levelQueue, glbl_queueSize);
+
+  entry.priority = sorted_logProb (passwordAsInt, length);
+  entry.cost = entry.priority;
+  entry.next = 0;
+  entry.length = length;
+  entry.depth = length;
+  for (size_t i = 0; i < length; i++)
+    entry.prefix[i] = passwordAsInt[i];
+  return probQueue_push (glbl_levelQueue, &entry);
+}                               // (intern) sorted_bufferPassword
+
+/* (intern function) Returns the level of the given password of length @length (initialProb, conditionalProbs, endProb and, unless a fixed length is set, the level of the length) */
+int scored_level (int passwordAsInt[MAX_PASSWORD_LENGTH], int length)
+{
+  int sizeOf_alphabet = glbl_alphabet->sizeOf_alphabet;
+  int position = 0;
+  int level = 0;
+
+  get_positionFromNGramAsInt (&position, passwordAsInt, (glbl_nGramLevel->sizeOf_N - 1), sizeOf_alphabet);
+  level = glbl_nGramLevel->iP[position];
+  for (size_t i = glbl_nGramLevel->sizeOf_N - 1; i < length; i++)
+  {
+    level += glbl_nGramLevel->cP[position * sizeOf_alphabet + passwordAsInt[i]];
+    position = (position % (glbl_nGramLevel->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet + passwordAsInt[i];
+  }
+  if (!glbl_ignoreEPMode)
+    level += glbl_nGramLevel->eP[position];
+  if (glbl_fixedLenght == 0)
+  {
+    for (size_t i = 0; i < MAX_PASSWORD_LENGTH - glbl_sortedLength->lengthMin; i++)
+      if (glbl_sortedLength->length[i] == length)
+        return level + glbl_sortedLength->level[i];
+  }
+  return level;
+}                               // (intern) scored_level
+
+/* (intern function) Writes the given password to the ring (ringMode) or adds it to the password file (stdout in pipeMode), as binary record with its @level in scoredMode. */
+void output_password (const char *passwordAsChar, int length, int level)
+{
+  if (glbl_ringMode)
+  {
+    // stopped by a signal or no consumer left, exit_routine removes the ring
+    if (!candidateRing_push (glbl_ring, passwordAsChar, length))
+    {
+      if (glbl_ringSignal != 0 && glbl_verboseMode)
+        fprintf (stderr, "\nExiting ok...\n");
+      exit (glbl_ringSignal != 0 ? 2 : EXIT_FAILURE);
+    }
+  }
+  else if (glbl_scoredMode)
+    scoredStream_write (glbl_FP_generatedPasswords, level, passwordAsChar, length);
+  else
+    fprintf (glbl_FP_generatedPasswords, "%s\n", passwordAsChar);
+}                               // (intern) output_password
+
+/* (intern function) Returns TRUE (printing a warning) if all passwords matching the constraints have been created or dropped by the exclusion filter. */
+bool handle_constraintsDone ()
+{
+  if (glbl_constraint != NULL && glbl_attemptsCount + glbl_excludedCount == glbl_constraintCount)
+  {
+    errorHandler_print (errorType_Warning, "All passwords matching the constraints have been created.\n");
+    return true;
+  }
+  return false;
+}                               // (intern) handle_constraintsDone
+
+// handles a cracked password of the simulated attack
+void handle_crackedPassword (const char *passwordAsChar, int length, uint64_t attempt)
+{
+  // ... adapt the model to the cracked PW at the next level boundary (if adaptMode is active)
+  if (glbl_adaptation != NULL)
+    adaptation_addCracked (glbl_adaptation, passwordAsChar, length);
+  // ... and print any cracked PW (if verboseFileMode is active)
+  // fprintf(glbl_FP_generatedPasswords, "%s\n", passwordAsChar);
+  // ... for analysis, prints the guess attempts
+  if (glbl_verboseFileMode)
+    fprintf (glbl_FP_generatedPasswords, "%s, %" PRIu64 "\n", passwordAsChar, attempt);
+}                               // handle_crackedPassword
+
+/* (intern function) Handles a candidate (as char, with its @level for the scoredMode) based on the selected mode, i.e.: - if simulatedAttMode is active, the PW is checked against the testing set - if pipeMode is active, the PW is printed to stdout - in defaultMode the PW is added to the password file Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool handle_candidate (const char *passwordAsChar, int length, int level)
+{
+  // drop any password of the earlier attacks (without counting it as attempt)
+  if (glbl_excludeFilter != NULL && bloomFilter_contains (glbl_excludeFilter, passwordAsChar, length))
+  {
+    glbl_excludedCount++;
+    return !handle_constraintsDone ();
+  }
+
+  // adjust counter
+  glbl_attemptsCount++;
+  glbl_createdLengths[length - 1]++;
+
+  // if simulated attack mode is active...
+  if (glbl_alphaBoostingMode)
+  {
+    if (glbl_simulatedAttMode)
+    {
+      if (simAtt_boostCheckCandidate (passwordAsChar, length))
+      {
+        if (glbl_verboseFileMode)
+        {
+          fprintf (glbl_FP_generatedPasswords, "%s, %" PRIu64 "\n", passwordAsChar, glbl_attemptsCount);
+        }
+        return false;           // return false here means: we are finished with enumerating
+      }
+    }
+    else
+    {
+      // pipe, ring or normal mode
+      output_password (passwordAsChar, length, level);
+    }
+  }
+  else if (glbl_simulatedAttMode)
+  {
+    // ...check candidate (by the checking threads, reporting the cracked ones with their guess number later)
+    if (glbl_simThreads > 0)
+      simAtt_addCandidate (passwordAsChar, length);
+    else if (simAtt_checkCandidate (passwordAsChar, length))
+      handle_crackedPassword (passwordAsChar, length, glbl_attemptsCount);
+  }
+  else if (glbl_hashCheckMode)
+  {
+    // ...hash the candidate (in batches by the hashChecker threads) and stop once all hashes are cracked
+    if (!hashChecker_add (glbl_hashChecker, passwordAsChar, length, glbl_attemptsCount))
+      return false;
+  }
+  else
+  {
+    // pipe, ring or normal mode
+    output_password (passwordAsChar, length, level);
+  }
+
+  // print the progress (if verboseMode is active)
+  progress_update (1);
+
+  // if endlessMode is deactivated and current attempts equals max attempts, end run through
+  if (!glbl_endlessMode && glbl_attemptsCount == glbl_attemptsMax)
+    return false;
+
+  // constrained enumeration: all passwords matching the constraints have been created
+  if (handle_constraintsDone ())
+    return false;
+
+  // else continue run through
+  return true;
+}                               // (intern) handle_candidate
+
+// applies the rules to the passwords of the current batch
+bool handle_ruleBatch ()
+{
+  bool result = true;
+
+  for (int rule = 0; rule < glbl_ruleEngine->sizeOf_rules && result; rule++)
+  {
+    ruleEngine_applyBatch (glbl_ruleEngine, rule);
+    for (int i = 0; i < glbl_ruleEngine->sizeOf_batch && result; i++)
+    {
+      if (glbl_ruleEngine->resultLength[i] > 0)
+        result = handle_candidate (glbl_ruleEngine->results + (size_t) i * MAX_PASSWORD_LENGTH, glbl_ruleEngine->resultLength[i], glbl_ruleEngine->batchLevel[i]);
+    }
+  }
+  ruleEngine_clear (glbl_ruleEngine);
+  return result;
+}                               // handle_ruleBatch
+
+/* (intern function) Handles a enumerated password (as char, with its @level for the scoredMode): the password is added to the batch of the rules (if given), which are applied once the batch is full, or handled directly (see handle_candidate). Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool handle_passwordAsChar (const char *passwordAsChar, int length, int level)
+{
+  if (glbl_ruleEngine != NULL)
+  {
+    if (ruleEngine_add (glbl_ruleEngine, passwordAsChar, length, level))
+      return handle_ruleBatch ();
+    return true;
+  }
+  return handle_candidate (passwordAsChar, length, level);
+}                               // (intern) handle_passwordAsChar
+
+/* (intern function) Handles a enumerated password (see handle_passwordAsChar), unless the sorted level order keeps it until its level is complete. Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool handle_createdPassword (int passwordAsInt[MAX_PASSWORD_LENGTH], int levelChain[MAX_PASSWORD_LENGTH], int length)
+{
+  char passwordAsChar[length + 1];
+
+  // sorted level order: keep the password until its level is complete
+  if (glbl_sortedLevelMode && !glbl_levelQueueFlushing)
+    return sorted_bufferPassword (passwordAsInt, length);
+
+  // create the corresponding password as char
+  for (size_t i = 0; i < length; i++)
+  {
+    get_charAtPosition (passwordAsChar + i, passwordAsInt[i], glbl_alphabet->alphabet, glbl_alphabet->sizeOf_alphabet);
+  }
+  passwordAsChar[length] = '\0';
+
+  return handle_passwordAsChar (passwordAsChar, length, glbl_scoredMode ? scored_level (passwordAsInt, length) : 0);
+}                               // (intern) handle_password
+
+/* (intern function) Returns TRUE if @symbol is @allowed at position @lengthCur of a password of @lengthMax and the constraints can still be matched, storing the state of the new prefix. */
+bool enumerate_constraintAppend (const bool *allowed, int symbol, int lengthCur, int lengthMax)
+{
+  if (!allowed[symbol])
+    return false;
+  glbl_constraintState[lengthCur + 1] = constraint_next (glbl_constraint, glbl_constraintState[lengthCur], symbol, lengthMax, lengthCur);
+  return glbl_constraintState[lengthCur + 1] >= 0;
+}                               // (intern) enumerate_constraintAppend
+
+/* (intern function) Recursively generates all passwords based on the current levelChain and the previous password characters. If a password has been found, enumerate_password_handleCandidate is used to evaluate the password based on the selected mode Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool enumerate_password_recursivly (int passwordAsInt[MAX_PASSWORD_LENGTH], int levelChain[MAX_PASSWORD_LENGTH], int lengthCur, int lengthMax)
+{
+  int position = 0;
+  int level = 0;
+
+  // get position of the mGram
+  get_positionFromNGramAsInt (&position, passwordAsInt + (lengthCur - (glbl_nGramLevel->sizeOf_N - 1)), (glbl_nGramLevel->sizeOf_N - 1), glbl_alphabet->sizeOf_alphabet);
+
+  /* get current level from the levelChain (need to be adjusted by sizeOf_N since iP take 1 level from levelChain, but N-1 characters in the Password) */
+  level = levelChain[lengthCur - (glbl_nGramLevel->sizeOf_N - 2)];
+
+  // length of new PW equals max length
+  if (lengthCur == lengthMax)
+  {
+    // check if the level match the endProp
+    if (!glbl_ignoreEPMode)
+    {
+      if (level != glbl_nGramLevel->eP[position])
+        return true;
+    }
+    return handle_createdPassword (passwordAsInt, levelChain, lengthCur);
+  }
+  else
+  {                             // lengthCur != lengthMax
+    const bool *allowed = (glbl_constraint != NULL) ? constraint_getAllowed (glbl_constraint, lengthMax, lengthCur) : NULL;
+
+    // for each lastGram with current @level and @position
+    for (size_t i = glbl_sortedLastGram[level].indexStart[position]; i < glbl_sortedLastGram[level].indexStart[position + 1]; i++)
+    {
+      // constrained enumeration: skip any lastGram not allowed at this position (or not leading to a matching password)
+      if (allowed != NULL && !enumerate_constraintAppend (allowed, glbl_sortedLastGram[level].lastGrams[i], lengthCur, lengthMax))
+        continue;
+      // add lastGram as int to the PW
+      passwordAsInt[lengthCur] = glbl_sortedLastGram[level].lastGrams[i];
+      // call recursive function with length + 1
+      if (!enumerate_password_recursivly (passwordAsInt, levelChain, lengthCur + 1, lengthMax))
+        return false;
+    }
+    return true;
+  }
+}                               // (intern) enumerate_password_recursivly
+
+/* (intern function) Accounts @count skipped candidates of the given @length like handle_createdPassword does for a single candidate (see simAtt_skipCandidates). Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool handle_skippedPasswords (uint64_t count, int length)
+{
+  bool result = true;
+
+  if (count == 0)
+    return true;
+
+  // never exceed max attempts (if endlessMode is deactivated)
+  if (!glbl_endlessMode && count >= glbl_attemptsMax - glbl_attemptsCount)
+  {
+    count = glbl_attemptsMax - glbl_attemptsCount;
+    result = false;
+  }
+
+  // adjust counter
+  glbl_attemptsCount += count;
+  glbl_createdLengths[length - 1] += count;
+
+  // add the graph points of the skipped attempts
+  simAtt_skipCandidates (count, length);
+
+  // print the progress (if verboseMode is active)
+  progress_update (count);
+
+  return result;
+}                               // (intern) handle_skippedPasswords
+
+/* (intern function) Returns the amount of candidates enumerate_password_recursivly creates for the current levelChain starting with a prefix of length @lengthCur, whose last (n-1) chars are at @position. The counts are cached for the current levelChain (identified by glbl_subtreeStampCur). */
+uint64_t count_subtreeCandidates (int levelChain[MAX_PASSWORD_LENGTH], int lengthCur, int lengthMax, int position)
+{
+  int level = 0;
+  uint64_t count = 0;
+  uint64_t subtree = 0;
+  int sizeOf_alphabet = glbl_alphabet->sizeOf_alphabet;
+
+  // length of new PW equals max length
+  if (lengthCur == lengthMax)
+  {
+    // check if the level match the endProp
+    if (!glbl_ignoreEPMode && levelChain[lengthCur - (glbl_nGramLevel->sizeOf_N - 2)] != glbl_nGramLevel->eP[position])
+      return 0;
+    return 1;
+  }
+
+  // count already calculated for the current levelChain
+  if (glbl_subtreeStamp[lengthCur][position] == glbl_subtreeStampCur)
+    return glbl_subtreeCount[lengthCur][position];
+
+  level = levelChain[lengthCur - (glbl_nGramLevel->sizeOf_N - 2)];
+  for (size_t i = glbl_sortedLastGram[level].indexStart[position]; i < glbl_sortedLastGram[level].indexStart[position + 1]; i++)
+  {
+    // the position of the next mGram drops the first char and appends the lastGram
+    subtree = count_subtreeCandidates (levelChain, lengthCur + 1, lengthMax, (position % (glbl_nGramLevel->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet + glbl_sortedLastGram[level].lastGrams[i]);
+    // saturate instead of overflow (endless mode only)
+    count = (count > UINT64_MAX - subtree) ? UINT64_MAX : count + subtree;
+  }
+
+  glbl_subtreeStamp[lengthCur][position] = glbl_subtreeStampCur;
+  glbl_subtreeCount[lengthCur][position] = count;
+  return count;
+}                               // (intern) count_subtreeCandidates
+
+/* (intern function) Works like enumerate_password_recursivly, but only descends into prefixes stored in the prefix trie of the testing set (@node is the trie node of the current prefix, @position the position of its last (n-1) chars). Any other subtree is skipped and only its candidates are counted. Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool enumerate_password_skipping (int passwordAsInt[MAX_PASSWORD_LENGTH], int levelChain[MAX_PASSWORD_LENGTH], int lengthCur, int lengthMax, int position, int node)
+{
+  int level = 0;
+  int lastGram = 0;
+  int nextPosition = 0;
+  int child = 0;
+  int sizeOf_alphabet = glbl_alphabet->sizeOf_alphabet;
+
+  level = levelChain[lengthCur - (glbl_nGramLevel->sizeOf_N - 2)];
+
+  // length of new PW equals max length
+  if (lengthCur == lengthMax)
+  {
+    // check if the level match the endProp
+    if (!glbl_ignoreEPMode)
+    {
+      if (level != glbl_nGramLevel->eP[position])
+        return true;
+    }
+    return handle_createdPassword (passwordAsInt, levelChain, lengthCur);
+  }
+
+  // for each lastGram with current @level and @position
+  for (size_t i = glbl_sortedLastGram[level].indexStart[position]; i < glbl_sortedLastGram[level].indexStart[position + 1]; i++)
+  {
+    lastGram = glbl_sortedLastGram[level].lastGrams[i];
+    nextPosition = (position % (glbl_nGramLevel->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet + lastGram;
+    child = simAtt_trieChild (node, lastGram);
+
+    if (child == SIMATT_TRIE_NONE)
+    {
+      // no testing set password starts with this prefix
+      if (!handle_skippedPasswords (count_subtreeCandidates (levelChain, lengthCur + 1, lengthMax, nextPosition), lengthMax))
+        return false;
+    }
+    else
+    {
+      // add lastGram as int to the PW and call recursive function with length + 1
+      passwordAsInt[lengthCur] = lastGram;
+      if (!enumerate_password_skipping (passwordAsInt, levelChain, lengthCur + 1, lengthMax, nextPosition, child))
+        return false;
+    }
+  }
+  return true;
+}                               // (intern) enumerate_password_skipping
+
+/* (intern function) enumerate_password for the subtreeSkipMode */
+bool enumerate_password_subtreeSkipMode (int levelChain[MAX_PASSWORD_LENGTH], int lengthMax)
+{
+  int passwordAsInt[MAX_PASSWORD_LENGTH];
+  int iP_level = levelChain[0]; // the first level of the levelChain is for the initialProb
+  int lengthCur = (glbl_nGramLevel->sizeOf_N - 1);  // the initial lengths equals the size of N - 1 (size of the initialProb)
+  int position = 0;
+
+  memset (passwordAsInt, 0, sizeof (passwordAsInt));
+
+  // look up the trie node of each initialProb once
+  if (glbl_subtreeIPNode == NULL)
+  {
+    glbl_subtreeIPNode = (int *) malloc (glbl_nGramLevel->sizeOf_iP * sizeof (int));
+    EXIT_IF_NULL (glbl_subtreeIPNode);
+    for (size_t i = 0; i < glbl_nGramLevel->sizeOf_iP; i++)
+    {
+      get_nGramAsIntFromPosition (passwordAsInt, i, lengthCur, glbl_alphabet->sizeOf_alphabet);
+      glbl_subtreeIPNode[i] = SIMATT_TRIE_ROOT;
+      for (size_t j = 0; j < lengthCur && glbl_subtreeIPNode[i] != SIMATT_TRIE_NONE; j++)
+        glbl_subtreeIPNode[i] = simAtt_trieChild (glbl_subtreeIPNode[i], passwordAsInt[j]);
+    }
+  }
+
+  // allocate the subtree counts for all needed prefix lengths
+  for (size_t i = lengthCur; i < lengthMax; i++)
+  {
+    if (glbl_subtreeCount[i] == NULL)
+    {
+      glbl_subtreeCount[i] = (uint64_t *) malloc (glbl_nGramLevel->sizeOf_iP * sizeof (uint64_t));
+      EXIT_IF_NULL (glbl_subtreeCount[i]);
+      glbl_subtreeStamp[i] = (uint32_t *) calloc (glbl_nGramLevel->sizeOf_iP, sizeof (uint32_t));
+      EXIT_IF_NULL (glbl_subtreeStamp[i]);
+    }
+  }
+
+  // new levelChain -> invalidate all cached counts (reset the stamps on overflow)
+  glbl_subtreeStampCur++;
+  if (glbl_subtreeStampCur == 0)
+  {
+    for (size_t i = 0; i < MAX_PASSWORD_LENGTH; i++)
+    {
+      if (glbl_subtreeStamp[i] != NULL)
+        memset (glbl_subtreeStamp[i], 0, glbl_nGramLevel->sizeOf_iP * sizeof (uint32_t));
+    }
+    glbl_subtreeStampCur = 1;
+  }
+
+  // for each initialProb with the given @iP_level
+  for (size_t i = 0; i < glbl_sortedIP[iP_level].indexCur; i++)
+  {
+    position = glbl_sortedIP[iP_level].iP[i];
+
+    if (glbl_subtreeIPNode[position] == SIMATT_TRIE_NONE)
+    {
+      // no testing set password starts with this initialProb
+      if (!handle_skippedPasswords (count_subtreeCandidates (levelChain, lengthCur, lengthMax, position), lengthMax))
+        return false;
+    }
+    else
+    {
+      // set the first (sizeOf_N - 1) int according to the position stored in sortedIp
+      get_nGramAsIntFromPosition (passwordAsInt, position, lengthCur, glbl_alphabet->sizeOf_alphabet);
+      if (!enumerate_password_skipping (passwordAsInt, levelChain, lengthCur, lengthMax, position, glbl_subtreeIPNode[position]))
+        return false;
+    }
+  }
+  return true;
+}                               // (intern) enumerate_password_subtreeSkipMode
+
+// generates passwords based on the given levelChain and length
+bool enumerate_password (int levelChain[MAX_PASSWORD_LENGTH], int lengthMax)
+{
+  int passwordAsInt[MAX_PASSWORD_LENGTH];
+
+  // simulated attack: skip any candidate not matching a prefix of the testing set
+  if (glbl_subtreeSkipMode)
+    return enumerate_password_subtreeSkipMode (levelChain, lengthMax);
+
+  memset (passwordAsInt, 0, sizeof (passwordAsInt));
+
+  int iP_level = levelChain[0]; // the first level of the levelChain is for the initialProb
+  int lengthCur = (glbl_nGramLevel->sizeOf_N - 1);  // the initial lengths equals the size of N - 1 (size of the initialProb)
+  const int *iP = glbl_sortedIP[iP_level].iP;
+  int sizeOf_iP = glbl_sortedIP[iP_level].indexCur;
+
+  // constrained enumeration: only the initialProbs matching the constraints
+  if (glbl_constraint != NULL)
+    iP = constraint_getIP (glbl_constraint, glbl_sortedIP, glbl_maxLevel, glbl_nGramLevel->sizeOf_N, lengthMax, iP_level, &sizeOf_iP);
+
+  // for each initialProb with the given @iP_level
+  for (size_t i = 0; i < sizeOf_iP; i++)
+  {
+    // set the first (sizeOf_N - 1) int according to the position stored in sortedIp
+    get_nGramAsIntFromPosition (passwordAsInt, iP[i], (glbl_nGramLevel->sizeOf_N - 1), glbl_alphabet->sizeOf_alphabet);
+    // constrained enumeration: the state of the first chars
+    if (glbl_constraint != NULL)
+      constraint_checkPrefix (glbl_constraint, passwordAsInt, lengthCur, lengthMax, glbl_constraintState);
+    // call the recursive function
+    if (!enumerate_password_recursivly (passwordAsInt, levelChain, lengthCur, lengthMax))
+      return false;
+  }
+  return true;
+}                               // enumerate_password_iP
+
+/* (intern function) Works like enumerate_password_recursivly, but without a levelChain: the remaining @level must be distributed on the remaining chars (and the endProb) of the prefix of length @lengthCur, whose last (n-1) chars are at @position. Only subtrees whose level range contains the remaining level are visited. Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool range_enumeratePassword (int passwordAsInt[MAX_PASSWORD_LENGTH], int lengthCur, int lengthMax, int position, int level)
+{
+  int sizeOf_alphabet = glbl_alphabet->sizeOf_alphabet;
+  const unsigned short *lastGrams = glbl_levelRange->lastGrams + position * sizeOf_alphabet;
+  const int *cP = glbl_nGramLevel->cP + position * sizeOf_alphabet;
+  const int *levelMin = NULL;
+  const int *levelMax = NULL;
+  const bool *allowed = NULL;   // allowed symbols (constrained enumeration only)
+  int levelCur = 0;
+  int nextPosition = 0;
+
+  // length of new PW equals max length (the level range ensures the endProb matches the remaining level)
+  if (lengthCur == lengthMax)
+    return handle_createdPassword (passwordAsInt, NULL, lengthCur);
+
+  levelRange_getRest (glbl_levelRange, lengthMax - lengthCur - 1, &levelMin, &levelMax);
+  if (glbl_constraint != NULL)
+    allowed = constraint_getAllowed (glbl_constraint, lengthMax, lengthCur);
+
+  // for each lastGram (ascending by level) not exceeding the remaining level
+  for (size_t i = 0; i < sizeOf_alphabet; i++)
+  {
+    levelCur = cP[lastGrams[i]];
+    if (levelCur > level)
+      break;
+    if (allowed != NULL && !enumerate_constraintAppend (allowed, lastGrams[i], lengthCur, lengthMax))
+      continue;
+    // the position of the next mGram drops the first char and appends the lastGram
+    nextPosition = (position % (glbl_nGramLevel->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet + lastGrams[i];
+    if (level - levelCur < levelMin[nextPosition] || level - levelCur > levelMax[nextPosition])
+      continue;
+    // add lastGram as int to the PW and call recursive function with length + 1
+    passwordAsInt[lengthCur] = lastGrams[i];
+    if (!range_enumeratePassword (passwordAsInt, lengthCur + 1, lengthMax, nextPosition, level - levelCur))
+      return false;
+  }
+  return true;
+}                               // (intern) range_enumeratePassword
+
+/* (intern function) enumerate_level for the levelRangeMode */
+bool range_enumerateLevel (int lengthMax, int level)
+{
+  int passwordAsInt[MAX_PASSWORD_LENGTH];
+  const levelRange_ip *iP = levelRange_getIP (glbl_levelRange, lengthMax);
+  int lengthCur = (glbl_nGramLevel->sizeOf_N - 1);  // the initial lengths equals the size of N - 1 (size of the initialProb)
+
+  memset (passwordAsInt, 0, sizeof (passwordAsInt));
+
+  // for each initialProb (ascending by minimal level) whose level range contains the @level
+  for (size_t i = 0; i < glbl_nGramLevel->sizeOf_iP && iP[i].levelMin <= level; i++)
+  {
+    if (iP[i].levelMax < level)
+      continue;
+    // set the first (sizeOf_N - 1) int according to the position of the initialProb
+    get_nGramAsIntFromPosition (passwordAsInt, iP[i].position, lengthCur, glbl_alphabet->sizeOf_alphabet);
+    if (glbl_constraint != NULL && !constraint_checkPrefix (glbl_constraint, passwordAsInt, lengthCur, lengthMax, glbl_constraintState))
+      continue;
+    if (!range_enumeratePassword (passwordAsInt, lengthCur, lengthMax, iP[i].position, level - glbl_nGramLevel->iP[iP[i].position]))
+      return false;
+  }
+  return true;
+}                               // (intern) range_enumerateLevel
+
+// generates all passwords with the given length and level
+bool enumerate_level (int lengthLC, int lengthPW, int level)
+{
+  int levelChain[MAX_PASSWORD_LENGTH + 1];  // stores current levelChain
+  bool newChain = true;         // true: create a new levelChain, false: create next one based on a given levelChain
+
+  // constrained enumeration: no password of this length matches the constraints
+  if (glbl_constraint != NULL && glbl_constraint->candidateCount[lengthPW] == 0)
+    return true;
+
+  if (glbl_levelRangeMode)
+    return range_enumerateLevel (lengthPW, level);
+
+  // reset levelChain
+  reset_levelChain (levelChain, lengthLC);
+
+  // get all levelChains for current length and level
+  while (getNext_levelChain (levelChain, lengthLC, level, newChain))
+  {
+    newChain = false;
+
+    // enumerate all PWs returns false if max attempts has been reached
+    if (!enumerate_password (levelChain, lengthPW))
+      return false;
+  }
+  return true;
+}                               // enumerate_level
+
+// handles the passwords of the completed level (sorted order)
+bool flush_sortedLevel ()
+{
+  int passwordAsInt[MAX_PASSWORD_LENGTH];
+  probQueue_entry entry;
+  bool result = true;
+
+  if (glbl_levelQueue == NULL)
+    return true;
+
+  // take the passwords by ascending log-probability
+  glbl_levelQueueFlushing = true;
+  while (result && probQueue_pop (glbl_levelQueue, &entry))
+  {
+    for (size_t i = 0; i < entry.length; i++)
+      passwordAsInt[i] = entry.prefix[i];
+    result = handle_createdPassword (passwordAsInt, NULL, entry.length);
+  }
+  glbl_levelQueueFlushing = false;
+
+  // start the next level with an empty queue (and without any spilled runs)
+  probQueue_free (&glbl_levelQueue);
+  return result;
+}                               // flush_sortedLevel
+
+/* (intern function) Works like enumerate_password_recursivly, but handles only the passwords whose level decreased by at least @dropMissing by the last adaptation, i.e. the passwords moved below the current level of their length. Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool adapt_enumeratePasswordRecursivly (int passwordAsInt[MAX_PASSWORD_LENGTH], int levelChain[MAX_PASSWORD_LENGTH], int lengthCur, int lengthMax, int dropMissing)
+{
+  int position = 0;
+  int level = 0;
+  int sizeOf_alphabet = glbl_alphabet->sizeOf_alphabet;
+
+  // the remaining entries can't decrease the level enough
+  if (dropMissing > (lengthMax - lengthCur) * glbl_adaptation->dropCP + glbl_adaptation->dropEP)
+    return true;
+
+  // get position of the mGram and the current level (see enumerate_password_recursivly)
+  get_positionFromNGramAsInt (&position, passwordAsInt + (lengthCur - (glbl_nGramLevel->sizeOf_N - 1)), (glbl_nGramLevel->sizeOf_N - 1), sizeOf_alphabet);
+  level = levelChain[lengthCur - (glbl_nGramLevel->sizeOf_N - 2)];
+
+  if (lengthCur == lengthMax)
+  {
+    if (!glbl_ignoreEPMode)
+    {
+      if (level != glbl_nGramLevel->eP[position])
+        return true;
+      dropMissing -= glbl_adaptation->droppedEP[position];
+    }
+    if (dropMissing > 0)
+      return true;              // created before the adaptation
+    return handle_createdPassword (passwordAsInt, levelChain, lengthCur);
+  }
+  for (size_t i = glbl_sortedLastGram[level].indexStart[position]; i < glbl_sortedLastGram[level].indexStart[position + 1]; i++)
+  {
+    passwordAsInt[lengthCur] = glbl_sortedLastGram[level].lastGrams[i];
+    if (!adapt_enumeratePasswordRecursivly (passwordAsInt, levelChain, lengthCur + 1, lengthMax, dropMissing - glbl_adaptation->droppedCP[position * sizeOf_alphabet + passwordAsInt[lengthCur]]))
+      return false;
+  }
+  return true;
+}                               // (intern) adapt_enumeratePasswordRecursivly
+
+/* (intern function) Enumerates the passwords of length @lengthPW moved below the level @frontier (the next level of the length) by the last adaptation: the levels the passwords have been moved to are enumerated again, handling only the passwords whose level was at least @frontier before. Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool adapt_enumerateMoved (int lengthLC, int lengthPW, int frontier)
+{
+  int levelChain[MAX_PASSWORD_LENGTH + 1];
+  int passwordAsInt[MAX_PASSWORD_LENGTH];
+  int lengthCur = (glbl_nGramLevel->sizeOf_N - 1);
+  int position = 0;
+  bool newChain = true;
+  int level = frontier - adaptation_maxDrop (glbl_adaptation, lengthPW);
+
+  memset (passwordAsInt, 0, sizeof (passwordAsInt));
+  for (level = (level < 0) ? 0 : level; level < frontier; level++)
+  {
+    reset_levelChain (levelChain, lengthLC);
+    newChain = true;
+    while (getNext_levelChain (levelChain, lengthLC, level, newChain))
+    {
+      newChain = false;
+      for (size_t i = 0; i < glbl_sortedIP[levelChain[0]].indexCur; i++)
+      {
+        position = glbl_sortedIP[levelChain[0]].iP[i];
+        get_nGramAsIntFromPosition (passwordAsInt, position, lengthCur, glbl_alphabet->sizeOf_alphabet);
+        if (!adapt_enumeratePasswordRecursivly (passwordAsInt, levelChain, lengthCur, lengthPW, frontier - level - glbl_adaptation->droppedIP[position]))
+          return false;
+      }
+    }
+  }
+  return true;
+}                               // (intern) adapt_enumerateMoved
+
+// adapts the model to the passwords cracked since the last level boundary
+bool adapt_levelBoundary (const int frontier[MAX_PASSWORD_LENGTH])
+{
+  char password[MAX_PASSWORD_LENGTH];
+  int length = 0;
+  bool result = true;
+  int lengthLCModifier = (glbl_ignoreEPMode ? 2 : 3) - glbl_nGramLevel->sizeOf_N; // N-3 if using endProbs, N-2 if not
+
+  if (glbl_adaptation == NULL)
+    return true;
+
+  // collect the passwords cracked by the simulated attack, the hash checking or the external password cracker
+  if (!simAtt_flush ())
+    exit (EXIT_SUCCESS);    // all passwords cracked, like simAtt_checkCandidate
+  if (glbl_feedback != NULL)
+  {
+    feedback_poll (glbl_feedback);
+    while (feedback_nextCracked (glbl_feedback, password, &length))
+      adaptation_addCracked (glbl_adaptation, password, length);
+  }
+  if (glbl_hashChecker != NULL)
+  {
+    while (hashChecker_nextCracked (glbl_hashChecker, password, &length))
+      adaptation_addCracked (glbl_adaptation, password, length);
+  }
+
+  if (!adaptation_isDue (glbl_adaptation) || !adaptation_apply (glbl_adaptation, glbl_sortedLastGram, glbl_sortedIP))
+    return true;
+
+  // catch up on the passwords moved below the current level of their length
+  for (int lengthPW = glbl_nGramLevel->sizeOf_N; lengthPW < MAX_PASSWORD_LENGTH && result; lengthPW++)
+  {
+    if (frontier[lengthPW] > 0)
+      result = adapt_enumerateMoved (lengthPW + lengthLCModifier, lengthPW, frontier[lengthPW]);
+  }
+  adaptation_finish (glbl_adaptation);
+  return result;
+}                               // adapt_levelBoundary
+
+/* (intern function) Fills glbl_exactRest up to @restMax chars: the minimal log-probability to append x chars (and the endProb) to a prefix, whose last (n-1) chars are at a given position. */
+void exact_initializeRest (int restMax)
+{
+  int sizeOf_alphabet = glbl_alphabet->sizeOf_alphabet;
+  int sizeOf_iP = glbl_nGramProb->sizeOf_iP;
+  int *rest = NULL;
+  int *restPrev = NULL;
+  int cost = 0;
+
+  for (int r = 0; r <= restMax; r++)
+  {
+    glbl_exactRest[r] = (int *) malloc (sizeOf_iP * sizeof (int));
+    EXIT_IF_NULL (glbl_exactRest[r]);
+    rest = glbl_exactRest[r];
+
+    for (size_t position = 0; position < sizeOf_iP; position++)
+    {
+      if (r == 0)
+      {
+        // no more chars, only the endProb is left
+        rest[position] = glbl_ignoreEPMode ? 0 : glbl_nGramProb->eP[position];
+        continue;
+      }
+      // best lastGram for this position
+      rest[position] = INT32_MAX;
+      for (size_t lastGram = 0; lastGram < sizeOf_alphabet; lastGram++)
+      {
+        cost = glbl_nGramProb->cP[position * sizeOf_alphabet + lastGram] + restPrev[(position % (sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet + lastGram];
+        if (cost < rest[position])
+          rest[position] = cost;
+      }
+    }
+    restPrev = rest;
+  }
+}                               // (intern) exact_initializeRest
+
+/* (intern) temporary struct used to sort the initialProbs by priority */
+typedef struct exact_sortIP_struct
+{
+  int priority;
+  int position;
+} exact_sortIP_struct;
+
+/* (intern function) compare function for qsort (ascending by priority, than by position) */
+int exact_compareIP (const void *a, const void *b)
+{
+  const exact_sortIP_struct *ipA = (const exact_sortIP_struct *) a;
+  const exact_sortIP_struct *ipB = (const exact_sortIP_struct *) b;
+
+  if (ipA->priority != ipB->priority)
+    return (ipA->priority > ipB->priority) - (ipA->priority < ipB->priority);
+  return (ipA->position > ipB->position) - (ipA->position < ipB->position);
+}                               // (intern) exact_compareIP
+
+/* (intern function) Returns the priority of the initialProb at @position for passwords of the given @length */
+int exact_priorityIP (int position, int length)
+{
+  return glbl_nGramProb->len[length] + glbl_nGramProb->iP[position] + glbl_exactRest[length - (glbl_nGramLevel->sizeOf_N - 1)][position];
+}                               // (intern) exact_priorityIP
+
+/* (intern function) Sorts all initialProbs by their priority for passwords of the given @length (stored in glbl_exactIP) */
+void exact_sortIP (int length)
+{
+  int sizeOf_iP = glbl_nGramProb->sizeOf_iP;
+  exact_sortIP_struct *sorted = (exact_sortIP_struct *) malloc (sizeOf_iP * sizeof (exact_sortIP_struct));
+
+  EXIT_IF_NULL (sorted);
+  glbl_exactIP[length] = (int *) malloc (sizeOf_iP * sizeof (int));
+  EXIT_IF_NULL (glbl_exactIP[length]);
+
+  for (int i = 0; i < sizeOf_iP; i++)
+  {
+    sorted[i].priority = exact_priorityIP (i, length);
+    sorted[i].position = i;
+  }
+  qsort (sorted, sizeOf_iP, sizeof (exact_sortIP_struct), exact_compareIP);
+  for (int i = 0; i < sizeOf_iP; i++)
+    glbl_exactIP[length][i] = sorted[i].position;
+
+  free (sorted);
+}                               // (intern) exact_sortIP
+
+/* (intern function) Searches the children of the prefix in @entry (whose last (n-1) chars are at @position) for the most probable one following the child (@priority, @lastGram) (any child if @lastGram is -1). The found child is stored in @entry (next and priority). Returns false, if there is no such child. */
+bool exact_nextChild (probQueue_entry * entry, int position, int priority, int lastGram)
+{
+  int sizeOf_alphabet = glbl_alphabet->sizeOf_alphabet;
+  int positionNext = (position % (glbl_nGramProb->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet;
+  int *rest = glbl_exactRest[entry->length - entry->depth - 1];
+  int *cP = glbl_nGramProb->cP + (size_t) position * sizeOf_alphabet;
+  int best = -1;
+  int bestPriority = INT32_MAX;
+  int childPriority = 0;
+
+  for (int i = 0; i < sizeOf_alphabet; i++)
+  {
+    childPriority = entry->cost + cP[i] + rest[positionNext + i];
+    // children are ordered by (priority, lastGram)
+    if (childPriority < priority || (childPriority == priority && i <= lastGram))
+      continue;
+    if (childPriority < bestPriority)
+    {
+      best = i;
+      bestPriority = childPriority;
+    }
+  }
+
+  if (best == -1)
+    return false;
+  entry->next = best;
+  entry->priority = bestPriority;
+  return true;
+}                               // (intern) exact_nextChild
+
+/* (intern function) Returns the position of the last (n-1) chars of the prefix in @entry */
+int exact_position (const probQueue_entry * entry)
+{
+  int position = 0;
+
+  for (int i = entry->depth - (glbl_nGramLevel->sizeOf_N - 1); i < entry->depth; i++)
+    position = position * glbl_alphabet->sizeOf_alphabet + entry->prefix[i];
+  return position;
+}                               // (intern) exact_position
+
+/* (intern function) Processes the popped @entry: any sibling is added to the queue and the most probable path is followed until a password is complete, which is handled by handle_createdPassword. Returns false if as many passwords as glbl_attemptsMax have been created (or the queue failed). */
+bool exact_processEntry (probQueue_entry * entry)
+{
+  int sizeOf_N = glbl_nGramLevel->sizeOf_N;
+  int passwordAsInt[MAX_PASSWORD_LENGTH];
+  probQueue_entry sibling;
+  int position = 0;
+  int priority = entry->priority;
+
+  // root entry: the next initialProb for this length
+  if (entry->depth == 0)
+  {
+    if (glbl_exactIP[entry->length] == NULL)
+      exact_sortIP (entry->length);
+
+    // add the following initialProb to the queue
+    if (entry->next + 1 < glbl_nGramProb->sizeOf_iP)
+    {
+      sibling = *entry;
+      sibling.next++;
+      sibling.priority = exact_priorityIP (glbl_exactIP[entry->length][sibling.next], entry->length);
+      if (!probQueue_push (glbl_exactQueue, &sibling))
+        return false;
+    }
+
+    // set the first (n-1) chars
+    position = glbl_exactIP[entry->length][entry->next];
+    get_nGramAsIntFromPosition (passwordAsInt, position, sizeOf_N - 1, glbl_alphabet->sizeOf_alphabet);
+    for (int i = 0; i < sizeOf_N - 1; i++)
+      entry->prefix[i] = passwordAsInt[i];
+    entry->depth = sizeOf_N - 1;
+    entry->cost = glbl_nGramProb->len[entry->length] + glbl_nGramProb->iP[position];
+
+    // the first child has the same priority
+    exact_nextChild (entry, position, priority, -1);
+  }
+  else
+  {
+    position = exact_position (entry);
+  }
+
+  // follow the most probable path
+  while (true)
+  {
+    // add the following sibling to the queue
+    sibling = *entry;
+    if (exact_nextChild (&sibling, position, entry->priority, entry->next))
+    {
+      if (!probQueue_push (glbl_exactQueue, &sibling))
+        return false;
+    }
+
+    // append the child
+    entry->cost += glbl_nGramProb->cP[(size_t) position * glbl_alphabet->sizeOf_alphabet + entry->next];
+    entry->prefix[entry->depth] = entry->next;
+    entry->depth++;
+    position = (position % (glbl_nGramProb->sizeOf_iP / glbl_alphabet->sizeOf_alphabet)) * glbl_alphabet->sizeOf_alphabet + entry->next;
+
+    // password is complete
+    if (entry->depth == entry->length)
+      break;
+
+    // continue with the most probable child (it has the same priority)
+    exact_nextChild (entry, position, priority, -1);
+  }
+
+  for (int i = 0; i < entry->length; i++)
+    passwordAsInt[i] = entry->prefix[i];
+  return handle_createdPassword (passwordAsInt, NULL, entry->length);
+}                               // (intern) exact_processEntry
+
+// enumerates the passwords in exact order
+void run_enumeration_exact ()
+{
+  int sizeOf_N = glbl_nGramLevel->sizeOf_N;
+  int lengthMin = sizeOf_N;     // like the levelChains, only passwords with at least n chars are created
+  int lengthMax = MAX_PASSWORD_LENGTH - 1;
+  probQueue_entry entry;
+  int priority = 0;
+
+  if (glbl_fixedLenght != 0)
+  {
+    lengthMin = glbl_fixedLenght;
+    lengthMax = glbl_fixedLenght;
+  }
+  if (glbl_optimizedLengthMode || glbl_lengthLevelFactor != 0.0 || glbl_lengthLevelSet != -1)
+  {
+    errorHandler_print (errorType_Warning, "The length scheduling is ignored by the exact order (the length probabilities are used instead).\n");
+  }
+
+  exact_initializeRest (lengthMax - (sizeOf_N - 1));
+  probQueue_initialize (&glbl_exactQueue, glbl_queueSize);
+
+  // add the most probable initialProb of each length
+  memset (&entry, 0, sizeof (entry));
+  for (int length = lengthMin; length <= lengthMax; length++)
+  {
+    entry.priority = INT32_MAX;
+    for (int i = 0; i < glbl_nGramProb->sizeOf_iP; i++)
+    {
+      priority = exact_priorityIP (i, length);
+      if (priority < entry.priority)
+        entry.priority = priority;
+    }
+    entry.length = length;
+    if (!probQueue_push (glbl_exactQueue, &entry))
+      return;
+  }
+
+  progress_init ();
+
+  // process the most probable entry until max attempts has been reached
+  while (true)
+  {
+    if (!probQueue_pop (glbl_exactQueue, &entry))
+    {
+      // no more passwords, stop enumeration
+      errorHandler_print (errorType_Warning, "All possible passwords have been created.\n");
+      break;
+    }
+    if (!exact_processEntry (&entry))
+      break;
+  }
+
+  progress_finish ();
+}                               // run_enumeration_exact
+
+// merges the enumerations of all models of the ensemble
+void run_enumeration_ensemble ()
+{
+  omen_candidate candidate;
+
+  progress_init ();
+  while (true)
+  {
+    if (!ensemble_next (glbl_ensemble, &candidate))
+    {
+      errorHandler_print (errorType_Warning, "All possible LevelChains have been created.\n");
+      break;
+    }
+    if (!handle_passwordAsChar (candidate.password, candidate.length, candidate.level))
+      break;
+  }
+  progress_finish ();
+}                               // run_enumeration_ensemble
+
+/* (intern function) Recursively appends the chars of a suffix of @lengthSuffix to the word of @lengthWord in @password. @suffixAsInt contains the last (n-1) chars of the word followed by the @lengthCur chars appended so far, whose levels leave @levelLeft for the remaining conditionalProbs and the endProb. Each complete password is handled with the given @level. Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool hybrid_enumerateSuffix (char password[MAX_PASSWORD_LENGTH], int lengthWord, int suffixAsInt[2 * MAX_PASSWORD_LENGTH], int lengthCur, int lengthSuffix, int levelLeft, int level)
+{
+  int sizeOf_N1 = glbl_nGramLevel->sizeOf_N - 1;
+  int levelMax = glbl_maxLevel - 1;
+  int position = 0;
+  int termsLeft = lengthSuffix - lengthCur - 1 + (glbl_ignoreEPMode ? 0 : 1);  // levels following the next char
+
+  // position of the last (n-1) chars
+  get_positionFromNGramAsInt (&position, suffixAsInt + lengthCur, sizeOf_N1, glbl_alphabet->sizeOf_alphabet);
+
+  // the last char takes the remaining level (together with the endProb)
+  if (lengthCur == lengthSuffix - 1)
+  {
+    int sizeOf_symbols = 0;
+    const unsigned char *symbols = hybridAttack_getSymbols (glbl_hybridAttack, &(glbl_hybridAttack->suffixLast), position, levelLeft, &sizeOf_symbols);
+
+    password[lengthWord + lengthSuffix] = '\0';
+    for (int i = 0; i < sizeOf_symbols; i++)
     {
-      lengthCrackRate[lengthPW] = 0.0000001;
+      get_charAtPosition (password + lengthWord + lengthCur, symbols[i], glbl_alphabet->alphabet, glbl_alphabet->sizeOf_alphabet);
+      glbl_hybridAttack->suffixCount++;
+      if (!handle_passwordAsChar (password, lengthWord + lengthSuffix, level))
+        return false;
     }
+    return true;
+  }
 
-    if (lengthCrackRate[lengthPW] >= 1) // should not get too large
+  for (int levelCur = 0; levelCur <= levelLeft && levelCur <= levelMax; levelCur++)
+  {
+    // the remaining levels can't be reached anymore
+    if (levelLeft - levelCur > termsLeft * levelMax)
+      continue;
+    for (size_t i = glbl_sortedLastGram[levelCur].indexStart[position]; i < glbl_sortedLastGram[levelCur].indexStart[position + 1]; i++)
     {
-      lengthCrackRate[lengthPW] = 0.999999;
+      suffixAsInt[sizeOf_N1 + lengthCur] = glbl_sortedLastGram[levelCur].lastGrams[i];
+      get_charAtPosition (password + lengthWord + lengthCur, suffixAsInt[sizeOf_N1 + lengthCur], glbl_alphabet->alphabet, glbl_alphabet->sizeOf_alphabet);
+      if (!hybrid_enumerateSuffix (password, lengthWord, suffixAsInt, lengthCur + 1, lengthSuffix, levelLeft - levelCur, level))
+        return false;
     }
+  }
+  return true;
+}                               // (intern) hybrid_enumerateSuffix
 
-    if (lenghtLevel[lengthPW] >= ((glbl_maxLevel - 1) * lengthPW))
-    {                           // reached highest supported level
-      errorHandler_print (errorType_Warning, "All possible LevelChains for length %i have been created.\n", lengthPW);
-      lengthCrackRate[lengthPW] = 0;  // prevent it from getting scheduled again
-      lengthsReachedMax++;
-    }
-    else
+/* (intern function) Recursively prepends the chars of a prefix of @lengthPrefix (from right to left) to the word of @lengthWord in @password. @prefixAsInt contains the prefix followed by the first (n-1) chars of the word, the chars following @index are set, their levels leave @levelLeft for the remaining conditionalProbs and the initialProb. Each complete password is handled with the given @level. Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool hybrid_enumeratePrefix (char password[MAX_PASSWORD_LENGTH], int lengthWord, int prefixAsInt[2 * MAX_PASSWORD_LENGTH], int index, int lengthPrefix, int levelLeft, int level)
+{
+  int sizeOf_N1 = glbl_nGramLevel->sizeOf_N - 1;
+  int levelMax = glbl_maxLevel - 1;
+  int position = 0;
+  int termsLeft = index + 1;    // conditionalProbs of the chars before @index and the initialProb
+  int sizeOf_symbols = 0;
+  const unsigned char *symbols = NULL;
+
+  // position of the (n-1) chars following the char at @index
+  get_positionFromNGramAsInt (&position, prefixAsInt + index + 1, sizeOf_N1, glbl_alphabet->sizeOf_alphabet);
+
+  // the first char takes the remaining level (together with the initialProb)
+  if (index == 0)
+  {
+    symbols = hybridAttack_getSymbols (glbl_hybridAttack, &(glbl_hybridAttack->prefixFirst), position, levelLeft, &sizeOf_symbols);
+    for (int i = 0; i < sizeOf_symbols; i++)
     {
-      lenghtLevel[lengthPW]++;
+      get_charAtPosition (password, symbols[i], glbl_alphabet->alphabet, glbl_alphabet->sizeOf_alphabet);
+      glbl_hybridAttack->prefixCount++;
+      if (!handle_passwordAsChar (password, lengthPrefix + lengthWord, level))
+        return false;
     }
+    return true;
+  }
 
-    if (lengthsReachedMax >= MAX_PASSWORD_LENGTH)
+  for (int levelCur = 0; levelCur <= levelLeft && levelCur <= levelMax; levelCur++)
+  {
+    // the remaining levels can't be reached anymore
+    if (levelLeft - levelCur > termsLeft * levelMax)
+      continue;
+    symbols = hybridAttack_getSymbols (glbl_hybridAttack, &(glbl_hybridAttack->prefixChar), position, levelCur, &sizeOf_symbols);
+    for (int i = 0; i < sizeOf_symbols; i++)
     {
-      // no more levelChains, stop enumeration
-      errorHandler_print (errorType_Warning, "All possible LevelChains have been created.\n");
-      runCreation = false;
+      prefixAsInt[index] = symbols[i];
+      get_charAtPosition (password + index, symbols[i], glbl_alphabet->alphabet, glbl_alphabet->sizeOf_alphabet);
+      if (!hybrid_enumeratePrefix (password, lengthWord, prefixAsInt, index - 1, lengthPrefix, levelLeft - levelCur, level))
+        return false;
     }
   }
+  return true;
+}                               // (intern) hybrid_enumeratePrefix
 
-  progress_finish ();
-}                               // run_enumeration
-
-/* (intern faction) Recursively generates a levelChain for the given length and level. Returns true if a levelChain could be created or false if not. */
-bool generate_levelChain_2ndToLast_recursive (int levelChain[MAX_PASSWORD_LENGTH], int depth, int lengthMax, int levelCur, int levelMax, bool newChain)
+/* (intern function) Handles the candidates of the given @word whose affix has the level @affixLevel: the word itself (level 0), followed by the suffixes and prefixes of each length. Returns false if as many passwords as glbl_attemptsMax have been created. */
+bool hybrid_enumerateWord (int word, int affixLevel)
 {
-  // if last int for levelChain is reached ...
-  if (depth == (lengthMax - 1))
+  const char *chars = hybridAttack_getWord (glbl_hybridAttack, word);
+  int lengthWord = glbl_hybridAttack->words[word].length;
+  int level = glbl_hybridAttack->words[word].level + affixLevel;
+  int sizeOf_N1 = glbl_nGramLevel->sizeOf_N - 1;
+  char password[MAX_PASSWORD_LENGTH];
+  int affixAsInt[2 * MAX_PASSWORD_LENGTH];
+  int boundary[2][MAX_PASSWORD_LENGTH]; // first and last (n-1) chars of the word
+  bool valid[2] = { lengthWord >= sizeOf_N1, lengthWord >= sizeOf_N1 };
+
+  if (affixLevel == 0)
+  {
+    glbl_hybridAttack->wordCount++;
+    if (!handle_passwordAsChar (chars, lengthWord, level))
+      return false;
+  }
+
+  // the affixes are conditioned on the (n-1) chars of the word next to them, which must be part of the alphabet
+  for (int i = 0; i < sizeOf_N1 && valid[0]; i++)
+    valid[0] = get_positionInAlphabet (boundary[0] + i, chars[i], glbl_alphabet->alphabet, glbl_alphabet->sizeOf_alphabet);
+  for (int i = 0; i < sizeOf_N1 && valid[1]; i++)
+    valid[1] = get_positionInAlphabet (boundary[1] + i, chars[lengthWord - sizeOf_N1 + i], glbl_alphabet->alphabet, glbl_alphabet->sizeOf_alphabet);
+
+  // suffixes, following the last (n-1) chars of the word
+  if (valid[1])
   {
-    // the last int must be the rest of levelMax
-    levelChain[lengthMax - 1] = levelMax - levelCur;
-    // and should not be larger then global maximum level
-    if (levelChain[lengthMax - 1] > (glbl_maxLevel - 1))
+    memcpy (password, chars, lengthWord);
+    memcpy (affixAsInt, boundary[1], sizeOf_N1 * sizeof (int));
+    for (int length = 1; length <= glbl_hybridAffix && lengthWord + length < MAX_PASSWORD_LENGTH; length++)
     {
-      return false;             // reject generated levelChain
+      if (!hybrid_enumerateSuffix (password, lengthWord, affixAsInt, 0, length, affixLevel, level))
+        return false;
     }
-
-    // accept generated levelChain
-    return true;
   }
-  else
-  {                             // if depth < (length-1)
-    // get max possible level, but do not exceed global maximum level
-    int level = levelMax - levelCur;
 
-    if (level > (glbl_maxLevel - 1))
+  // prefixes, preceding the first (n-1) chars of the word
+  if (valid[0])
+  {
+    for (int length = 1; length <= glbl_hybridAffix && lengthWord + length < MAX_PASSWORD_LENGTH; length++)
     {
-      level = (glbl_maxLevel - 1);
+      memcpy (password + length, chars, lengthWord + 1);
+      memcpy (affixAsInt + length, boundary[0], sizeOf_N1 * sizeof (int));
+      if (!hybrid_enumeratePrefix (password, lengthWord, affixAsInt, length - 1, length, affixLevel, level))
+        return false;
     }
+  }
+  return true;
+}                               // (intern) hybrid_enumerateWord
 
-    // proceed from previous set level
-    for (; levelChain[depth] <= level; levelChain[depth]++)
+// combines the words of the wordlist with prefixes and suffixes in ascending level
+void run_enumeration_hybrid ()
+{
+  int word = 0;
+  int affixLevel = 0;
+
+  progress_init ();
+  while (true)
+  {
+    if (!hybridAttack_next (glbl_hybridAttack, &word, &affixLevel))
     {
-      // call recursive function to determine next int
-      if (generate_levelChain_2ndToLast_recursive (levelChain, depth + 1, lengthMax, levelCur + levelChain[depth], levelMax, newChain))
-      {
-        return true;
-      }
-      // reset all others
-      levelChain[depth + 1] = 0;
+      errorHandler_print (errorType_Warning, "All candidates of the hybrid mode have been created.\n");
+      break;
     }
+    if (!hybrid_enumerateWord (word, affixLevel))
+      break;
   }
-  return false;
-}                               // (intern) generate_levelChain_2ndToLast_recursive
+  progress_finish ();
+}                               // run_enumeration_hybrid
 
-// set levelChain to the next one
-bool getNext_levelChain (int levelChain[MAX_PASSWORD_LENGTH], int length, int levelMax, bool newChain)
+/* (intern function) Sends the given @line to the coordinator. Returns FALSE (printing an error) if the connection failed. */
+bool worker_send (const char *line)
 {
-  // since any single level can not be larger then 10:
-  int level = levelMax;
+  size_t length = strlen (line);
+
+  if (send (glbl_workerSocket, line, length, MSG_NOSIGNAL) != (ssize_t) length)
+  {
+    errorHandler_print (errorType_Error, "Lost the connection to the coordinator %s\n", glbl_workerAddress);
+    return false;
+  }
+  return true;
+}                               // (intern) worker_send
 
-  if (level > (glbl_maxLevel - 1))
-    level = glbl_maxLevel - 1;
+/* (intern function) Returns TRUE if the given @unit belongs to the model of this worker (same length of the levelChain, levels and initialProbs). */
+bool worker_checkUnit (const workUnit_struct * unit)
+{
+  int lengthLCModifier = (glbl_ignoreEPMode ? 2 : 3) - glbl_nGramLevel->sizeOf_N;
+  int sizeOf_iP = 0;
 
-  // check, if the chain is possible
-  if (levelMax > (glbl_maxLevel - 1) * length)
+  if (unit->lengthLC != unit->lengthPW + lengthLCModifier || unit->depth > unit->lengthPW - (glbl_nGramLevel->sizeOf_N - 1))
     return false;
+  for (int i = 0; i < unit->lengthLC; i++)
+    if (unit->levelChain[i] >= glbl_maxLevel)
+      return false;
+  sizeOf_iP = glbl_sortedIP[unit->levelChain[0]].indexCur;
+  return (unit->depth == 0) ? unit->end <= sizeOf_iP : unit->path[0] < sizeOf_iP;
+}                               // (intern) worker_checkUnit
 
-  // if no new chain should be created;
-  if (!newChain)
-    levelChain[length - 2]++;   // increase second last to avoid doublets
+/* (intern function) Sets the range of indices at @depth for a node with @sizeOf_indices children: the path or the range of the unit (in its first levelChain only) or all of them. */
+void worker_initializeRange (int depth, int sizeOf_indices)
+{
+  const workUnit_struct *unit = &glbl_workerUnit;
+
+  glbl_workerIndex[depth] = 0;
+  glbl_workerEnd[depth] = sizeOf_indices;
+  if (glbl_workerChain != 0 || depth > unit->depth)
+    return;
+  glbl_workerIndex[depth] = (depth < unit->depth) ? unit->path[depth] : unit->start;
+  if (depth < unit->depth)
+    glbl_workerEnd[depth] = unit->path[depth] + 1;
+  else if (unit->end < sizeOf_indices)
+    glbl_workerEnd[depth] = unit->end;
+}                               // (intern) worker_initializeRange
+
+/* (intern function) Splits off a part of the current unit (answering SPLIT of the coordinator), while the nodes up to @depth are being enumerated: the following levelChains or else the upper half of the remaining indices at the smallest depth. The part is removed from the unit. Returns FALSE if nothing is left to split off. */
+bool worker_splitUnit (int depth, workUnit_struct * part)
+{
+  workUnit_struct *unit = &glbl_workerUnit;
 
-  // for each level <= levelMax (or 10)
-  for (; levelChain[0] <= level; levelChain[0]++)
+  *part = *unit;
+  part->chainIndex = unit->chainIndex + glbl_workerChain;
+  part->chainCount = 1;
+
+  // the following levelChains
+  if (glbl_workerChain + 1 < unit->chainCount)
   {
-    // call recursive function to determine 2nd to Last int for the levelChain with maxLevel
-    if (generate_levelChain_2ndToLast_recursive (levelChain, 1, length, levelChain[0], levelMax, newChain))
-      return true;
-    // reset levelChain
-    levelChain[1] = 0;
+    int level = 0;
+
+    for (int i = 0; i < unit->lengthLC; i++)
+      level += unit->levelChain[i];
+    getNext_levelChain (part->levelChain, part->lengthLC, level, false);
+    part->chainIndex++;
+    part->chainCount = unit->chainCount - glbl_workerChain - 1;
+    part->depth = 0;
+    part->start = 0;
+    part->end = glbl_sortedIP[part->levelChain[0]].indexCur;
+    unit->chainCount = glbl_workerChain + 1;
+    return true;
+  }
+
+  // the upper half of the remaining indices at the smallest depth (the largest part left)
+  for (int i = 0; i <= depth; i++)
+  {
+    int remaining = glbl_workerEnd[i] - glbl_workerIndex[i] - 1;
+
+    if (remaining < 1)
+      continue;
+    part->depth = i;
+    memcpy (part->path, glbl_workerIndex, i * sizeof (int));
+    part->start = glbl_workerIndex[i] + 1 + remaining / 2;
+    part->end = glbl_workerEnd[i];
+    glbl_workerEnd[i] = part->start;
+    return true;
   }
   return false;
-}                               // getNext_levelChains
+}                               // (intern) worker_splitUnit
 
-/* (intern function) Handles a enumerated password based on the selected mode, i.e.: - if simulatedAttMode is active, the PW is checked against the testing set - if pipeMode is active, the PW is printed to stdout - in defaultMode the PW is added to the password file Returns false if as many passwords as glbl_attemptsMax have been created. */
-bool handle_createdPassword (int passwordAsInt[MAX_PASSWORD_LENGTH], int levelChain[MAX_PASSWORD_LENGTH], int length)
+/* (intern function) Reports the progress of the current unit and answers the split and stop requests of the coordinator received so far (called every WORKUNIT_CHECK_INTERVAL nodes), while the nodes up to @depth are being enumerated. Returns FALSE if the unit has been stopped or the connection failed (printing an error). */
+bool worker_checkSplit (int depth)
 {
-  char passwordAsChar[length + 1];
+  char line[WORKUNIT_SIZEOF_LINE];
+  uint64_t id = 0;
+  int result = 0;
 
-  // create the corresponding password as char
-  for (size_t i = 0; i < length; i++)
+  // the coordinator stops the busy units once all workers together created enough passwords
+  if (glbl_attemptsCount - glbl_workerStart != glbl_workerProgress)
   {
-    get_charAtPosition (passwordAsChar + i, passwordAsInt[i], glbl_alphabet->alphabet, glbl_alphabet->sizeOf_alphabet);
+    glbl_workerProgress = glbl_attemptsCount - glbl_workerStart;
+    snprintf (line, WORKUNIT_SIZEOF_LINE, "PROGRESS %" PRIu64 " %" PRIu64 "\n", glbl_workerUnit.id, glbl_workerProgress);
+    if (!worker_send (line))
+      return false;
   }
-  passwordAsChar[length] = '\0';
-
-  // adjust counter
-  glbl_attemptsCount++;
-  glbl_createdLengths[length - 1]++;
 
-  // if simulated attack mode is active...
-  if (glbl_alphaBoostingMode)
+  while ((result = workUnit_readLine (&glbl_workerReader, line, false)) == 1)
   {
-    if (glbl_simulatedAttMode)
+    workUnit_struct part;
+
+    if (sscanf (line, "STOP %" SCNu64, &id) == 1)
     {
-      if (simAtt_boostCheckCandidate (passwordAsChar, length))
-      {
-        if (glbl_verboseFileMode)
-        {
-          fprintf (glbl_FP_generatedPasswords, "%s, %" PRIu64 "\n", passwordAsChar, glbl_attemptsCount);
-        }
-        return false;           // return false here means: we are finished with enumerating
-      }
+      if (id != glbl_workerUnit.id)
+        continue;
+      glbl_workerStopped = true;
+      return false;
     }
-    else
+    if (strcmp (line, "SPLIT") != 0)
     {
-      // pipe or normal mode (glbl_FP_generatedPasswords is set to stdout in pipeMode)
-      fprintf (glbl_FP_generatedPasswords, "%s\n", passwordAsChar); // just add the generated password to the file/stdout
+      errorHandler_print (errorType_Error, "Invalid message of the coordinator: %s\n", line);
+      return false;
     }
-  }
-  else if (glbl_simulatedAttMode)
-  {
-    // ...check candidate (and print it to file if verboseFileMode is active)
-    if (simAtt_checkCandidate (passwordAsChar, length) && glbl_verboseFileMode)
+    if (!worker_splitUnit (depth, &part))
+      strcpy (line, "NOSPLIT\n");
+    else
     {
-      // ... and print any cracked PW (if verboseFileMode is active)
-      // fprintf(glbl_FP_generatedPasswords, "%s\n", passwordAsChar);
-      // ... for analysis, prints the guess attempts
-      fprintf (glbl_FP_generatedPasswords, "%s, %" PRIu64 "\n", passwordAsChar, glbl_attemptsCount);
+      workUnit_format (&part, line);
+      glbl_workerSplits++;
     }
+    if (!worker_send (line))
+      return false;
   }
-  else
-  {
-    // pipe or normal mode (glbl_FP_generatedPasswords is set to stdout in pipeMode)
-    fprintf (glbl_FP_generatedPasswords, "%s\n", passwordAsChar); // just add the generated password to the file/stdout
-  }
-
-  // print the progress (if verboseMode is active)
-  progress_update ();
-
-  // if endlessMode is deactivated and current attempts equals max attempts, end run through
-  if (!glbl_endlessMode && glbl_attemptsCount == glbl_attemptsMax)
-    return false;
-
-  // else continue run through
-  return true;
-}                               // (intern) handle_password
+  if (result < 0)
+    errorHandler_print (errorType_Error, "Lost the connection to the coordinator %s\n", glbl_workerAddress);
+  return result == 0;
+}                               // (intern) worker_checkSplit
 
-/* (intern function) Recursively generates all passwords based on the current levelChain and the previous password characters. If a password has been found, enumerate_password_handleCandidate is used to evaluate the password based on the selected mode Returns false if as many passwords as glbl_attemptsMax have been created. */
-bool enumerate_password_recursivly (int passwordAsInt[MAX_PASSWORD_LENGTH], int levelChain[MAX_PASSWORD_LENGTH], int lengthCur, int lengthMax)
+/* (intern function) Works like enumerate_password_recursivly, but takes the lastGrams appended at @depth (the prefix of length @lengthCur has @depth - 1 lastGrams) from glbl_workerIndex to glbl_workerEnd, so parts of the subtree can be split off while it is enumerated. Returns false if as many passwords as glbl_attemptsMax have been created (or the connection failed). */
+bool worker_enumerateRecursivly (int passwordAsInt[MAX_PASSWORD_LENGTH], int levelChain[MAX_PASSWORD_LENGTH], int lengthCur, int lengthMax, int depth)
 {
   int position = 0;
   int level = 0;
+  const int *lastGrams = NULL;
 
-  // get position of the mGram
   get_positionFromNGramAsInt (&position, passwordAsInt + (lengthCur - (glbl_nGramLevel->sizeOf_N - 1)), (glbl_nGramLevel->sizeOf_N - 1), glbl_alphabet->sizeOf_alphabet);
-
-  /* get current level from the levelChain (need to be adjusted by sizeOf_N since iP take 1 level from levelChain, but N-1 characters in the Password) */
   level = levelChain[lengthCur - (glbl_nGramLevel->sizeOf_N - 2)];
 
-  // length of new PW equals max length
   if (lengthCur == lengthMax)
   {
-    // check if the level match the endProp
-    if (!glbl_ignoreEPMode)
-    {
-      if (level != glbl_nGramLevel->eP[position])
-        return true;
-    }
-    return handle_createdPassword (passwordAsInt, levelChain, lengthCur);
-  }
-  else
-  {                             // lengthCur != lengthMax
-    // for each lastGram with current @level and @position
-    for (size_t i = 0; i < (glbl_sortedLastGram[level].indexCur)[position]; i++)
+    if (!glbl_ignoreEPMode && level != glbl_nGramLevel->eP[position])
+      return true;
+    if (!handle_createdPassword (passwordAsInt, levelChain, lengthCur))
+      return false;
+    // the budget of the unit (passwords left until --maxattempts of the coordinator) is used up
+    if (glbl_workerUnit.budget != 0 && glbl_attemptsCount - glbl_workerStart >= glbl_workerUnit.budget)
     {
-      // add lastGram as int to the PW
-      passwordAsInt[lengthCur] = (glbl_sortedLastGram[level].lastGrams)[position][i];
-      // call recursive function with length + 1
-      if (!enumerate_password_recursivly (passwordAsInt, levelChain, lengthCur + 1, lengthMax))
-        return false;
+      glbl_workerStopped = true;
+      return false;
     }
     return true;
   }
-}                               // (intern) enumerate_password_recursivly
 
-// generates passwords based on the given levelChain and length
-bool enumerate_password (int levelChain[MAX_PASSWORD_LENGTH], int lengthMax)
+  lastGrams = glbl_sortedLastGram[level].lastGrams + glbl_sortedLastGram[level].indexStart[position];
+  worker_initializeRange (depth, glbl_sortedLastGram[level].indexStart[position + 1] - glbl_sortedLastGram[level].indexStart[position]);
+  // glbl_workerEnd may be lowered by a split
+  for (; glbl_workerIndex[depth] < glbl_workerEnd[depth]; glbl_workerIndex[depth]++)
+  {
+    if ((++glbl_workerSteps % WORKUNIT_CHECK_INTERVAL) == 0 && !worker_checkSplit (depth))
+      return false;
+    passwordAsInt[lengthCur] = lastGrams[glbl_workerIndex[depth]];
+    if (!worker_enumerateRecursivly (passwordAsInt, levelChain, lengthCur + 1, lengthMax, depth + 1))
+      return false;
+  }
+  return true;
+}                               // (intern) worker_enumerateRecursivly
+
+/* (intern function) Enumerates the current unit: the part of the subtree of its first levelChain and the following levelChains completely. Returns FALSE if as many passwords as glbl_attemptsMax have been created, the unit has been stopped (see glbl_workerStopped) or is invalid. */
+bool worker_enumerateUnit ()
 {
+  workUnit_struct *unit = &glbl_workerUnit;
   int passwordAsInt[MAX_PASSWORD_LENGTH];
+  int level = 0;
 
   memset (passwordAsInt, 0, sizeof (passwordAsInt));
+  for (int i = 0; i < unit->lengthLC; i++)
+    level += unit->levelChain[i];
 
-  int iP_level = levelChain[0]; // the first level of the levelChain is for the initialProb
-  int lengthCur = (glbl_nGramLevel->sizeOf_N - 1);  // the initial lengths equals the size of N - 1 (size of the initialProb)
-
-  // for each initialProb with the given @iP_level
-  for (size_t i = 0; i < glbl_sortedIP[iP_level].indexCur; i++)
+  // glbl_workerUnit.chainCount may be lowered by a split
+  for (glbl_workerChain = 0; glbl_workerChain < unit->chainCount; glbl_workerChain++)
   {
-    // set the first (sizeOf_N - 1) int according to the position stored in sortedIp
-    get_nGramAsIntFromPosition (passwordAsInt, glbl_sortedIP[iP_level].iP[i], (glbl_nGramLevel->sizeOf_N - 1), glbl_alphabet->sizeOf_alphabet);
-    // call the recursive function
-    if (!enumerate_password_recursivly (passwordAsInt, levelChain, lengthCur, lengthMax))
+    const int *iP = NULL;
+
+    if (glbl_workerChain > 0 && !getNext_levelChain (unit->levelChain, unit->lengthLC, level, false))
+    {
+      errorHandler_print (errorType_Error, "Invalid work unit %" PRIu64 " (only %" PRIu64 " levelChains)\n", unit->id, glbl_workerChain);
       return false;
+    }
+    iP = glbl_sortedIP[unit->levelChain[0]].iP;
+    worker_initializeRange (0, glbl_sortedIP[unit->levelChain[0]].indexCur);
+    for (; glbl_workerIndex[0] < glbl_workerEnd[0]; glbl_workerIndex[0]++)
+    {
+      if ((++glbl_workerSteps % WORKUNIT_CHECK_INTERVAL) == 0 && !worker_checkSplit (0))
+        return false;
+      get_nGramAsIntFromPosition (passwordAsInt, iP[glbl_workerIndex[0]], (glbl_nGramLevel->sizeOf_N - 1), glbl_alphabet->sizeOf_alphabet);
+      if (!worker_enumerateRecursivly (passwordAsInt, unit->levelChain, glbl_nGramLevel->sizeOf_N - 1, unit->lengthPW, 1))
+        return false;
+    }
   }
   return true;
-}                               // enumerate_password_iP
+}                               // (intern) worker_enumerateUnit
+
+/* (intern function) Returns the amount of cracked passwords, counting the ones reported with a delay (hash checking, feedback file) of the given @length only. */
+uint64_t worker_crackedCount (int length)
+{
+  uint64_t crackedLengths[MAX_PASSWORD_LENGTH];
+
+  if (!simAtt_flush ())
+    exit (EXIT_SUCCESS);    // all passwords cracked, like simAtt_checkCandidate
+  if (glbl_hashChecker == NULL && glbl_feedback == NULL)
+    return glbl_crackedCount;
+  get_crackedLengths (crackedLengths);
+  return glbl_crackedCount + crackedLengths[length - 1];
+}                               // (intern) worker_crackedCount
+
+// enumerates the work units handed out by the coordinator
+void run_enumeration_worker ()
+{
+  char line[WORKUNIT_SIZEOF_LINE];
+
+  glbl_workerReader.fd = glbl_workerSocket;
+  glbl_workerReader.sizeOf_buffer = 0;
+  progress_init ();
+  while (worker_send ("GET\n"))
+  {
+    uint64_t crackedStart = 0;
+    int result = 0;
+
+    // a split or stop request sent before the unit has been reported can't be answered anymore
+    while ((result = workUnit_readLine (&glbl_workerReader, line, true)) == 1 && (strcmp (line, "SPLIT") == 0 || strncmp (line, "STOP ", strlen ("STOP ")) == 0))
+      if (strcmp (line, "SPLIT") == 0 && !worker_send ("NOSPLIT\n"))
+        break;
+    if (result != 1)
+    {
+      errorHandler_print (errorType_Error, "Lost the connection to the coordinator %s\n", glbl_workerAddress);
+      break;
+    }
+    if (strcmp (line, "END") == 0)
+    {
+      errorHandler_print (errorType_Warning, "All work units of the coordinator have been completed.\n");
+      break;
+    }
+    if (!workUnit_parse (line, &glbl_workerUnit) || !worker_checkUnit (&glbl_workerUnit))
+    {
+      errorHandler_print (errorType_Error, "Invalid work unit (is the coordinator using the same model?): %s\n", line);
+      break;
+    }
+
+    // the unit is only reported if all its passwords have been handled (else it is handed out again)
+    crackedStart = worker_crackedCount (glbl_workerUnit.lengthPW);
+    glbl_workerStart = glbl_attemptsCount;
+    glbl_workerProgress = 0;
+    glbl_workerStopped = false;
+    // a stopped unit is reported with the passwords created so far
+    if (!worker_enumerateUnit () && !glbl_workerStopped)
+      break;
+    if (glbl_ruleEngine != NULL && !handle_ruleBatch ())
+      break;
+    // the cracks of the unit are the crack rate of the optimized length scheduling of the coordinator
+    snprintf (line, WORKUNIT_SIZEOF_LINE, "DONE %" PRIu64 " %" PRIu64 " %" PRIu64 "\n", glbl_workerUnit.id, glbl_attemptsCount - glbl_workerStart, worker_crackedCount (glbl_workerUnit.lengthPW) - crackedStart);
+    if (!worker_send (line))
+      break;
+    glbl_workerUnits++;
+  }
+  progress_finish ();
+}                               // run_enumeration_worker
 
 // creates a new result folder
 void create_resultFolder ()
@@ -1023,8 +3151,71 @@ void print_settings_enumNG (FILE * fp)
   if (fp == stdout)
     fprintf (fp, "\nStarting enumNG with the following settings:\n");
 
+  if (glbl_exactOrderMode)
+  {
+    fprintf (fp, " - exact order (queue size: %i", glbl_queueSize);
+    if (glbl_exactQueue != NULL)
+      fprintf (fp, ", spilled: %" PRIu64, glbl_exactQueue->spilledCount);
+    fprintf (fp, ")\n");
+  }
+  else if (glbl_sortedLevelMode)
+    fprintf (fp, " - sorted order (each level sorted by log-probability, queue size: %i)\n", glbl_queueSize);
+  if (glbl_levelRangeMode)
+    fprintf (fp, " - fine-grained levels (no explicit levelChains, pruned by level ranges)\n");
+  if (glbl_constraint != NULL)
+  {
+    if (glbl_constraintCount < UINT64_MAX)
+      fprintf (fp, " - constraints (%" PRIu64 " matching passwords)\n", glbl_constraintCount);
+    else
+      fprintf (fp, " - constraints (more than %" PRIu64 " matching passwords)\n", UINT64_MAX - 1);
+    if (glbl_args_info.mask_given)
+      fprintf (fp, "   - mask: %s\n", glbl_args_info.mask_arg);
+    if (glbl_args_info.prefix_given)
+      fprintf (fp, "   - prefix: %s\n", glbl_args_info.prefix_arg);
+    if (glbl_args_info.suffix_given)
+      fprintf (fp, "   - suffix: %s\n", glbl_args_info.suffix_arg);
+    if (glbl_args_info.infix_given)
+      fprintf (fp, "   - infix: %s\n", glbl_args_info.infix_arg);
+    if (glbl_args_info.minLength_given || glbl_args_info.maxLength_given)
+      fprintf (fp, "   - length: %i to %i\n", glbl_args_info.minLength_given ? glbl_args_info.minLength_arg : 1, glbl_args_info.maxLength_given ? glbl_args_info.maxLength_arg : MAX_PASSWORD_LENGTH - 1);
+    if (glbl_args_info.minLower_arg > 0 || glbl_args_info.minUpper_arg > 0 || glbl_args_info.minDigits_arg > 0 || glbl_args_info.minSpecial_arg > 0)
+      fprintf (fp, "   - at least %i lower, %i upper, %i digits, %i other chars\n", glbl_args_info.minLower_arg, glbl_args_info.minUpper_arg, glbl_args_info.minDigits_arg, glbl_args_info.minSpecial_arg);
+  }
+  if (glbl_sharedModel != NULL)
+    fprintf (fp, " - shared model (%s)\n", glbl_sharedModelName);
+  if (glbl_hashCheckMode)
+    fprintf (fp, " - hash checking (%s, %s, %i threads)\n", glbl_filenameHashes, glbl_args_info.hashType_arg, glbl_hashThreads);
+  if (glbl_ringMode)
+    fprintf (fp, " - ring output (%s, %i batches, timeout %i s)\n", glbl_ringName, glbl_ringSlots, glbl_ringTimeout);
+  if (glbl_scoredMode)
+    fprintf (fp, " - scored output (binary records with the level of each password)\n");
+  if (glbl_filenameFeedback != NULL)
+    fprintf (fp, " - feedback (%s%s)\n", glbl_filenameFeedback, glbl_args_info.feedbackPotfile_flag ? ", potfile" : "");
+  if (glbl_excludeFilter != NULL)
+    fprintf (fp, " - exclusion filter (%s, %" PRIu64 " passwords, %" PRIu64 " KiB)\n", glbl_filenameExclude, glbl_excludeFilter->insertedCount, glbl_excludeFilter->sizeOf_blocks * BLOOMFILTER_BLOCK_WORDS * sizeof (uint64_t) / 1024);
+  if (glbl_adaptAlpha > 0)
+    fprintf (fp, " - online adaptation (alpha: %i, max: %i)\n", glbl_adaptAlpha, glbl_args_info.adaptMax_arg);
+  if (glbl_usernameMode)
+    fprintf (fp, " - username mode (%s, alpha: %i%s, %i threads)\n", glbl_filenameUsername, glbl_args_info.userAlpha_arg, glbl_args_info.boostEP_flag ? ", endProbs boosted" : "", glbl_args_info.userThreads_arg);
+  if (glbl_hybridAttack != NULL)
+    fprintf (fp, " - hybrid mode (%s, %i words, affixes of up to %i chars)\n", glbl_filenameHybrid, glbl_hybridAttack->sizeOf_words, glbl_hybridAffix);
+  if (glbl_ruleEngine != NULL)
+    fprintf (fp, " - rules (%s, %i rules, batches of %i passwords)\n", glbl_filenameRules, glbl_ruleEngine->sizeOf_rules, glbl_rulesBatch);
+  if (glbl_workerMode)
+    fprintf (fp, " - worker (coordinator: %s)\n", glbl_workerAddress);
+  if (glbl_ensembleMode)
+  {
+    fprintf (fp, " - ensemble of %u models (merged by weighted level, filter: at most %i MiB)\n", glbl_args_info.config_given, glbl_args_info.ensembleFilter_arg);
+    for (size_t i = 0; i < glbl_args_info.config_given; i++)
+      fprintf (fp, "   - %s (weight %g)\n", glbl_args_info.config_arg[i], glbl_args_info.weight_given ? glbl_args_info.weight_arg[i] : 1.0);
+  }
+
   if (glbl_fixedLenght != 0)
     fprintf (fp, " - fixedLength (%i)\n", glbl_fixedLenght);
+  else if (glbl_exactOrderMode)
+    fprintf (fp, " - lengthProbs\n");
+  else if (glbl_banditMode)
+    fprintf (fp, " - optimized scheduling (bandit over lengths and initialProb levels, pull size: %i)\n", glbl_pullSize);
   else if (glbl_optimizedLengthMode)
     fprintf (fp, " - optimized length scheduling\n");
   else
@@ -1045,7 +3236,13 @@ void print_settings_enumNG (FILE * fp)
     fprintf (fp, " - endlessMode\n");
 
   if (glbl_simulatedAttMode)
+  {
     fprintf (fp, " - simulatedAttack (target: %s)\n", glbl_filenameTestingSet);
+    if (glbl_subtreeSkipMode)
+      fprintf (fp, " - subtree skipping\n");
+    if (glbl_simThreads > 0)
+      fprintf (fp, " - checking threads (%i, batches of %i candidates)\n", glbl_simThreads, SIMATT_BATCH_SIZE);
+  }
   else
     fprintf (fp, " - normalMode\n");
   print_settings_default (fp, glbl_nGramLevel->sizeOf_N, glbl_alphabet, glbl_filenames, glbl_maxLevel, glbl_verboseFileMode);
@@ -1053,6 +3250,25 @@ void print_settings_enumNG (FILE * fp)
   fprintf (fp, "\n");
 }
 
+/* (intern function) Prints the amount of cracked passwords read from the feedback file (overall and by length) */
+void print_feedbackResults (FILE * fp)
+{
+  feedback_poll (glbl_feedback);  // include the passwords cracked since the last poll
+  fprintf (fp, "feedback: %" PRIu64 " cracked passwords read from '%s'", glbl_feedback->crackedCount, glbl_filenameFeedback);
+  if (glbl_feedback->ignoredCount > 0)
+    fprintf (fp, " (%" PRIu64 " lines ignored)", glbl_feedback->ignoredCount);
+  fprintf (fp, "\n\nlengths of the cracked passwords (length - cracked)\n");
+  for (size_t i = 0; i < MAX_PASSWORD_LENGTH; i++)
+    if (glbl_feedback->crackedLengths[i] > 0)
+      fprintf (fp, "%2zu - %9" PRIu64 "\n", i + 1, glbl_feedback->crackedLengths[i]);
+}                               // print_feedbackResults
+
+/* (intern function) Prints the amount of passwords dropped by the exclusion filter */
+void print_excludedResults (FILE * fp)
+{
+  fprintf (fp, "excluded: %" PRIu64 " passwords found in the filter of earlier attacks ('%s')\n", glbl_excludedCount, glbl_filenameExclude);
+}                               // print_excludedResults
+
 // prints the selected parameters
 void print_report_enumNG (FILE * fp)
 {
@@ -1060,9 +3276,27 @@ void print_report_enumNG (FILE * fp)
     fprintf (fp, "\nResults: \ncreated: %" PRIu64 "\n", glbl_attemptsCount);  // ... just print created count
   else
     fprintf (fp, "\nResults: \ncreated: %" PRIu64 " of %" PRIu64 "\n", glbl_attemptsCount, glbl_attemptsMax);
+  if (glbl_excludeFilter != NULL)
+    print_excludedResults (fp);
+  if (glbl_hybridAttack != NULL)
+    hybridAttack_printResults (glbl_hybridAttack, fp);
+  if (glbl_ruleEngine != NULL)
+    ruleEngine_printResults (glbl_ruleEngine, fp);
+  if (glbl_workerMode)
+    fprintf (fp, "work units: %" PRIu64 " completed (%" PRIu64 " parts split off)\n", glbl_workerUnits, glbl_workerSplits);
 
   if (glbl_simulatedAttMode)
     print_simulatedAttackResults (fp, false);
+  else if (glbl_usernameAttack != NULL)
+    usernameAttack_printResults (glbl_usernameAttack, fp);
+  else if (glbl_hashChecker != NULL)
+    hashChecker_printResults (glbl_hashChecker, fp);
+  if (glbl_ensemble != NULL)
+    ensemble_printResults (glbl_ensemble, glbl_args_info.config_arg, fp);
+  if (glbl_feedback != NULL)
+    print_feedbackResults (fp);
+  if (glbl_adaptation != NULL)
+    adaptation_printResults (glbl_adaptation, fp);
   fprintf (fp, "\n");
 }                               // print_report
 
@@ -1109,8 +3343,14 @@ bool print_log ()
       {
         int count = 0;
 
-        for (size_t j = 0; j < glbl_sortedLastGram[i].sizeOf_mGram; j++)
-          count += glbl_sortedLastGram[i].indexCur[j];
+        if (glbl_levelRangeMode)
+        {
+          // no lastGrams sorted per level, count the levels instead
+          for (size_t j = 0; j < glbl_nGramLevel->sizeOf_cP; j++)
+            count += (glbl_nGramLevel->cP[j] == i);
+        }
+        else
+          count = glbl_sortedLastGram[i].indexStart[glbl_sortedLastGram[i].sizeOf_mGram];
         fprintf (fp, "%2zu - %9i\n", i, count);
       }
       fprintf (fp, "\ninitial Prob (level - count):\n");
@@ -1136,17 +3376,77 @@ bool print_log ()
       fprintf (fp, "TestingSet file: '%s'\n", glbl_filenameTestingSet);
       fprintf (fp, "created: %" PRIu64 " of %" PRIu64 "\n", glbl_attemptsCount, glbl_attemptsMax);
       print_simulatedAttackResults (fp, true);
+      if (glbl_ensemble != NULL)
+      {
+        fprintf (fp, "\n== Ensemble ==\n");
+        ensemble_printResults (glbl_ensemble, glbl_args_info.config_arg, fp);
+      }
+      if (glbl_adaptation != NULL)
+      {
+        fprintf (fp, "\n");
+        adaptation_printResults (glbl_adaptation, fp);
+      }
     }
     else
     {                           // glbl_simulatedAttMode == false
-      if (glbl_pipeMode)
+      if (glbl_usernameMode)
+        fprintf (fp, "\n== Username mode ==\nUsername file: '%s'\n", glbl_filenameUsername);
+      else if (glbl_pipeMode)
         fprintf (fp, "\n== Password pipe mode ==\n");
+      else if (glbl_hashChecker != NULL)
+        fprintf (fp, "\n== Hash checking mode ==\nHashes file: '%s'\n", glbl_filenameHashes);
+      else if (glbl_ringMode)
+        fprintf (fp, "\n== Password ring mode (%s) ==\n", glbl_ringName);
       else
         fprintf (fp, "\n== Password creator mode ==\n");
-      fprintf (fp, "\ncreated: %" PRIu64 " of %" PRIu64 "\n", glbl_attemptsCount, glbl_attemptsMax);
-      fprintf (fp, "\nlengths of the created passwords (length - created)\n");
-      for (size_t i = glbl_nGramLevel->sizeOf_N; i < MAX_PASSWORD_LENGTH; i++)
-        fprintf (fp, "%2zu - %9" PRIu64 "\n", i + 1, glbl_createdLengths[i]);
+      if (glbl_usernameAttack != NULL)
+      {
+        // the passwords are counted for each user (at most maxAttempts each), not created
+        fprintf (fp, "\ncounted: %" PRIu64 "\n\n", glbl_attemptsCount);
+        usernameAttack_printResults (glbl_usernameAttack, fp);
+      }
+      else
+      {
+        fprintf (fp, "\ncreated: %" PRIu64 " of %" PRIu64 "\n", glbl_attemptsCount, glbl_attemptsMax);
+        fprintf (fp, "\nlengths of the created passwords (length - created)\n");
+        for (size_t i = glbl_nGramLevel->sizeOf_N; i < MAX_PASSWORD_LENGTH; i++)
+          fprintf (fp, "%2zu - %9" PRIu64 "\n", i + 1, glbl_createdLengths[i]);
+      }
+      if (glbl_hashChecker != NULL)
+      {
+        fprintf (fp, "\n");
+        hashChecker_printResults (glbl_hashChecker, fp);
+      }
+      if (glbl_ensemble != NULL)
+      {
+        fprintf (fp, "\n== Ensemble ==\n");
+        ensemble_printResults (glbl_ensemble, glbl_args_info.config_arg, fp);
+      }
+      if (glbl_feedback != NULL)
+      {
+        fprintf (fp, "\n");
+        print_feedbackResults (fp);
+      }
+      if (glbl_adaptation != NULL)
+      {
+        fprintf (fp, "\n");
+        adaptation_printResults (glbl_adaptation, fp);
+      }
+    }
+    if (glbl_hybridAttack != NULL)
+    {
+      fprintf (fp, "\n");
+      hybridAttack_printResults (glbl_hybridAttack, fp);
+    }
+    if (glbl_ruleEngine != NULL)
+    {
+      fprintf (fp, "\n");
+      ruleEngine_printResults (glbl_ruleEngine, fp);
+    }
+    if (glbl_excludeFilter != NULL)
+    {
+      fprintf (fp, "\n");
+      print_excludedResults (fp);
     }
   }
 
@@ -1162,6 +3462,13 @@ bool print_log ()
 // ctrl-c handler
 void sigint_handler (int s)
 {
+  // the ring producer may wait for the consumers, it stops and exits at the next password (see output_password)
+  if (glbl_ring != NULL)
+  {
+    glbl_ringSignal = s;
+    candidateRing_stop ();
+    return;
+  }
   if (glbl_verboseMode)
   {
     fprintf (stderr, "\nExiting ok...\n");
@@ -1276,6 +3583,7 @@ bool boostingMode ()
     struct_sortedLastGram_free (glbl_maxLevel, &glbl_sortedLastGram);
     struct_sortedIP_free (glbl_maxLevel, &glbl_sortedIP);
     struct_sortedLength_free (&glbl_sortedLength);
+    levelRange_free (&glbl_levelRange);
     for (int i = 0; i < alpha_count; i++)
     {
       free (hints[i]);
@@ -1288,3 +3596,25 @@ bool boostingMode ()
   free (alphas);
   return true;
 }
+
+// targeted guessing of the passwords of the given users
+bool usernameMode ()
+{
+  // generate sorted arrays (shared by all users, the hints of each user are boosted on top of them)
+  if (!sort_ngrams ())
+  {
+    errorHandler_print (errorType_Error, "Failed to sort ngrams\n");
+    return false;
+  }
+  if (glbl_levelRangeMode)
+  {
+    errorHandler_print (errorType_Error, "The username mode needs levelChains, which are not used for fine-grained levels.\n");
+    return false;
+  }
+
+  usernameAttack_initialize (&glbl_usernameAttack, glbl_nGramLevel, glbl_alphabet, glbl_sortedLastGram, glbl_sortedIP, glbl_sortedLength, glbl_maxLevel, glbl_args_info.userAlpha_arg, glbl_args_info.boostEP_flag, glbl_ignoreEPMode, glbl_fixedLenght, glbl_attemptsMax, glbl_args_info.userThreads_arg);
+  if (!usernameAttack_run (glbl_usernameAttack, glbl_filenameUsername, glbl_FP_generatedPasswords))
+    return false;
+  glbl_attemptsCount = glbl_usernameAttack->attemptsCount;
+  return true;
+}                               // usernameMode
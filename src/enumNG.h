@@ -67,10 +67,58 @@ bool sort_ngrams ();
  *  equals the global variable @attemptsMax.
  *  run_enumeration_fixedLenghts() works just like run_enumeration(), but
  *  for a fixed length only (set by argument -L)
+ *  run_enumeration_optimizedLengths() schedules the length with the highest
+ *  crack rate next (-O). The crack rates are taken from the simulated attack,
+ *  the hash checking or the feedback file (--feedback); since the latter two
+ *  report cracks with a delay, each crack is credited to its own length.
+ *  With --scheduler bandit, run_enumeration_optimizedLengths() calls
+ *  run_enumeration_bandit(), which pulls arms of a length and initialProb
+ *  level chosen by a multi-armed bandit (see banditScheduler.h) instead.
  */
 void run_enumeration ();
 void run_enumeration_fixedLenghts ();
 void run_enumeration_optimizedLengths ();
+void run_enumeration_bandit ();
+
+/*
+ *  Alternative enumeration engine (--order exact): instead of levelChains,
+ *  the fixed point log-probabilities (see createNG --exact) are used to
+ *  create the passwords in exact descending probability (length, initialProb,
+ *  conditionalProbs and endProb). The partial passwords are stored in a
+ *  bounded priority queue (see probQueue.h), which spills to disk if needed.
+ */
+void run_enumeration_exact ();
+
+/*
+ *  Ensemble enumeration (-C given multiple times): the models of all configs
+ *  are enumerated at once and their passwords are handled in ascending
+ *  weighted level (see ensemble.h), dropping the passwords already created
+ *  by any model.
+ */
+void run_enumeration_ensemble ();
+
+/*
+ *  Hybrid enumeration (--hybrid): the words of the wordlist are combined with
+ *  prefixes and suffixes (see hybridAttack.h). The word with the smallest
+ *  level of its next candidates is taken from the queue, its suffixes are
+ *  created using the sorted lastGrams (following the last (n-1) chars of the
+ *  word) and its prefixes from right to left (preceding the first (n-1)
+ *  chars of the word). The outermost char of an affix is taken from the
+ *  symbols adding exactly the remaining level.
+ */
+void run_enumeration_hybrid ();
+
+/*
+ *  Worker mode (--worker): requests the work units of the coordinator
+ *  (omenCoord, see workUnit.h) one by one, enumerates the passwords of each
+ *  unit and reports the amount of created passwords, until the coordinator
+ *  has no further unit or as many passwords as glbl_attemptsMax have been
+ *  created. The ranges of indices at each depth of the subtree are kept in
+ *  global arrays, so a split request of the coordinator (checked every
+ *  WORKUNIT_CHECK_INTERVAL nodes) can give away a part of the unit while it
+ *  is enumerated.
+ */
+void run_enumeration_worker ();
 
 /*
  * Generates the next levelChain based on the given @levelChain, with
@@ -97,6 +145,56 @@ bool getNext_levelChain (int levelChain[MAX_PASSWORD_LENGTH], // next levelChain
 bool enumerate_password (int levelChain[MAX_PASSWORD_LENGTH], // levelChain specifying the level of each char in the passwords
                          int lengthMax);  // length of the passwords to be generated
 
+/*
+ * Generates all passwords with a length of @lengthPW and the overall level
+ * @level (without the level of the length). By default, all levelChains
+ * (with a length of @lengthLC) of this level are created using
+ * getNext_levelChain and enumerate_password is called for each of them.
+ * For fine-grained levels (maxLevel > MAX_LEVEL), the passwords are created
+ * without explicit levelChains (see levelRange.h), since their amount
+ * explodes with the maxLevel.
+ * Returns FALSE if as many passwords as glbl_attemptsMax have been created.
+ */
+bool enumerate_level (int lengthLC, // length of the levelChains
+                      int lengthPW, // length of the passwords to be generated
+                      int level); // overall level of the passwords (without the length level)
+
+/*
+ * Sorted level order (--order sorted): the passwords created by
+ * enumerate_level are buffered (see probQueue.h, spilled to disk if the
+ * queue is full) instead of being handled directly. Once a level is
+ * complete, this function handles its passwords in descending probability
+ * (using the fixed point log-probabilities, see createNG --exact).
+ * Returns FALSE if as many passwords as glbl_attemptsMax have been created.
+ */
+bool flush_sortedLevel ();
+
+/*
+ * Online adaptation (--adapt): applies the passwords cracked since the last
+ * call to the model (see adaptation.h). Must be called at a level boundary,
+ * @frontier contains the next level of each length (0 if no level of the
+ * length has been enumerated yet or all of them have been). The passwords
+ * moved below this level are enumerated right away.
+ * Returns FALSE if as many passwords as glbl_attemptsMax have been created.
+ */
+bool adapt_levelBoundary (const int frontier[MAX_PASSWORD_LENGTH]);
+
+/*
+ * Mangling rules (--rules): applies each rule (by priority, see
+ * ruleEngine.h) to all passwords of the current batch and handles the
+ * results like any created password. The batch is cleared afterwards.
+ * Returns FALSE if as many passwords as glbl_attemptsMax have been created.
+ */
+bool handle_ruleBatch ();
+
+/*
+ * Simulated attack: handles a password of the testing set cracked by the
+ * candidate with the guess number @attempt (online adaptation, verbose
+ * file). Called in order of the guess numbers, by the checking threads
+ * (--simThreads) once the batch of the candidate has been checked.
+ */
+void handle_crackedPassword (const char *passwordAsChar, int length, uint64_t attempt);
+
 /*
  * Creates a new result folder under the subfolder "results". The created
  * folder is named after the current date and time ("Year-Mon-Day_Hou.Min").
@@ -129,6 +227,15 @@ bool boost_allHints ();
 
 bool boostingMode ();
 
+/*
+ * Username mode (-u): derives hints from the username of each user and
+ * returns the guess number of its password under the model boosted by
+ * them (see usernameAttack.h), written to guessNumbers.txt (or stdout in
+ * pipe mode). The users are handled by --userThreads threads.
+ * Returns FALSE if the username file can't be read.
+ */
+bool usernameMode ();
+
 /*
  * Handles signal "ctrl + c" for application abortion
  */
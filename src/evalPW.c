@@ -18,14 +18,22 @@
 #include "commonStructs.h"
 #include "errorHandler.h"
 #include "nGramReader.h"
+#include "scoringServer.h"
+#include "sharedModel.h"
 
 struct filename_struct *glbl_filenamesIn = NULL;
 struct alphabet_struct *glbl_alphabet = NULL;
 struct nGram_struct *glbl_nGramLevel = NULL;
 
-char glbl_maxLevel = MAX_LEVEL;
+int glbl_maxLevel = MAX_LEVEL;
 char *glbl_password = NULL;
 bool glbl_verboseMode = false;
+bool glbl_serveMode = false;    // answer queries on a Unix domain socket [--serve <filename>]
+char *glbl_socketFilename = NULL; // socket used in serveMode
+int glbl_serveThreads = 0;      // amount of threads answering queries [--threads]
+int glbl_serveSamples = 0;      // amount of passwords sampled per length to estimate guess numbers [--samples]
+char *glbl_sharedModelName = NULL;  // name of the shared memory segment [--shm <name>]
+sharedModel_struct *glbl_sharedModel = NULL;  // attached segment containing the nGram arrays
 struct gengetopt_args_info glbl_args_info;
 
 int main (int argc, char **argv)
@@ -44,6 +52,14 @@ int main (int argc, char **argv)
   if (!evaluate_arguments (&glbl_args_info))
     exit (1);
 
+  // the server reads (and reloads) the model by itself
+  if (glbl_serveMode)
+  {
+    if (!scoringServer_run (glbl_socketFilename, glbl_filenamesIn->cfg, glbl_serveThreads, glbl_serveSamples, glbl_verboseMode))
+      exit (1);
+    exit (EXIT_SUCCESS);
+  }
+
   if (!apply_settings ())
     exit (1);
 
@@ -78,13 +94,16 @@ void initialize ()
 void exit_routine ()
 {
   // free all pointer using the CHECKED_FREE operation (defined in common.h)
-  // count arrays
+  // count arrays (the arrays of the shared model are only detached)
+  sharedModel_detach (&glbl_sharedModel, glbl_nGramLevel, glbl_maxLevel, NULL, NULL);
+  CHECKED_FREE (glbl_sharedModelName);
   struct_nGrams_free (&glbl_nGramLevel);
   // alphabet
   struct_alphabet_free (&glbl_alphabet);
   // filenames
   struct_filenames_free (&glbl_filenamesIn);
   CHECKED_FREE (glbl_password);
+  CHECKED_FREE (glbl_socketFilename);
 
   print_timestamp ("End:");
 
@@ -110,11 +129,48 @@ bool evaluate_arguments (struct gengetopt_args_info *args_info)
     glbl_verboseMode = true;
   }
 
+  if (args_info->serve_given)
+  {
+    result &= changeFilename (&glbl_socketFilename, FILENAME_MAX, "socket", args_info->serve_arg);
+    glbl_serveMode = true;
+    glbl_serveThreads = args_info->threads_arg;
+    if (glbl_serveThreads < 1 || glbl_serveThreads > SCORINGSERVER_MAX_THREADS)
+    {
+      errorHandler_print (errorType_Error, "The amount of threads must be in range 1 to %i.\n", SCORINGSERVER_MAX_THREADS);
+      return false;
+    }
+    glbl_serveSamples = args_info->samples_arg;
+    if (glbl_serveSamples < 1)
+    {
+      errorHandler_print (errorType_Error, "The amount of samples must be at least 1.\n");
+      return false;
+    }
+  }
+
+  if (args_info->shm_given)
+  {
+    if (glbl_serveMode)
+    {
+      errorHandler_print (errorType_Error, "The shared model is not supported by --serve.\n");
+      return false;
+    }
+    result &= changeFilename (&glbl_sharedModelName, FILENAME_MAX, "shared memory", args_info->shm_arg);
+  }
+
   if (errorHandler_errorOccurred ())
   {
     return false;
   }
 
+  if (glbl_serveMode)
+    return result;
+
+  if (!args_info->pw_given)
+  {
+    errorHandler_print (errorType_Error, "A password to evaluate (--pw) is required unless --serve is given.\n");
+    return false;
+  }
+
   if (strlen (args_info->pw_arg) > MAX_PASSWORD_LENGTH)
   {
     errorHandler_print (errorType_Error, "The password should not be longer then %i characters.\n", MAX_PASSWORD_LENGTH);
@@ -134,6 +190,8 @@ bool evaluate_arguments (struct gengetopt_args_info *args_info)
 
 bool apply_settings ()
 {
+  if (glbl_sharedModelName != NULL)
+    return sharedModel_attach (&glbl_sharedModel, glbl_sharedModelName, glbl_nGramLevel, glbl_alphabet, glbl_filenamesIn, &glbl_maxLevel, NULL, NULL);
   if (!read_inputFiles (glbl_nGramLevel, glbl_alphabet, glbl_filenamesIn, &glbl_maxLevel))
     return false;
   return true;
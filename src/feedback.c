@@ -0,0 +1,189 @@
+/*
+ * feedback.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "feedback.h"
+#include "errorHandler.h"
+
+/* (intern function) Opens the feedback file if it exists, starting at its end (regular files only). Returns FALSE if it exists but can't be opened. */
+bool open_feedbackFile (feedback_struct * feedback)
+{
+  struct stat fileStat;
+
+  feedback->fd = open (feedback->filename, O_RDONLY | O_NONBLOCK);
+  if (feedback->fd < 0)
+  {
+    if (errno == ENOENT)
+      return true;              // not created yet
+    errorHandler_print (errorType_Error, "Can't open feedback file %s: %s\n", feedback->filename, strerror (errno));
+    return false;
+  }
+  if (fstat (feedback->fd, &fileStat) == 0 && S_ISREG (fileStat.st_mode))
+    lseek (feedback->fd, 0, SEEK_END);
+  return true;
+}                               // open_feedbackFile
+
+/* (intern function) Sets @password to the password in the given @line (without line break, $HEX[...] decoded) and returns its length or -1 if there is none */
+int get_feedbackPassword (const feedback_struct * feedback, const char *line, int length, char password[MAX_LINE_LENGTH])
+{
+  const char *begin = line;
+  unsigned int byte = 0;
+
+  if (length > 0 && line[length - 1] == '\r')
+    length--;
+  if (feedback->potfile)
+  {
+    // the hash may contain ':' (salted hashes, e.g. "hash:salt:password")
+    begin = line + length;
+    while (begin > line && begin[-1] != ':')
+      begin--;
+    if (begin == line)
+      return -1;
+    length -= begin - line;
+  }
+  // hashcat encodes passwords with special chars as $HEX[...]
+  if (length >= 6 && strncmp (begin, "$HEX[", 5) == 0 && begin[length - 1] == ']')
+  {
+    length = (length - 6) / 2;
+    for (int i = 0; i < length; i++)
+    {
+      if (sscanf (begin + 5 + 2 * i, "%2x", &byte) != 1)
+        return -1;
+      password[i] = (char) byte;
+    }
+    return length;
+  }
+  memcpy (password, begin, length);
+  return length;
+}                               // get_feedbackPassword
+
+/* (intern function) Counts the password of the given @line and adds it to the queue of recent passwords */
+void add_feedbackLine (feedback_struct * feedback, const char *line, int length)
+{
+  char password[MAX_LINE_LENGTH];
+  int recent = 0;
+
+  length = get_feedbackPassword (feedback, line, length, password);
+  if (length < 1 || length > MAX_PASSWORD_LENGTH)
+  {
+    if (length != 0)
+      feedback->ignoredCount++;
+    return;
+  }
+  feedback->crackedLengths[length - 1]++;
+  feedback->crackedCount++;
+  if (feedback->sizeOf_recent < FEEDBACK_RECENT)
+  {
+    recent = (feedback->recentFirst + feedback->sizeOf_recent) % FEEDBACK_RECENT;
+    memcpy (feedback->recentPasswords[recent], password, length);
+    feedback->recentLengths[recent] = length;
+    feedback->sizeOf_recent++;
+  }
+}                               // add_feedbackLine
+
+// opens the feedback file
+bool feedback_open (feedback_struct ** feedback, const char *filename, bool potfile)
+{
+  (*feedback) = malloc (sizeof (feedback_struct));
+  EXIT_IF_NULL (*feedback);
+  (*feedback)->filename = NULL;
+  (*feedback)->fd = -1;
+  (*feedback)->potfile = potfile;
+  (*feedback)->sizeOf_partial = 0;
+  memset ((*feedback)->crackedLengths, 0, sizeof ((*feedback)->crackedLengths));
+  (*feedback)->crackedCount = 0;
+  (*feedback)->ignoredCount = 0;
+  (*feedback)->recentFirst = 0;
+  (*feedback)->sizeOf_recent = 0;
+  if (!str_allocCpy (&((*feedback)->filename), filename))
+  {
+    printf ("Error: Out of Memory\n");
+    exit (1);
+  }
+
+  if (!open_feedbackFile (*feedback))
+  {
+    feedback_close (feedback);
+    return false;
+  }
+  return true;
+}                               // feedback_open
+
+// reads the lines appended since the last call
+void feedback_poll (feedback_struct * feedback)
+{
+  char buffer[4096];
+  ssize_t sizeOf_buffer;
+  struct stat fileStat;
+
+  if (feedback->fd < 0)
+  {
+    // wait for the file to be created, reading it from the beginning
+    feedback->fd = open (feedback->filename, O_RDONLY | O_NONBLOCK);
+    if (feedback->fd < 0)
+      return;
+  }
+  else if (fstat (feedback->fd, &fileStat) == 0 && S_ISREG (fileStat.st_mode) && fileStat.st_size < lseek (feedback->fd, 0, SEEK_CUR))
+  {
+    // truncated: read it from the beginning
+    lseek (feedback->fd, 0, SEEK_SET);
+    feedback->sizeOf_partial = 0;
+  }
+
+  // EOF (0) or EAGAIN (-1) if nothing new has been written
+  while ((sizeOf_buffer = read (feedback->fd, buffer, sizeof (buffer))) > 0)
+  {
+    for (ssize_t i = 0; i < sizeOf_buffer; i++)
+    {
+      if (buffer[i] == '\n')
+      {
+        if (feedback->sizeOf_partial >= 0)
+          add_feedbackLine (feedback, feedback->partial, feedback->sizeOf_partial);
+        else
+          feedback->ignoredCount++;
+        feedback->sizeOf_partial = 0;
+      }
+      else if (feedback->sizeOf_partial >= 0)
+      {
+        if (feedback->sizeOf_partial < MAX_LINE_LENGTH)
+          feedback->partial[feedback->sizeOf_partial++] = buffer[i];
+        else
+          feedback->sizeOf_partial = -1;  // too long, skip the rest of the line
+      }
+    }
+  }
+}                               // feedback_poll
+
+// takes the next cracked password
+bool feedback_nextCracked (feedback_struct * feedback, char password[MAX_PASSWORD_LENGTH], int *length)
+{
+  if (feedback->sizeOf_recent == 0)
+    return false;
+  *length = feedback->recentLengths[feedback->recentFirst];
+  memcpy (password, feedback->recentPasswords[feedback->recentFirst], *length);
+  feedback->recentFirst = (feedback->recentFirst + 1) % FEEDBACK_RECENT;
+  feedback->sizeOf_recent--;
+  return true;
+}                               // feedback_nextCracked
+
+// closes the feedback file
+void feedback_close (feedback_struct ** feedback)
+{
+  if (*feedback == NULL)
+    return;
+  if ((*feedback)->fd >= 0)
+    close ((*feedback)->fd);
+  CHECKED_FREE ((*feedback)->filename);
+  free (*feedback);
+  (*feedback) = NULL;
+}                               // feedback_close
@@ -0,0 +1,78 @@
+/*
+ * feedback.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Used by enumNG (--feedback) to read the passwords cracked by an external
+ * password cracker (e.g. a potfile written by hashcat or a FIFO), so the
+ * optimized length scheduling can adapt to the actual cracks outside of a
+ * simulated attack.
+ * The file is read like "tail -f": only lines appended after opening it are
+ * read, without ever blocking. A file which doesn't exist yet is opened once
+ * it has been created, a truncated file is read from the beginning again.
+ * Each line contains a single password or, for potfiles, "hash:password"
+ * as written by hashcat or john (the password follows the last ':', so the
+ * hash may contain salts separated by ':', while passwords containing ':'
+ * must be encoded as $HEX[...]). Passwords encoded as $HEX[...] are counted
+ * with their decoded length.
+ *
+ */
+
+#ifndef FEEDBACK_H_
+#define FEEDBACK_H_
+
+#include <stdint.h>
+
+#include "common.h"
+
+// === Defines ===
+#define FEEDBACK_RECENT 1024     // cracked passwords kept until taken (see feedback_nextCracked)
+
+/*
+ * State of the feedback file.
+ */
+typedef struct feedback_struct
+{
+  char *filename;               // file (or FIFO) to read
+  int fd;                       // file descriptor (-1 if not opened yet)
+  bool potfile;                 // TRUE, if the lines are "hash:password"
+  char partial[MAX_LINE_LENGTH];  // begin of a line not completely written yet
+  int sizeOf_partial;           // length of @partial (-1 while skipping a too long line)
+
+  uint64_t crackedLengths[MAX_PASSWORD_LENGTH]; // cracked passwords by length (index: length - 1)
+  uint64_t crackedCount;        // amount of cracked passwords
+  uint64_t ignoredCount;        // amount of lines with an unsupported length
+
+  char recentPasswords[FEEDBACK_RECENT][MAX_PASSWORD_LENGTH]; // cracked passwords not taken yet (queue)
+  int recentLengths[FEEDBACK_RECENT];
+  int recentFirst;              // index of the oldest password in the queue
+  int sizeOf_recent;            // amount of passwords in the queue
+} feedback_struct;
+
+/*
+ * Opens the given feedback file (or FIFO), skipping its current content.
+ * Returns FALSE if the file exists but can't be read.
+ */
+bool feedback_open (feedback_struct ** feedback,  // feedback to be initialized
+                    const char *filename, // file or FIFO containing the cracked passwords
+                    bool potfile);  // lines are "hash:password"
+
+/*
+ * Reads all lines appended since the last call (without blocking) and adds
+ * the cracked passwords to @crackedLengths and @crackedCount.
+ */
+void feedback_poll (feedback_struct * feedback);
+
+/*
+ * Takes the next password read since the last call (oldest first, $HEX[...]
+ * decoded). At most FEEDBACK_RECENT passwords are kept, any further one is
+ * only counted. Returns FALSE if there is none.
+ */
+bool feedback_nextCracked (feedback_struct * feedback, char password[MAX_PASSWORD_LENGTH], int *length);
+
+/*
+ * Closes and frees the given feedback (if not NULL).
+ */
+void feedback_close (feedback_struct ** feedback);
+
+#endif /* FEEDBACK_H_ */
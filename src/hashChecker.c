@@ -0,0 +1,798 @@
+/*
+ * hashChecker.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <crypt.h>
+
+#include "hashChecker.h"
+#include "errorHandler.h"
+#include "uthash.h"
+
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+/*
+ * Single hash of the hash file.
+ */
+typedef struct hashChecker_entry
+{
+  unsigned char digest[HASHCHECKER_MAX_DIGEST]; // digest (unsalted hashes only)
+  char *hash;                   // hash as given in the hash file
+  int cracked;                  // set once cracked (accessed atomically)
+  UT_hash_handle hh;            // makes this structure hashable (by digest)
+} hashChecker_entry;
+
+/*
+ * Passwords hashed by the threads at once. A batch is either filled by
+ * enumNG or hashed by the threads, never both.
+ */
+typedef struct hashChecker_batch
+{
+  char passwords[HASHCHECKER_BATCH_SIZE][MAX_PASSWORD_LENGTH];  // passwords (not null terminated)
+  unsigned char lengths[HASHCHECKER_BATCH_SIZE];  // length of each password
+  int count;                    // amount of passwords in the batch
+  uint64_t firstAttempt;        // guess number of the first password
+  int next;                     // index of the next password handed to a thread (accessed atomically)
+
+  // cracked hashes (rare, so guarded by a mutex)
+  pthread_mutex_t crackedMutex;
+  int *crackedIndex;            // index of the cracking password
+  hashChecker_entry **crackedEntry; // cracked hash
+  int sizeOf_cracked;           // amount of cracked hashes
+  int maxOf_cracked;            // allocated size of @crackedIndex and @crackedEntry
+} hashChecker_batch;
+
+struct hashChecker_struct
+{
+  hashType type;
+  int sizeOf_digest;            // size of the digests (unsalted hashes only)
+  hashChecker_entry *entries;   // all hashes
+  int sizeOf_entries;           // amount of hashes
+  int sizeOf_unique;            // amount of different hashes (unsalted hashes listed several times are checked once)
+  hashChecker_entry *table;     // hashmap of the digests (unsalted hashes only)
+  FILE *potfile;
+  FILE *crackedFile;
+
+  // results (only accessed by enumNG)
+  int crackedCount;             // amount of cracked hashes
+  uint64_t crackedLengths[MAX_PASSWORD_LENGTH]; // cracked hashes by password length
+  char recentPasswords[HASHCHECKER_RECENT][MAX_PASSWORD_LENGTH];  // cracked passwords not taken yet (queue)
+  int recentLengths[HASHCHECKER_RECENT];
+  int recentFirst;              // index of the oldest password in the queue
+  int sizeOf_recent;            // amount of passwords in the queue
+
+  // batches
+  hashChecker_batch *batches[2];  // filled and hashed alternately
+  int batchCur;                 // batch filled by enumNG
+  int batchLimit;               // amount of passwords per batch
+  bool batchHashing;            // TRUE, while the other batch is hashed by the threads
+
+  // threads
+  pthread_t *threads;
+  int sizeOf_threads;
+  pthread_mutex_t mutex;
+  pthread_cond_t condStart;     // signaled, once a batch is handed to the threads
+  pthread_cond_t condDone;      // signaled, once all threads are done with the batch
+  uint64_t generation;          // increased for each batch handed to the threads
+  int threadsDone;              // amount of threads done with the current batch
+  bool shutdown;                // TRUE, if the threads should exit
+};
+
+/*
+ * State of a single hashing thread.
+ */
+typedef struct hashChecker_thread
+{
+  hashChecker_struct *checker;
+  struct crypt_data cryptData;  // used for bcrypt only
+} hashChecker_thread;
+
+// === hash functions (multi-buffer) ===
+/*
+ * The words of the (single) message block of each lane are stored as
+ * block[word][lane]. Passwords have at most MAX_PASSWORD_LENGTH chars
+ * (2 * MAX_PASSWORD_LENGTH bytes for NTLM), so a single block is enough.
+ */
+
+const uint32_t md5_K[64] = {
+  0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+  0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+  0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+  0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+  0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+  0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+  0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+  0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+const int md5_S[64] = {
+  7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+  5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+  4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+  6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+};
+
+const int md4_word[48] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+  0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+  0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15
+};
+
+const int md4_S[48] = {
+  3, 7, 11, 19, 3, 7, 11, 19, 3, 7, 11, 19, 3, 7, 11, 19,
+  3, 5, 9, 13, 3, 5, 9, 13, 3, 5, 9, 13, 3, 5, 9, 13,
+  3, 9, 11, 15, 3, 9, 11, 15, 3, 9, 11, 15, 3, 9, 11, 15
+};
+
+/* (intern function) MD5 of a single block for all lanes */
+void md5_lanes (uint32_t block[16][HASHCHECKER_LANES], uint32_t state[4][HASHCHECKER_LANES])
+{
+  uint32_t a[HASHCHECKER_LANES], b[HASHCHECKER_LANES], c[HASHCHECKER_LANES], d[HASHCHECKER_LANES];
+  uint32_t f = 0, tmp = 0;
+  int g = 0;
+
+  for (int l = 0; l < HASHCHECKER_LANES; l++)
+  {
+    a[l] = 0x67452301;
+    b[l] = 0xefcdab89;
+    c[l] = 0x98badcfe;
+    d[l] = 0x10325476;
+  }
+  for (int i = 0; i < 64; i++)
+  {
+    if (i < 16)
+      g = i;
+    else if (i < 32)
+      g = (5 * i + 1) % 16;
+    else if (i < 48)
+      g = (3 * i + 5) % 16;
+    else
+      g = (7 * i) % 16;
+    for (int l = 0; l < HASHCHECKER_LANES; l++)
+    {
+      if (i < 16)
+        f = (b[l] & c[l]) | (~b[l] & d[l]);
+      else if (i < 32)
+        f = (d[l] & b[l]) | (~d[l] & c[l]);
+      else if (i < 48)
+        f = b[l] ^ c[l] ^ d[l];
+      else
+        f = c[l] ^ (b[l] | ~d[l]);
+      tmp = d[l];
+      d[l] = c[l];
+      c[l] = b[l];
+      f = a[l] + f + md5_K[i] + block[g][l];
+      b[l] = b[l] + ROTL32 (f, md5_S[i]);
+      a[l] = tmp;
+    }
+  }
+  for (int l = 0; l < HASHCHECKER_LANES; l++)
+  {
+    state[0][l] = a[l] + 0x67452301;
+    state[1][l] = b[l] + 0xefcdab89;
+    state[2][l] = c[l] + 0x98badcfe;
+    state[3][l] = d[l] + 0x10325476;
+  }
+}                               // md5_lanes
+
+/* (intern function) MD4 of a single block for all lanes */
+void md4_lanes (uint32_t block[16][HASHCHECKER_LANES], uint32_t state[4][HASHCHECKER_LANES])
+{
+  uint32_t a[HASHCHECKER_LANES], b[HASHCHECKER_LANES], c[HASHCHECKER_LANES], d[HASHCHECKER_LANES];
+  uint32_t f = 0, tmp = 0;
+
+  for (int l = 0; l < HASHCHECKER_LANES; l++)
+  {
+    a[l] = 0x67452301;
+    b[l] = 0xefcdab89;
+    c[l] = 0x98badcfe;
+    d[l] = 0x10325476;
+  }
+  for (int i = 0; i < 48; i++)
+  {
+    for (int l = 0; l < HASHCHECKER_LANES; l++)
+    {
+      if (i < 16)
+        f = ((b[l] & c[l]) | (~b[l] & d[l]));
+      else if (i < 32)
+        f = ((b[l] & c[l]) | (b[l] & d[l]) | (c[l] & d[l])) + 0x5a827999;
+      else
+        f = (b[l] ^ c[l] ^ d[l]) + 0x6ed9eba1;
+      tmp = d[l];
+      d[l] = c[l];
+      c[l] = b[l];
+      f = a[l] + f + block[md4_word[i]][l];
+      b[l] = ROTL32 (f, md4_S[i]);
+      a[l] = tmp;
+    }
+  }
+  for (int l = 0; l < HASHCHECKER_LANES; l++)
+  {
+    state[0][l] = a[l] + 0x67452301;
+    state[1][l] = b[l] + 0xefcdab89;
+    state[2][l] = c[l] + 0x98badcfe;
+    state[3][l] = d[l] + 0x10325476;
+  }
+}                               // md4_lanes
+
+/* (intern function) SHA-1 of a single block for all lanes */
+void sha1_lanes (uint32_t block[16][HASHCHECKER_LANES], uint32_t state[5][HASHCHECKER_LANES])
+{
+  uint32_t w[80][HASHCHECKER_LANES];
+  uint32_t a[HASHCHECKER_LANES], b[HASHCHECKER_LANES], c[HASHCHECKER_LANES], d[HASHCHECKER_LANES], e[HASHCHECKER_LANES];
+  uint32_t f = 0, tmp = 0;
+
+  for (int i = 0; i < 16; i++)
+    for (int l = 0; l < HASHCHECKER_LANES; l++)
+      w[i][l] = block[i][l];
+  for (int i = 16; i < 80; i++)
+    for (int l = 0; l < HASHCHECKER_LANES; l++)
+    {
+      tmp = w[i - 3][l] ^ w[i - 8][l] ^ w[i - 14][l] ^ w[i - 16][l];
+      w[i][l] = ROTL32 (tmp, 1);
+    }
+
+  for (int l = 0; l < HASHCHECKER_LANES; l++)
+  {
+    a[l] = 0x67452301;
+    b[l] = 0xefcdab89;
+    c[l] = 0x98badcfe;
+    d[l] = 0x10325476;
+    e[l] = 0xc3d2e1f0;
+  }
+  for (int i = 0; i < 80; i++)
+  {
+    for (int l = 0; l < HASHCHECKER_LANES; l++)
+    {
+      if (i < 20)
+        f = ((b[l] & c[l]) | (~b[l] & d[l])) + 0x5a827999;
+      else if (i < 40)
+        f = (b[l] ^ c[l] ^ d[l]) + 0x6ed9eba1;
+      else if (i < 60)
+        f = ((b[l] & c[l]) | (b[l] & d[l]) | (c[l] & d[l])) + 0x8f1bbcdc;
+      else
+        f = (b[l] ^ c[l] ^ d[l]) + 0xca62c1d6;
+      tmp = ROTL32 (a[l], 5) + f + e[l] + w[i][l];
+      e[l] = d[l];
+      d[l] = c[l];
+      c[l] = ROTL32 (b[l], 30);
+      b[l] = a[l];
+      a[l] = tmp;
+    }
+  }
+  for (int l = 0; l < HASHCHECKER_LANES; l++)
+  {
+    state[0][l] = a[l] + 0x67452301;
+    state[1][l] = b[l] + 0xefcdab89;
+    state[2][l] = c[l] + 0x98badcfe;
+    state[3][l] = d[l] + 0x10325476;
+    state[4][l] = e[l] + 0xc3d2e1f0;
+  }
+}                               // sha1_lanes
+
+/* (intern function) stores the padded message of @length bytes as block of the given @lane (words little or big endian) */
+void set_block (uint32_t block[16][HASHCHECKER_LANES], int lane, const unsigned char *message, int length, bool bigEndian)
+{
+  unsigned char padded[64] = { 0 };
+  uint64_t bits = (uint64_t) length * 8;
+
+  memcpy (padded, message, length);
+  padded[length] = 0x80;
+  for (int i = 0; i < 8; i++)
+  {
+    if (bigEndian)
+      padded[63 - i] = (unsigned char) (bits >> (8 * i));
+    else
+      padded[56 + i] = (unsigned char) (bits >> (8 * i));
+  }
+  for (int i = 0; i < 16; i++)
+  {
+    if (bigEndian)
+      block[i][lane] = ((uint32_t) padded[4 * i] << 24) | ((uint32_t) padded[4 * i + 1] << 16) | ((uint32_t) padded[4 * i + 2] << 8) | padded[4 * i + 3];
+    else
+      block[i][lane] = padded[4 * i] | ((uint32_t) padded[4 * i + 1] << 8) | ((uint32_t) padded[4 * i + 2] << 16) | ((uint32_t) padded[4 * i + 3] << 24);
+  }
+}                               // set_block
+
+/* (intern function) hashes the @count (up to HASHCHECKER_LANES) passwords of the batch starting at @start, storing the digests */
+void hash_lanes (const hashChecker_struct * checker, const hashChecker_batch * batch, int start, int count, unsigned char digests[HASHCHECKER_LANES][HASHCHECKER_MAX_DIGEST])
+{
+  uint32_t block[16][HASHCHECKER_LANES];
+  uint32_t state[5][HASHCHECKER_LANES];
+  unsigned char message[2 * MAX_PASSWORD_LENGTH];
+  int words = (checker->type == hashType_SHA1) ? 5 : 4;
+
+  for (int l = 0; l < HASHCHECKER_LANES; l++)
+  {
+    // unused lanes hash the empty password
+    int length = (l < count) ? batch->lengths[start + l] : 0;
+    const char *password = batch->passwords[start + ((l < count) ? l : 0)];
+
+    if (checker->type == hashType_NTLM)
+    {
+      // UTF-16LE (the chars are treated as Latin-1)
+      for (int i = 0; i < length; i++)
+      {
+        message[2 * i] = (unsigned char) password[i];
+        message[2 * i + 1] = 0;
+      }
+      set_block (block, l, message, 2 * length, false);
+    }
+    else
+      set_block (block, l, (const unsigned char *) password, length, checker->type == hashType_SHA1);
+  }
+
+  if (checker->type == hashType_MD5)
+    md5_lanes (block, state);
+  else if (checker->type == hashType_NTLM)
+    md4_lanes (block, state);
+  else
+    sha1_lanes (block, state);
+
+  for (int l = 0; l < count; l++)
+  {
+    for (int i = 0; i < words; i++)
+    {
+      if (checker->type == hashType_SHA1)
+      {
+        digests[l][4 * i] = (unsigned char) (state[i][l] >> 24);
+        digests[l][4 * i + 1] = (unsigned char) (state[i][l] >> 16);
+        digests[l][4 * i + 2] = (unsigned char) (state[i][l] >> 8);
+        digests[l][4 * i + 3] = (unsigned char) state[i][l];
+      }
+      else
+      {
+        digests[l][4 * i] = (unsigned char) state[i][l];
+        digests[l][4 * i + 1] = (unsigned char) (state[i][l] >> 8);
+        digests[l][4 * i + 2] = (unsigned char) (state[i][l] >> 16);
+        digests[l][4 * i + 3] = (unsigned char) (state[i][l] >> 24);
+      }
+    }
+  }
+}                               // hash_lanes
+
+// === batches and threads ===
+
+/* (intern function) stores that the password at @index of the batch cracked the given @entry (called by the threads) */
+void add_cracked (hashChecker_batch * batch, int index, hashChecker_entry * entry)
+{
+  pthread_mutex_lock (&(batch->crackedMutex));
+  if (batch->sizeOf_cracked == batch->maxOf_cracked)
+  {
+    batch->maxOf_cracked = (batch->maxOf_cracked == 0) ? 64 : batch->maxOf_cracked * 2;
+    batch->crackedIndex = (int *) realloc (batch->crackedIndex, sizeof (int) * batch->maxOf_cracked);
+    EXIT_IF_NULL (batch->crackedIndex);
+    batch->crackedEntry = (hashChecker_entry **) realloc (batch->crackedEntry, sizeof (hashChecker_entry *) * batch->maxOf_cracked);
+    EXIT_IF_NULL (batch->crackedEntry);
+  }
+  batch->crackedIndex[batch->sizeOf_cracked] = index;
+  batch->crackedEntry[batch->sizeOf_cracked] = entry;
+  batch->sizeOf_cracked++;
+  pthread_mutex_unlock (&(batch->crackedMutex));
+}                               // add_cracked
+
+/* (intern function) checks the passwords of the batch handed out to the calling thread until all are checked */
+void check_batch (hashChecker_thread * thread, hashChecker_batch * batch)
+{
+  hashChecker_struct *checker = thread->checker;
+  unsigned char digests[HASHCHECKER_LANES][HASHCHECKER_MAX_DIGEST];
+  hashChecker_entry *entry = NULL;
+  char password[MAX_PASSWORD_LENGTH + 1];
+  char *result = NULL;
+  int start = 0;
+  int count = 0;
+
+  if (checker->type == hashType_BCRYPT)
+  {
+    // one password at a time, each against any hash not cracked yet
+    while ((start = __atomic_fetch_add (&(batch->next), 1, __ATOMIC_RELAXED)) < batch->count)
+    {
+      memcpy (password, batch->passwords[start], batch->lengths[start]);
+      password[batch->lengths[start]] = '\0';
+      for (int i = 0; i < checker->sizeOf_entries; i++)
+      {
+        entry = checker->entries + i;
+        if (__atomic_load_n (&(entry->cracked), __ATOMIC_RELAXED))
+          continue;
+        result = crypt_r (password, entry->hash, &(thread->cryptData));
+        if (result != NULL && strcmp (result, entry->hash) == 0)
+          add_cracked (batch, start, entry);
+      }
+    }
+    return;
+  }
+
+  while ((start = __atomic_fetch_add (&(batch->next), HASHCHECKER_LANES, __ATOMIC_RELAXED)) < batch->count)
+  {
+    count = (batch->count - start < HASHCHECKER_LANES) ? batch->count - start : HASHCHECKER_LANES;
+    hash_lanes (checker, batch, start, count, digests);
+    for (int l = 0; l < count; l++)
+    {
+      HASH_FIND (hh, checker->table, digests[l], checker->sizeOf_digest, entry);
+      if (entry != NULL)
+        add_cracked (batch, start + l, entry);
+    }
+  }
+}                               // check_batch
+
+/* (intern function) main function of each hashing thread */
+void *run_thread (void *arg)
+{
+  hashChecker_thread *thread = (hashChecker_thread *) arg;
+  hashChecker_struct *checker = thread->checker;
+  hashChecker_batch *batch = NULL;
+  uint64_t generation = 0;
+
+  for (;;)
+  {
+    pthread_mutex_lock (&(checker->mutex));
+    while (!checker->shutdown && checker->generation == generation)
+      pthread_cond_wait (&(checker->condStart), &(checker->mutex));
+    if (checker->shutdown)
+    {
+      pthread_mutex_unlock (&(checker->mutex));
+      break;
+    }
+    generation = checker->generation;
+    batch = checker->batches[checker->batchCur ^ 1];
+    pthread_mutex_unlock (&(checker->mutex));
+
+    check_batch (thread, batch);
+
+    pthread_mutex_lock (&(checker->mutex));
+    checker->threadsDone++;
+    if (checker->threadsDone == checker->sizeOf_threads)
+      pthread_cond_signal (&(checker->condDone));
+    pthread_mutex_unlock (&(checker->mutex));
+  }
+  free (thread);
+  return NULL;
+}                               // run_thread
+
+/* (intern function) waits until the threads are done with the batch they hash and handles its cracked hashes */
+void collect_batch (hashChecker_struct * checker)
+{
+  hashChecker_batch *batch = checker->batches[checker->batchCur ^ 1];
+  hashChecker_entry *entry = NULL;
+  int index = 0;
+
+  if (!checker->batchHashing)
+    return;
+
+  pthread_mutex_lock (&(checker->mutex));
+  while (checker->threadsDone < checker->sizeOf_threads)
+    pthread_cond_wait (&(checker->condDone), &(checker->mutex));
+  pthread_mutex_unlock (&(checker->mutex));
+  checker->batchHashing = false;
+
+  for (int i = 0; i < batch->sizeOf_cracked; i++)
+  {
+    entry = batch->crackedEntry[i];
+    index = batch->crackedIndex[i];
+    // bcrypt hashes are checked by several threads until the batch is collected
+    if (__atomic_load_n (&(entry->cracked), __ATOMIC_RELAXED))
+      continue;
+    __atomic_store_n (&(entry->cracked), 1, __ATOMIC_RELAXED);
+    checker->crackedCount++;
+    checker->crackedLengths[batch->lengths[index] - 1]++;
+    fprintf (checker->potfile, "%s:%.*s\n", entry->hash, batch->lengths[index], batch->passwords[index]);
+    if (checker->sizeOf_recent < HASHCHECKER_RECENT)
+    {
+      int recent = (checker->recentFirst + checker->sizeOf_recent) % HASHCHECKER_RECENT;
+      memcpy (checker->recentPasswords[recent], batch->passwords[index], batch->lengths[index]);
+      checker->recentLengths[recent] = batch->lengths[index];
+      checker->sizeOf_recent++;
+    }
+    if (checker->crackedFile != NULL)
+      fprintf (checker->crackedFile, "%.*s, %" PRIu64 "\n", batch->lengths[index], batch->passwords[index], batch->firstAttempt + index);
+  }
+  fflush (checker->potfile);
+  batch->sizeOf_cracked = 0;
+}                               // collect_batch
+
+/* (intern function) hands the current batch to the threads and switches to the other one */
+void dispatch_batch (hashChecker_struct * checker)
+{
+  hashChecker_batch *batch = checker->batches[checker->batchCur];
+
+  // the other batch must be done before it is filled again
+  collect_batch (checker);
+  if (batch->count == 0)
+    return;
+
+  batch->next = 0;
+  pthread_mutex_lock (&(checker->mutex));
+  checker->batchCur ^= 1;
+  checker->threadsDone = 0;
+  checker->generation++;
+  checker->batchHashing = true;
+  pthread_cond_broadcast (&(checker->condStart));
+  pthread_mutex_unlock (&(checker->mutex));
+
+  checker->batches[checker->batchCur]->count = 0;
+}                               // dispatch_batch
+
+// === hash file ===
+
+/* (intern function) parses the hex digest @hex of the given @size into @digest. Returns FALSE if invalid. */
+bool parse_hex (const char *hex, unsigned char *digest, int size)
+{
+  int value = 0;
+
+  if ((int) strlen (hex) != 2 * size)
+    return false;
+  for (int i = 0; i < 2 * size; i++)
+  {
+    if (!isxdigit ((unsigned char) hex[i]))
+      return false;
+    value = isdigit ((unsigned char) hex[i]) ? hex[i] - '0' : tolower ((unsigned char) hex[i]) - 'a' + 10;
+    if (i % 2 == 0)
+      digest[i / 2] = (unsigned char) (value << 4);
+    else
+      digest[i / 2] |= (unsigned char) value;
+  }
+  return true;
+}                               // parse_hex
+
+/* (intern function) reads all valid hashes of @hashFile */
+bool read_hashFile (hashChecker_struct * checker, const char *hashFile)
+{
+  FILE *fp = NULL;
+  char line[MAX_LINE_LENGTH];
+  int maxOf_entries = 1024;
+  int invalid = 0;
+  size_t length = 0;
+  hashChecker_entry *entry = NULL;
+  hashChecker_entry *found = NULL;
+
+  if (!open_file (&fp, hashFile, NULL, "r"))
+  {
+    errorHandler_print (errorType_Error, "Could not open file (%s)\n", hashFile);
+    return false;
+  }
+  checker->entries = (hashChecker_entry *) malloc (sizeof (hashChecker_entry) * maxOf_entries);
+  EXIT_IF_NULL (checker->entries);
+
+  while (fgets (line, sizeof (line), fp) != NULL)
+  {
+    length = strlen (line);
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+      line[--length] = '\0';
+    if (length == 0)
+      continue;
+
+    if (checker->sizeOf_entries == maxOf_entries)
+    {
+      maxOf_entries *= 2;
+      checker->entries = (hashChecker_entry *) realloc (checker->entries, sizeof (hashChecker_entry) * maxOf_entries);
+      EXIT_IF_NULL (checker->entries);
+    }
+    entry = checker->entries + checker->sizeOf_entries;
+    memset (entry, 0, sizeof (hashChecker_entry));
+    if (checker->type == hashType_BCRYPT)
+    {
+      if (length != 60 || strncmp (line, "$2", 2) != 0 || line[3] != '$' || strchr ("aby", line[2]) == NULL)
+      {
+        invalid++;
+        continue;
+      }
+    }
+    else if (!parse_hex (line, entry->digest, checker->sizeOf_digest))
+    {
+      invalid++;
+      continue;
+    }
+    if (!str_allocCpy (&(entry->hash), line))
+    {
+      printf ("Error: Out of Memory\n");
+      exit (1);
+    }
+    checker->sizeOf_entries++;
+  }
+  fclose (fp);
+
+  if (invalid > 0)
+    errorHandler_print (errorType_Warning, "%i invalid hashes in %s have been skipped\n", invalid, hashFile);
+  if (checker->sizeOf_entries == 0)
+  {
+    errorHandler_print (errorType_Error, "No valid hash found in %s\n", hashFile);
+    return false;
+  }
+
+  // the entries don't move anymore, so they can be added to the hashmap
+  if (checker->type == hashType_BCRYPT)
+  {
+    checker->sizeOf_unique = checker->sizeOf_entries;
+    return true;
+  }
+  for (int i = 0; i < checker->sizeOf_entries; i++)
+  {
+    entry = checker->entries + i;
+    HASH_FIND (hh, checker->table, entry->digest, checker->sizeOf_digest, found);
+    if (found == NULL)
+    {
+      HASH_ADD (hh, checker->table, digest, checker->sizeOf_digest, entry);
+      checker->sizeOf_unique++;
+    }
+  }
+  return true;
+}                               // read_hashFile
+
+// === public functions ===
+
+// parses the name of a hash type
+bool hashChecker_parseType (const char *name, hashType * type)
+{
+  if (strcmp (name, "md5") == 0)
+    *type = hashType_MD5;
+  else if (strcmp (name, "sha1") == 0)
+    *type = hashType_SHA1;
+  else if (strcmp (name, "ntlm") == 0)
+    *type = hashType_NTLM;
+  else if (strcmp (name, "bcrypt") == 0)
+    *type = hashType_BCRYPT;
+  else
+    return false;
+  return true;
+}                               // hashChecker_parseType
+
+// reads the hashes and starts the threads
+bool hashChecker_initialize (hashChecker_struct ** checker, const char *hashFile, hashType type, int threads, FILE * potfile, FILE * crackedFile)
+{
+  hashChecker_thread *thread = NULL;
+
+  (*checker) = (hashChecker_struct *) calloc (1, sizeof (hashChecker_struct));
+  EXIT_IF_NULL ((*checker));
+  (*checker)->type = type;
+  (*checker)->sizeOf_digest = (type == hashType_SHA1) ? 20 : 16;
+  (*checker)->potfile = potfile;
+  (*checker)->crackedFile = crackedFile;
+  pthread_mutex_init (&((*checker)->mutex), NULL);
+  pthread_cond_init (&((*checker)->condStart), NULL);
+  pthread_cond_init (&((*checker)->condDone), NULL);
+
+  if (!read_hashFile (*checker, hashFile))
+  {
+    hashChecker_free (checker);
+    return false;
+  }
+
+  // bcrypt takes milliseconds per password and hash, so smaller batches keep the threads busy
+  (*checker)->batchLimit = (type == hashType_BCRYPT) ? HASHCHECKER_BATCH_SIZE_BCRYPT * threads : HASHCHECKER_BATCH_SIZE;
+  if ((*checker)->batchLimit > HASHCHECKER_BATCH_SIZE)
+    (*checker)->batchLimit = HASHCHECKER_BATCH_SIZE;
+  for (int i = 0; i < 2; i++)
+  {
+    (*checker)->batches[i] = (hashChecker_batch *) calloc (1, sizeof (hashChecker_batch));
+    EXIT_IF_NULL ((*checker)->batches[i]);
+    pthread_mutex_init (&((*checker)->batches[i]->crackedMutex), NULL);
+  }
+
+  (*checker)->threads = (pthread_t *) malloc (sizeof (pthread_t) * threads);
+  EXIT_IF_NULL ((*checker)->threads);
+  for (int i = 0; i < threads; i++)
+  {
+    thread = (hashChecker_thread *) calloc (1, sizeof (hashChecker_thread));
+    EXIT_IF_NULL (thread);
+    thread->checker = *checker;
+    if (pthread_create ((*checker)->threads + i, NULL, run_thread, thread) != 0)
+    {
+      errorHandler_print (errorType_Error, "Unable to create the hashing threads\n");
+      free (thread);
+      hashChecker_free (checker);
+      return false;
+    }
+    (*checker)->sizeOf_threads++;
+  }
+  return true;
+}                               // hashChecker_initialize
+
+// adds a password to the current batch
+bool hashChecker_add (hashChecker_struct * checker, const char *password, int length, uint64_t attempt)
+{
+  hashChecker_batch *batch = checker->batches[checker->batchCur];
+
+  if (batch->count == 0)
+    batch->firstAttempt = attempt;
+  memcpy (batch->passwords[batch->count], password, length);
+  batch->lengths[batch->count] = (unsigned char) length;
+  batch->count++;
+
+  if (batch->count == checker->batchLimit)
+    dispatch_batch (checker);
+  return checker->crackedCount < checker->sizeOf_unique;
+}                               // hashChecker_add
+
+// checks the remaining passwords
+void hashChecker_finish (hashChecker_struct * checker)
+{
+  // the batches are missing if the initialization failed
+  if (checker == NULL || checker->batches[0] == NULL)
+    return;
+  dispatch_batch (checker);
+  collect_batch (checker);
+}                               // hashChecker_finish
+
+// stops the threads and frees the checker
+void hashChecker_free (hashChecker_struct ** checker)
+{
+  hashChecker_entry *entry = NULL;
+  hashChecker_entry *tmp = NULL;
+
+  if ((*checker) == NULL)
+    return;
+
+  // the threads are idle once the last batch has been collected
+  if ((*checker)->batches[0] != NULL)
+    collect_batch (*checker);
+  pthread_mutex_lock (&((*checker)->mutex));
+  (*checker)->shutdown = true;
+  pthread_cond_broadcast (&((*checker)->condStart));
+  pthread_mutex_unlock (&((*checker)->mutex));
+  for (int i = 0; i < (*checker)->sizeOf_threads; i++)
+    pthread_join ((*checker)->threads[i], NULL);
+  CHECKED_FREE ((*checker)->threads);
+
+  HASH_ITER (hh, (*checker)->table, entry, tmp)
+  {
+    HASH_DEL ((*checker)->table, entry);
+  }
+  if ((*checker)->entries != NULL)
+  {
+    for (int i = 0; i < (*checker)->sizeOf_entries; i++)
+      CHECKED_FREE ((*checker)->entries[i].hash);
+    free ((*checker)->entries);
+  }
+  for (int i = 0; i < 2; i++)
+  {
+    if ((*checker)->batches[i] != NULL)
+    {
+      pthread_mutex_destroy (&((*checker)->batches[i]->crackedMutex));
+      CHECKED_FREE ((*checker)->batches[i]->crackedIndex);
+      CHECKED_FREE ((*checker)->batches[i]->crackedEntry);
+      free ((*checker)->batches[i]);
+    }
+  }
+  pthread_mutex_destroy (&((*checker)->mutex));
+  pthread_cond_destroy (&((*checker)->condStart));
+  pthread_cond_destroy (&((*checker)->condDone));
+  free (*checker);
+  (*checker) = NULL;
+}                               // hashChecker_free
+
+// returns the amount of cracked hashes of the given length
+uint64_t hashChecker_crackedLength (const hashChecker_struct * checker, int length)
+{
+  if (length < 1 || length > MAX_PASSWORD_LENGTH)
+    return 0;
+  return checker->crackedLengths[length - 1];
+}                               // hashChecker_crackedLength
+
+// takes the next cracked password
+bool hashChecker_nextCracked (hashChecker_struct * checker, char password[MAX_PASSWORD_LENGTH], int *length)
+{
+  if (checker->sizeOf_recent == 0)
+    return false;
+  *length = checker->recentLengths[checker->recentFirst];
+  memcpy (password, checker->recentPasswords[checker->recentFirst], *length);
+  checker->recentFirst = (checker->recentFirst + 1) % HASHCHECKER_RECENT;
+  checker->sizeOf_recent--;
+  return true;
+}                               // hashChecker_nextCracked
+
+// prints the results
+void hashChecker_printResults (hashChecker_struct * checker, FILE * fp)
+{
+  fprintf (fp, "cracked: %i of %i hashes (%.2f %%)\n", checker->crackedCount, checker->sizeOf_unique, 100.0 * checker->crackedCount / checker->sizeOf_unique);
+  fprintf (fp, "\nlengths of the cracked passwords (length - cracked)\n");
+  for (size_t i = 0; i < MAX_PASSWORD_LENGTH; i++)
+    if (checker->crackedLengths[i] > 0)
+      fprintf (fp, "%2zu - %9" PRIu64 "\n", i + 1, checker->crackedLengths[i]);
+}                               // hashChecker_printResults
@@ -0,0 +1,111 @@
+/*
+ * hashChecker.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Used by enumNG to check the created passwords directly against a list of
+ * hashes (--hashes) instead of piping them into a password cracker.
+ * The passwords are collected in batches, which are hashed by a pool of
+ * threads while enumNG creates the next batch. Unsalted hashes (MD5, SHA-1,
+ * NTLM) are computed for HASHCHECKER_LANES passwords at once (multi-buffer:
+ * the rounds are applied lane by lane on arrays, which the compiler
+ * vectorizes) and looked up in a hashmap; bcrypt hashes are checked one by
+ * one using crypt(3), since each has its own salt and cost.
+ * Cracked hashes are written as "hash:password" to a potfile and counted by
+ * length, giving enumNG the same feedback as a simulated attack.
+ *
+ * The hash file contains a single hash per line: 32 (MD5, NTLM) or 40 (SHA-1)
+ * hex digits or a bcrypt hash ($2a$, $2b$ or $2y$).
+ *
+ */
+
+#ifndef HASHCHECKER_H_
+#define HASHCHECKER_H_
+
+#include <stdint.h>
+
+#include "common.h"
+
+// === Defines ===
+#define HASHCHECKER_LANES 8     // passwords hashed at once by a single thread
+#define HASHCHECKER_BATCH_SIZE 16384  // passwords per batch (unsalted hashes)
+#define HASHCHECKER_BATCH_SIZE_BCRYPT 16  // passwords per batch and thread (bcrypt)
+#define HASHCHECKER_MAX_THREADS 256
+#define HASHCHECKER_MAX_DIGEST 20 // size of the largest digest (SHA-1)
+#define HASHCHECKER_RECENT 1024  // cracked passwords kept until taken (see hashChecker_nextCracked)
+
+/*
+ * Supported hash types.
+ */
+typedef enum
+{
+  hashType_MD5,
+  hashType_SHA1,
+  hashType_NTLM,                // MD4 of the UTF-16LE encoded password
+  hashType_BCRYPT
+} hashType;
+
+/*
+ * Opaque state of the hash checker (see hashChecker.c).
+ */
+typedef struct hashChecker_struct hashChecker_struct;
+
+/*
+ * Reads the hashes of the given @type from @hashFile and starts @threads
+ * threads hashing the passwords. Cracked hashes are appended to @potfile;
+ * if @crackedFile is not NULL, the cracked passwords are also written to it
+ * with their guess number ("password, attempt").
+ * Returns FALSE (setting @checker to NULL) if the file can't be read or contains
+ * no valid hash.
+ */
+bool hashChecker_initialize (hashChecker_struct ** checker, // checker to be initialized
+                             const char *hashFile,  // file containing the hashes
+                             hashType type, // type of all hashes
+                             int threads, // amount of hashing threads
+                             FILE * potfile,  // cracked hashes ("hash:password")
+                             FILE * crackedFile); // cracked passwords with their guess number (may be NULL)
+
+/*
+ * Adds the given @password with the guess number @attempt to the current
+ * batch, handing the batch to the threads once it is full.
+ * Returns FALSE once all hashes have been cracked.
+ */
+bool hashChecker_add (hashChecker_struct * checker, const char *password, int length, uint64_t attempt);
+
+/*
+ * Checks all remaining passwords and waits for the threads.
+ */
+void hashChecker_finish (hashChecker_struct * checker);
+
+/*
+ * Stops the threads and frees the given checker (if not NULL).
+ */
+void hashChecker_free (hashChecker_struct ** checker);
+
+/*
+ * Returns the amount of cracked hashes whose password has the given @length
+ * (used by the optimized length scheduling).
+ */
+uint64_t hashChecker_crackedLength (const hashChecker_struct * checker, int length);
+
+/*
+ * Takes the next password cracked since the last call (oldest first), so
+ * enumNG can credit it to the part of the enumeration which created it.
+ * At most HASHCHECKER_RECENT passwords are kept, any further one is only
+ * counted. Returns FALSE if there is none.
+ */
+bool hashChecker_nextCracked (hashChecker_struct * checker, char password[MAX_PASSWORD_LENGTH], int *length);
+
+/*
+ * Prints the amount of cracked hashes (overall and by length) to the
+ * given file pointer (i.e. stdout or log-file).
+ */
+void hashChecker_printResults (hashChecker_struct * checker, FILE * fp);
+
+/*
+ * Parses the name of a hash type ("md5", "sha1", "ntlm" or "bcrypt").
+ * Returns FALSE if the name is unknown.
+ */
+bool hashChecker_parseType (const char *name, hashType * type);
+
+#endif /* HASHCHECKER_H_ */
@@ -0,0 +1,312 @@
+/*
+ * hybridAttack.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <ctype.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "errorHandler.h"
+#include "hybridAttack.h"
+
+/* (intern function) Returns TRUE if the entry @a comes before the entry @b (smaller level, words in the order of the list for equal levels). */
+bool hybrid_isBefore (const hybridAttack_entry * a, const hybridAttack_entry * b)
+{
+  if (a->level != b->level)
+    return a->level < b->level;
+  return a->word < b->word;
+}                               // (intern) hybrid_isBefore
+
+/* (intern function) Moves the entry at @index of the heap down to its position. */
+void hybrid_siftDown (hybridAttack_struct * attack, int index)
+{
+  while (true)
+  {
+    int smallest = index;
+    int left = 2 * index + 1;
+    int right = left + 1;
+    hybridAttack_entry swap;
+
+    if (left < attack->sizeOf_heap && hybrid_isBefore (attack->heap + left, attack->heap + smallest))
+      smallest = left;
+    if (right < attack->sizeOf_heap && hybrid_isBefore (attack->heap + right, attack->heap + smallest))
+      smallest = right;
+    if (smallest == index)
+      return;
+    swap = attack->heap[index];
+    attack->heap[index] = attack->heap[smallest];
+    attack->heap[smallest] = swap;
+    index = smallest;
+  }
+}                               // (intern) hybrid_siftDown
+
+/* (intern function) Splits the given @line into the frequency (1 if not given) and the word. Returns FALSE if the frequency is 0. */
+bool hybrid_parseLine (char *line, uint64_t * count, char **word)
+{
+  char *cur = line;
+  char *end = NULL;
+
+  // optional frequency, followed by a single space or tab (like sort | uniq -c)
+  while (*cur == ' ')
+    cur++;
+  if (isdigit ((unsigned char) *cur))
+  {
+    uint64_t value = strtoull (cur, &end, 10);
+
+    if ((*end == ' ' || *end == '\t') && end[1] != '\0')
+    {
+      *count = value;
+      *word = end + 1;
+      return value > 0;
+    }
+  }
+  *count = 1;
+  *word = line;
+  return true;
+}                               // (intern) hybrid_parseLine
+
+/* (intern function) Adds the given @word of @length with its frequency @count to the list. */
+void hybrid_addWord (hybridAttack_struct * attack, const char *word, int length, uint64_t count)
+{
+  if (attack->sizeOf_words == attack->indexMax_words)
+  {
+    attack->indexMax_words *= 2;
+    attack->words = (hybridAttack_word *) realloc (attack->words, attack->indexMax_words * sizeof (hybridAttack_word));
+    EXIT_IF_NULL (attack->words);
+  }
+  while (attack->sizeOf_chars + length + 1 > attack->indexMax_chars)
+  {
+    attack->indexMax_chars *= 2;
+    attack->chars = (char *) realloc (attack->chars, attack->indexMax_chars);
+    EXIT_IF_NULL (attack->chars);
+  }
+
+  attack->words[attack->sizeOf_words].start = attack->sizeOf_chars;
+  attack->words[attack->sizeOf_words].length = length;
+  attack->words[attack->sizeOf_words].count = count;
+  attack->words[attack->sizeOf_words].level = 0;
+  memcpy (attack->chars + attack->sizeOf_chars, word, length);
+  attack->chars[attack->sizeOf_chars + length] = '\0';
+  attack->sizeOf_chars += length + 1;
+  attack->sizeOf_words++;
+}                               // (intern) hybrid_addWord
+
+/* (intern function) Returns the given @level of the model, limited to the largest level @maxLevel - 1 (like the sorted arrays). */
+int hybrid_limit (int level, int maxLevel)
+{
+  return (level > maxLevel - 1) ? maxLevel - 1 : level;
+}                               // (intern) hybrid_limit
+
+/* (intern function) Fills the given @table with the symbols next to each (n-1)-gram, sorted by the level of the nGram and (if @outerLevels is not NULL) the level of the (n-1)-gram at the outer end of the symbol in @outerLevels. The symbols are appended if @append is TRUE and prepended otherwise. */
+void hybrid_fillTable (hybridAttack_table * table, const nGram_struct * nGrams, const int *outerLevels, bool append, int sizeOf_alphabet, int maxLevel)
+{
+  int sizeOf_mGram = nGrams->sizeOf_iP;
+  int sizeOf_levels = (outerLevels != NULL) ? 2 * (maxLevel - 1) + 1 : maxLevel;
+  int levels[sizeOf_alphabet];
+  int index[sizeOf_levels];     // next free index of each level
+
+  table->sizeOf_levels = sizeOf_levels;
+  table->symbols = (unsigned char *) malloc ((size_t) sizeOf_mGram * sizeOf_alphabet);
+  EXIT_IF_NULL (table->symbols);
+  table->levelStart = (unsigned short *) malloc ((size_t) sizeOf_mGram * (sizeOf_levels + 1) * sizeof (unsigned short));
+  EXIT_IF_NULL (table->levelStart);
+  table->levelUsed = (uint32_t *) calloc (sizeOf_mGram, sizeof (uint32_t));
+  EXIT_IF_NULL (table->levelUsed);
+
+  for (int position = 0; position < sizeOf_mGram; position++)
+  {
+    unsigned short *levelStart = table->levelStart + (size_t) position * (sizeOf_levels + 1);
+
+    memset (levelStart, 0, (sizeOf_levels + 1) * sizeof (unsigned short));
+    // level of each symbol: the nGram consists of the (n-1)-gram followed by the symbol (append) or the symbol followed by the (n-1)-gram
+    for (int symbol = 0; symbol < sizeOf_alphabet; symbol++)
+    {
+      if (append)
+      {
+        levels[symbol] = hybrid_limit (nGrams->cP[position * sizeOf_alphabet + symbol], maxLevel);
+        if (outerLevels != NULL)
+          levels[symbol] += hybrid_limit (outerLevels[(position % (sizeOf_mGram / sizeOf_alphabet)) * sizeOf_alphabet + symbol], maxLevel);
+      }
+      else
+      {
+        levels[symbol] = hybrid_limit (nGrams->cP[symbol * sizeOf_mGram + position], maxLevel);
+        if (outerLevels != NULL)
+          levels[symbol] += hybrid_limit (outerLevels[symbol * (sizeOf_mGram / sizeOf_alphabet) + position / sizeOf_alphabet], maxLevel);
+      }
+      levelStart[levels[symbol] + 1]++;
+      table->levelUsed[position] |= (uint32_t) 1 << levels[symbol];
+    }
+    // sum up the counts to the start indices and sort the symbols by level
+    for (int level = 0; level < sizeOf_levels; level++)
+    {
+      levelStart[level + 1] += levelStart[level];
+      index[level] = levelStart[level];
+    }
+    for (int symbol = 0; symbol < sizeOf_alphabet; symbol++)
+      table->symbols[(size_t) position * sizeOf_alphabet + index[levels[symbol]]++] = (unsigned char) symbol;
+  }
+}                               // (intern) hybrid_fillTable
+
+// reads the wordlist and initializes the queue
+bool hybridAttack_initialize (hybridAttack_struct ** attack, const char *filename, const nGram_struct * nGrams, int sizeOf_alphabet, int maxLevel, bool ignoreEP, int affixLength)
+{
+  FILE *fp = NULL;
+  char line[HYBRIDATTACK_SIZEOF_LINE];
+  uint64_t countTotal = 0;
+
+  if (!open_file (&fp, filename, NULL, "r"))
+  {
+    errorHandler_print (errorType_Error, "Can't open the wordlist (%s)\n", filename);
+    return false;
+  }
+
+  *attack = (hybridAttack_struct *) calloc (1, sizeof (hybridAttack_struct));
+  EXIT_IF_NULL (*attack);
+  (*attack)->indexMax_chars = 4096;
+  (*attack)->chars = (char *) malloc ((*attack)->indexMax_chars);
+  EXIT_IF_NULL ((*attack)->chars);
+  (*attack)->indexMax_words = 256;
+  (*attack)->words = (hybridAttack_word *) malloc ((*attack)->indexMax_words * sizeof (hybridAttack_word));
+  EXIT_IF_NULL ((*attack)->words);
+  // an affix of x chars has x conditionalProbs and an initialProb or endProb
+  (*attack)->affixLevelMax = (affixLength + 1) * (maxLevel - 1);
+
+  while (fgets (line, HYBRIDATTACK_SIZEOF_LINE, fp) != NULL)
+  {
+    size_t length = strlen (line);
+    uint64_t count = 0;
+    char *word = NULL;
+
+    // the line doesn't fit: skip the rest of it
+    if (length > 0 && line[length - 1] != '\n' && !feof (fp))
+    {
+      int c = 0;
+
+      while ((c = fgetc (fp)) != EOF && c != '\n');
+      (*attack)->ignoredCount++;
+      continue;
+    }
+    // remove the line break (LF or CRLF)
+    if (length > 0 && line[length - 1] == '\n')
+      line[--length] = '\0';
+    if (length > 0 && line[length - 1] == '\r')
+      line[--length] = '\0';
+
+    if (!hybrid_parseLine (line, &count, &word) || word[0] == '\0' || strlen (word) >= MAX_PASSWORD_LENGTH || countTotal + count < countTotal || (*attack)->sizeOf_words == INT32_MAX)
+    {
+      (*attack)->ignoredCount++;
+      continue;
+    }
+    hybrid_addWord (*attack, word, (int) strlen (word), count);
+    countTotal += count;
+  }
+  fclose (fp);
+
+  if ((*attack)->sizeOf_words == 0)
+  {
+    errorHandler_print (errorType_Error, "The wordlist (%s) doesn't contain any word.\n", filename);
+    return false;
+  }
+
+  // level of each word: -ln(p) of its frequency; each word starts with its own level (affix level 0)
+  (*attack)->heap = (hybridAttack_entry *) malloc ((*attack)->sizeOf_words * sizeof (hybridAttack_entry));
+  EXIT_IF_NULL ((*attack)->heap);
+  for (int i = 0; i < (*attack)->sizeOf_words; i++)
+  {
+    (*attack)->words[i].level = (int) log ((double) countTotal / (double) (*attack)->words[i].count);
+    (*attack)->heap[i].level = (*attack)->words[i].level;
+    (*attack)->heap[i].word = i;
+    (*attack)->heap[i].affixLevel = 0;
+  }
+  (*attack)->sizeOf_heap = (*attack)->sizeOf_words;
+  for (int i = (*attack)->sizeOf_heap / 2 - 1; i >= 0; i--)
+    hybrid_siftDown (*attack, i);
+
+  // the symbols are stored as unsigned char
+  if (sizeOf_alphabet > 256)
+  {
+    errorHandler_print (errorType_Error, "The hybrid mode supports alphabets of at most %i symbols.\n", 256);
+    return false;
+  }
+  hybrid_fillTable (&((*attack)->suffixLast), nGrams, ignoreEP ? NULL : nGrams->eP, true, sizeOf_alphabet, maxLevel);
+  hybrid_fillTable (&((*attack)->prefixChar), nGrams, NULL, false, sizeOf_alphabet, maxLevel);
+  hybrid_fillTable (&((*attack)->prefixFirst), nGrams, nGrams->iP, false, sizeOf_alphabet, maxLevel);
+  (*attack)->sizeOf_alphabet = sizeOf_alphabet;
+  return true;
+}                               // hybridAttack_initialize
+
+// returns the symbols of the given level
+const unsigned char *hybridAttack_getSymbols (const hybridAttack_struct * attack, const hybridAttack_table * table, int position, int level, int *sizeOf_symbols)
+{
+  const unsigned short *levelStart = table->levelStart + (size_t) position * (table->sizeOf_levels + 1);
+
+  // the small bit mask avoids reading the start indices for the (frequent) empty levels
+  if (level >= table->sizeOf_levels || (table->levelUsed[position] & ((uint32_t) 1 << level)) == 0)
+  {
+    *sizeOf_symbols = 0;
+    return NULL;
+  }
+  *sizeOf_symbols = levelStart[level + 1] - levelStart[level];
+  return table->symbols + (size_t) position * attack->sizeOf_alphabet + levelStart[level];
+}                               // hybridAttack_getSymbols
+
+// returns the next word and affix level
+bool hybridAttack_next (hybridAttack_struct * attack, int *word, int *affixLevel)
+{
+  if (attack->sizeOf_heap == 0)
+    return false;
+
+  *word = attack->heap[0].word;
+  *affixLevel = attack->heap[0].affixLevel;
+
+  // queue the word again with the next affix level (or remove it)
+  if (attack->heap[0].affixLevel < attack->affixLevelMax)
+  {
+    attack->heap[0].affixLevel++;
+    attack->heap[0].level++;
+  }
+  else
+    attack->heap[0] = attack->heap[--attack->sizeOf_heap];
+  hybrid_siftDown (attack, 0);
+  return true;
+}                               // hybridAttack_next
+
+// returns the word
+const char *hybridAttack_getWord (const hybridAttack_struct * attack, int word)
+{
+  return attack->chars + attack->words[word].start;
+}                               // hybridAttack_getWord
+
+// prints the results
+void hybridAttack_printResults (const hybridAttack_struct * attack, FILE * fp)
+{
+  fprintf (fp, "hybrid: %i words read (%" PRIu64 " lines ignored)\n", attack->sizeOf_words, attack->ignoredCount);
+  fprintf (fp, " - created: %" PRIu64 " words, %" PRIu64 " with a prefix, %" PRIu64 " with a suffix\n", attack->wordCount, attack->prefixCount, attack->suffixCount);
+}                               // hybridAttack_printResults
+
+// frees the struct
+void hybridAttack_free (hybridAttack_struct ** attack)
+{
+  if (*attack != NULL)
+  {
+    CHECKED_FREE ((*attack)->chars);
+    CHECKED_FREE ((*attack)->words);
+    CHECKED_FREE ((*attack)->heap);
+    CHECKED_FREE ((*attack)->suffixLast.symbols);
+    CHECKED_FREE ((*attack)->suffixLast.levelStart);
+    CHECKED_FREE ((*attack)->suffixLast.levelUsed);
+    CHECKED_FREE ((*attack)->prefixChar.symbols);
+    CHECKED_FREE ((*attack)->prefixChar.levelStart);
+    CHECKED_FREE ((*attack)->prefixChar.levelUsed);
+    CHECKED_FREE ((*attack)->prefixFirst.symbols);
+    CHECKED_FREE ((*attack)->prefixFirst.levelStart);
+    CHECKED_FREE ((*attack)->prefixFirst.levelUsed);
+    free (*attack);
+    *attack = NULL;
+  }
+}                               // hybridAttack_free
@@ -0,0 +1,149 @@
+/*
+ * hybridAttack.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Hybrid mode of enumNG (--hybrid): the words of a wordlist are combined
+ * with prefixes and suffixes enumerated by the model. Each line of the
+ * wordlist contains a word, optionally preceded by its frequency (like the
+ * output of sort | uniq -c). The level of a word is -ln(p) of its frequency
+ * (like the levels of the model at the default level scale).
+ * The level of an affix is the level of the model for creating it next to
+ * the word, i.e. conditioned on the first or last (n-1) chars of the word:
+ *   suffix: conditionalProbs of its chars and the endProb
+ *   prefix: initialProb, conditionalProbs of its chars and the ones of the
+ *           first (n-1) chars of the word (following the prefix)
+ * A candidate (the word itself or with an affix) has the level of the word
+ * plus the level of the affix. All words are kept in a single priority queue
+ * by the level of their next candidates, so the candidates of all words are
+ * created in ascending level. The affixes themselves are created by enumNG
+ * (see run_enumeration_hybrid): the chars of a suffix are appended using the
+ * sorted lastGrams, the chars of a prefix are prepended from right to left.
+ * For the prefixes and the last char of a suffix, the symbols next to each
+ * (n-1)-gram are sorted by the level they add (including the initialProb or
+ * endProb of the outermost char) in the tables below, so the outermost char
+ * of an affix is only chosen among the symbols of the level still missing.
+ *
+ */
+
+#ifndef HYBRIDATTACK_H_
+#define HYBRIDATTACK_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "common.h"
+
+// === Defines ===
+#define HYBRIDATTACK_SIZEOF_LINE 1024 // lines of the wordlist are read in chunks of this size
+
+/*
+ * Symbols next to each (n-1)-gram sorted by the level they add to an affix.
+ */
+typedef struct hybridAttack_table
+{
+  unsigned char *symbols;       // symbols of each (n-1)-gram (sizeOf_alphabet each), ascending by level
+  unsigned short *levelStart;   // index of the first symbol of each level within the symbols of the (n-1)-gram (sizeOf_levels + 1 entries each)
+  uint32_t *levelUsed;          // levels of the symbols of each (n-1)-gram (bit i set if any symbol adds level i)
+  int sizeOf_levels;            // amount of levels
+} hybridAttack_table;
+
+/*
+ * Single word of the wordlist.
+ */
+typedef struct hybridAttack_word
+{
+  size_t start;                 // index of the word in @chars
+  int length;                   // length of the word
+  int level;                    // level of the word (-ln(p) of its frequency)
+  uint64_t count;               // frequency of the word
+} hybridAttack_word;
+
+/*
+ * Entry of the priority queue: the next affix level of a word.
+ */
+typedef struct hybridAttack_entry
+{
+  int level;                    // level of the word plus @affixLevel (key)
+  int word;                     // index of the word (second key, so the words are kept in the order of the list)
+  int affixLevel;               // level of the affixes to be created next
+} hybridAttack_entry;
+
+/*
+ * Contains the words, the priority queue and the amount of created
+ * candidates.
+ */
+typedef struct hybridAttack_struct
+{
+  char *chars;                  // all words (null terminated, one after another)
+  size_t sizeOf_chars;
+  size_t indexMax_chars;
+  hybridAttack_word *words;     // words in the order of the list
+  int sizeOf_words;
+  int indexMax_words;
+
+  hybridAttack_entry *heap;     // min-heap of the next affix level of each word
+  int sizeOf_heap;
+  int affixLevelMax;            // largest affix level of any candidate
+
+  int sizeOf_alphabet;
+  hybridAttack_table suffixLast;  // last char of a suffix, following the (n-1)-gram: conditionalProb and endProb
+  hybridAttack_table prefixChar;  // char of a prefix, preceding the (n-1)-gram: conditionalProb
+  hybridAttack_table prefixFirst; // first char of a prefix, preceding the (n-1)-gram: conditionalProb and initialProb
+
+  uint64_t ignoredCount;        // amount of lines not containing a word (empty, too long or invalid frequency)
+  uint64_t wordCount;           // amount of words created
+  uint64_t prefixCount;         // amount of words created with a prefix
+  uint64_t suffixCount;         // amount of words created with a suffix
+} hybridAttack_struct;
+
+/*
+ * Reads the wordlist @filename and initializes the queue with the words
+ * (at affix level 0) and the tables of the affixes based on the given model.
+ * Affixes of up to @affixLength chars are created.
+ * Returns FALSE (printing an error) if the file can't be read or doesn't
+ * contain any word.
+ * If the allocation fails, the application is aborted.
+ */
+bool hybridAttack_initialize (hybridAttack_struct ** attack, // hybrid mode to be initialized
+                              const char *filename, // wordlist
+                              const nGram_struct * nGrams,  // model
+                              int sizeOf_alphabet,  // size of the alphabet of the model
+                              int maxLevel, // amount of levels
+                              bool ignoreEP,  // endProbs are not used
+                              int affixLength); // maximal length of an affix
+
+/*
+ * Returns the symbols of the given @table next to the (n-1)-gram at
+ * @position which add @level to an affix, storing their amount in
+ * @sizeOf_symbols.
+ */
+const unsigned char *hybridAttack_getSymbols (const hybridAttack_struct * attack, const hybridAttack_table * table, int position, int level, int *sizeOf_symbols);
+
+/*
+ * Removes the word with the smallest level of its next candidates from the
+ * queue, storing its index in @word and the @affixLevel of the candidates,
+ * and queues the word again with the next affix level (if not larger than
+ * @affixLevelMax).
+ * Returns FALSE if the queue is empty, i.e. all candidates have been
+ * created.
+ */
+bool hybridAttack_next (hybridAttack_struct * attack, int *word, int *affixLevel);
+
+/*
+ * Returns the given @word (null terminated).
+ */
+const char *hybridAttack_getWord (const hybridAttack_struct * attack, int word);
+
+/*
+ * Prints the amount of words read and the amount of candidates created
+ * with and without affixes to the given file pointer @fp.
+ */
+void hybridAttack_printResults (const hybridAttack_struct * attack, FILE * fp);
+
+/*
+ * Frees the given struct (if not NULL).
+ */
+void hybridAttack_free (hybridAttack_struct ** attack);
+
+#endif /* HYBRIDATTACK_H_ */
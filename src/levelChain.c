@@ -0,0 +1,82 @@
+/*
+ * levelChain.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "common.h"
+#include "levelChain.h"
+
+/* (intern faction) Recursively generates a levelChain for the given length and level. Returns true if a levelChain could be created or false if not. */
+bool generate_levelChain_2ndToLast_recursive (int levelChain[MAX_PASSWORD_LENGTH], int depth, int lengthMax, int levelCur, int levelMax, int maxLevel, bool newChain)
+{
+  // if last int for levelChain is reached ...
+  if (depth == (lengthMax - 1))
+  {
+    // the last int must be the rest of levelMax
+    levelChain[lengthMax - 1] = levelMax - levelCur;
+    // and should not be larger then global maximum level
+    if (levelChain[lengthMax - 1] > (maxLevel - 1))
+    {
+      return false;             // reject generated levelChain
+    }
+
+    // accept generated levelChain
+    return true;
+  }
+  else
+  {                             // if depth < (length-1)
+    // get max possible level, but do not exceed global maximum level
+    int level = levelMax - levelCur;
+
+    if (level > (maxLevel - 1))
+    {
+      level = (maxLevel - 1);
+    }
+
+    // proceed from previous set level
+    for (; levelChain[depth] <= level; levelChain[depth]++)
+    {
+      // call recursive function to determine next int
+      if (generate_levelChain_2ndToLast_recursive (levelChain, depth + 1, lengthMax, levelCur + levelChain[depth], levelMax, maxLevel, newChain))
+      {
+        return true;
+      }
+      // reset all others
+      levelChain[depth + 1] = 0;
+    }
+  }
+  return false;
+}                               // (intern) generate_levelChain_2ndToLast_recursive
+
+// set levelChain to the next one
+bool levelChain_getNext (int levelChain[MAX_PASSWORD_LENGTH], int length, int levelMax, int maxLevel, bool newChain)
+{
+  // since any single level can not be larger then 10:
+  int level = levelMax;
+
+  if (level > (maxLevel - 1))
+    level = maxLevel - 1;
+
+  // check, if the chain is possible
+  if (levelMax > (maxLevel - 1) * length)
+    return false;
+
+  // if no new chain should be created;
+  if (!newChain)
+    levelChain[length - 2]++;   // increase second last to avoid doublets
+
+  // for each level <= levelMax (or 10)
+  for (; levelChain[0] <= level; levelChain[0]++)
+  {
+    // call recursive function to determine 2nd to Last int for the levelChain with maxLevel
+    if (generate_levelChain_2ndToLast_recursive (levelChain, 1, length, levelChain[0], levelMax, maxLevel, newChain))
+      return true;
+    // reset levelChain
+    levelChain[1] = 0;
+  }
+  return false;
+}                               // levelChain_getNext
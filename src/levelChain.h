@@ -0,0 +1,33 @@
+/*
+ * levelChain.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Generates the levelChains used by enumNG and libomen. A levelChain
+ * contains one level for the initialProb, each conditionalProb and the
+ * endProb of a password (in this order). Its levels sum up to the level
+ * of the password (without the level of the length).
+ *
+ */
+
+#ifndef LEVELCHAIN_H_
+#define LEVELCHAIN_H_
+
+#include "common.h"
+
+/*
+ * Generates the next levelChain based on the given @levelChain, with
+ * a @length and a level of @levelMax. No single level of the levelChain
+ * is larger than @maxLevel - 1.
+ * To generate a levelChain with different length or level, reset each value
+ * of @levelChain to the minimum (0) and set @newChain.
+ * The new levelChain is stored in @levelChain.
+ * Returns FALSE if there is no further levelChain.
+ */
+bool levelChain_getNext (int levelChain[MAX_PASSWORD_LENGTH], // next levelChain
+                         int length,  // length for the next levelChain
+                         int levelMax,  // sum level for the next levelChain
+                         int maxLevel,  // max level (of the nGrams)
+                         bool newChain);  // new chain? or create one on based the given levelChain?
+
+#endif /* LEVELCHAIN_H_ */
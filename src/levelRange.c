@@ -0,0 +1,162 @@
+/*
+ * levelRange.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "common.h"
+#include "commonStructs.h"
+#include "levelRange.h"
+
+/* (intern function) compare function for qsort (ascending int) */
+int compare_ints (const void *a, const void *b)
+{
+  int intA = *((const int *) a);
+  int intB = *((const int *) b);
+
+  return (intA > intB) - (intA < intB);
+}                               // (intern) compare_ints
+
+/* (intern function) compare function for qsort (ascending by levelMin, then position) */
+int compare_ips (const void *a, const void *b)
+{
+  const levelRange_ip *ipA = (const levelRange_ip *) a;
+  const levelRange_ip *ipB = (const levelRange_ip *) b;
+
+  if (ipA->levelMin != ipB->levelMin)
+    return (ipA->levelMin > ipB->levelMin) - (ipA->levelMin < ipB->levelMin);
+  return (ipA->position > ipB->position) - (ipA->position < ipB->position);
+}                               // (intern) compare_ips
+
+/* (intern function) calculates the level ranges for up to @rest more chars */
+void calculate_rest (levelRange_struct * range, int rest)
+{
+  int sizeOf_alphabet = range->sizeOf_alphabet;
+  int sizeOf_mGram = range->nGramLevel->sizeOf_iP;
+  const int *cP = range->nGramLevel->cP;
+  int level = 0;
+  int next = 0;
+
+  for (int r = range->indexMax_level + 1; r <= rest; r++)
+  {
+    range->levelMin[r] = (int *) malloc (sizeOf_mGram * sizeof (int));
+    EXIT_IF_NULL (range->levelMin[r]);
+    range->levelMax[r] = (int *) malloc (sizeOf_mGram * sizeof (int));
+    EXIT_IF_NULL (range->levelMax[r]);
+
+    for (size_t position = 0; position < sizeOf_mGram; position++)
+    {
+      if (r == 0)
+      {
+        // no more chars, only the endProb is left
+        range->levelMin[r][position] = range->ignoreEP ? 0 : range->nGramLevel->eP[position];
+        range->levelMax[r][position] = range->levelMin[r][position];
+        continue;
+      }
+      range->levelMin[r][position] = INT32_MAX;
+      range->levelMax[r][position] = 0;
+      for (size_t lastGram = 0; lastGram < sizeOf_alphabet; lastGram++)
+      {
+        // the position of the next mGram drops the first char and appends the lastGram
+        next = (position % (sizeOf_mGram / sizeOf_alphabet)) * sizeOf_alphabet + lastGram;
+        level = cP[position * sizeOf_alphabet + lastGram];
+        if (level + range->levelMin[r - 1][next] < range->levelMin[r][position])
+          range->levelMin[r][position] = level + range->levelMin[r - 1][next];
+        if (level + range->levelMax[r - 1][next] > range->levelMax[r][position])
+          range->levelMax[r][position] = level + range->levelMax[r - 1][next];
+      }
+    }
+  }
+  if (rest > range->indexMax_level)
+    range->indexMax_level = rest;
+}                               // (intern) calculate_rest
+
+// allocates the struct and sorts the lastGrams
+void levelRange_initialize (levelRange_struct ** range, const nGram_struct * nGramLevel, int sizeOf_alphabet, bool ignoreEP)
+{
+  int keys[sizeOf_alphabet];    // level and lastGram of each lastGram of a mGram
+
+  *range = (levelRange_struct *) malloc (sizeof (levelRange_struct));
+  EXIT_IF_NULL ((*range));
+
+  for (size_t i = 0; i < MAX_PASSWORD_LENGTH; i++)
+  {
+    (*range)->levelMin[i] = NULL;
+    (*range)->levelMax[i] = NULL;
+    (*range)->iP[i] = NULL;
+  }
+  (*range)->indexMax_level = -1;
+  (*range)->nGramLevel = nGramLevel;
+  (*range)->sizeOf_alphabet = sizeOf_alphabet;
+  (*range)->ignoreEP = ignoreEP;
+
+  (*range)->lastGrams = (unsigned short *) malloc (nGramLevel->sizeOf_cP * sizeof (unsigned short));
+  EXIT_IF_NULL ((*range)->lastGrams);
+
+  // sort the lastGrams of each mGram by level (equal levels keep the order of the alphabet)
+  for (size_t position = 0; position < nGramLevel->sizeOf_iP; position++)
+  {
+    for (size_t lastGram = 0; lastGram < sizeOf_alphabet; lastGram++)
+      keys[lastGram] = nGramLevel->cP[position * sizeOf_alphabet + lastGram] * sizeOf_alphabet + lastGram;
+    qsort (keys, sizeOf_alphabet, sizeof (int), compare_ints);
+    for (size_t i = 0; i < sizeOf_alphabet; i++)
+      (*range)->lastGrams[position * sizeOf_alphabet + i] = (unsigned short) (keys[i] % sizeOf_alphabet);
+  }
+}                               // levelRange_initialize
+
+// frees the struct
+void levelRange_free (levelRange_struct ** range)
+{
+  if (*range != NULL)
+  {
+    for (size_t i = 0; i < MAX_PASSWORD_LENGTH; i++)
+    {
+      CHECKED_FREE ((*range)->levelMin[i]);
+      CHECKED_FREE ((*range)->levelMax[i]);
+      CHECKED_FREE ((*range)->iP[i]);
+    }
+    CHECKED_FREE ((*range)->lastGrams);
+    free (*range);
+    *range = NULL;
+  }
+}                               // levelRange_free
+
+// returns the level ranges to add @rest more chars
+void levelRange_getRest (levelRange_struct * range, int rest, const int **levelMin, const int **levelMax)
+{
+  if (rest > range->indexMax_level)
+    calculate_rest (range, rest);
+  *levelMin = range->levelMin[rest];
+  *levelMax = range->levelMax[rest];
+}                               // levelRange_getRest
+
+// returns the initialProbs sorted by their minimal level for the given length
+const levelRange_ip *levelRange_getIP (levelRange_struct * range, int length)
+{
+  int sizeOf_iP = range->nGramLevel->sizeOf_iP;
+  int rest = length - (range->nGramLevel->sizeOf_N - 1);
+  const int *levelMin = NULL;
+  const int *levelMax = NULL;
+
+  if (range->iP[length] == NULL)
+  {
+    levelRange_getRest (range, rest, &levelMin, &levelMax);
+
+    range->iP[length] = (levelRange_ip *) malloc (sizeOf_iP * sizeof (levelRange_ip));
+    EXIT_IF_NULL (range->iP[length]);
+    for (size_t i = 0; i < sizeOf_iP; i++)
+    {
+      range->iP[length][i].levelMin = range->nGramLevel->iP[i] + levelMin[i];
+      range->iP[length][i].levelMax = range->nGramLevel->iP[i] + levelMax[i];
+      range->iP[length][i].position = i;
+    }
+    qsort (range->iP[length], sizeOf_iP, sizeof (levelRange_ip), compare_ips);
+  }
+  return range->iP[length];
+}                               // levelRange_getIP
@@ -0,0 +1,83 @@
+/*
+ * levelRange.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Storage used by enumNG for fine-grained level scales (see createNG
+ * --levelScale). With hundreds of levels, neither the explicit levelChains
+ * nor the lastGrams stored per level (sortedLastGram_struct) scale, since
+ * both grow with maxLevel. Instead, the lastGrams of each mGram are stored
+ * sorted by level in a single array and each subtree (remaining chars and the
+ * position of the last (n-1) chars) is summarized by the range of levels its
+ * passwords can reach. The levelChain is then refined lazily while the
+ * password is created: only subtrees whose level range contains the
+ * remaining level are visited.
+ *
+ */
+
+#ifndef LEVELRANGE_H_
+#define LEVELRANGE_H_
+
+#include "common.h"
+#include "commonStructs.h"
+
+/*
+ * An initialProb and the range of the overall level (without the length
+ * level) of any password of a given length starting with it.
+ */
+typedef struct levelRange_ip
+{
+  int levelMin;                 // minimal level (initialProb + minimal rest)
+  int levelMax;                 // maximal level (initialProb + maximal rest)
+  int position;                 // position of the initialProb
+} levelRange_ip;
+
+/*
+ * Contains the lastGrams sorted by level, the level ranges of all subtrees
+ * and the initialProbs sorted by their minimal level (one array per length).
+ * The ranges and initialProbs are calculated on first use.
+ */
+typedef struct levelRange_struct
+{
+  unsigned short *lastGrams;    // lastGrams of each mGram (alphabet size entries each), sorted by level
+
+  int *levelMin[MAX_PASSWORD_LENGTH]; // minimal level to add x more chars (and the endProb) by position of the mGram
+  int *levelMax[MAX_PASSWORD_LENGTH]; // maximal level to add x more chars (and the endProb) by position of the mGram
+  int indexMax_level;           // largest x calculated so far (-1 if none)
+
+  levelRange_ip *iP[MAX_PASSWORD_LENGTH]; // initialProbs by password length, sorted by levelMin
+
+  const nGram_struct *nGramLevel; // levels (must not change while the struct is used)
+  int sizeOf_alphabet;          // size of the alphabet
+  bool ignoreEP;                // TRUE, if the endProbs are ignored
+} levelRange_struct;
+
+/*
+ * Allocates the given struct and sorts the lastGrams of @nGramLevel by level.
+ * The level arrays of @nGramLevel are referenced, not copied.
+ * If the allocation fails, the application is aborted.
+ */
+void levelRange_initialize (levelRange_struct ** range, // struct to be initialized
+                            const nGram_struct * nGramLevel, // levels (iP, cP and eP)
+                            int sizeOf_alphabet,  // size of the alphabet
+                            bool ignoreEP); // TRUE, if the endProbs are ignored
+
+/*
+ * Frees the given struct (if not NULL).
+ */
+void levelRange_free (levelRange_struct ** range);
+
+/*
+ * Returns the minimal (@levelMin) and maximal (@levelMax) level arrays to
+ * add @rest more chars (and the endProb), calculating them if needed.
+ */
+void levelRange_getRest (levelRange_struct * range, int rest, const int **levelMin, const int **levelMax);
+
+/*
+ * Returns all initialProbs sorted by the minimal level of a password with
+ * the given @length (at least n), calculating them if needed.
+ * The returned array contains sizeOf_iP entries.
+ */
+const levelRange_ip *levelRange_getIP (levelRange_struct * range, int length);
+
+#endif /* LEVELRANGE_H_ */
@@ -0,0 +1,410 @@
+/*
+ * libomen.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "errorHandler.h"
+#include "commonStructs.h"
+#include "nGramReader.h"
+#include "levelChain.h"
+#include "levelRange.h"
+#include "libomen.h"
+
+struct omen_model
+{
+  nGram_struct *nGramLevel;     // levels of nGrams, initialProbs, endProbs and lengths
+  alphabet_struct *alphabet;    // alphabet read from the config
+  filename_struct *filenames;   // filenames of the level files (read from the config)
+  int maxLevel;                 // max level read from the config
+
+  sortedLastGram_struct *sortedLastGram;  // lastGrams sorted by level and position (NULL for fine-grained levels)
+  sortedIP_struct *sortedIP;    // initialProbs sorted by level (NULL for fine-grained levels)
+  sortedLength_struct *sortedLength;  // lengths sorted by level
+  levelRange_struct *levelRange[2]; // level ranges for fine-grained levels by ignoreEP (created by omen_enum_new)
+  bool levelRangeMode;          // TRUE, if maxLevel > MAX_LEVEL (see enumNG)
+  int charPosition[256];        // position in the alphabet by char (-1 if not part of the alphabet)
+};
+
+/*
+ * The enumeration is split into nested steps, each resumed where the last
+ * call of omen_next_batch stopped: the next length (and overall level), the
+ * next levelChain, the next initialProb and the next password created by a
+ * depth-first search over the remaining chars.
+ */
+typedef enum omen_state
+{
+  omen_stateLength,
+  omen_stateChain,
+  omen_stateIP,
+  omen_statePassword,
+  omen_stateFinished
+} omen_state;
+
+struct omen_enum_ctx
+{
+  const omen_model *model;      // model the enumeration is based on
+  const levelRange_struct *levelRange;  // level ranges (fine-grained levels only)
+  int fixedLength;              // if != 0, only create passwords of this length
+  bool ignoreEP;                // TRUE, if the endProbs are ignored
+  omen_state state;             // next step of the enumeration
+
+  int levelOverall;             // current overall level
+  int levelOverallMax;          // max value for the overall level
+  int lengthIndex;              // current index in the sorted lengths
+  int lengthIndexMax;           // amount of lengths with a level smaller or equal levelOverall
+
+  int lengthLC;                 // length of the levelChain
+  int lengthPW;                 // length of the password
+  int level;                    // level of the password without the level of the length
+  int levelChain[MAX_PASSWORD_LENGTH + 1];  // current levelChain
+  bool newChain;                // TRUE, if the next levelChain is the first of the length and level
+  int iPIndex;                  // index of the next initialProb
+
+  int lengthCur;                // length of the current prefix (depth of the search)
+  int index[MAX_PASSWORD_LENGTH + 1]; // index of the next lastGram by prefix length
+  int position[MAX_PASSWORD_LENGTH + 1];  // position of the last (n-1) chars by prefix length
+  int levelRest[MAX_PASSWORD_LENGTH + 1]; // remaining level by prefix length (fine-grained levels only)
+  int passwordAsInt[MAX_PASSWORD_LENGTH]; // current password as positions in the alphabet
+};
+
+// reads the config and all level files and sorts the levels
+omen_model *omen_model_load (const char *configFilename)
+{
+  omen_model *model = (omen_model *) malloc (sizeof (omen_model));
+
+  EXIT_IF_NULL (model);
+
+  struct_filenames_initialize (&(model->filenames));
+  struct_filenames_allocateDefaults (model->filenames);
+  struct_alphabet_initialize (&(model->alphabet));
+  struct_alphabet_allocateDefaults (model->alphabet);
+  struct_nGrams_initialize (&(model->nGramLevel));
+  model->maxLevel = MAX_LEVEL;
+  model->sortedLastGram = NULL;
+  model->sortedIP = NULL;
+  model->sortedLength = NULL;
+  model->levelRange[0] = NULL;
+  model->levelRange[1] = NULL;
+
+  if (!changeFilename (&(model->filenames->cfg), FILENAME_MAX, "config", configFilename)
+      || !read_inputFiles (model->nGramLevel, model->alphabet, model->filenames, &(model->maxLevel)))
+  {
+    errorHandler_print (errorType_Error, "Unable to read the model (config: %s).\n", configFilename);
+    omen_model_free (model);
+    return NULL;
+  }
+  model->levelRangeMode = model->maxLevel > MAX_LEVEL;
+
+  // lookup table replacing the search in the alphabet (see omen_model_level)
+  struct_alphabet_fillPositions (model->alphabet, model->charPosition);
+
+  // sort the levels (the level ranges depend on ignoreEP and are created by omen_enum_new)
+  if (!model->levelRangeMode)
+  {
+    struct_sortedLastGram_initialize (model->maxLevel, &(model->sortedLastGram), model->nGramLevel->sizeOf_N, model->alphabet->sizeOf_alphabet);
+    struct_sortedLastGram_fill (model->maxLevel, model->sortedLastGram, model->nGramLevel->cP, model->nGramLevel->sizeOf_cP, model->nGramLevel->sizeOf_N, model->alphabet->sizeOf_alphabet);
+    struct_sortedIP_initialize (model->maxLevel, &(model->sortedIP), 1);
+    struct_sortedIP_fill (model->maxLevel, model->sortedIP, model->nGramLevel->iP, model->nGramLevel->sizeOf_iP);
+  }
+  struct_sortedLength_initialize (&(model->sortedLength));
+  struct_sortedLength_fill (model->sortedLength, model->nGramLevel->len, model->nGramLevel->sizeOf_N, 0.0, -1);
+
+  return model;
+}                               // omen_model_load
+
+// calculates the level of the password
+bool omen_model_level (const omen_model * model, const omen_enum_options * options, const char *password, int length, int *level)
+{
+  int fixedLength = (options != NULL) ? options->fixedLength : 0;
+  bool ignoreEP = (options != NULL) ? options->ignoreEP : false;
+
+  if (fixedLength != 0 && length != fixedLength)
+    return false;
+  // the level of the length is only part of the overall level without a fixed length
+  return struct_nGrams_level (model->nGramLevel, model->charPosition, model->alphabet->sizeOf_alphabet, password, length, ignoreEP, fixedLength == 0, level);
+}                               // omen_model_level
+
+// frees the model
+void omen_model_free (omen_model * model)
+{
+  if (model != NULL)
+  {
+    struct_sortedLastGram_free (model->maxLevel, &(model->sortedLastGram));
+    struct_sortedIP_free (model->maxLevel, &(model->sortedIP));
+    struct_sortedLength_free (&(model->sortedLength));
+    levelRange_free (&(model->levelRange[0]));
+    levelRange_free (&(model->levelRange[1]));
+    struct_nGrams_free (&(model->nGramLevel));
+    struct_alphabet_free (&(model->alphabet));
+    struct_filenames_free (&(model->filenames));
+    free (model);
+  }
+}                               // omen_model_free
+
+// creates a new enumeration
+omen_enum_ctx *omen_enum_new (omen_model * model, const omen_enum_options * options)
+{
+  omen_enum_ctx *ctx = NULL;
+  int sizeOf_N = model->nGramLevel->sizeOf_N;
+  int fixedLength = (options != NULL) ? options->fixedLength : 0;
+  bool ignoreEP = (options != NULL) ? options->ignoreEP : false;
+
+  if (fixedLength != 0 && (fixedLength < sizeOf_N || fixedLength >= MAX_PASSWORD_LENGTH))
+  {
+    errorHandler_print (errorType_Error, "The fixed length must be in range %i to %i.\n", sizeOf_N, MAX_PASSWORD_LENGTH - 1);
+    return NULL;
+  }
+
+  // fine-grained levels: calculate the level ranges of all lengths once, so they are read-only while enumerating
+  if (model->levelRangeMode && model->levelRange[ignoreEP] == NULL)
+  {
+    levelRange_initialize (&(model->levelRange[ignoreEP]), model->nGramLevel, model->alphabet->sizeOf_alphabet, ignoreEP);
+    for (int length = sizeOf_N; length < MAX_PASSWORD_LENGTH; length++)
+      levelRange_getIP (model->levelRange[ignoreEP], length);
+  }
+
+  ctx = (omen_enum_ctx *) malloc (sizeof (omen_enum_ctx));
+  EXIT_IF_NULL (ctx);
+  memset (ctx, 0, sizeof (omen_enum_ctx));
+
+  ctx->model = model;
+  ctx->levelRange = model->levelRange[ignoreEP];
+  ctx->fixedLength = fixedLength;
+  ctx->ignoreEP = ignoreEP;
+  ctx->state = omen_stateLength;
+
+  // start before the first length with level 0
+  ctx->levelOverall = 0;
+  ctx->lengthIndex = -1;
+  if (fixedLength != 0)
+  {
+    ctx->lengthIndexMax = 1;
+    ctx->levelOverallMax = (model->maxLevel - 1) * (fixedLength + (ignoreEP ? 2 : 3) - sizeOf_N);
+  }
+  else
+  {
+    ctx->lengthIndexMax = struct_sortedLength_getMaxIndexForLevel (model->sortedLength, 0);
+    ctx->levelOverallMax = (model->maxLevel - 1) * MAX_PASSWORD_LENGTH + model->sortedLength->level[MAX_PASSWORD_LENGTH - sizeOf_N - 1];
+  }
+  return ctx;
+}                               // omen_enum_new
+
+// frees the enumeration
+void omen_enum_free (omen_enum_ctx * ctx)
+{
+  CHECKED_FREE (ctx);
+}                               // omen_enum_free
+
+/* (intern function) Selects the next length (and overall level, if all lengths of the current one are done). Returns FALSE if the max level has been reached. */
+bool next_length (omen_enum_ctx * ctx)
+{
+  const omen_model *model = ctx->model;
+
+  ctx->lengthIndex++;
+  while (ctx->lengthIndex >= ctx->lengthIndexMax)
+  {
+    ctx->levelOverall++;
+    if (ctx->levelOverall > ctx->levelOverallMax)
+      return false;
+    ctx->lengthIndex = 0;
+    if (ctx->fixedLength == 0)
+      ctx->lengthIndexMax = struct_sortedLength_getMaxIndexForLevel (model->sortedLength, ctx->levelOverall);
+  }
+
+  if (ctx->fixedLength != 0)
+  {
+    ctx->lengthPW = ctx->fixedLength;
+    ctx->level = ctx->levelOverall;
+  }
+  else
+  {
+    ctx->lengthPW = model->sortedLength->length[ctx->lengthIndex];
+    ctx->level = ctx->levelOverall - model->sortedLength->level[ctx->lengthIndex];
+  }
+  ctx->lengthLC = ctx->lengthPW + (ctx->ignoreEP ? 2 : 3) - model->nGramLevel->sizeOf_N;
+
+  memset (ctx->levelChain, 0, sizeof (ctx->levelChain));
+  ctx->newChain = true;
+  return true;
+}                               // (intern) next_length
+
+/* (intern function) Selects the next levelChain of the current length and level. Returns FALSE if there is none. */
+bool next_chain (omen_enum_ctx * ctx)
+{
+  if (ctx->levelRange != NULL)
+  {
+    // fine-grained levels: the levelChain is refined while the password is created
+    if (!ctx->newChain)
+      return false;
+  }
+  else if (!levelChain_getNext (ctx->levelChain, ctx->lengthLC, ctx->level, ctx->model->maxLevel, ctx->newChain))
+    return false;
+
+  ctx->newChain = false;
+  ctx->iPIndex = 0;
+  return true;
+}                               // (intern) next_chain
+
+/* (intern function) Starts the search for the next initialProb matching the current levelChain. Returns FALSE if there is none. */
+bool next_iP (omen_enum_ctx * ctx)
+{
+  const nGram_struct *nGramLevel = ctx->model->nGramLevel;
+  int lengthCur = nGramLevel->sizeOf_N - 1;
+  int position = 0;
+
+  if (ctx->levelRange != NULL)
+  {
+    const levelRange_ip *iP = ctx->levelRange->iP[ctx->lengthPW];
+
+    // initialProbs are sorted ascending by minimal level
+    while (ctx->iPIndex < nGramLevel->sizeOf_iP && iP[ctx->iPIndex].levelMin <= ctx->level && iP[ctx->iPIndex].levelMax < ctx->level)
+      ctx->iPIndex++;
+    if (ctx->iPIndex == nGramLevel->sizeOf_iP || iP[ctx->iPIndex].levelMin > ctx->level)
+      return false;
+    position = iP[ctx->iPIndex].position;
+  }
+  else
+  {
+    const sortedIP_struct *sortedIP = ctx->model->sortedIP + ctx->levelChain[0];
+
+    if (ctx->iPIndex == sortedIP->indexCur)
+      return false;
+    position = sortedIP->iP[ctx->iPIndex];
+  }
+  ctx->iPIndex++;
+
+  get_nGramAsIntFromPosition (ctx->passwordAsInt, position, lengthCur, ctx->model->alphabet->sizeOf_alphabet);
+  ctx->lengthCur = lengthCur;
+  ctx->index[lengthCur] = 0;
+  ctx->position[lengthCur] = position;
+  ctx->levelRest[lengthCur] = ctx->level - nGramLevel->iP[position];
+  return true;
+}                               // (intern) next_iP
+
+/* (intern function) Selects the next lastGram for the prefix of the current length. Returns FALSE if there is none. */
+bool next_lastGram (omen_enum_ctx * ctx, int *lastGram)
+{
+  const omen_model *model = ctx->model;
+  int sizeOf_alphabet = model->alphabet->sizeOf_alphabet;
+  int lengthCur = ctx->lengthCur;
+  int position = ctx->position[lengthCur];
+  int next = 0;
+  int levelCur = 0;
+  int rest = 0;
+
+  if (ctx->levelRange != NULL)
+  {
+    const unsigned short *lastGrams = ctx->levelRange->lastGrams + position * sizeOf_alphabet;
+    const int *cP = model->nGramLevel->cP + position * sizeOf_alphabet;
+
+    rest = ctx->lengthPW - lengthCur - 1;
+    // for each lastGram (ascending by level) not exceeding the remaining level
+    while (ctx->index[lengthCur] < sizeOf_alphabet)
+    {
+      *lastGram = lastGrams[ctx->index[lengthCur]];
+      levelCur = cP[*lastGram];
+      if (levelCur > ctx->levelRest[lengthCur])
+        break;
+      ctx->index[lengthCur]++;
+      next = (position % (model->nGramLevel->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet + *lastGram;
+      if (ctx->levelRest[lengthCur] - levelCur >= ctx->levelRange->levelMin[rest][next] && ctx->levelRest[lengthCur] - levelCur <= ctx->levelRange->levelMax[rest][next])
+      {
+        ctx->levelRest[lengthCur + 1] = ctx->levelRest[lengthCur] - levelCur;
+        return true;
+      }
+    }
+    ctx->index[lengthCur] = sizeOf_alphabet;
+    return false;
+  }
+  else
+  {
+    const sortedLastGram_struct *sortedLastGram = model->sortedLastGram + ctx->levelChain[lengthCur - (model->nGramLevel->sizeOf_N - 2)];
+
+    if (ctx->index[lengthCur] == sortedLastGram->indexStart[position + 1] - sortedLastGram->indexStart[position])
+      return false;
+    *lastGram = sortedLastGram->lastGrams[sortedLastGram->indexStart[position] + ctx->index[lengthCur]];
+    ctx->index[lengthCur]++;
+    return true;
+  }
+}                               // (intern) next_lastGram
+
+/* (intern function) Continues the depth-first search of the current initialProb. Returns FALSE if all its passwords have been created. */
+bool next_password (omen_enum_ctx * ctx)
+{
+  const nGram_struct *nGramLevel = ctx->model->nGramLevel;
+  int sizeOf_alphabet = ctx->model->alphabet->sizeOf_alphabet;
+  int lengthMin = nGramLevel->sizeOf_N - 1;
+  int lengthCur = 0;
+  int lastGram = 0;
+
+  while (ctx->lengthCur >= lengthMin)
+  {
+    lengthCur = ctx->lengthCur;
+
+    // password is complete: go back to the previous char and check the endProb
+    if (lengthCur == ctx->lengthPW)
+    {
+      ctx->lengthCur--;
+      // (for fine-grained levels, the level ranges ensure the endProb matches)
+      if (ctx->levelRange != NULL || ctx->ignoreEP || ctx->levelChain[lengthCur - (nGramLevel->sizeOf_N - 2)] == nGramLevel->eP[ctx->position[lengthCur]])
+        return true;
+    }
+    else if (next_lastGram (ctx, &lastGram))
+    {
+      // add lastGram as int to the PW and continue with length + 1
+      ctx->passwordAsInt[lengthCur] = lastGram;
+      ctx->position[lengthCur + 1] = (ctx->position[lengthCur] % (nGramLevel->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet + lastGram;
+      ctx->index[lengthCur + 1] = 0;
+      ctx->lengthCur++;
+    }
+    else
+      ctx->lengthCur--;
+  }
+  return false;
+}                               // (intern) next_password
+
+// returns the next passwords of the enumeration
+size_t omen_next_batch (omen_enum_ctx * ctx, omen_candidate * buf, size_t n)
+{
+  size_t count = 0;
+
+  while (count < n && ctx->state != omen_stateFinished)
+  {
+    switch (ctx->state)
+    {
+    case omen_stateLength:
+      ctx->state = next_length (ctx) ? omen_stateChain : omen_stateFinished;
+      break;
+    case omen_stateChain:
+      ctx->state = next_chain (ctx) ? omen_stateIP : omen_stateLength;
+      break;
+    case omen_stateIP:
+      ctx->state = next_iP (ctx) ? omen_statePassword : omen_stateChain;
+      break;
+    case omen_statePassword:
+      if (!next_password (ctx))
+      {
+        ctx->state = omen_stateIP;
+        break;
+      }
+      // create the corresponding password as char
+      for (size_t i = 0; i < ctx->lengthPW; i++)
+        get_charAtPosition (buf[count].password + i, ctx->passwordAsInt[i], ctx->model->alphabet->alphabet, ctx->model->alphabet->sizeOf_alphabet);
+      buf[count].password[ctx->lengthPW] = '\0';
+      buf[count].length = (unsigned char) ctx->lengthPW;
+      buf[count].level = ctx->levelOverall;
+      count++;
+      break;
+    case omen_stateFinished:
+      break;
+    }
+  }
+  return count;
+}                               // omen_next_batch
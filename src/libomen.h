@@ -0,0 +1,99 @@
+/*
+ * libomen.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Library interface to the ordered password enumeration of enumNG (build
+ * using "make libomen", creating libomen.a and libomen.so).
+ * A model (omen_model) holds the level files created by createNG and is
+ * read-only once loaded. Any amount of enumerations (omen_enum_ctx) can be
+ * created from the same model; each enumeration keeps its own state and
+ * returns the passwords in the same order as enumNG (default order) in
+ * batches of arbitrary size using omen_next_batch.
+ * Different enumerations may be used concurrently from different threads,
+ * while creating and freeing them must not overlap with other calls on the
+ * same model.
+ * The library also contains the consumer side of the ring buffer written by
+ * enumNG --ring (see candidateRing.h).
+ *
+ */
+
+#ifndef LIBOMEN_H_
+#define LIBOMEN_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "defines.h"
+
+/*
+ * Model created by createNG (see omen_model_load).
+ */
+typedef struct omen_model omen_model;
+
+/*
+ * State of a single enumeration (see omen_enum_new).
+ */
+typedef struct omen_enum_ctx omen_enum_ctx;
+
+/*
+ * Settings of an enumeration. Zero initialized settings equal the default
+ * settings of enumNG.
+ */
+typedef struct omen_enum_options
+{
+  int fixedLength;              // if != 0, only create passwords of this length (like enumNG -l)
+  bool ignoreEP;                // TRUE, if the endProbs are ignored (like enumNG -E)
+} omen_enum_options;
+
+/*
+ * Single password returned by omen_next_batch.
+ */
+typedef struct omen_candidate
+{
+  char password[MAX_PASSWORD_LENGTH]; // password (null terminated)
+  unsigned char length;         // length of the password
+  int level;                    // overall level (including the level of the length, unless a fixed length is set)
+} omen_candidate;
+
+/*
+ * Reads the config @configFilename and all level files listed in it
+ * (relative to the working directory, like enumNG -c).
+ * Returns NULL if any file can't be read.
+ */
+omen_model *omen_model_load (const char *configFilename);
+
+/*
+ * Frees the given model (if not NULL). Any enumeration created from it must
+ * have been freed before.
+ */
+void omen_model_free (omen_model * model);
+
+/*
+ * Creates a new enumeration based on the given @model, starting with the
+ * most probable password. @options may be NULL to use the default settings.
+ * Returns NULL if the settings are invalid.
+ */
+omen_enum_ctx *omen_enum_new (omen_model * model, const omen_enum_options * options);
+
+/*
+ * Frees the given enumeration (if not NULL).
+ */
+void omen_enum_free (omen_enum_ctx * ctx);
+
+/*
+ * Stores the next (up to) @n passwords of the enumeration in @buf.
+ * Returns the amount of passwords stored, which is smaller than @n only if
+ * all passwords have been created.
+ */
+size_t omen_next_batch (omen_enum_ctx * ctx, omen_candidate * buf, size_t n);
+
+/*
+ * Calculates the level an enumeration of the @model with the given
+ * @options (may be NULL) assigns to the @password of @length (as returned
+ * in omen_candidate).
+ * Returns FALSE if the enumeration never creates the password.
+ */
+bool omen_model_level (const omen_model * model, const omen_enum_options * options, const char *password, int length, int *level);
+
+#endif /* LIBOMEN_H_ */
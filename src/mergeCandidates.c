@@ -0,0 +1,311 @@
+/*
+ * mergeCandidates.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "cmdlineMergeCandidates.h"
+#include "common.h"
+#include "errorHandler.h"
+#include "bloomFilter.h"
+#include "scoredStream.h"
+#include "mergeCandidates.h"
+
+mergeCandidates_stream *glbl_streams = NULL;  // input streams
+int glbl_sizeOf_streams = 0;
+int *glbl_heap = NULL;          // indices of the unfinished streams, min-heap by score (and index)
+int glbl_sizeOf_heap = 0;
+
+char *glbl_filenameOutput = NULL; // output file (stdout if NULL) [-o <filename>]
+FILE *glbl_FP_output = NULL;
+bool glbl_scoredMode = false;   // write a scored stream instead of a password per line [-s]
+bool glbl_verboseMode = false;  // print the results to stderr [-v]
+
+// rolling filter: passwords are inserted into the current filter, both filters are checked
+bloomFilter_struct *glbl_filter[2] = { NULL, NULL };
+int glbl_filterCur = 0;         // index of the current filter
+uint64_t glbl_filterCapacity = 0; // passwords inserted into the current filter before rolling over
+uint64_t glbl_duplicateCount = 0; // amount of passwords dropped as duplicate
+uint64_t glbl_rollCount = 0;    // amount of times the older filter has been cleared
+double glbl_falsePositiveRate = 0.0;  // probability of a new password being dropped by the filters
+double glbl_falsePositiveCount = 0.0; // expected amount of new passwords dropped as duplicate
+
+struct gengetopt_args_info glbl_args_info;
+
+int main (int argc, char **argv)
+{
+  // let's call our cmdline parser
+  if (cmdline_parser (argc, argv, &glbl_args_info) != 0)
+  {
+    printf ("failed parsing command line arguments\n");
+    exit (EXIT_FAILURE);
+  }
+  // set exit_routine so thats automatically called
+  atexit (exit_routine);
+
+  initialize ();
+
+  if (!evaluate_arguments (&glbl_args_info))
+    exit (EXIT_FAILURE);
+
+  if (!apply_settings ())
+    exit (EXIT_FAILURE);
+
+  if (!run_merge ())
+    exit (EXIT_FAILURE);
+
+  exit (EXIT_SUCCESS);
+}
+
+void initialize ()
+{
+  glbl_sizeOf_streams = 0;
+  glbl_sizeOf_heap = 0;
+  glbl_duplicateCount = 0;
+  glbl_falsePositiveRate = 0.0;
+  glbl_falsePositiveCount = 0.0;
+}
+
+// exit routine, frees any allocated memory (for global variables)
+void exit_routine ()
+{
+  if (glbl_verboseMode && glbl_streams != NULL)
+    print_results (stderr);
+
+  for (int i = 0; i < glbl_sizeOf_streams; i++)
+  {
+    if (glbl_streams[i].fp != NULL && glbl_streams[i].fp != stdin)
+      fclose (glbl_streams[i].fp);
+  }
+  CHECKED_FREE (glbl_streams);
+  CHECKED_FREE (glbl_heap);
+  bloomFilter_free (&glbl_filter[0]);
+  bloomFilter_free (&glbl_filter[1]);
+
+  if (glbl_FP_output != NULL && glbl_FP_output != stdout)
+    fclose (glbl_FP_output);
+  glbl_FP_output = NULL;
+  CHECKED_FREE (glbl_filenameOutput);
+
+  errorHandler_finalize ();
+  cmdline_parser_free (&glbl_args_info);  // release allocated memory
+}                               // exit_routine
+
+// evaluates command line parameters
+bool evaluate_arguments (struct gengetopt_args_info *args_info)
+{
+  bool result = true;
+
+  errorHandler_init (args_info->printWarnings_flag);
+
+  glbl_verboseMode = args_info->verbose_flag;
+  glbl_scoredMode = args_info->scored_flag;
+
+  if (args_info->output_given)
+  {
+    result &= changeFilename (&glbl_filenameOutput, FILENAME_MAX, "output", args_info->output_arg);
+  }
+
+  if (args_info->offset_given != 0 && args_info->offset_given != args_info->input_given)
+  {
+    errorHandler_print (errorType_Error, "The offset must be given for each input (or for none of them).\n");
+    result = false;
+  }
+
+  if (args_info->filter_arg < 1)
+  {
+    errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "filter", 1);
+    result = false;
+  }
+  return result;
+}                               // evaluate_arguments
+
+/* (intern function) Reads the next record of the given stream, returns FALSE at the end of the stream. */
+bool merge_readNext (mergeCandidates_stream * stream)
+{
+  int32_t score = 0;
+  int64_t scorePrevious = stream->score;
+  int result = scoredStream_read (stream->fp, &score, stream->password, &(stream->length));
+
+  if (result < 0)
+    errorHandler_print (errorType_Warning, "The last record of %s is truncated.\n", stream->filename);
+  if (result <= 0)
+    return false;
+
+  stream->score = (int64_t) score + stream->offset;
+  if (stream->readCount > 0 && stream->score < scorePrevious && !stream->unsorted)
+  {
+    errorHandler_print (errorType_Warning, "%s is not sorted by score, the merged passwords aren't either.\n", stream->filename);
+    stream->unsorted = true;
+  }
+  stream->readCount++;
+  return true;
+}                               // (intern) merge_readNext
+
+/* (intern function) Returns TRUE if the next password of stream @a comes before the one of stream @b (smaller score, streams in the order given for equal scores). */
+bool merge_isBefore (int a, int b)
+{
+  if (glbl_streams[a].score != glbl_streams[b].score)
+    return glbl_streams[a].score < glbl_streams[b].score;
+  return a < b;
+}                               // (intern) merge_isBefore
+
+/* (intern function) Moves the stream at @index of the heap down to its position. */
+void merge_siftDown (int index)
+{
+  while (true)
+  {
+    int smallest = index;
+    int left = 2 * index + 1;
+    int right = left + 1;
+    int swap = 0;
+
+    if (left < glbl_sizeOf_heap && merge_isBefore (glbl_heap[left], glbl_heap[smallest]))
+      smallest = left;
+    if (right < glbl_sizeOf_heap && merge_isBefore (glbl_heap[right], glbl_heap[smallest]))
+      smallest = right;
+    if (smallest == index)
+      return;
+    swap = glbl_heap[index];
+    glbl_heap[index] = glbl_heap[smallest];
+    glbl_heap[smallest] = swap;
+    index = smallest;
+  }
+}                               // (intern) merge_siftDown
+
+bool apply_settings ()
+{
+  uint64_t filterBytes = ((uint64_t) glbl_args_info.filter_arg << 20) / 2;
+
+  // open the output
+  if (glbl_filenameOutput == NULL)
+    glbl_FP_output = stdout;
+  else if (!open_file (&glbl_FP_output, glbl_filenameOutput, NULL, "w"))
+  {
+    errorHandler_print (errorType_Error, "Can't open output file.\n");
+    return false;
+  }
+  if (glbl_scoredMode && !scoredStream_writeHeader (glbl_FP_output))
+  {
+    errorHandler_print (errorType_Error, "Can't write the output.\n");
+    return false;
+  }
+
+  // two filters of half the size, each holding BLOOMFILTER_BITS_PER_ELEMENT bits per password
+  bloomFilter_initialize (&glbl_filter[0], filterBytes * 8 / BLOOMFILTER_BITS_PER_ELEMENT, BLOOMFILTER_BITS_PER_ELEMENT, filterBytes);
+  bloomFilter_initialize (&glbl_filter[1], filterBytes * 8 / BLOOMFILTER_BITS_PER_ELEMENT, BLOOMFILTER_BITS_PER_ELEMENT, filterBytes);
+  glbl_filterCapacity = glbl_filter[0]->sizeOf_blocks * BLOOMFILTER_BLOCK_WORDS * 64 / BLOOMFILTER_BITS_PER_ELEMENT;
+
+  // open the input streams and read their first record
+  glbl_streams = (mergeCandidates_stream *) calloc (glbl_args_info.input_given, sizeof (mergeCandidates_stream));
+  EXIT_IF_NULL (glbl_streams);
+  glbl_heap = (int *) malloc (glbl_args_info.input_given * sizeof (int));
+  EXIT_IF_NULL (glbl_heap);
+  for (size_t i = 0; i < glbl_args_info.input_given; i++)
+  {
+    mergeCandidates_stream *stream = glbl_streams + glbl_sizeOf_streams;
+
+    stream->filename = glbl_args_info.input_arg[i];
+    stream->offset = (glbl_args_info.offset_given > 0) ? glbl_args_info.offset_arg[i] : 0;
+    if (strcmp (stream->filename, "-") == 0)
+      stream->fp = stdin;
+    else if (!open_file (&(stream->fp), stream->filename, NULL, "r"))
+    {
+      errorHandler_print (errorType_Error, "Can't open input file %s.\n", stream->filename);
+      return false;
+    }
+    glbl_sizeOf_streams++;
+    if (!scoredStream_readHeader (stream->fp))
+    {
+      errorHandler_print (errorType_Error, "%s is not a scored password stream.\n", stream->filename);
+      return false;
+    }
+    if (merge_readNext (stream))
+      glbl_heap[glbl_sizeOf_heap++] = glbl_sizeOf_streams - 1;
+  }
+
+  // build the heap
+  for (int i = glbl_sizeOf_heap / 2 - 1; i >= 0; i--)
+    merge_siftDown (i);
+  return true;
+}                               // apply_settings
+
+/* (intern function) Returns TRUE if the given password has (probably) been written before, inserting it into the rolling filter. */
+bool merge_isDuplicate (const char *password, int length)
+{
+  bloomFilter_struct *current = glbl_filter[glbl_filterCur];
+  bloomFilter_struct *older = glbl_filter[1 - glbl_filterCur];
+
+  if (bloomFilter_insert (current, password, length))
+    return true;
+  if (bloomFilter_contains (older, password, length))
+    return true;
+
+  /* each new password is dropped with the false positive rate, so each written one stands for rate / (1 - rate) new passwords dropped
+     (the duplicates can't be told apart from them) */
+  glbl_falsePositiveCount += glbl_falsePositiveRate / (1.0 - glbl_falsePositiveRate);
+
+  // the current filter is full: clear the older one and continue with it
+  if (current->insertedCount >= glbl_filterCapacity)
+  {
+    bloomFilter_clear (older);
+    glbl_filterCur = 1 - glbl_filterCur;
+    glbl_rollCount++;
+  }
+  // a new password is dropped if any of both filters reports it as seen (updated after clearing one of them as well)
+  if (glbl_filter[glbl_filterCur]->insertedCount % MERGECANDIDATES_RATE_INTERVAL == 0)
+    glbl_falsePositiveRate = 1.0 - (1.0 - bloomFilter_falsePositiveRate (glbl_filter[0])) * (1.0 - bloomFilter_falsePositiveRate (glbl_filter[1]));
+  return false;
+}                               // (intern) merge_isDuplicate
+
+// merges the streams by score
+bool run_merge ()
+{
+  while (glbl_sizeOf_heap > 0)
+  {
+    mergeCandidates_stream *stream = glbl_streams + glbl_heap[0];
+
+    if (merge_isDuplicate (stream->password, stream->length))
+      glbl_duplicateCount++;
+    else
+    {
+      stream->createdCount++;
+      if (glbl_scoredMode)
+        scoredStream_write (glbl_FP_output, (int32_t) stream->score, stream->password, stream->length);
+      else
+        fprintf (glbl_FP_output, "%s\n", stream->password);
+      if (ferror (glbl_FP_output))
+      {
+        errorHandler_print (errorType_Error, "Can't write the output.\n");
+        return false;
+      }
+    }
+
+    // continue with the next record of the stream (or remove it from the heap)
+    if (!merge_readNext (stream))
+      glbl_heap[0] = glbl_heap[--glbl_sizeOf_heap];
+    merge_siftDown (0);
+  }
+  return true;
+}                               // run_merge
+
+// prints the amount of passwords of each stream
+void print_results (FILE * fp)
+{
+  uint64_t createdCount = 0;
+
+  fprintf (fp, "\nResults:\n");
+  for (int i = 0; i < glbl_sizeOf_streams; i++)
+  {
+    fprintf (fp, " - %s (offset %i): %" PRIu64 " read, %" PRIu64 " written%s\n", glbl_streams[i].filename, glbl_streams[i].offset, glbl_streams[i].readCount, glbl_streams[i].createdCount, glbl_streams[i].unsorted ? " (not sorted)" : "");
+    createdCount += glbl_streams[i].createdCount;
+  }
+  fprintf (fp, "written: %" PRIu64 ", dropped as duplicate: %" PRIu64 " (about %.0f of them new passwords, false positives of the filter)\n", createdCount, glbl_duplicateCount, glbl_falsePositiveCount);
+  fprintf (fp, "filter: 2 x %" PRIu64 " KiB, %" PRIu64 " passwords each, cleared %" PRIu64 " times\n", glbl_filter[0]->sizeOf_blocks * BLOOMFILTER_BLOCK_WORDS * sizeof (uint64_t) / 1024, glbl_filterCapacity, glbl_rollCount);
+}                               // print_results
@@ -0,0 +1,84 @@
+/*
+ * mergeCandidates.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Merges any amount of scored password streams (see scoredStream.h), e.g.
+ * created by enumNG --scored and other guessers, into a single stream
+ * ordered by score. Only the next record of each stream is kept in memory
+ * (in a min-heap by score), so the streams may be pipes of running guessers.
+ * Duplicates are dropped using a rolling filter of two Bloom filters (see
+ * bloomFilter.h): new passwords are inserted into the current one, while
+ * both are checked. Once the current filter is full, the older one is
+ * cleared and becomes the current one, bounding the memory (and the rate of
+ * falsely dropped passwords) for streams of any length. The streams may be
+ * written by any guesser, so a new password reported as seen by a filter
+ * (false positive) can't be told apart from a duplicate and is dropped as
+ * well; the expected amount of them is estimated from the false positive
+ * rate of the filters and printed with the results.
+ */
+
+#ifndef MERGECANDIDATES_H_
+#define MERGECANDIDATES_H_
+
+#include <stdint.h>
+
+#include "scoredStream.h"
+
+// === Defines ===
+#define MERGECANDIDATES_RATE_INTERVAL 4096  // passwords inserted between two updates of the false positive rate
+
+/*
+ * Single input stream and its next record.
+ */
+typedef struct mergeCandidates_stream
+{
+  FILE *fp;                     // scored stream
+  const char *filename;         // filename of the stream (- for stdin)
+  int offset;                   // added to each score of the stream
+  int64_t score;                // score of the next password (including the offset)
+  char password[SCOREDSTREAM_MAX_LENGTH + 1]; // next password
+  int length;                   // length of the next password
+  bool unsorted;                // TRUE, if a score has been smaller than the one before
+  uint64_t readCount;           // amount of passwords read
+  uint64_t createdCount;        // amount of passwords written (not dropped as duplicate)
+} mergeCandidates_stream;
+
+/*
+ * initializes all global parameters, setting them to their default value
+ * !! this function must be called before any other operation !!
+ */
+void initialize ();
+
+/*
+ *  clears the allocated memory of the global variables, prints the results
+ *  (if verbose) and ends the application
+ *  !! this function is set via atexit() !!
+ */
+void exit_routine ();
+
+/*
+ * Evaluates the given command line arguments.
+ * Returns TRUE, if the evaluation was successful.
+ */
+bool evaluate_arguments (struct gengetopt_args_info *args_info);
+
+/*
+ * Opens all input streams (reading their first record) and the output.
+ * Returns TRUE on success and FALSE if something went wrong.
+ */
+bool apply_settings ();
+
+/*
+ * Merges the input streams by score until all of them are finished.
+ * Returns FALSE if any stream is truncated or can't be written.
+ */
+bool run_merge ();
+
+/*
+ * Prints the amount of passwords read from each input stream and the
+ * dropped duplicates to the given file pointer @fp.
+ */
+void print_results (FILE * fp);
+
+#endif /* MERGECANDIDATES_H_ */
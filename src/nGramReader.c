@@ -14,8 +14,8 @@
 #include "common.h"
 #include "commonStructs.h"
 
-/* (intern function) reads config file and sets the different structs */
-bool read_config (struct nGram_struct *nGrams, struct alphabet_struct *alphabet, struct filename_struct *filenames, char *maxLevel, const char *filenameConfig)
+/* (intern function) reads config file and sets the different structs (allocating the nGram arrays if @allocate is set) */
+bool read_config (struct nGram_struct *nGrams, struct alphabet_struct *alphabet, struct filename_struct *filenames, int *maxLevel, const char *filenameConfig, bool allocate)
 {
   FILE *fp = NULL;              // file pointer
   char curLine[MAX_LINE_LENGTH] = ""; // current line
@@ -77,9 +77,9 @@ bool read_config (struct nGram_struct *nGrams, struct alphabet_struct *alphabet,
     }
     else if (strcmp (argName, "maxLevel") == 0)
     {
-      int config_maxlevel = (char) atoi (argValue);
+      int config_maxlevel = atoi (argValue);
 
-      if ((*maxLevel) < 2 || (*maxLevel) > 101)
+      if (config_maxlevel < 2 || config_maxlevel > MAX_MAX_LEVEL)
       {
         fprintf (stderr, "ERROR: Bad Header (max level)\n");
         success = false;
@@ -152,7 +152,7 @@ bool read_config (struct nGram_struct *nGrams, struct alphabet_struct *alphabet,
     return false;
 
   // if the alphabet or the size of N has been changed, nGram and initalProb have to be reallocated
-  if (nGramChanges)
+  if (nGramChanges && allocate)
     struct_nGrams_allocate (nGrams, alphabet);
 
   return true;
@@ -268,10 +268,10 @@ bool read_array (struct nGram_struct * nGrams, struct alphabet_struct * alphabet
 // === public functions ===
 
 // reads and evaluates all input files for enumNG
-bool read_inputFiles (struct nGram_struct * nGrams, struct alphabet_struct * alphabet, struct filename_struct * filenames, char *maxLevel)
+bool read_inputFiles (struct nGram_struct * nGrams, struct alphabet_struct * alphabet, struct filename_struct * filenames, int *maxLevel)
 {
   // read config file
-  if (!(read_config (nGrams, alphabet, filenames, maxLevel, filenames->cfg)))
+  if (!(read_config (nGrams, alphabet, filenames, maxLevel, filenames->cfg, true)))
     return false;
 
   // read nGram level
@@ -292,3 +292,31 @@ bool read_inputFiles (struct nGram_struct * nGrams, struct alphabet_struct * alp
 
   return true;
 }
+
+// reads only the config file
+bool read_configFile (struct nGram_struct * nGrams, struct alphabet_struct * alphabet, struct filename_struct * filenames, int *maxLevel)
+{
+  return read_config (nGrams, alphabet, filenames, maxLevel, filenames->cfg, false);
+}                               // read_configFile
+
+// reads the fixed point log-probabilities for enumNG
+bool read_probFiles (struct nGram_struct * probs, struct alphabet_struct * alphabet, struct filename_struct * filenames, int sizeOf_N)
+{
+  // allocate the arrays according to the read config
+  probs->sizeOf_N = sizeOf_N;
+  struct_nGrams_allocate (probs, alphabet);
+
+  if (!(read_array (probs, alphabet, filenames->cP, DEFAULT_FILE_ATTACHMENT_PROB, arrayType_conditionalProb)))
+    return false;
+
+  if (!(read_array (probs, alphabet, filenames->iP, DEFAULT_FILE_ATTACHMENT_PROB, arrayType_initialProb)))
+    return false;
+
+  if (!(read_array (probs, alphabet, filenames->eP, DEFAULT_FILE_ATTACHMENT_PROB, arrayType_endProb)))
+    return false;
+
+  if (!(read_array (probs, alphabet, filenames->len, DEFAULT_FILE_ATTACHMENT_PROB, arrayType_length)))
+    return false;
+
+  return true;
+}
@@ -46,7 +46,30 @@
 bool read_inputFiles (struct nGram_struct *nGrams,  // nGram arrays (must be initialized)
                       struct alphabet_struct *alphabet, // alphabet (must be initialized)
                       struct filename_struct *filenames,  // filenames (must contain a set config file name!)
-                      char *maxLevel  // max level
+                      int *maxLevel // max level
   );
 
+/*
+ *  Reads only the config file (set in @filenames), setting @alphabet, @filenames,
+ *  the size of N and @maxLevel like read_inputFiles, but without allocating
+ *  or reading the nGram arrays (used to attach a shared model).
+ *  Returns TRUE, if reading was successful.
+ */
+bool read_configFile (struct nGram_struct *nGrams,  // nGram struct (only sizeOf_N is set)
+                      struct alphabet_struct *alphabet, // alphabet (must be initialized)
+                      struct filename_struct *filenames,  // filenames (must contain a set config file name!)
+                      int *maxLevel); // max level
+
+/*
+ *  Reads the fixed point log-probabilities (.prob files written by createNG
+ *  using --exact) into the given @probs. The config must have been read
+ *  using read_inputFiles before, since the filenames and the sizes of the
+ *  arrays are taken from @filenames and @alphabet.
+ *  Returns TRUE, if reading was successful.
+ */
+bool read_probFiles (struct nGram_struct *probs,  // nGram arrays storing the log-probabilities (must be initialized)
+                     struct alphabet_struct *alphabet,  // alphabet (already read)
+                     struct filename_struct *filenames, // filenames (already read)
+                     int sizeOf_N); // size of the nGram N (already read)
+
 #endif /* NGRAMIO_H_ */
@@ -0,0 +1,959 @@
+/*
+ * omenCoord.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#include "cmdlineOmenCoord.h"
+#include "common.h"
+#include "errorHandler.h"
+#include "commonStructs.h"
+#include "nGramReader.h"
+#include "levelChain.h"
+#include "workUnit.h"
+#include "omenCoord.h"
+
+/*
+ * Position of the enumeration: the next work unit to be created.
+ */
+typedef struct coord_cursor
+{
+  int levelOverall;             // current overall level
+  int levelOverallMax;          // max value for the overall level
+  int lengthIndexFixed;         // index of the only length in the sorted lengths (-1: all lengths)
+  int lengthIndex;              // current index in the sorted lengths (-1 before the first length)
+  int lengthIndexMax;           // amount of lengths with a level smaller or equal levelOverall
+  int lengthPW;                 // length of the password
+  int lengthLC;                 // length of the levelChain
+  int level;                    // level of the password without the level of the length
+  int levelChain[MAX_PASSWORD_LENGTH + 1];  // current levelChain
+  bool newChain;                // TRUE, if the next levelChain is the first of the length and level
+  bool chainsDone;              // TRUE, if all levelChains of the length and level have been selected
+  uint64_t chainIndex;          // index of the current levelChain (for this length and level)
+  int iPIndex;                  // index of the next initialProb of the levelChain
+  int sizeOf_iP;                // amount of initialProbs of the levelChain (0 if none selected)
+  bool finished;                // TRUE, if all units have been created
+} coord_cursor;
+
+/*
+ * Single length of the optimized length scheduling: its own cursor (like
+ * --fixedLength) and the crack rate of its last level reported so far.
+ */
+typedef struct coord_length
+{
+  coord_cursor cursor;          // next unit of the length
+  double crackRate;             // cracked passwords per created one of @rateLevel (1 until the first report)
+  int rateLevel;                // level of the units the crack rate is based on
+  uint64_t rateCreated;         // passwords created by the reported units of @rateLevel
+  uint64_t rateCracked;         // passwords cracked by the reported units of @rateLevel
+} coord_length;
+
+/*
+ * Connection of a single worker.
+ */
+typedef struct coord_client
+{
+  int fd;                       // socket of the connection
+  char buffer[WORKUNIT_SIZEOF_LINE];  // received chars not yet processed
+  size_t sizeOf_buffer;
+  bool busy;                    // TRUE, if @unit has been handed out and not reported yet
+  bool waiting;                 // TRUE, if the worker asked for a unit not available yet
+  bool splitRequested;          // TRUE, if the worker has been asked to split its unit (and didn't answer yet)
+  bool splitRefused;            // TRUE, if the worker couldn't split its current unit
+  bool stopRequested;           // TRUE, if the worker has been told to stop its unit (--maxattempts reached)
+  uint64_t progress;            // passwords created by the unit so far (reported by PROGRESS)
+  uint64_t handedOut;           // sequence number of the unit handed out (the oldest busy worker is asked first)
+  workUnit_struct unit;         // unit handed out to the worker (without the parts split off)
+} coord_client;
+
+/*
+ * Unit split by work stealing: it is completed once all parts have been.
+ */
+typedef struct coord_split
+{
+  uint64_t id;                  // id of the unit (and all parts of it)
+  int pending;                  // amount of parts not completed yet
+} coord_split;
+
+char *glbl_listenAddress = NULL;  // address of the listening socket [--listen <address>]
+char *glbl_filenameState = NULL;  // state file [--state <filename>]
+bool glbl_verboseMode = false;  // print the progress and the results to stderr [-v]
+bool glbl_ignoreEPMode = false; // the endProbs are ignored [-E]
+int glbl_unitSize = 0;          // max amount of initialProbs per unit [--unitSize]
+int glbl_fixedLength = 0;       // only hand out passwords of this length (0: all lengths) [--fixedLength]
+bool glbl_optimizedLengthMode = false;  // hand out the length with the highest crack rate [-O]
+uint64_t glbl_attemptsMax = 0;  // stop handing out units once reached (0: endless) [-m, -e]
+
+// model
+nGram_struct *glbl_nGramLevel = NULL;
+alphabet_struct *glbl_alphabet = NULL;
+filename_struct *glbl_filenames = NULL;
+int glbl_maxLevel = MAX_LEVEL;
+sortedIP_struct *glbl_sortedIP = NULL;
+sortedLength_struct *glbl_sortedLength = NULL;
+
+// units
+coord_cursor glbl_cursor;       // next unit to be created (finished in optimizedLengthMode once all lengths are)
+coord_length glbl_lengths[MAX_PASSWORD_LENGTH];  // cursor and crack rate of each length (index: length, optimizedLengthMode only)
+uint64_t glbl_nextId = 0;       // id of the next unit
+workUnit_struct *glbl_requeue = NULL; // units of workers left before reporting them and parts split off (handed out first)
+int glbl_sizeOf_requeue = 0;
+int glbl_indexMax_requeue = 0;
+uint8_t *glbl_done = NULL;      // completed units following glbl_doneBase (1 if completed)
+size_t glbl_sizeOf_done = 0;
+size_t glbl_indexMax_done = 0;
+uint64_t glbl_doneBase = 0;     // all units with a smaller id have been completed
+coord_split *glbl_splits = NULL;  // units split by work stealing not completed yet
+int glbl_sizeOf_splits = 0;
+int glbl_indexMax_splits = 0;
+uint64_t glbl_handedOut = 0;    // amount of units handed out (including the parts split off)
+
+// connections
+int glbl_listenSocket = -1;
+coord_client *glbl_clients = NULL;
+int glbl_sizeOf_clients = 0;
+int glbl_indexMax_clients = 0;
+volatile sig_atomic_t glbl_stop = 0;  // set by SIGINT and SIGTERM
+time_t glbl_stateSaved = 0;     // time of the last save of the state file
+
+// results
+uint64_t glbl_createdCount = 0; // amount of passwords created by the workers
+uint64_t glbl_crackedCount = 0; // amount of passwords cracked by the workers (reported with -s, --hashes or --feedback)
+uint64_t glbl_unitsDone = 0;    // amount of completed units
+uint64_t glbl_unitsRequeued = 0;  // amount of units handed out again
+uint64_t glbl_unitsSplit = 0;   // amount of parts split off units by work stealing
+uint64_t glbl_workersCount = 0; // amount of connections of workers
+
+struct gengetopt_args_info glbl_args_info;
+
+int main (int argc, char **argv)
+{
+  // let's call our cmdline parser
+  if (cmdline_parser (argc, argv, &glbl_args_info) != 0)
+  {
+    printf ("failed parsing command line arguments\n");
+    exit (EXIT_FAILURE);
+  }
+  // set exit_routine so thats automatically called
+  atexit (exit_routine);
+
+  initialize ();
+
+  if (!evaluate_arguments (&glbl_args_info))
+    exit (EXIT_FAILURE);
+
+  if (!apply_settings ())
+    exit (EXIT_FAILURE);
+
+  if (!run_coordination ())
+    exit (EXIT_FAILURE);
+
+  exit (EXIT_SUCCESS);
+}
+
+/* (intern function) Stops the coordinator on SIGINT and SIGTERM. */
+void coord_signalHandler (int signal)
+{
+  (void) signal;
+  glbl_stop = 1;
+}                               // (intern) coord_signalHandler
+
+void initialize ()
+{
+  struct sigaction stopHandler;
+
+  memset (&stopHandler, 0, sizeof (stopHandler));
+  stopHandler.sa_handler = coord_signalHandler;
+  sigemptyset (&stopHandler.sa_mask);
+  sigaction (SIGINT, &stopHandler, NULL);
+  sigaction (SIGTERM, &stopHandler, NULL);
+  // a worker leaving while its answer is sent closes the connection only
+  signal (SIGPIPE, SIG_IGN);
+
+  struct_filenames_initialize (&glbl_filenames);
+  struct_filenames_allocateDefaults (glbl_filenames);
+  struct_alphabet_initialize (&glbl_alphabet);
+  struct_alphabet_allocateDefaults (glbl_alphabet);
+  struct_nGrams_initialize (&glbl_nGramLevel);
+  memset (&glbl_cursor, 0, sizeof (glbl_cursor));
+  memset (glbl_lengths, 0, sizeof (glbl_lengths));
+}
+
+/* (intern function) Saves the completed units and the amount of created passwords to the state file (if given), at most once per OMENCOORD_SAVE_INTERVAL unless @force is TRUE. The file is replaced at once, so a crash never leaves a partial state. */
+void coord_saveState (bool force)
+{
+  char filenameTemp[FILENAME_MAX];
+  FILE *fp = NULL;
+
+  if (glbl_filenameState == NULL || (!force && time (NULL) - glbl_stateSaved < OMENCOORD_SAVE_INTERVAL))
+    return;
+  glbl_stateSaved = time (NULL);
+
+  snprintf (filenameTemp, FILENAME_MAX, "%s.tmp", glbl_filenameState);
+  if (!open_file (&fp, filenameTemp, NULL, "w"))
+  {
+    errorHandler_print (errorType_Error, "Can't write the state file (%s)\n", filenameTemp);
+    return;
+  }
+  fprintf (fp, "omenCoord %i\n", OMENCOORD_STATE_VERSION);
+  fprintf (fp, "config %s\n", glbl_args_info.config_arg);
+  fprintf (fp, "ignoreEP %i\n", glbl_ignoreEPMode ? 1 : 0);
+  fprintf (fp, "unitSize %i\n", glbl_unitSize);
+  fprintf (fp, "fixedLength %i\n", glbl_fixedLength);
+  fprintf (fp, "created %" PRIu64 "\n", glbl_createdCount);
+  fprintf (fp, "done %" PRIu64 "\n", glbl_doneBase);
+  // completed units following the ones all completed
+  for (size_t i = 0; i < glbl_sizeOf_done; i++)
+    if (glbl_done[i])
+      fprintf (fp, "%" PRIu64 "\n", glbl_doneBase + i);
+  if (fclose (fp) != 0 || rename (filenameTemp, glbl_filenameState) != 0)
+    errorHandler_print (errorType_Error, "Can't write the state file (%s): %s\n", glbl_filenameState, strerror (errno));
+}                               // (intern) coord_saveState
+
+// exit routine, frees any allocated memory (for global variables)
+void exit_routine ()
+{
+  // close all connections, the units not reported are handed out again after a restart
+  for (int i = 0; i < glbl_sizeOf_clients; i++)
+    close (glbl_clients[i].fd);
+  if (glbl_listenSocket >= 0)
+  {
+    close (glbl_listenSocket);
+    if (strncmp (glbl_listenAddress, "unix:", strlen ("unix:")) == 0)
+      unlink (glbl_listenAddress + strlen ("unix:"));
+    coord_saveState (true);
+    if (glbl_verboseMode)
+      print_results (stderr);
+  }
+
+  struct_sortedIP_free (glbl_maxLevel, &glbl_sortedIP);
+  struct_sortedLength_free (&glbl_sortedLength);
+  struct_nGrams_free (&glbl_nGramLevel);
+  struct_alphabet_free (&glbl_alphabet);
+  struct_filenames_free (&glbl_filenames);
+  CHECKED_FREE (glbl_clients);
+  CHECKED_FREE (glbl_requeue);
+  CHECKED_FREE (glbl_done);
+  CHECKED_FREE (glbl_splits);
+  CHECKED_FREE (glbl_listenAddress);
+  CHECKED_FREE (glbl_filenameState);
+
+  errorHandler_finalize ();
+  cmdline_parser_free (&glbl_args_info);  // release allocated memory
+}                               // exit_routine
+
+// evaluates command line parameters
+bool evaluate_arguments (struct gengetopt_args_info *args_info)
+{
+  bool result = true;
+
+  errorHandler_init (args_info->printWarnings_flag);
+
+  glbl_verboseMode = args_info->verbose_flag;
+  glbl_ignoreEPMode = args_info->ignoreEP_flag;
+
+  result &= changeFilename (&glbl_listenAddress, FILENAME_MAX, "listen", args_info->listen_arg);
+  result &= changeFilename (&(glbl_filenames->cfg), FILENAME_MAX, "config", args_info->config_arg);
+  if (args_info->state_given)
+    result &= changeFilename (&glbl_filenameState, FILENAME_MAX, "state", args_info->state_arg);
+
+  glbl_unitSize = args_info->unitSize_arg;
+  if (glbl_unitSize < 1)
+  {
+    errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "unitSize", 1);
+    result = false;
+  }
+
+  glbl_fixedLength = args_info->fixedLength_arg;
+  if (glbl_fixedLength != 0 && (glbl_fixedLength < 3 || glbl_fixedLength >= MAX_PASSWORD_LENGTH))
+  {
+    errorHandler_print (errorType_Error, "The fixedLength must be in range %i to %i\n", 3, MAX_PASSWORD_LENGTH - 1);
+    result = false;
+  }
+
+  // the order of the units depends on the reported cracks, so their ids can't be restored by a state file
+  glbl_optimizedLengthMode = args_info->optimizedLS_flag;
+  if (glbl_optimizedLengthMode && (glbl_fixedLength != 0 || glbl_filenameState != NULL))
+  {
+    errorHandler_print (errorType_Error, "The optimized length scheduling can't be combined with a fixed length or a state file.\n");
+    result = false;
+  }
+
+  if (!args_info->endless_flag)
+  {
+    if (args_info->maxattempts_arg < 1)
+    {
+      errorHandler_print (errorType_Error, "The minimum value for the %s should be %i\n", "maxattempts", 1);
+      result = false;
+    }
+    glbl_attemptsMax = (uint64_t) args_info->maxattempts_arg;
+  }
+  return result;
+}                               // evaluate_arguments
+
+/* (intern function) Returns TRUE if the unit @id has been completed. */
+bool coord_isDone (uint64_t id)
+{
+  if (id < glbl_doneBase)
+    return true;
+  return id - glbl_doneBase < glbl_sizeOf_done && glbl_done[id - glbl_doneBase];
+}                               // (intern) coord_isDone
+
+/* (intern function) Marks the unit @id as completed. */
+void coord_markDone (uint64_t id)
+{
+  size_t index = 0;
+  size_t completed = 0;
+
+  if (id < glbl_doneBase)
+    return;
+  index = id - glbl_doneBase;
+  if (index >= glbl_indexMax_done)
+  {
+    size_t indexMax = (glbl_indexMax_done == 0) ? 1024 : glbl_indexMax_done;
+
+    while (index >= indexMax)
+      indexMax *= 2;
+    glbl_done = (uint8_t *) realloc (glbl_done, indexMax);
+    EXIT_IF_NULL (glbl_done);
+    memset (glbl_done + glbl_indexMax_done, 0, indexMax - glbl_indexMax_done);
+    glbl_indexMax_done = indexMax;
+  }
+  glbl_done[index] = 1;
+  if (index >= glbl_sizeOf_done)
+    glbl_sizeOf_done = index + 1;
+
+  // all units up to the first one not completed are only stored by glbl_doneBase
+  while (completed < glbl_sizeOf_done && glbl_done[completed])
+    completed++;
+  if (completed > 0)
+  {
+    memmove (glbl_done, glbl_done + completed, glbl_sizeOf_done - completed);
+    memset (glbl_done + glbl_sizeOf_done - completed, 0, completed);
+    glbl_sizeOf_done -= completed;
+    glbl_doneBase += completed;
+  }
+}                               // (intern) coord_markDone
+
+/* (intern function) Reads the state file (if it exists), returns FALSE (printing an error) if it is invalid or belongs to a different enumeration. */
+bool coord_readState ()
+{
+  FILE *fp = NULL;
+  char line[FILENAME_MAX + 32];
+  char config[FILENAME_MAX];
+  int version = 0;
+  int ignoreEP = 0;
+  int unitSize = 0;
+  int fixedLength = 0;
+  uint64_t id = 0;
+
+  fp = fopen (glbl_filenameState, "r");
+  if (fp == NULL)
+    return true;                // first run
+
+  if (fscanf (fp, "omenCoord %i\n", &version) != 1 || version != OMENCOORD_STATE_VERSION
+      || fgets (line, sizeof (line), fp) == NULL || sscanf (line, "config %s", config) != 1
+      || fscanf (fp, "ignoreEP %i\nunitSize %i\nfixedLength %i\ncreated %" SCNu64 "\ndone %" SCNu64 "\n", &ignoreEP, &unitSize, &fixedLength, &glbl_createdCount, &glbl_doneBase) != 5)
+  {
+    errorHandler_print (errorType_Error, "Invalid state file (%s)\n", glbl_filenameState);
+    fclose (fp);
+    return false;
+  }
+  // the ids of the units depend on the model and the size of the units
+  if (strcmp (config, glbl_args_info.config_arg) != 0 || ignoreEP != (glbl_ignoreEPMode ? 1 : 0) || unitSize != glbl_unitSize || fixedLength != glbl_fixedLength)
+  {
+    errorHandler_print (errorType_Error, "The state file (%s) belongs to a different enumeration (config %s, ignoreEP %i, unitSize %i, fixedLength %i).\n", glbl_filenameState, config, ignoreEP, unitSize, fixedLength);
+    fclose (fp);
+    return false;
+  }
+  glbl_unitsDone = glbl_doneBase;
+  while (fscanf (fp, "%" SCNu64 "\n", &id) == 1)
+  {
+    coord_markDone (id);
+    glbl_unitsDone++;
+  }
+  fclose (fp);
+  if (glbl_verboseMode)
+    fprintf (stderr, "Continuing the enumeration of %s: %" PRIu64 " units completed, %" PRIu64 " passwords created\n", glbl_filenameState, glbl_unitsDone, glbl_createdCount);
+  return true;
+}                               // (intern) coord_readState
+
+/* (intern function) Sets the @cursor to the levels of the levelChains of the given @length only (like run_enumeration_fixedLenghts of enumNG). */
+void coord_initializeLengthCursor (coord_cursor * cursor, int length)
+{
+  cursor->lengthIndexFixed = 0;
+  while (glbl_sortedLength->length[cursor->lengthIndexFixed] != length)
+    cursor->lengthIndexFixed++;
+  cursor->lengthIndex = -1;
+  cursor->levelOverallMax = (glbl_maxLevel - 1) * (length + (glbl_ignoreEPMode ? 2 : 3) - glbl_nGramLevel->sizeOf_N);
+}                               // (intern) coord_initializeLengthCursor
+
+// reads the model and the state, creates the socket
+bool apply_settings ()
+{
+  if (!read_inputFiles (glbl_nGramLevel, glbl_alphabet, glbl_filenames, &glbl_maxLevel))
+  {
+    errorHandler_print (errorType_Error, "Unable to read the model (config: %s).\n", glbl_args_info.config_arg);
+    return false;
+  }
+  // the workers enumerate the levelChains (fine-grained levels are enumerated without them)
+  if (glbl_maxLevel > MAX_LEVEL)
+  {
+    errorHandler_print (errorType_Error, "The coordinator doesn't support fine-grained levels (maxLevel larger than %i).\n", MAX_LEVEL);
+    return false;
+  }
+  struct_sortedIP_initialize (glbl_maxLevel, &glbl_sortedIP, 1);
+  struct_sortedIP_fill (glbl_maxLevel, glbl_sortedIP, glbl_nGramLevel->iP, glbl_nGramLevel->sizeOf_iP);
+  struct_sortedLength_initialize (&glbl_sortedLength);
+  struct_sortedLength_fill (glbl_sortedLength, glbl_nGramLevel->len, glbl_nGramLevel->sizeOf_N, 0.0, -1);
+
+  // start before the first length with level 0 (like run_enumeration of enumNG)
+  glbl_cursor.lengthIndexFixed = -1;
+  glbl_cursor.lengthIndex = -1;
+  glbl_cursor.lengthIndexMax = struct_sortedLength_getMaxIndexForLevel (glbl_sortedLength, 0);
+  glbl_cursor.levelOverallMax = (glbl_maxLevel - 1) * MAX_PASSWORD_LENGTH + glbl_sortedLength->level[MAX_PASSWORD_LENGTH - 1];
+  if (glbl_fixedLength != 0)
+    coord_initializeLengthCursor (&glbl_cursor, glbl_fixedLength);
+  // optimized length scheduling: each length is scheduled at least once (like run_enumeration_optimizedLengths of enumNG)
+  if (glbl_optimizedLengthMode)
+    for (int i = glbl_nGramLevel->sizeOf_N; i < MAX_PASSWORD_LENGTH; i++)
+    {
+      coord_initializeLengthCursor (&(glbl_lengths[i].cursor), i);
+      glbl_lengths[i].crackRate = 1;
+    }
+
+  if (glbl_filenameState != NULL && !coord_readState ())
+    return false;
+
+  glbl_listenSocket = workUnit_listen (glbl_listenAddress);
+  if (glbl_listenSocket < 0)
+    return false;
+  if (glbl_verboseMode)
+    fprintf (stderr, "Handing out work units on %s\n", glbl_listenAddress);
+  return true;
+}                               // apply_settings
+
+/* (intern function) Selects the next levelChain of the @cursor (with at least one initialProb), continuing with the next length and overall level if necessary (unless @sameLevel is TRUE). Returns FALSE if all levelChains (of the current length and level if @sameLevel) have been selected. */
+bool coord_nextChain (coord_cursor * cursor, bool sameLevel)
+{
+  while (true)
+  {
+    // next levelChain of the current length and level
+    while (cursor->lengthIndex >= 0 && !cursor->chainsDone)
+    {
+      if (!levelChain_getNext (cursor->levelChain, cursor->lengthLC, cursor->level, glbl_maxLevel, cursor->newChain))
+      {
+        cursor->chainsDone = true;
+        break;
+      }
+      cursor->chainIndex = cursor->newChain ? 0 : cursor->chainIndex + 1;
+      cursor->newChain = false;
+      cursor->iPIndex = 0;
+      cursor->sizeOf_iP = glbl_sortedIP[cursor->levelChain[0]].indexCur;
+      if (cursor->sizeOf_iP > 0)
+        return true;
+    }
+    if (sameLevel)
+      return false;
+
+    if (cursor->lengthIndexFixed >= 0)
+    {
+      // fixed length: next level (without the level of the length)
+      if (cursor->lengthIndex >= 0 && ++cursor->levelOverall > cursor->levelOverallMax)
+        return false;
+      cursor->lengthIndex = cursor->lengthIndexFixed;
+      cursor->level = cursor->levelOverall;
+    }
+    else
+    {
+      // next length (and overall level, if all lengths of the current one are done)
+      cursor->lengthIndex++;
+      while (cursor->lengthIndex >= cursor->lengthIndexMax)
+      {
+        cursor->levelOverall++;
+        if (cursor->levelOverall > cursor->levelOverallMax)
+          return false;
+        cursor->lengthIndex = 0;
+        cursor->lengthIndexMax = struct_sortedLength_getMaxIndexForLevel (glbl_sortedLength, cursor->levelOverall);
+      }
+      cursor->level = cursor->levelOverall - glbl_sortedLength->level[cursor->lengthIndex];
+    }
+    cursor->lengthPW = glbl_sortedLength->length[cursor->lengthIndex];
+    cursor->lengthLC = cursor->lengthPW + (glbl_ignoreEPMode ? 2 : 3) - glbl_nGramLevel->sizeOf_N;
+    memset (cursor->levelChain, 0, sizeof (cursor->levelChain));
+    cursor->newChain = true;
+    cursor->chainsDone = false;
+  }
+}                               // (intern) coord_nextChain
+
+/* (intern function) Returns the cursor of the next unit: the only one or, in optimizedLengthMode, the one of the length with the highest crack rate reported so far (planned again for each unit, the shorter length on a tie). Returns NULL if all units have been created. */
+coord_cursor *coord_scheduleCursor ()
+{
+  coord_length *best = NULL;
+
+  if (!glbl_optimizedLengthMode)
+    return glbl_cursor.finished ? NULL : &glbl_cursor;
+  for (int i = glbl_nGramLevel->sizeOf_N; i < MAX_PASSWORD_LENGTH; i++)
+    if (!glbl_lengths[i].cursor.finished && (best == NULL || glbl_lengths[i].crackRate > best->crackRate))
+      best = glbl_lengths + i;
+  if (best == NULL)
+  {
+    glbl_cursor.finished = true;
+    return NULL;
+  }
+  return &(best->cursor);
+}                               // (intern) coord_scheduleCursor
+
+/* (intern function) Returns the amount of passwords created by the workers, including the progress of the units not reported yet. */
+uint64_t coord_createdCount ()
+{
+  uint64_t created = glbl_createdCount;
+
+  for (int i = 0; i < glbl_sizeOf_clients; i++)
+    if (glbl_clients[i].busy)
+      created += glbl_clients[i].progress;
+  return created;
+}                               // (intern) coord_createdCount
+
+/* (intern function) Creates the next unit not completed yet (the units of workers left before are handed out first). Most levelChains create few or no passwords at all, so consecutive levelChains are combined up to glbl_unitSize initialProbs, while a levelChain with more initialProbs is split. Returns FALSE if there is none or the workers created enough passwords. */
+bool coord_nextUnit (workUnit_struct * unit)
+{
+  coord_cursor *cursor = NULL;
+
+  if (glbl_attemptsMax != 0 && coord_createdCount () >= glbl_attemptsMax)
+    return false;
+  if (glbl_sizeOf_requeue > 0)
+  {
+    *unit = glbl_requeue[--glbl_sizeOf_requeue];
+    return true;
+  }
+
+  while ((cursor = coord_scheduleCursor ()) != NULL)
+  {
+    int sizeOf_unit = 0;        // amount of initialProbs of the unit
+
+    if (cursor->iPIndex >= cursor->sizeOf_iP && !coord_nextChain (cursor, false))
+    {
+      cursor->finished = true;
+      continue;
+    }
+    unit->id = glbl_nextId++;
+    unit->levelOverall = cursor->levelOverall;
+    unit->lengthIndex = cursor->lengthIndex;
+    unit->chainIndex = cursor->chainIndex;
+    unit->chainCount = 1;
+    unit->lengthPW = cursor->lengthPW;
+    unit->depth = 0;
+    unit->start = cursor->iPIndex;
+    unit->end = (cursor->sizeOf_iP - cursor->iPIndex > glbl_unitSize) ? cursor->iPIndex + glbl_unitSize : cursor->sizeOf_iP;
+    unit->lengthLC = cursor->lengthLC;
+    memcpy (unit->levelChain, cursor->levelChain, sizeof (unit->levelChain));
+    cursor->iPIndex = unit->end;
+    sizeOf_unit = unit->end - unit->start;
+
+    // add the following levelChains (of the same length and level) fitting into the unit
+    while (cursor->iPIndex >= cursor->sizeOf_iP && sizeOf_unit < glbl_unitSize && coord_nextChain (cursor, true))
+    {
+      if (sizeOf_unit + cursor->sizeOf_iP > glbl_unitSize)
+        break;                  // first levelChain of the next unit
+      sizeOf_unit += cursor->sizeOf_iP;
+      cursor->iPIndex = cursor->sizeOf_iP;
+      unit->chainCount = cursor->chainIndex - unit->chainIndex + 1;
+    }
+    // units completed before a restart are skipped
+    if (!coord_isDone (unit->id))
+      return true;
+  }
+  return false;
+}                               // (intern) coord_nextUnit
+
+/* (intern function) Sends the given @line to the @client. Returns FALSE if the connection failed. */
+bool coord_send (coord_client * client, const char *line)
+{
+  size_t length = strlen (line);
+  size_t sent = 0;
+
+  while (sent < length)
+  {
+    ssize_t result = send (client->fd, line + sent, length - sent, MSG_NOSIGNAL);
+
+    if (result < 0 && errno == EINTR)
+      continue;
+    if (result <= 0)
+      return false;
+    sent += (size_t) result;
+  }
+  return true;
+}                               // (intern) coord_send
+
+/* (intern function) Adds the given @unit to the units handed out first. */
+void coord_requeue (const workUnit_struct * unit)
+{
+  if (glbl_sizeOf_requeue == glbl_indexMax_requeue)
+  {
+    glbl_indexMax_requeue = (glbl_indexMax_requeue == 0) ? 16 : glbl_indexMax_requeue * 2;
+    glbl_requeue = (workUnit_struct *) realloc (glbl_requeue, glbl_indexMax_requeue * sizeof (workUnit_struct));
+    EXIT_IF_NULL (glbl_requeue);
+  }
+  glbl_requeue[glbl_sizeOf_requeue++] = *unit;
+}                               // (intern) coord_requeue
+
+/* (intern function) Closes the connection of the client at @index, handing out its unit again (if not reported). */
+void coord_closeClient (int index)
+{
+  coord_client *client = glbl_clients + index;
+
+  if (client->busy)
+  {
+    coord_requeue (&(client->unit));
+    glbl_unitsRequeued++;
+  }
+  close (client->fd);
+  glbl_clients[index] = glbl_clients[--glbl_sizeOf_clients];
+}                               // (intern) coord_closeClient
+
+/* (intern function) Returns the index of the split unit @id in glbl_splits or -1 if it hasn't been split. */
+int coord_findSplit (uint64_t id)
+{
+  for (int i = 0; i < glbl_sizeOf_splits; i++)
+    if (glbl_splits[i].id == id)
+      return i;
+  return -1;
+}                               // (intern) coord_findSplit
+
+/* (intern function) Adds the @part split off the unit of the @client (answering SPLIT) to the units handed out first. The unit of the client shrinks by the part, if it can be described without it (the following levelChains or the upper part of the range of the unit). Returns FALSE if the part is invalid. */
+bool coord_addPart (coord_client * client, const workUnit_struct * part)
+{
+  workUnit_struct *unit = &(client->unit);
+  int index = coord_findSplit (unit->id);
+
+  if (!client->busy || part->id != unit->id || part->lengthPW != unit->lengthPW)
+    return false;
+
+  // the unit is completed once all of its parts are (the workers report the same id)
+  if (index < 0)
+  {
+    if (glbl_sizeOf_splits == glbl_indexMax_splits)
+    {
+      glbl_indexMax_splits = (glbl_indexMax_splits == 0) ? 16 : glbl_indexMax_splits * 2;
+      glbl_splits = (coord_split *) realloc (glbl_splits, glbl_indexMax_splits * sizeof (coord_split));
+      EXIT_IF_NULL (glbl_splits);
+    }
+    glbl_splits[glbl_sizeOf_splits].id = unit->id;
+    glbl_splits[glbl_sizeOf_splits++].pending = 2;
+  }
+  else
+    glbl_splits[index].pending++;
+
+  // the following levelChains (given away completely) or the upper part of the range of the unit
+  if (part->chainIndex > unit->chainIndex && part->depth == 0 && part->start == 0 && part->chainIndex - unit->chainIndex < unit->chainCount)
+    unit->chainCount = part->chainIndex - unit->chainIndex;
+  else if (part->chainIndex == unit->chainIndex && part->depth == unit->depth && part->start > unit->start && part->start < unit->end && memcmp (part->path, unit->path, unit->depth * sizeof (int)) == 0)
+    unit->end = part->start;
+  coord_requeue (part);
+  glbl_unitsSplit++;
+  return true;
+}                               // (intern) coord_addPart
+
+/* (intern function) Updates the crack rate of the length of the reported @unit (optimizedLengthMode only) by its @created and @cracked passwords: the rate of the last level of the length reported so far, like the crack rate of enumNG -O, but with each reported unit instead of once the level is completed. */
+void coord_updateCrackRate (const workUnit_struct * unit, uint64_t created, uint64_t cracked)
+{
+  coord_length *length = glbl_lengths + unit->lengthPW;
+
+  // units of a former level are reported late (e.g. split parts or handed out again)
+  if (!glbl_optimizedLengthMode || unit->levelOverall < length->rateLevel)
+    return;
+  if (unit->levelOverall > length->rateLevel)
+  {
+    length->rateLevel = unit->levelOverall;
+    length->rateCreated = 0;
+    length->rateCracked = 0;
+  }
+  length->rateCreated += created;
+  length->rateCracked += cracked;
+  if (length->rateCreated == 0)
+    return;                     // no passwords yet, keep the rate of the former level
+  length->crackRate = (double) length->rateCracked / (double) length->rateCreated;
+  // keep the crack rate in range ]0, 1[ (like limit_crackRate of enumNG)
+  if (length->crackRate < 0.0000001)
+    length->crackRate = 0.0000001;
+  else if (length->crackRate >= 1)
+    length->crackRate = 0.999999;
+}                               // (intern) coord_updateCrackRate
+
+/* (intern function) Handles a single @line sent by the @client. Returns FALSE if the line is invalid (closing the connection). */
+bool coord_handleLine (coord_client * client, const char *line)
+{
+  workUnit_struct part;
+  uint64_t id = 0;
+  uint64_t count = 0;
+  uint64_t cracked = 0;         // not reported by workers without -s, --hashes or --feedback
+
+  if (strcmp (line, "GET") == 0 && !client->busy)
+  {
+    client->waiting = true;     // answered by coord_serveWaiting
+    return true;
+  }
+  if (sscanf (line, "DONE %" SCNu64 " %" SCNu64 " %" SCNu64, &id, &count, &cracked) >= 2 && client->busy && id == client->unit.id)
+  {
+    int index = coord_findSplit (id);
+
+    client->busy = false;
+    client->progress = 0;
+    glbl_createdCount += count;
+    glbl_crackedCount += cracked;
+    coord_updateCrackRate (&(client->unit), count, cracked);
+    // a split unit is completed with its last part
+    if (index >= 0 && --glbl_splits[index].pending > 0)
+      return true;
+    if (index >= 0)
+      glbl_splits[index] = glbl_splits[--glbl_sizeOf_splits];
+    coord_markDone (id);
+    glbl_unitsDone++;
+    coord_saveState (false);
+    return true;
+  }
+  if (sscanf (line, "PROGRESS %" SCNu64 " %" SCNu64, &id, &count) == 2)
+  {
+    // sent before the unit has been reported
+    if (client->busy && id == client->unit.id)
+      client->progress = count;
+    return true;
+  }
+  // answers of SPLIT
+  if (client->splitRequested && strcmp (line, "NOSPLIT") == 0)
+  {
+    client->splitRequested = false;
+    client->splitRefused = true;
+    return true;
+  }
+  if (client->splitRequested && workUnit_parse (line, &part) && coord_addPart (client, &part))
+  {
+    client->splitRequested = false;
+    return true;
+  }
+  errorHandler_print (errorType_Warning, "Invalid message of a worker: %s\n", line);
+  return false;
+}                               // (intern) coord_handleLine
+
+/* (intern function) Reads the lines sent by the client at @index. Returns FALSE if the connection has been closed. */
+bool coord_readClient (int index)
+{
+  coord_client *client = glbl_clients + index;
+  ssize_t result = recv (client->fd, client->buffer + client->sizeOf_buffer, WORKUNIT_SIZEOF_LINE - client->sizeOf_buffer, 0);
+  char *lineEnd = NULL;
+
+  if (result < 0 && errno == EINTR)
+    return true;
+  if (result <= 0)
+  {
+    coord_closeClient (index);
+    return false;
+  }
+  client->sizeOf_buffer += (size_t) result;
+
+  // handle each complete line
+  while ((lineEnd = memchr (client->buffer, '\n', client->sizeOf_buffer)) != NULL)
+  {
+    size_t length = (size_t) (lineEnd - client->buffer);
+
+    *lineEnd = '\0';
+    if (!coord_handleLine (client, client->buffer))
+    {
+      coord_closeClient (index);
+      return false;
+    }
+    memmove (client->buffer, lineEnd + 1, client->sizeOf_buffer - length - 1);
+    client->sizeOf_buffer -= length + 1;
+  }
+  if (client->sizeOf_buffer == WORKUNIT_SIZEOF_LINE)
+  {
+    errorHandler_print (errorType_Warning, "Invalid message of a worker (line too long)\n");
+    coord_closeClient (index);
+    return false;
+  }
+  return true;
+}                               // (intern) coord_readClient
+
+/* (intern function) Hands out the next units to the waiting workers, each with the passwords left until --maxattempts as budget. If no unit is left, the busy workers are asked to split their units (the worker busy for the longest time first). Once the workers created --maxattempts passwords, the busy ones are told to stop their units. Once no unit is left and no worker is busy, they are told to stop. Returns TRUE if the enumeration is complete and all workers have been stopped. */
+bool coord_serveWaiting ()
+{
+  bool busy = false;
+  uint64_t created = coord_createdCount ();
+  bool limitReached = (glbl_attemptsMax != 0 && created >= glbl_attemptsMax);
+  int waiting = 0;
+  char line[WORKUNIT_SIZEOF_LINE];
+
+  for (int i = 0; i < glbl_sizeOf_clients; i++)
+  {
+    coord_client *client = glbl_clients + i;
+
+    if (!client->waiting || !coord_nextUnit (&(client->unit)))
+      continue;
+    client->waiting = false;
+    client->busy = true;
+    client->splitRefused = false;
+    client->stopRequested = false;
+    client->progress = 0;
+    client->handedOut = glbl_handedOut++;
+    client->unit.budget = (glbl_attemptsMax != 0) ? glbl_attemptsMax - created : 0;
+    workUnit_format (&(client->unit), line);
+    if (!coord_send (client, line))
+      coord_closeClient (i--);
+  }
+
+  // the units handed out so far would exceed --maxattempts (a lost connection is noticed reading it)
+  for (int i = 0; i < glbl_sizeOf_clients && limitReached; i++)
+    if (glbl_clients[i].busy && !glbl_clients[i].stopRequested)
+    {
+      glbl_clients[i].stopRequested = true;
+      snprintf (line, WORKUNIT_SIZEOF_LINE, "STOP %" PRIu64 "\n", glbl_clients[i].unit.id);
+      coord_send (glbl_clients + i, line);
+    }
+
+  // work stealing: a split request for each waiting worker (not answered yet)
+  for (int i = 0; i < glbl_sizeOf_clients; i++)
+  {
+    waiting += glbl_clients[i].waiting;
+    waiting -= glbl_clients[i].splitRequested;
+    busy |= glbl_clients[i].busy;
+  }
+  while (waiting-- > 0 && !limitReached)
+  {
+    coord_client *victim = NULL;
+
+    for (int i = 0; i < glbl_sizeOf_clients; i++)
+    {
+      coord_client *client = glbl_clients + i;
+
+      if (client->busy && !client->splitRequested && !client->splitRefused && (victim == NULL || client->handedOut < victim->handedOut))
+        victim = client;
+    }
+    if (victim == NULL)
+      break;
+    victim->splitRequested = true;
+    coord_send (victim, "SPLIT\n");  // a lost connection is noticed reading it
+  }
+
+  // a busy worker may still leave or split its unit, handing out a unit again (not needed once enough passwords have been created)
+  if (busy || (!limitReached && (glbl_sizeOf_requeue > 0 || !glbl_cursor.finished)))
+    return false;
+
+  // the workers not waiting yet are told to stop once they ask for the next unit, all of them close the connection
+  for (int i = 0; i < glbl_sizeOf_clients; i++)
+    if (glbl_clients[i].waiting)
+    {
+      glbl_clients[i].waiting = false;
+      coord_send (glbl_clients + i, "END\n");
+    }
+  return glbl_sizeOf_clients == 0;
+}                               // (intern) coord_serveWaiting
+
+// hands out the units
+bool run_coordination ()
+{
+  struct pollfd *fds = NULL;
+  time_t progressPrinted = 0;
+
+  while (!glbl_stop)
+  {
+    int sizeOf_fds = glbl_sizeOf_clients + 1;
+    int result = 0;
+
+    if (coord_serveWaiting ())
+    {
+      struct pollfd pending = { glbl_listenSocket, POLLIN, 0 };
+
+      // workers connecting right now are told to stop as well
+      if (poll (&pending, 1, 0) <= 0)
+      {
+        if (glbl_cursor.finished)
+          errorHandler_print (errorType_Warning, "All work units have been completed.\n");
+        break;
+      }
+    }
+    if (glbl_verboseMode && time (NULL) != progressPrinted)
+    {
+      progressPrinted = time (NULL);
+      fprintf (stderr, "\r%" PRIu64 " units completed, %" PRIu64 " passwords created, %i workers connected", glbl_unitsDone, glbl_createdCount, glbl_sizeOf_clients);
+    }
+
+    fds = (struct pollfd *) realloc (fds, sizeOf_fds * sizeof (struct pollfd));
+    EXIT_IF_NULL (fds);
+    fds[0].fd = glbl_listenSocket;
+    fds[0].events = POLLIN;
+    for (int i = 0; i < glbl_sizeOf_clients; i++)
+    {
+      fds[i + 1].fd = glbl_clients[i].fd;
+      fds[i + 1].events = POLLIN;
+    }
+    result = poll (fds, sizeOf_fds, 1000 * OMENCOORD_SAVE_INTERVAL);
+    if (result < 0 && errno == EINTR)
+      continue;
+    if (result < 0)
+    {
+      errorHandler_print (errorType_Error, "Waiting for the workers failed: %s\n", strerror (errno));
+      CHECKED_FREE (fds);
+      return false;
+    }
+    coord_saveState (false);
+
+    // read the clients from the last one, since closing one moves the last client to its index
+    for (int i = sizeOf_fds - 2; i >= 0; i--)
+      if (fds[i + 1].revents != 0)
+        coord_readClient (i);
+
+    // new worker
+    if (fds[0].revents & POLLIN)
+    {
+      int fd = accept (glbl_listenSocket, NULL, NULL);
+
+      if (fd < 0)
+        continue;
+      if (glbl_sizeOf_clients == glbl_indexMax_clients)
+      {
+        glbl_indexMax_clients = (glbl_indexMax_clients == 0) ? 16 : glbl_indexMax_clients * 2;
+        glbl_clients = (coord_client *) realloc (glbl_clients, glbl_indexMax_clients * sizeof (coord_client));
+        EXIT_IF_NULL (glbl_clients);
+      }
+      memset (glbl_clients + glbl_sizeOf_clients, 0, sizeof (coord_client));
+      glbl_clients[glbl_sizeOf_clients++].fd = fd;
+      glbl_workersCount++;
+    }
+  }
+  if (glbl_verboseMode)
+    fprintf (stderr, "\n");
+  CHECKED_FREE (fds);
+  return true;
+}                               // run_coordination
+
+// prints the results
+void print_results (FILE * fp)
+{
+  fprintf (fp, "\nResults:\n");
+  fprintf (fp, "units: %" PRIu64 " completed (%" PRIu64 " handed out again, %" PRIu64 " parts split off)\n", glbl_unitsDone, glbl_unitsRequeued, glbl_unitsSplit);
+  fprintf (fp, "created: %" PRIu64 " passwords by %" PRIu64 " workers\n", glbl_createdCount, glbl_workersCount);
+  if (glbl_crackedCount > 0)
+    fprintf (fp, "cracked: %" PRIu64 " passwords (%f per created one)\n", glbl_crackedCount, (double) glbl_crackedCount / (double) glbl_createdCount);
+  if (glbl_optimizedLengthMode)
+  {
+    fprintf (fp, "crack rates (length: level, rate):");
+    for (int i = glbl_nGramLevel->sizeOf_N; i < MAX_PASSWORD_LENGTH; i++)
+      fprintf (fp, " %i: %i, %g%s", i, glbl_lengths[i].rateLevel, glbl_lengths[i].crackRate, glbl_lengths[i].cursor.finished ? " (finished)" : "");
+    fprintf (fp, "\n");
+  }
+  if (glbl_filenameState != NULL)
+    fprintf (fp, "state: %s\n", glbl_filenameState);
+}                               // print_results
@@ -0,0 +1,84 @@
+/*
+ * omenCoord.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Coordinator distributing the enumeration of a model to any amount of
+ * workers (enumNG --worker) on the same or other machines. The enumeration
+ * is split into work units (see workUnit.h) in the order of enumNG: by
+ * overall level, length and levelChain. Each unit contains at most
+ * --unitSize initialProbs: consecutive levelChains are combined (most of
+ * them create few or no passwords), larger ones are split into ranges of
+ * initialProbs. The units are handed out whenever a
+ * worker asks for the next one, so faster workers and cheaper units simply
+ * take more of them (instead of a static split of the levelChains, whose
+ * amount of passwords varies a lot). The workers report the amount of
+ * created passwords of each unit; units of a worker leaving before
+ * reporting them are handed out again.
+ * A single levelChain (e.g. of a high level, where most lastGrams are)
+ * may create far more passwords than all others. Once no unit is left, the
+ * workers waiting for one steal work from the busy ones: the coordinator
+ * asks the worker busy for the longest time to split its unit (see
+ * workUnit.h), at any depth of the subtree of its levelChain, so all
+ * workers stay busy until the end, even for --fixedLength.
+ * With -O, the units follow the optimized length scheduling of enumNG
+ * instead: the workers report the cracked passwords of each unit (see
+ * workUnit.h) and the next unit is taken from the length with the highest
+ * crack rate of its last level reported so far. The rates are updated with
+ * each reported unit, so several lengths and levels are enumerated at the
+ * same time, without waiting for a level to be completed.
+ * The completed units are saved to a state file (--state), so a restarted
+ * coordinator continues with the units not completed before.
+ *
+ */
+
+#ifndef OMENCOORD_H_
+#define OMENCOORD_H_
+
+#include <stdint.h>
+
+// === Defines ===
+#define OMENCOORD_STATE_VERSION 2 // version of the state file
+#define OMENCOORD_SAVE_INTERVAL 1 // seconds between two saves of the state file
+
+/*
+ * initializes all global parameters, setting them to their default value
+ * !! this function must be called before any other operation !!
+ */
+void initialize ();
+
+/*
+ *  clears the allocated memory of the global variables, saves the state
+ *  (if given), prints the results (if verbose) and ends the application
+ *  !! this function is set via atexit() !!
+ */
+void exit_routine ();
+
+/*
+ * Evaluates the given command line arguments.
+ * Returns TRUE, if the evaluation was successful.
+ */
+bool evaluate_arguments (struct gengetopt_args_info *args_info);
+
+/*
+ * Reads the model and the state file (if given) and creates the listening
+ * socket.
+ * Returns TRUE on success and FALSE if something went wrong.
+ */
+bool apply_settings ();
+
+/*
+ * Hands out the work units to the connected workers until all units have
+ * been completed, the workers created as many passwords as given by
+ * --maxattempts or the coordinator is stopped (SIGINT, SIGTERM).
+ * Returns FALSE if waiting for the workers fails.
+ */
+bool run_coordination ();
+
+/*
+ * Prints the amount of completed units, created passwords and workers to
+ * the given file pointer @fp.
+ */
+void print_results (FILE * fp);
+
+#endif /* OMENCOORD_H_ */
@@ -0,0 +1,211 @@
+/*
+ * probQueue.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "errorHandler.h"
+#include "probQueue.h"
+
+/* (intern function) compare function for qsort (ascending by priority) */
+int compare_entries (const void *a, const void *b)
+{
+  int priorityA = ((const probQueue_entry *) a)->priority;
+  int priorityB = ((const probQueue_entry *) b)->priority;
+
+  return (priorityA > priorityB) - (priorityA < priorityB);
+}                               // (intern) compare_entries
+
+/* (intern function) moves the entry at @index up until the heap property is restored */
+void heap_siftUp (probQueue_entry * heap, size_t index)
+{
+  probQueue_entry tmp = heap[index];
+
+  while (index > 0 && heap[(index - 1) / 2].priority > tmp.priority)
+  {
+    heap[index] = heap[(index - 1) / 2];
+    index = (index - 1) / 2;
+  }
+  heap[index] = tmp;
+}                               // (intern) heap_siftUp
+
+/* (intern function) moves the entry at @index down until the heap property is restored */
+void heap_siftDown (probQueue_entry * heap, size_t sizeOf_heap, size_t index)
+{
+  probQueue_entry tmp = heap[index];
+  size_t child;
+
+  while ((child = 2 * index + 1) < sizeOf_heap)
+  {
+    // select the smaller child
+    if (child + 1 < sizeOf_heap && heap[child + 1].priority < heap[child].priority)
+      child++;
+    if (heap[child].priority >= tmp.priority)
+      break;
+    heap[index] = heap[child];
+    index = child;
+  }
+  heap[index] = tmp;
+}                               // (intern) heap_siftDown
+
+/* (intern function) Spills the less probable half of the heap into a new run. Returns FALSE if the run can't be written. */
+bool spill_heap (probQueue_struct * queue)
+{
+  size_t keep = queue->sizeOf_heap / 2;
+  FILE *run = NULL;
+
+  // a sorted array is a valid heap, so the first half can be kept as it is
+  qsort (queue->heap, queue->sizeOf_heap, sizeof (probQueue_entry), compare_entries);
+
+  run = tmpfile ();
+  if (run == NULL)
+  {
+    errorHandler_print (errorType_Error, "Unable to create a temporary file for the priority queue.\n");
+    return false;
+  }
+  if (fwrite (queue->heap + keep, sizeof (probQueue_entry), queue->sizeOf_heap - keep, run) != queue->sizeOf_heap - keep)
+  {
+    errorHandler_print (errorType_Error, "Unable to write the priority queue to disk.\n");
+    fclose (run);
+    return false;
+  }
+  rewind (run);
+
+  // add the run (reallocate if needed)
+  if (queue->sizeOf_runs == queue->indexMax_runs)
+  {
+    queue->indexMax_runs = (queue->indexMax_runs == 0) ? 8 : (queue->indexMax_runs * 2);
+    queue->runs = (FILE **) realloc (queue->runs, queue->indexMax_runs * sizeof (FILE *));
+    EXIT_IF_NULL (queue->runs);
+    queue->runHeads = (probQueue_entry *) realloc (queue->runHeads, queue->indexMax_runs * sizeof (probQueue_entry));
+    EXIT_IF_NULL (queue->runHeads);
+  }
+  if (fread (queue->runHeads + queue->sizeOf_runs, sizeof (probQueue_entry), 1, run) != 1)
+  {
+    errorHandler_print (errorType_Error, "Unable to read the priority queue from disk.\n");
+    fclose (run);
+    return false;
+  }
+  queue->runs[queue->sizeOf_runs] = run;
+  queue->sizeOf_runs++;
+
+  queue->spilledCount += queue->sizeOf_heap - keep;
+  queue->sizeOf_heap = keep;
+  return true;
+}                               // (intern) spill_heap
+
+// allocates a new queue
+void probQueue_initialize (probQueue_struct ** queue, size_t capacity)
+{
+  *queue = (probQueue_struct *) malloc (sizeof (probQueue_struct));
+  EXIT_IF_NULL ((*queue));
+
+  if (capacity < 2)
+    capacity = 2;
+
+  (*queue)->heap = (probQueue_entry *) malloc (capacity * sizeof (probQueue_entry));
+  EXIT_IF_NULL ((*queue)->heap);
+  (*queue)->sizeOf_heap = 0;
+  (*queue)->capacity = capacity;
+
+  (*queue)->runs = NULL;
+  (*queue)->runHeads = NULL;
+  (*queue)->sizeOf_runs = 0;
+  (*queue)->indexMax_runs = 0;
+  (*queue)->spilledCount = 0;
+}                               // probQueue_initialize
+
+// frees the given queue
+void probQueue_free (probQueue_struct ** queue)
+{
+  if (*queue != NULL)
+  {
+    // temporary files are deleted once closed
+    for (size_t i = 0; i < (*queue)->sizeOf_runs; i++)
+      fclose ((*queue)->runs[i]);
+    CHECKED_FREE ((*queue)->runs);
+    CHECKED_FREE ((*queue)->runHeads);
+    CHECKED_FREE ((*queue)->heap);
+    free (*queue);
+    *queue = NULL;
+  }
+}                               // probQueue_free
+
+// adds a new entry
+bool probQueue_push (probQueue_struct * queue, const probQueue_entry * entry)
+{
+  if (queue->sizeOf_heap == queue->capacity)
+  {
+    if (!spill_heap (queue))
+      return false;
+  }
+  queue->heap[queue->sizeOf_heap] = *entry;
+  heap_siftUp (queue->heap, queue->sizeOf_heap);
+  queue->sizeOf_heap++;
+  return true;
+}                               // probQueue_push
+
+// removes the most probable entry
+bool probQueue_pop (probQueue_struct * queue, probQueue_entry * entry)
+{
+  size_t run = queue->sizeOf_runs;  // run containing the most probable entry (sizeOf_runs = heap)
+  bool found = false;           // TRUE, if any entry has been found
+  int priority = 0;
+
+  if (queue->sizeOf_heap > 0)
+  {
+    priority = queue->heap[0].priority;
+    found = true;
+  }
+
+  // check the heads of all runs
+  for (size_t i = 0; i < queue->sizeOf_runs; i++)
+  {
+    if (!found || queue->runHeads[i].priority < priority)
+    {
+      run = i;
+      priority = queue->runHeads[i].priority;
+      found = true;
+    }
+  }
+
+  // queue is empty
+  if (!found)
+    return false;
+
+  // take the entry from the heap ...
+  if (run == queue->sizeOf_runs)
+  {
+    *entry = queue->heap[0];
+    queue->sizeOf_heap--;
+    if (queue->sizeOf_heap > 0)
+    {
+      queue->heap[0] = queue->heap[queue->sizeOf_heap];
+      heap_siftDown (queue->heap, queue->sizeOf_heap, 0);
+    }
+    return true;
+  }
+
+  // ... or from the selected run and read the next head of this run
+  *entry = queue->runHeads[run];
+  if (fread (queue->runHeads + run, sizeof (probQueue_entry), 1, queue->runs[run]) != 1)
+  {
+    if (ferror (queue->runs[run]))
+    {
+      errorHandler_print (errorType_Error, "Unable to read the priority queue from disk.\n");
+      return false;
+    }
+    // run is exhausted, close it and replace it by the last one
+    fclose (queue->runs[run]);
+    queue->sizeOf_runs--;
+    queue->runs[run] = queue->runs[queue->sizeOf_runs];
+    queue->runHeads[run] = queue->runHeads[queue->sizeOf_runs];
+  }
+  return true;
+}                               // probQueue_pop
@@ -0,0 +1,80 @@
+/*
+ * probQueue.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Bounded priority queue used by enumNG for the exact enumeration order
+ * (--order exact). Each entry describes a partial password and is ordered by
+ * its priority (the fixed point log-probability of the most probable password
+ * it leads to, smaller is more probable). The queue keeps at most
+ * @capacity entries in memory (as binary heap). If the heap is full, the less
+ * probable half is sorted and spilled into a temporary file (a so called run).
+ * Popping always merges the heap with the heads of all runs, so the entries
+ * are returned in exact order regardless of any spilling.
+ *
+ */
+
+#ifndef PROBQUEUE_H_
+#define PROBQUEUE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "common.h"
+
+/*
+ * Single entry of the queue: a partial password and the child to be
+ * visited next.
+ */
+typedef struct probQueue_entry
+{
+  int priority;                 // log-probability of the most probable password reachable (key)
+  int cost;                     // log-probability of the prefix
+  int next;                     // next child (alphabet position or index of the initialProb)
+  unsigned char length;         // length of the password
+  unsigned char depth;          // length of the prefix
+  unsigned short prefix[MAX_PASSWORD_LENGTH]; // prefix as positions in the alphabet
+} probQueue_entry;
+
+/*
+ * Contains the heap of entries kept in memory and the spilled runs.
+ */
+typedef struct probQueue_struct
+{
+  probQueue_entry *heap;        // binary min-heap (by priority)
+  size_t sizeOf_heap;           // current amount of entries in the heap
+  size_t capacity;              // maximal amount of entries in the heap
+
+  FILE **runs;                  // spilled runs (each sorted by priority)
+  probQueue_entry *runHeads;    // next entry of each run
+  size_t sizeOf_runs;           // current amount of runs
+  size_t indexMax_runs;         // allocated amount of runs
+
+  uint64_t spilledCount;        // total amount of entries written to runs
+} probQueue_struct;
+
+/*
+ * Allocates the given queue keeping at most @capacity entries in memory.
+ * If the allocation fails, the application is aborted.
+ */
+void probQueue_initialize (probQueue_struct ** queue, // queue to be initialized
+                           size_t capacity);  // maximal amount of entries kept in memory (at least 2)
+
+/*
+ * Frees the given queue, closing (and thereby deleting) any spilled run.
+ */
+void probQueue_free (probQueue_struct ** queue);
+
+/*
+ * Adds the given @entry to the @queue. If the heap is full, half of it is
+ * spilled to a temporary file. Returns FALSE if spilling failed.
+ */
+bool probQueue_push (probQueue_struct * queue, const probQueue_entry * entry);
+
+/*
+ * Removes the entry with the smallest priority from the @queue and stores
+ * it in @entry. Returns FALSE if the queue is empty (or a run can't be read).
+ */
+bool probQueue_pop (probQueue_struct * queue, probQueue_entry * entry);
+
+#endif /* PROBQUEUE_H_ */
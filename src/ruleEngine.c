@@ -0,0 +1,494 @@
+/*
+ * ruleEngine.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "errorHandler.h"
+#include "ruleEngine.h"
+
+/*
+ * Function of the rule syntax and the kind of its arguments:
+ * 'N' position, 'X' char
+ */
+typedef struct rule_function
+{
+  char name;                    // char of the function in a rule
+  ruleOp op;                    // opcode of the function
+  const char *args;             // kind of each argument
+} rule_function;
+
+const rule_function rule_functions[] = {
+  {'l', ruleOp_lower, ""},
+  {'u', ruleOp_upper, ""},
+  {'c', ruleOp_capitalize, ""},
+  {'C', ruleOp_invertCapitalize, ""},
+  {'t', ruleOp_toggle, ""},
+  {'T', ruleOp_toggleAt, "N"},
+  {'r', ruleOp_reverse, ""},
+  {'d', ruleOp_duplicate, ""},
+  {'p', ruleOp_duplicateN, "N"},
+  {'f', ruleOp_reflect, ""},
+  {'{', ruleOp_rotateLeft, ""},
+  {'}', ruleOp_rotateRight, ""},
+  {'$', ruleOp_append, "X"},
+  {'^', ruleOp_prepend, "X"},
+  {'[', ruleOp_deleteFirst, ""},
+  {']', ruleOp_deleteLast, ""},
+  {'D', ruleOp_deleteAt, "N"},
+  {'x', ruleOp_extract, "NN"},
+  {'\'', ruleOp_truncate, "N"},
+  {'i', ruleOp_insert, "NX"},
+  {'o', ruleOp_overwrite, "NX"},
+  {'s', ruleOp_replace, "XX"},
+  {'@', ruleOp_purge, "X"},
+  {'z', ruleOp_duplicateFirst, "N"},
+  {'Z', ruleOp_duplicateLast, "N"},
+  {'q', ruleOp_duplicateEach, ""},
+  {'k', ruleOp_swapFirst, ""},
+  {'K', ruleOp_swapLast, ""}
+};
+
+/* (intern function) Returns the position given by the char @c (0-9, A-Z) or -1 if @c is no position. */
+int rule_position (char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'A' && c <= 'Z')
+    return c - 'A' + 10;
+  return -1;
+}                               // (intern) rule_position
+
+/* (intern function) Appends the instruction @op with the arguments @arg1 and @arg2 to the code. */
+void rule_emit (ruleEngine_struct * engine, ruleOp op, unsigned char arg1, unsigned char arg2)
+{
+  if (engine->sizeOf_code + 3 > engine->indexMax_code)
+  {
+    engine->indexMax_code *= 2;
+    engine->code = (unsigned char *) realloc (engine->code, engine->indexMax_code);
+    EXIT_IF_NULL (engine->code);
+  }
+  engine->code[engine->sizeOf_code++] = (unsigned char) op;
+  engine->code[engine->sizeOf_code++] = arg1;
+  engine->code[engine->sizeOf_code++] = arg2;
+}                               // (intern) rule_emit
+
+/* (intern function) Compiles the rule given in @line (@lineNumber of @filename) and adds it to the rules. Returns FALSE (printing an error) if the rule uses an unsupported function or misses an argument. */
+bool rule_compile (ruleEngine_struct * engine, const char *line, const char *filename, int lineNumber)
+{
+  const char *cur = line;
+
+  if (engine->sizeOf_rules == engine->indexMax_rules)
+  {
+    engine->indexMax_rules *= 2;
+    engine->ruleStart = (int *) realloc (engine->ruleStart, engine->indexMax_rules * sizeof (int));
+    EXIT_IF_NULL (engine->ruleStart);
+  }
+  engine->ruleStart[engine->sizeOf_rules] = (int) engine->sizeOf_code;
+
+  while (*cur != '\0')
+  {
+    const rule_function *function = NULL;
+    unsigned char args[2] = { 0, 0 };
+
+    // functions may be separated by spaces, ':' does nothing
+    if (*cur == ' ' || *cur == ':')
+    {
+      cur++;
+      continue;
+    }
+    for (size_t i = 0; i < sizeof (rule_functions) / sizeof (rule_function); i++)
+    {
+      if (rule_functions[i].name == *cur)
+        function = rule_functions + i;
+    }
+    if (function == NULL)
+    {
+      errorHandler_print (errorType_Error, "Unsupported rule function '%c' in line %i of the rule file (%s)\n", *cur, lineNumber, filename);
+      return false;
+    }
+    cur++;
+    for (size_t i = 0; function->args[i] != '\0'; i++)
+    {
+      if (*cur == '\0' || (function->args[i] == 'N' && rule_position (*cur) < 0))
+      {
+        errorHandler_print (errorType_Error, "Missing or invalid argument of the rule function '%c' in line %i of the rule file (%s)\n", function->name, lineNumber, filename);
+        return false;
+      }
+      args[i] = (function->args[i] == 'N') ? (unsigned char) rule_position (*cur) : (unsigned char) *cur;
+      cur++;
+    }
+    rule_emit (engine, function->op, args[0], args[1]);
+  }
+  rule_emit (engine, ruleOp_end, 0, 0);
+  engine->sizeOf_rules++;
+  return true;
+}                               // (intern) rule_compile
+
+/* (intern function) Returns the given char @c as lower case letter (ASCII only). */
+char rule_lower (char c)
+{
+  return (c >= 'A' && c <= 'Z') ? (char) (c + ('a' - 'A')) : c;
+}                               // (intern) rule_lower
+
+/* (intern function) Returns the given char @c as upper case letter (ASCII only). */
+char rule_upper (char c)
+{
+  return (c >= 'a' && c <= 'z') ? (char) (c - ('a' - 'A')) : c;
+}                               // (intern) rule_upper
+
+/* (intern function) Returns the given char @c with toggled case (ASCII only). */
+char rule_toggle (char c)
+{
+  if (c >= 'a' && c <= 'z')
+    return rule_upper (c);
+  return rule_lower (c);
+}                               // (intern) rule_toggle
+
+/* (intern function) Interprets the instructions of a rule starting at @code on the given @password of @length, storing the result in @work (RULEENGINE_SIZEOF_BUFFER chars). Returns the length of the result or -1 if an intermediate result doesn't fit. Functions referring to a position beyond the password leave it unchanged (like hashcat). */
+int rule_apply (const unsigned char *code, const char *password, int length, char work[RULEENGINE_SIZEOF_BUFFER])
+{
+  int len = length;
+  char c = '\0';
+
+  memcpy (work, password, length);
+  for (const unsigned char *ins = code; *ins != ruleOp_end; ins += 3)
+  {
+    int n = ins[1];
+    int m = ins[2];
+
+    switch ((ruleOp) ins[0])
+    {
+    case ruleOp_lower:
+      for (int i = 0; i < len; i++)
+        work[i] = rule_lower (work[i]);
+      break;
+    case ruleOp_upper:
+      for (int i = 0; i < len; i++)
+        work[i] = rule_upper (work[i]);
+      break;
+    case ruleOp_capitalize:
+      for (int i = 1; i < len; i++)
+        work[i] = rule_lower (work[i]);
+      if (len > 0)
+        work[0] = rule_upper (work[0]);
+      break;
+    case ruleOp_invertCapitalize:
+      for (int i = 1; i < len; i++)
+        work[i] = rule_upper (work[i]);
+      if (len > 0)
+        work[0] = rule_lower (work[0]);
+      break;
+    case ruleOp_toggle:
+      for (int i = 0; i < len; i++)
+        work[i] = rule_toggle (work[i]);
+      break;
+    case ruleOp_toggleAt:
+      if (n < len)
+        work[n] = rule_toggle (work[n]);
+      break;
+    case ruleOp_reverse:
+      for (int i = 0; i < len / 2; i++)
+      {
+        c = work[i];
+        work[i] = work[len - 1 - i];
+        work[len - 1 - i] = c;
+      }
+      break;
+    case ruleOp_duplicate:
+      if (2 * len > RULEENGINE_SIZEOF_BUFFER)
+        return -1;
+      memcpy (work + len, work, len);
+      len *= 2;
+      break;
+    case ruleOp_duplicateN:
+      if ((n + 1) * len > RULEENGINE_SIZEOF_BUFFER)
+        return -1;
+      for (int i = 1; i <= n; i++)
+        memcpy (work + i * len, work, len);
+      len *= n + 1;
+      break;
+    case ruleOp_reflect:
+      if (2 * len > RULEENGINE_SIZEOF_BUFFER)
+        return -1;
+      for (int i = 0; i < len; i++)
+        work[len + i] = work[len - 1 - i];
+      len *= 2;
+      break;
+    case ruleOp_rotateLeft:
+      if (len > 1)
+      {
+        c = work[0];
+        memmove (work, work + 1, len - 1);
+        work[len - 1] = c;
+      }
+      break;
+    case ruleOp_rotateRight:
+      if (len > 1)
+      {
+        c = work[len - 1];
+        memmove (work + 1, work, len - 1);
+        work[0] = c;
+      }
+      break;
+    case ruleOp_append:
+      if (len + 1 > RULEENGINE_SIZEOF_BUFFER)
+        return -1;
+      work[len++] = (char) n;
+      break;
+    case ruleOp_prepend:
+      if (len + 1 > RULEENGINE_SIZEOF_BUFFER)
+        return -1;
+      memmove (work + 1, work, len++);
+      work[0] = (char) n;
+      break;
+    case ruleOp_deleteFirst:
+      if (len > 0)
+        memmove (work, work + 1, --len);
+      break;
+    case ruleOp_deleteLast:
+      if (len > 0)
+        len--;
+      break;
+    case ruleOp_deleteAt:
+      if (n < len)
+      {
+        memmove (work + n, work + n + 1, len - n - 1);
+        len--;
+      }
+      break;
+    case ruleOp_extract:
+      if (n + m <= len)
+      {
+        memmove (work, work + n, m);
+        len = m;
+      }
+      break;
+    case ruleOp_truncate:
+      if (n < len)
+        len = n;
+      break;
+    case ruleOp_insert:
+      if (len + 1 > RULEENGINE_SIZEOF_BUFFER)
+        return -1;
+      if (n <= len)
+      {
+        memmove (work + n + 1, work + n, len - n);
+        work[n] = (char) m;
+        len++;
+      }
+      break;
+    case ruleOp_overwrite:
+      if (n < len)
+        work[n] = (char) m;
+      break;
+    case ruleOp_replace:
+      for (int i = 0; i < len; i++)
+        if (work[i] == (char) n)
+          work[i] = (char) m;
+      break;
+    case ruleOp_purge:
+      {
+        int kept = 0;
+
+        for (int i = 0; i < len; i++)
+          if (work[i] != (char) n)
+            work[kept++] = work[i];
+        len = kept;
+      }
+      break;
+    case ruleOp_duplicateFirst:
+      if (len + n > RULEENGINE_SIZEOF_BUFFER)
+        return -1;
+      if (len > 0)
+      {
+        memmove (work + n, work, len);
+        memset (work, work[n], n);
+        len += n;
+      }
+      break;
+    case ruleOp_duplicateLast:
+      if (len + n > RULEENGINE_SIZEOF_BUFFER)
+        return -1;
+      if (len > 0)
+      {
+        memset (work + len, work[len - 1], n);
+        len += n;
+      }
+      break;
+    case ruleOp_duplicateEach:
+      if (2 * len > RULEENGINE_SIZEOF_BUFFER)
+        return -1;
+      for (int i = len - 1; i >= 0; i--)
+      {
+        work[2 * i] = work[i];
+        work[2 * i + 1] = work[i];
+      }
+      len *= 2;
+      break;
+    case ruleOp_swapFirst:
+      if (len > 1)
+      {
+        c = work[0];
+        work[0] = work[1];
+        work[1] = c;
+      }
+      break;
+    case ruleOp_swapLast:
+      if (len > 1)
+      {
+        c = work[len - 2];
+        work[len - 2] = work[len - 1];
+        work[len - 1] = c;
+      }
+      break;
+    case ruleOp_end:
+      break;
+    }
+  }
+  return len;
+}                               // (intern) rule_apply
+
+// reads and compiles the rules
+bool ruleEngine_initialize (ruleEngine_struct ** engine, const char *filename, int sizeOf_batch)
+{
+  FILE *fp = NULL;
+  char line[RULEENGINE_SIZEOF_LINE];
+  int lineNumber = 0;
+
+  if (!open_file (&fp, filename, NULL, "r"))
+  {
+    errorHandler_print (errorType_Error, "Can't open the rule file (%s)\n", filename);
+    return false;
+  }
+
+  *engine = (ruleEngine_struct *) calloc (1, sizeof (ruleEngine_struct));
+  EXIT_IF_NULL (*engine);
+  (*engine)->indexMax_code = 1024;
+  (*engine)->code = (unsigned char *) malloc ((*engine)->indexMax_code);
+  EXIT_IF_NULL ((*engine)->code);
+  (*engine)->indexMax_rules = 64;
+  (*engine)->ruleStart = (int *) malloc ((*engine)->indexMax_rules * sizeof (int));
+  EXIT_IF_NULL ((*engine)->ruleStart);
+
+  while (fgets (line, RULEENGINE_SIZEOF_LINE, fp) != NULL)
+  {
+    size_t length = strlen (line);
+
+    lineNumber++;
+    // remove the line break (LF or CRLF)
+    if (length > 0 && line[length - 1] == '\n')
+      line[--length] = '\0';
+    if (length > 0 && line[length - 1] == '\r')
+      line[--length] = '\0';
+    // empty lines and comments
+    if (length == 0 || line[0] == '#')
+      continue;
+    if (!rule_compile (*engine, line, filename, lineNumber))
+    {
+      fclose (fp);
+      return false;
+    }
+  }
+  fclose (fp);
+
+  if ((*engine)->sizeOf_rules == 0)
+  {
+    errorHandler_print (errorType_Error, "The rule file (%s) doesn't contain any rule.\n", filename);
+    return false;
+  }
+
+  // the batch and the results of a single rule
+  (*engine)->indexMax_batch = sizeOf_batch;
+  (*engine)->batch = (char *) malloc ((size_t) sizeOf_batch * MAX_PASSWORD_LENGTH);
+  EXIT_IF_NULL ((*engine)->batch);
+  (*engine)->batchLength = (int *) malloc (sizeOf_batch * sizeof (int));
+  EXIT_IF_NULL ((*engine)->batchLength);
+  (*engine)->batchLevel = (int *) malloc (sizeOf_batch * sizeof (int));
+  EXIT_IF_NULL ((*engine)->batchLevel);
+  (*engine)->batchCreated = (bool *) malloc (sizeOf_batch * sizeof (bool));
+  EXIT_IF_NULL ((*engine)->batchCreated);
+  (*engine)->results = (char *) malloc ((size_t) sizeOf_batch * MAX_PASSWORD_LENGTH);
+  EXIT_IF_NULL ((*engine)->results);
+  (*engine)->resultLength = (int *) malloc (sizeOf_batch * sizeof (int));
+  EXIT_IF_NULL ((*engine)->resultLength);
+  return true;
+}                               // ruleEngine_initialize
+
+// adds a password to the batch
+bool ruleEngine_add (ruleEngine_struct * engine, const char *password, int length, int level)
+{
+  memcpy (engine->batch + (size_t) engine->sizeOf_batch * MAX_PASSWORD_LENGTH, password, length);
+  engine->batchLength[engine->sizeOf_batch] = length;
+  engine->batchLevel[engine->sizeOf_batch] = level;
+  engine->batchCreated[engine->sizeOf_batch] = false;
+  engine->sizeOf_batch++;
+  engine->passwordCount++;
+  return engine->sizeOf_batch == engine->indexMax_batch;
+}                               // ruleEngine_add
+
+// applies a rule to the whole batch
+void ruleEngine_applyBatch (ruleEngine_struct * engine, int rule)
+{
+  const unsigned char *code = engine->code + engine->ruleStart[rule];
+  char work[RULEENGINE_SIZEOF_BUFFER];
+
+  for (int i = 0; i < engine->sizeOf_batch; i++)
+  {
+    const char *password = engine->batch + (size_t) i * MAX_PASSWORD_LENGTH;
+    char *result = engine->results + (size_t) i * MAX_PASSWORD_LENGTH;
+    int length = rule_apply (code, password, engine->batchLength[i], work);
+
+    // the unchanged password is only created by the first rule leaving it unchanged
+    if (length == engine->batchLength[i] && memcmp (work, password, length) == 0)
+    {
+      if (engine->batchCreated[i])
+        length = 0;
+      engine->batchCreated[i] = true;
+    }
+    if (length <= 0 || length >= MAX_PASSWORD_LENGTH)
+    {
+      engine->resultLength[i] = 0;
+      engine->rejectedCount++;
+      continue;
+    }
+    memcpy (result, work, length);
+    result[length] = '\0';
+    engine->resultLength[i] = length;
+  }
+}                               // ruleEngine_applyBatch
+
+// removes all passwords of the batch
+void ruleEngine_clear (ruleEngine_struct * engine)
+{
+  engine->sizeOf_batch = 0;
+}                               // ruleEngine_clear
+
+// prints the results
+void ruleEngine_printResults (const ruleEngine_struct * engine, FILE * fp)
+{
+  fprintf (fp, "rules: %i rules applied to %" PRIu64 " passwords (%" PRIu64 " results rejected: empty, too long or unchanged)\n", engine->sizeOf_rules, engine->passwordCount, engine->rejectedCount);
+}                               // ruleEngine_printResults
+
+// frees the struct
+void ruleEngine_free (ruleEngine_struct ** engine)
+{
+  if (*engine != NULL)
+  {
+    CHECKED_FREE ((*engine)->code);
+    CHECKED_FREE ((*engine)->ruleStart);
+    CHECKED_FREE ((*engine)->batch);
+    CHECKED_FREE ((*engine)->batchLength);
+    CHECKED_FREE ((*engine)->batchLevel);
+    CHECKED_FREE ((*engine)->batchCreated);
+    CHECKED_FREE ((*engine)->results);
+    CHECKED_FREE ((*engine)->resultLength);
+    free (*engine);
+    *engine = NULL;
+  }
+}                               // ruleEngine_free
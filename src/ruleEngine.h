@@ -0,0 +1,146 @@
+/*
+ * ruleEngine.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Used by enumNG to apply mangling rules (--rules) to the created passwords
+ * directly instead of piping them into a password cracker. The rules are
+ * read from a file in the syntax of hashcat (one rule per line, lines
+ * starting with '#' are ignored) and compiled into a small bytecode: each
+ * function becomes an instruction of an opcode and two arguments.
+ * The created passwords are collected in batches. The rules are applied by
+ * priority (their order in the file): the first rule is applied to each
+ * password of the batch, followed by the second rule and so on, so the
+ * instructions of a single rule are interpreted for the whole batch.
+ * A result is rejected if it is empty, not shorter than MAX_PASSWORD_LENGTH
+ * or equals a password already created unchanged by an earlier rule.
+ *
+ * Supported functions (N, M: position 0-9 or A-Z, X, Y: any char):
+ *   :  nothing              l  lower case         u  upper case
+ *   c  capitalize           C  invert capitalize  t  toggle case
+ *   TN toggle case at N     r  reverse            d  duplicate
+ *   pN duplicate N times    f  reflect            {  rotate left
+ *   }  rotate right         $X append X           ^X prepend X
+ *   [  delete first char    ]  delete last char   DN delete char at N
+ *   xNM extract M chars at N                      'N truncate at N
+ *   iNX insert X at N       oNX overwrite at N    sXY replace X by Y
+ *   @X purge X              zN duplicate first char N times
+ *   ZN duplicate last char N times                q  duplicate each char
+ *   k  swap first two chars K  swap last two chars
+ *
+ */
+
+#ifndef RULEENGINE_H_
+#define RULEENGINE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "common.h"
+
+// === Defines ===
+#define RULEENGINE_SIZEOF_LINE 1024 // lines of the rule file are read in chunks of this size
+#define RULEENGINE_SIZEOF_BUFFER 256  // largest intermediate result of a rule (like hashcat)
+#define RULEENGINE_MAX_BATCH 1048576  // largest amount of passwords per batch
+
+/*
+ * Opcodes of the bytecode (each followed by two arguments).
+ */
+typedef enum
+{
+  ruleOp_end,                   // end of the rule
+  ruleOp_lower,
+  ruleOp_upper,
+  ruleOp_capitalize,
+  ruleOp_invertCapitalize,
+  ruleOp_toggle,
+  ruleOp_toggleAt,
+  ruleOp_reverse,
+  ruleOp_duplicate,
+  ruleOp_duplicateN,
+  ruleOp_reflect,
+  ruleOp_rotateLeft,
+  ruleOp_rotateRight,
+  ruleOp_append,
+  ruleOp_prepend,
+  ruleOp_deleteFirst,
+  ruleOp_deleteLast,
+  ruleOp_deleteAt,
+  ruleOp_extract,
+  ruleOp_truncate,
+  ruleOp_insert,
+  ruleOp_overwrite,
+  ruleOp_replace,
+  ruleOp_purge,
+  ruleOp_duplicateFirst,
+  ruleOp_duplicateLast,
+  ruleOp_duplicateEach,
+  ruleOp_swapFirst,
+  ruleOp_swapLast
+} ruleOp;
+
+/*
+ * Contains the compiled rules, the current batch and the results of the
+ * last rule applied to it.
+ */
+typedef struct ruleEngine_struct
+{
+  unsigned char *code;          // instructions of all rules (opcode and two arguments each)
+  size_t sizeOf_code;
+  size_t indexMax_code;
+  int *ruleStart;               // index of the first instruction of each rule in @code
+  int sizeOf_rules;
+  int indexMax_rules;
+
+  char *batch;                  // passwords of the batch (MAX_PASSWORD_LENGTH chars each)
+  int *batchLength;             // length of each password of the batch
+  int *batchLevel;              // level of each password of the batch
+  bool *batchCreated;           // TRUE if the password has been created unchanged by a rule
+  int sizeOf_batch;             // amount of passwords in the batch
+  int indexMax_batch;           // passwords per batch
+
+  char *results;                // results of the last rule (MAX_PASSWORD_LENGTH chars each, null terminated)
+  int *resultLength;            // length of each result (0 if rejected)
+
+  uint64_t passwordCount;       // amount of passwords the rules have been applied to
+  uint64_t rejectedCount;       // amount of rejected results
+} ruleEngine_struct;
+
+/*
+ * Reads and compiles the rules of @filename and allocates a batch of
+ * @sizeOf_batch passwords.
+ * Returns FALSE (printing an error) if the file can't be read, contains no
+ * rule or a rule uses an unsupported function.
+ * If the allocation fails, the application is aborted.
+ */
+bool ruleEngine_initialize (ruleEngine_struct ** engine, const char *filename, int sizeOf_batch);
+
+/*
+ * Adds the given @password of @length with its @level to the batch.
+ * Returns TRUE if the batch is full.
+ */
+bool ruleEngine_add (ruleEngine_struct * engine, const char *password, int length, int level);
+
+/*
+ * Applies the given @rule to each password of the batch, storing the
+ * results in @results and their lengths in @resultLength (0 if rejected).
+ */
+void ruleEngine_applyBatch (ruleEngine_struct * engine, int rule);
+
+/*
+ * Removes all passwords of the batch.
+ */
+void ruleEngine_clear (ruleEngine_struct * engine);
+
+/*
+ * Prints the amount of rules, passwords and rejected results to the given
+ * file pointer @fp.
+ */
+void ruleEngine_printResults (const ruleEngine_struct * engine, FILE * fp);
+
+/*
+ * Frees the given struct (if not NULL).
+ */
+void ruleEngine_free (ruleEngine_struct ** engine);
+
+#endif /* RULEENGINE_H_ */
@@ -0,0 +1,58 @@
+/*
+ * scoredStream.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "scoredStream.h"
+
+// writes the magic
+bool scoredStream_writeHeader (FILE * fp)
+{
+  return fwrite (SCOREDSTREAM_MAGIC, 1, SCOREDSTREAM_SIZEOF_MAGIC, fp) == SCOREDSTREAM_SIZEOF_MAGIC;
+}                               // scoredStream_writeHeader
+
+// writes a single record
+void scoredStream_write (FILE * fp, int32_t score, const char *password, int length)
+{
+  unsigned char head[5];
+  uint32_t value = (uint32_t) score;
+
+  // the score is stored little endian, independent of the host
+  head[0] = (unsigned char) value;
+  head[1] = (unsigned char) (value >> 8);
+  head[2] = (unsigned char) (value >> 16);
+  head[3] = (unsigned char) (value >> 24);
+  head[4] = (unsigned char) length;
+  fwrite (head, 1, sizeof (head), fp);
+  fwrite (password, 1, length, fp);
+}                               // scoredStream_write
+
+// reads the magic
+bool scoredStream_readHeader (FILE * fp)
+{
+  char magic[SCOREDSTREAM_SIZEOF_MAGIC];
+
+  return fread (magic, 1, SCOREDSTREAM_SIZEOF_MAGIC, fp) == SCOREDSTREAM_SIZEOF_MAGIC && memcmp (magic, SCOREDSTREAM_MAGIC, SCOREDSTREAM_SIZEOF_MAGIC) == 0;
+}                               // scoredStream_readHeader
+
+// reads a single record
+int scoredStream_read (FILE * fp, int32_t * score, char password[SCOREDSTREAM_MAX_LENGTH + 1], int *length)
+{
+  unsigned char head[5];
+  size_t count = fread (head, 1, sizeof (head), fp);
+
+  if (count == 0)
+    return 0;
+  if (count < sizeof (head))
+    return -1;
+  *score = (int32_t) ((uint32_t) head[0] | ((uint32_t) head[1] << 8) | ((uint32_t) head[2] << 16) | ((uint32_t) head[3] << 24));
+  *length = head[4];
+  if (fread (password, 1, *length, fp) != (size_t) * length)
+    return -1;
+  password[*length] = '\0';
+  return 1;
+}                               // scoredStream_read
@@ -0,0 +1,56 @@
+/*
+ * scoredStream.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Binary format of a scored password stream, written by enumNG (--scored)
+ * and merged by mergeCandidates. Each password is stored with its score, so
+ * streams of different guessers (converted to this format) can be merged by
+ * score. The stream starts with the 8 byte SCOREDSTREAM_MAGIC, followed by
+ * a record for each password:
+ *   int32 score (little endian), uint8 length, @length chars (no '\0')
+ * A smaller score means a more probable password. enumNG writes the level
+ * of each password, i.e. about -ln(p) at the default level scale, so other
+ * guessers should write -ln(p) (rounded) for compatible streams.
+ *
+ */
+
+#ifndef SCOREDSTREAM_H_
+#define SCOREDSTREAM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// === Defines ===
+#define SCOREDSTREAM_MAGIC "OMENSC01"
+#define SCOREDSTREAM_SIZEOF_MAGIC 8
+#define SCOREDSTREAM_MAX_LENGTH 255 // maximal length of a password (stored as uint8)
+
+/*
+ * Writes the magic starting a stream to @fp.
+ * Returns FALSE if it can't be written.
+ */
+bool scoredStream_writeHeader (FILE * fp);
+
+/*
+ * Writes the given @password of @length (at most SCOREDSTREAM_MAX_LENGTH)
+ * and its @score to @fp.
+ */
+void scoredStream_write (FILE * fp, int32_t score, const char *password, int length);
+
+/*
+ * Reads the magic starting a stream from @fp.
+ * Returns FALSE if @fp doesn't contain a scored stream.
+ */
+bool scoredStream_readHeader (FILE * fp);
+
+/*
+ * Reads the next record of @fp, storing the password (null terminated) in
+ * @password and its @length and @score.
+ * Returns 1 on success, 0 at the end of the stream and -1 if the last record
+ * is truncated.
+ */
+int scoredStream_read (FILE * fp, int32_t * score, char password[SCOREDSTREAM_MAX_LENGTH + 1], int *length);
+
+#endif /* SCOREDSTREAM_H_ */
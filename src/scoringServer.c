@@ -0,0 +1,490 @@
+/*
+ * scoringServer.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "common.h"
+#include "commonStructs.h"
+#include "errorHandler.h"
+#include "nGramReader.h"
+#include "scoringServer.h"
+
+// === Structures ===
+
+/*
+ * Buffered reader of a single connection.
+ */
+typedef struct connection_struct
+{
+  int fd;                       // socket of the connection
+  char buffer[65536];           // received bytes
+  size_t begin;                 // index of the first unread byte in @buffer
+  size_t end;                   // index after the last received byte in @buffer
+  char *request;                // passwords of the current request (uint8 length and chars each, as received)
+  size_t sizeOf_request;        // allocated bytes of @request
+} connection_struct;
+
+// === Global Variables ===
+scoringServer_model *glbl_serverModel = NULL; // model used to answer the queries (replaced on SIGHUP)
+pthread_rwlock_t glbl_serverModelLock = PTHREAD_RWLOCK_INITIALIZER; // held for reading while answering a request
+int glbl_serverSocket = -1;     // listening socket
+volatile bool glbl_serverRunning = false; // FALSE, once the server is stopped
+int glbl_serverClients[SCORINGSERVER_MAX_THREADS];  // connection served by each thread (-1 if none)
+pthread_mutex_t glbl_serverClientsLock = PTHREAD_MUTEX_INITIALIZER; // lock for @glbl_serverClients
+
+/* (intern function) Estimates the amount of passwords by overall level: for each length, @samples passwords are drawn with probabilities following their levels and each is weighted by the inverse of its probability (importance sampling). */
+void estimate_guesses (scoringServer_model * model, int samples)
+{
+  const nGram_struct *nGramLevel = model->nGramLevel;
+  int sizeOf_alphabet = model->alphabet->sizeOf_alphabet;
+  int sizeOf_N = nGramLevel->sizeOf_N;
+  double scale = (double) (model->maxLevel - 1) / (MAX_LEVEL - 1); // levels per unit of -ln(p) (see createNG --levelScale)
+  double weight[model->maxLevel]; // proposal weight by level
+  double weightCP[sizeOf_alphabet];
+  double *iPCumulative = NULL;  // cumulative weights of the initialProbs
+  double *counts = NULL;        // estimated amount of passwords by overall level
+  unsigned int seed = 1;        // fixed seed, so the estimates don't change between runs
+  double sum = 0.0;
+  double draw = 0.0;
+  double logQ = 0.0;            // log-probability to draw the current password
+  int position = 0;
+  int level = 0;
+  int lower = 0;
+  int upper = 0;
+  int c = 0;
+
+  for (int i = 0; i < model->maxLevel; i++)
+    weight[i] = exp (-i / scale);
+
+  iPCumulative = (double *) malloc (nGramLevel->sizeOf_iP * sizeof (double));
+  EXIT_IF_NULL (iPCumulative);
+  for (int i = 0; i < nGramLevel->sizeOf_iP; i++)
+  {
+    sum += weight[nGramLevel->iP[i]];
+    iPCumulative[i] = sum;
+  }
+
+  // any overall level is smaller than maxLevel for each element of the levelChain plus the length
+  model->sizeOf_guesses = (model->maxLevel - 1) * (MAX_PASSWORD_LENGTH + 2) + 1;
+  counts = (double *) calloc (model->sizeOf_guesses, sizeof (double));
+  EXIT_IF_NULL (counts);
+  model->guesses = (double *) malloc (model->sizeOf_guesses * sizeof (double));
+  EXIT_IF_NULL (model->guesses);
+
+  for (int length = sizeOf_N; length < MAX_PASSWORD_LENGTH && samples > 0; length++)
+  {
+    for (int s = 0; s < samples; s++)
+    {
+      // draw the initialProb (binary search in the cumulative weights)
+      draw = rand_r (&seed) / (RAND_MAX + 1.0) * sum;
+      lower = 0;
+      upper = nGramLevel->sizeOf_iP - 1;
+      while (lower < upper)
+      {
+        if (iPCumulative[(lower + upper) / 2] <= draw)
+          lower = (lower + upper) / 2 + 1;
+        else
+          upper = (lower + upper) / 2;
+      }
+      position = lower;
+      level = nGramLevel->iP[position];
+      logQ = log (weight[level] / sum);
+
+      // draw each further char
+      for (int i = sizeOf_N - 1; i < length; i++)
+      {
+        const int *cP = nGramLevel->cP + position * sizeOf_alphabet;
+        double sumCP = 0.0;
+
+        for (c = 0; c < sizeOf_alphabet; c++)
+        {
+          weightCP[c] = weight[cP[c]];
+          sumCP += weightCP[c];
+        }
+        draw = rand_r (&seed) / (RAND_MAX + 1.0) * sumCP;
+        for (c = 0; c < sizeOf_alphabet - 1 && draw >= weightCP[c]; c++)
+          draw -= weightCP[c];
+        logQ += log (weightCP[c] / sumCP);
+        level += cP[c];
+        position = (position % (nGramLevel->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet + c;
+      }
+      level += nGramLevel->eP[position] + nGramLevel->len[length];
+      counts[level] += exp (-logQ) / samples;
+    }
+  }
+
+  // passwords created before a level are all passwords with a smaller level
+  model->guesses[0] = 0.0;
+  for (int i = 1; i < model->sizeOf_guesses; i++)
+    model->guesses[i] = model->guesses[i - 1] + counts[i - 1];
+
+  free (iPCumulative);
+  free (counts);
+}                               // (intern) estimate_guesses
+
+// reads the model
+bool scoringServer_loadModel (scoringServer_model ** model, const char *configFilename, int samples)
+{
+  *model = (scoringServer_model *) malloc (sizeof (scoringServer_model));
+  EXIT_IF_NULL ((*model));
+
+  struct_filenames_initialize (&((*model)->filenames));
+  struct_filenames_allocateDefaults ((*model)->filenames);
+  struct_alphabet_initialize (&((*model)->alphabet));
+  struct_alphabet_allocateDefaults ((*model)->alphabet);
+  struct_nGrams_initialize (&((*model)->nGramLevel));
+  (*model)->maxLevel = MAX_LEVEL;
+  (*model)->guesses = NULL;
+  (*model)->sizeOf_guesses = 0;
+
+  if (!changeFilename (&((*model)->filenames->cfg), FILENAME_MAX, "config", configFilename)
+      || !read_inputFiles ((*model)->nGramLevel, (*model)->alphabet, (*model)->filenames, &((*model)->maxLevel)))
+  {
+    scoringServer_freeModel (model);
+    return false;
+  }
+
+  // lookup table replacing the search in the alphabet
+  struct_alphabet_fillPositions ((*model)->alphabet, (*model)->charPosition);
+
+  estimate_guesses (*model, samples);
+  return true;
+}                               // scoringServer_loadModel
+
+// frees the model
+void scoringServer_freeModel (scoringServer_model ** model)
+{
+  if (*model != NULL)
+  {
+    struct_nGrams_free (&((*model)->nGramLevel));
+    struct_alphabet_free (&((*model)->alphabet));
+    struct_filenames_free (&((*model)->filenames));
+    CHECKED_FREE ((*model)->guesses);
+    free (*model);
+    *model = NULL;
+  }
+}                               // scoringServer_freeModel
+
+// calculates the overall level of the password
+bool scoringServer_evaluate (const scoringServer_model * model, const char *password, int length, int *level)
+{
+  return struct_nGrams_level (model->nGramLevel, model->charPosition, model->alphabet->sizeOf_alphabet, password, length, false, true, level);
+}                               // scoringServer_evaluate
+
+// returns the estimated guess number of the level
+uint64_t scoringServer_guesses (const scoringServer_model * model, int level)
+{
+  if (level < 0 || level >= model->sizeOf_guesses || model->guesses[level] >= (double) UINT64_MAX)
+    return UINT64_MAX;
+  return (uint64_t) model->guesses[level];
+}                               // scoringServer_guesses
+
+/* (intern function) Reads @size bytes from the @connection into @dest. Returns FALSE if the connection has been closed. */
+bool connection_read (connection_struct * connection, void *dest, size_t size)
+{
+  ssize_t received = 0;
+  size_t available = 0;
+
+  while (size > 0)
+  {
+    if (connection->begin == connection->end)
+    {
+      received = recv (connection->fd, connection->buffer, sizeof (connection->buffer), 0);
+      if (received < 0 && errno == EINTR)
+        continue;
+      // closed or timed out (SO_RCVTIMEO)
+      if (received <= 0)
+        return false;
+      connection->begin = 0;
+      connection->end = received;
+    }
+    available = connection->end - connection->begin;
+    if (available > size)
+      available = size;
+    memcpy (dest, connection->buffer + connection->begin, available);
+    connection->begin += available;
+    dest = (char *) dest + available;
+    size -= available;
+  }
+  return true;
+}                               // (intern) connection_read
+
+/* (intern function) Sends @size bytes of @src. Returns FALSE if the connection has been closed. */
+bool connection_write (int fd, const void *src, size_t size)
+{
+  ssize_t sent = 0;
+
+  while (size > 0)
+  {
+    sent = send (fd, src, size, MSG_NOSIGNAL);
+    if (sent < 0 && errno == EINTR)
+      continue;
+    if (sent <= 0)
+      return false;
+    src = (const char *) src + sent;
+    size -= sent;
+  }
+  return true;
+}                               // (intern) connection_write
+
+/* (intern function) Answers all requests of the @connection until it is closed or a request is invalid. */
+void serve_connection (connection_struct * connection, char *response)
+{
+  uint8_t header[4];            // type/status, reserved, count
+  uint16_t count = 0;
+  uint8_t length = 0;
+  size_t used = 0;              // bytes of the current request in connection->request
+  int32_t level = 0;
+  uint64_t guesses = 0;
+  size_t sizeOf_result = 0;
+  bool valid = false;
+
+  while (connection_read (connection, header, sizeof (header)))
+  {
+    memcpy (&count, header + 2, sizeof (count));
+    if ((header[0] != SCORINGSERVER_TYPE_LEVEL && header[0] != SCORINGSERVER_TYPE_GUESSES) || header[1] != 0)
+    {
+      header[0] = SCORINGSERVER_STATUS_ERROR;
+      memset (header + 1, 0, 3);
+      connection_write (connection->fd, header, sizeof (header));
+      return;
+    }
+    sizeOf_result = sizeof (level) + ((header[0] == SCORINGSERVER_TYPE_GUESSES) ? sizeof (guesses) : 0);
+
+    // receive the whole request first, so a stalled client never holds the model lock
+    used = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      if (!connection_read (connection, &length, sizeof (length)))
+        return;
+      if (used + 1 + length > connection->sizeOf_request)
+      {
+        while (used + 1 + length > connection->sizeOf_request)
+          connection->sizeOf_request *= 2;
+        connection->request = (char *) realloc (connection->request, connection->sizeOf_request);
+        EXIT_IF_NULL (connection->request);
+      }
+      connection->request[used] = (char) length;
+      if (!connection_read (connection, connection->request + used + 1, length))
+        return;
+      used += 1 + length;
+    }
+
+    // the model must not be replaced while a request is answered
+    pthread_rwlock_rdlock (&glbl_serverModelLock);
+    used = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      length = (uint8_t) connection->request[used];
+      valid = scoringServer_evaluate (glbl_serverModel, connection->request + used + 1, length, &level);
+      used += 1 + length;
+      if (!valid)
+        level = -1;
+      memcpy (response + sizeof (header) + i * sizeOf_result, &level, sizeof (level));
+      if (header[0] == SCORINGSERVER_TYPE_GUESSES)
+      {
+        guesses = valid ? scoringServer_guesses (glbl_serverModel, level) : UINT64_MAX;
+        memcpy (response + sizeof (header) + i * sizeOf_result + sizeof (level), &guesses, sizeof (guesses));
+      }
+    }
+    pthread_rwlock_unlock (&glbl_serverModelLock);
+
+    response[0] = SCORINGSERVER_STATUS_OK;
+    response[1] = 0;
+    memcpy (response + 2, &count, sizeof (count));
+    if (!connection_write (connection->fd, response, sizeof (header) + count * sizeOf_result))
+      return;
+  }
+}                               // (intern) serve_connection
+
+/* (intern function) Thread accepting and serving connections until the server is stopped. */
+void *serve_thread (void *arg)
+{
+  int index = (int) (intptr_t) arg; // index of the thread
+  connection_struct *connection = (connection_struct *) malloc (sizeof (connection_struct));
+  char *response = (char *) malloc (4 + UINT16_MAX * (sizeof (int32_t) + sizeof (uint64_t)));  // largest possible response
+  struct timeval timeout = { SCORINGSERVER_TIMEOUT, 0 };
+  int fd = -1;
+
+  EXIT_IF_NULL (connection);
+  EXIT_IF_NULL (response);
+  connection->sizeOf_request = 4096;  // grown for larger requests
+  connection->request = (char *) malloc (connection->sizeOf_request);
+  EXIT_IF_NULL (connection->request);
+
+  while (glbl_serverRunning)
+  {
+    fd = accept (glbl_serverSocket, NULL, NULL);
+    if (fd < 0)
+    {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+      break;                    // socket has been shut down
+    }
+
+    // register the connection, so it can be closed when the server is stopped
+    pthread_mutex_lock (&glbl_serverClientsLock);
+    if (!glbl_serverRunning)
+    {
+      pthread_mutex_unlock (&glbl_serverClientsLock);
+      close (fd);
+      break;
+    }
+    glbl_serverClients[index] = fd;
+    pthread_mutex_unlock (&glbl_serverClientsLock);
+
+    // a stalled client must not keep the thread forever
+    setsockopt (fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof (timeout));
+    setsockopt (fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof (timeout));
+
+    connection->fd = fd;
+    connection->begin = 0;
+    connection->end = 0;
+    serve_connection (connection, response);
+
+    pthread_mutex_lock (&glbl_serverClientsLock);
+    glbl_serverClients[index] = -1;
+    pthread_mutex_unlock (&glbl_serverClientsLock);
+    close (fd);
+  }
+
+  free (connection->request);
+  free (connection);
+  free (response);
+  return NULL;
+}                               // (intern) serve_thread
+
+/* (intern function) Creates the listening socket. Returns FALSE on error. */
+bool open_socket (const char *socketFilename)
+{
+  struct sockaddr_un address;
+  struct stat fileStat;
+
+  if (strlen (socketFilename) >= sizeof (address.sun_path))
+  {
+    errorHandler_print (errorType_Error, "The socket filename is too long (at most %zu chars).\n", sizeof (address.sun_path) - 1);
+    return false;
+  }
+  memset (&address, 0, sizeof (address));
+  address.sun_family = AF_UNIX;
+  strcpy (address.sun_path, socketFilename);
+
+  // remove a socket left over by a previous server (but never any other file)
+  if (stat (socketFilename, &fileStat) == 0 && S_ISSOCK (fileStat.st_mode))
+    unlink (socketFilename);
+
+  glbl_serverSocket = socket (AF_UNIX, SOCK_STREAM, 0);
+  if (glbl_serverSocket < 0 || bind (glbl_serverSocket, (struct sockaddr *) &address, sizeof (address)) != 0 || listen (glbl_serverSocket, SOMAXCONN) != 0)
+  {
+    errorHandler_print (errorType_Error, "Unable to create the socket %s: %s\n", socketFilename, strerror (errno));
+    if (glbl_serverSocket >= 0)
+      close (glbl_serverSocket);
+    glbl_serverSocket = -1;
+    return false;
+  }
+  return true;
+}                               // (intern) open_socket
+
+// answers queries until the server is stopped
+bool scoringServer_run (const char *socketFilename, const char *configFilename, int threads, int samples, bool verbose)
+{
+  pthread_t thread[threads];
+  scoringServer_model *model = NULL;  // model read on SIGHUP
+  scoringServer_model *swap = NULL;
+  sigset_t signals;
+  int received = 0;             // received signal
+
+  if (!scoringServer_loadModel (&glbl_serverModel, configFilename, samples))
+  {
+    errorHandler_print (errorType_Error, "Unable to read the model (config: %s).\n", configFilename);
+    return false;
+  }
+  if (!open_socket (socketFilename))
+  {
+    scoringServer_freeModel (&glbl_serverModel);
+    return false;
+  }
+
+  // the signals are only handled by this thread (using sigwait)
+  sigemptyset (&signals);
+  sigaddset (&signals, SIGHUP);
+  sigaddset (&signals, SIGINT);
+  sigaddset (&signals, SIGTERM);
+  pthread_sigmask (SIG_BLOCK, &signals, NULL);
+
+  glbl_serverRunning = true;
+  for (int i = 0; i < threads; i++)
+  {
+    glbl_serverClients[i] = -1;
+    if (pthread_create (&thread[i], NULL, serve_thread, (void *) (intptr_t) i) != 0)
+    {
+      printf ("Critical Error: Unable to create thread\n");
+      exit (1);
+    }
+  }
+  if (verbose)
+    printf ("Answering queries on %s using %i threads\n", socketFilename, threads);
+
+  while (glbl_serverRunning)
+  {
+    if (sigwait (&signals, &received) != 0)
+      continue;
+    if (received == SIGHUP)
+    {
+      // read the new model before replacing the old one, so queries are answered meanwhile
+      if (!scoringServer_loadModel (&model, configFilename, samples))
+      {
+        errorHandler_print (errorType_Warning, "Unable to reload the model (config: %s), keeping the old one.\n", configFilename);
+        continue;
+      }
+      pthread_rwlock_wrlock (&glbl_serverModelLock);
+      swap = glbl_serverModel;
+      glbl_serverModel = model;
+      pthread_rwlock_unlock (&glbl_serverModelLock);
+      // free the old model once no query uses it anymore (outside the lock, so no query is delayed)
+      scoringServer_freeModel (&swap);
+      model = NULL;
+      if (verbose)
+        printf ("Model reloaded\n");
+    }
+    else
+    {
+      // stop accepting connections and close all open ones
+      pthread_mutex_lock (&glbl_serverClientsLock);
+      glbl_serverRunning = false;
+      shutdown (glbl_serverSocket, SHUT_RDWR);
+      for (int i = 0; i < threads; i++)
+      {
+        if (glbl_serverClients[i] >= 0)
+          shutdown (glbl_serverClients[i], SHUT_RDWR);
+      }
+      pthread_mutex_unlock (&glbl_serverClientsLock);
+    }
+  }
+
+  for (int i = 0; i < threads; i++)
+    pthread_join (thread[i], NULL);
+  close (glbl_serverSocket);
+  glbl_serverSocket = -1;
+  unlink (socketFilename);
+  scoringServer_freeModel (&glbl_serverModel);
+  pthread_sigmask (SIG_UNBLOCK, &signals, NULL);
+  return true;
+}                               // scoringServer_run
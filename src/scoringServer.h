@@ -0,0 +1,102 @@
+/*
+ * scoringServer.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Scoring daemon used by evalPW (--serve). The model is read once and queries
+ * are answered over a Unix domain socket by a small pool of threads, each
+ * serving one connection at a time. On SIGHUP the model is read again and
+ * replaced once no query uses the old one anymore; SIGINT and SIGTERM stop
+ * the server.
+ *
+ * Protocol (all integers in the byte order of the host):
+ *  - request: uint8 type, uint8 reserved (0), uint16 count, followed by
+ *    @count passwords, each as uint8 length and @length chars (no '\0').
+ *  - response: uint8 status, uint8 reserved (0), uint16 count, followed by
+ *    @count results, each as int32 level and (only for
+ *    SCORINGSERVER_TYPE_GUESSES) uint64 guess number.
+ * The level is the overall level enumNG assigns to the password (including
+ * the level of its length) or -1 if the password can't be created by enumNG
+ * (invalid length or char). The guess number estimates how many passwords
+ * enumNG creates before it reaches this level (UINT64_MAX if level is -1).
+ * Any amount of requests can be sent over the same connection. If a request
+ * is invalid, a response with SCORINGSERVER_STATUS_ERROR and count 0 is sent
+ * and the connection is closed.
+ * A request is received completely before the model is locked, so a slow
+ * client never delays a reload. A connection without any data for
+ * SCORINGSERVER_TIMEOUT seconds (while a request is received or its
+ * response sent) is closed.
+ *
+ */
+
+#ifndef SCORINGSERVER_H_
+#define SCORINGSERVER_H_
+
+#include <stdint.h>
+
+#include "common.h"
+#include "commonStructs.h"
+
+// === Defines ===
+#define SCORINGSERVER_TYPE_LEVEL 1  // request the levels
+#define SCORINGSERVER_TYPE_GUESSES 2  // request the levels and guess numbers
+#define SCORINGSERVER_STATUS_OK 0
+#define SCORINGSERVER_STATUS_ERROR 1
+#define SCORINGSERVER_MAX_THREADS 256
+#define SCORINGSERVER_TIMEOUT 30  // seconds a connection may stall before it is closed
+
+/*
+ * Model used to answer the queries.
+ */
+typedef struct scoringServer_model
+{
+  nGram_struct *nGramLevel;     // levels read from the level files
+  alphabet_struct *alphabet;    // alphabet read from the config
+  filename_struct *filenames;   // filenames read from the config
+  int maxLevel;                 // max level read from the config
+  int charPosition[256];        // position in the alphabet by char (-1 if not part of the alphabet)
+
+  double *guesses;              // estimated amount of passwords created before each overall level
+  int sizeOf_guesses;           // size of @guesses (max overall level + 1)
+} scoringServer_model;
+
+/*
+ * Reads the config @configFilename as well as the level files listed in it
+ * and estimates the guess numbers by sampling @samples passwords per length
+ * (importance sampling with a proposal following the levels).
+ * Returns FALSE if any file can't be read.
+ */
+bool scoringServer_loadModel (scoringServer_model ** model, // model to be initialized
+                              const char *configFilename, // config created by createNG
+                              int samples); // amount of passwords sampled per length
+
+/*
+ * Frees the given model (if not NULL).
+ */
+void scoringServer_freeModel (scoringServer_model ** model);
+
+/*
+ * Calculates the overall level of the given @password with @length chars
+ * as used by enumNG (initialProb, conditionalProbs, endProb and length).
+ * Returns FALSE if the password can't be created by enumNG.
+ */
+bool scoringServer_evaluate (const scoringServer_model * model, const char *password, int length, int *level);
+
+/*
+ * Returns the estimated amount of passwords created by enumNG before
+ * reaching the given overall @level (UINT64_MAX if out of range).
+ */
+uint64_t scoringServer_guesses (const scoringServer_model * model, int level);
+
+/*
+ * Reads the model and answers queries on the Unix domain socket
+ * @socketFilename using @threads threads until SIGINT or SIGTERM is received.
+ * Returns FALSE if the model can't be read or the socket can't be created.
+ */
+bool scoringServer_run (const char *socketFilename, // socket to be created
+                        const char *configFilename, // config created by createNG
+                        int threads,  // amount of threads answering queries
+                        int samples,  // amount of passwords sampled per length
+                        bool verbose);  // print information about (re)loading the model
+
+#endif /* SCORINGSERVER_H_ */
@@ -0,0 +1,361 @@
+/*
+ * sharedModel.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sharedModel.h"
+#include "errorHandler.h"
+#include "nGramReader.h"
+
+#define SHAREDMODEL_ALIGNMENT 64  // alignment of each array in the segment (cache line)
+#define SHAREDMODEL_POLL_INTERVAL 10  // milliseconds between two checks of the ready flag
+
+/*
+ * Header stored at the beginning of the segment, followed by the arrays
+ * (each starting at the given offset in bytes from the beginning of the segment).
+ */
+typedef struct sharedModel_header
+{
+  uint32_t magic;               // SHAREDMODEL_MAGIC
+  uint32_t version;             // SHAREDMODEL_VERSION
+  int ready;                    // set once the segment is complete (accessed atomically)
+
+  // config the model has been read from
+  int64_t configSize;           // size of the config file
+  int64_t configMTime;          // last modification of the config file
+  int sizeOf_N;                 // size of the nGram 'n'
+  int maxLevel;                 // max level
+  int sizeOf_alphabet;          // size of the alphabet
+  char alphabet[MAX_ALPHABET_SIZE + 1]; // alphabet
+
+  // nGram arrays
+  int sizeOf_cP;
+  int sizeOf_iP;
+  int sizeOf_eP;
+  int sizeOf_len;
+  uint64_t offset_cP;
+  uint64_t offset_iP;
+  uint64_t offset_eP;
+  uint64_t offset_len;
+
+  // sorted arrays (only if @hasSorted is set, i.e. maxLevel <= MAX_LEVEL)
+  int hasSorted;
+  int sizeOf_mGram;
+  uint64_t offset_indexStart[MAX_LEVEL];  // sortedLastGram.indexStart of each level (sizeOf_mGram + 1 entries)
+  uint64_t offset_lastGrams[MAX_LEVEL]; // sortedLastGram.lastGrams of each level (indexStart[sizeOf_mGram] entries)
+  uint64_t offset_sortedIP[MAX_LEVEL];  // sortedIP.iP of each level (sizeOf_sortedIP entries)
+  int sizeOf_sortedIP[MAX_LEVEL];
+
+  uint64_t sizeOf_segment;      // size of the whole segment
+} sharedModel_header;
+
+/* (intern function) returns the offset of the next array of @count ints starting at @offset and moves @offset behind it */
+uint64_t reserve_array (uint64_t * offset, uint64_t count)
+{
+  uint64_t result = (*offset + SHAREDMODEL_ALIGNMENT - 1) / SHAREDMODEL_ALIGNMENT * SHAREDMODEL_ALIGNMENT;
+
+  *offset = result + count * sizeof (int);
+  return result;
+}                               // reserve_array
+
+/* (intern function) copies @count ints from @source to the segment at @offset */
+void copy_array (char *segment, uint64_t offset, const int *source, uint64_t count)
+{
+  if (count > 0)
+    memcpy (segment + offset, source, count * sizeof (int));
+}                               // copy_array
+
+/* (intern function) reads the model of the config set in @filenames and publishes it in the new (empty) segment @fd */
+bool publish_segment (int fd, struct nGram_struct *nGramLevel, struct alphabet_struct *alphabet, struct filename_struct *filenames, int *maxLevel, const struct stat *configStat)
+{
+  sharedModel_header header;
+  sortedLastGram_struct *sortedLastGram = NULL;
+  sortedIP_struct *sortedIP = NULL;
+  char *segment = NULL;
+  uint64_t offset = sizeof (sharedModel_header);
+  bool success = true;
+
+  if (!read_inputFiles (nGramLevel, alphabet, filenames, maxLevel))
+    return false;
+  if (strlen (alphabet->alphabet) > MAX_ALPHABET_SIZE)
+  {
+    errorHandler_print (errorType_Error, "The alphabet is too large to be shared.\n");
+    return false;
+  }
+
+  memset (&header, 0, sizeof (header));
+  header.magic = SHAREDMODEL_MAGIC;
+  header.version = SHAREDMODEL_VERSION;
+  header.configSize = (int64_t) configStat->st_size;
+  header.configMTime = (int64_t) configStat->st_mtime;
+  header.sizeOf_N = nGramLevel->sizeOf_N;
+  header.maxLevel = *maxLevel;
+  header.sizeOf_alphabet = alphabet->sizeOf_alphabet;
+  strcpy (header.alphabet, alphabet->alphabet);
+
+  header.sizeOf_cP = nGramLevel->sizeOf_cP;
+  header.sizeOf_iP = nGramLevel->sizeOf_iP;
+  header.sizeOf_eP = nGramLevel->sizeOf_eP;
+  header.sizeOf_len = nGramLevel->sizeOf_len;
+  header.offset_cP = reserve_array (&offset, header.sizeOf_cP);
+  header.offset_iP = reserve_array (&offset, header.sizeOf_iP);
+  header.offset_eP = reserve_array (&offset, header.sizeOf_eP);
+  header.offset_len = reserve_array (&offset, header.sizeOf_len);
+
+  // sort the arrays like enumNG does (the explicit per level storage is only used up to MAX_LEVEL)
+  header.hasSorted = (*maxLevel <= MAX_LEVEL);
+  if (header.hasSorted)
+  {
+    struct_sortedLastGram_initialize (*maxLevel, &sortedLastGram, nGramLevel->sizeOf_N, alphabet->sizeOf_alphabet);
+    struct_sortedLastGram_fill (*maxLevel, sortedLastGram, nGramLevel->cP, nGramLevel->sizeOf_cP, nGramLevel->sizeOf_N, alphabet->sizeOf_alphabet);
+    struct_sortedIP_initialize (*maxLevel, &sortedIP, 1);
+    struct_sortedIP_fill (*maxLevel, sortedIP, nGramLevel->iP, nGramLevel->sizeOf_iP);
+
+    header.sizeOf_mGram = sortedLastGram[0].sizeOf_mGram;
+    for (int level = 0; level < *maxLevel; level++)
+    {
+      header.offset_indexStart[level] = reserve_array (&offset, header.sizeOf_mGram + 1);
+      header.offset_lastGrams[level] = reserve_array (&offset, sortedLastGram[level].indexStart[header.sizeOf_mGram]);
+      header.sizeOf_sortedIP[level] = sortedIP[level].indexCur;
+      header.offset_sortedIP[level] = reserve_array (&offset, header.sizeOf_sortedIP[level]);
+    }
+  }
+  header.sizeOf_segment = offset;
+
+  // create and fill the segment
+  if (ftruncate (fd, (off_t) header.sizeOf_segment) != 0)
+  {
+    errorHandler_print (errorType_Error, "Unable to resize the shared memory segment (%s)\n", strerror (errno));
+    success = false;
+  }
+  else if ((segment = mmap (NULL, header.sizeOf_segment, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+  {
+    errorHandler_print (errorType_Error, "Unable to map the shared memory segment (%s)\n", strerror (errno));
+    segment = NULL;
+    success = false;
+  }
+  else
+  {
+    copy_array (segment, header.offset_cP, nGramLevel->cP, header.sizeOf_cP);
+    copy_array (segment, header.offset_iP, nGramLevel->iP, header.sizeOf_iP);
+    copy_array (segment, header.offset_eP, nGramLevel->eP, header.sizeOf_eP);
+    copy_array (segment, header.offset_len, nGramLevel->len, header.sizeOf_len);
+    if (header.hasSorted)
+    {
+      for (int level = 0; level < *maxLevel; level++)
+      {
+        copy_array (segment, header.offset_indexStart[level], sortedLastGram[level].indexStart, header.sizeOf_mGram + 1);
+        copy_array (segment, header.offset_lastGrams[level], sortedLastGram[level].lastGrams, sortedLastGram[level].indexStart[header.sizeOf_mGram]);
+        copy_array (segment, header.offset_sortedIP[level], sortedIP[level].iP, header.sizeOf_sortedIP[level]);
+      }
+    }
+    memcpy (segment, &header, sizeof (header));
+    // the arrays must be visible before the flag
+    __atomic_store_n (&(((sharedModel_header *) segment)->ready), 1, __ATOMIC_RELEASE);
+    munmap (segment, header.sizeOf_segment);
+  }
+
+  // the private copies are replaced by the segment
+  struct_sortedLastGram_free (*maxLevel, &sortedLastGram);
+  struct_sortedIP_free (*maxLevel, &sortedIP);
+  CHECKED_FREE (nGramLevel->cP);
+  CHECKED_FREE (nGramLevel->iP);
+  CHECKED_FREE (nGramLevel->eP);
+  CHECKED_FREE (nGramLevel->len);
+
+  return success;
+}                               // publish_segment
+
+/* (intern function) maps the segment @fd read-only, waiting until it is published */
+bool map_segment (int fd, const char *name, sharedModel_struct * shared)
+{
+  struct stat segmentStat;
+  struct timespec interval = { 0, SHAREDMODEL_POLL_INTERVAL * 1000000L };
+  long polls = SHAREDMODEL_TIMEOUT * (1000L / SHAREDMODEL_POLL_INTERVAL);
+
+  // the segment has its final size before it is filled
+  for (;;)
+  {
+    if (fstat (fd, &segmentStat) != 0)
+    {
+      errorHandler_print (errorType_Error, "Unable to access the shared memory segment %s (%s)\n", name, strerror (errno));
+      return false;
+    }
+    if ((size_t) segmentStat.st_size >= sizeof (sharedModel_header))
+      break;
+    if (polls-- == 0)
+    {
+      errorHandler_print (errorType_Error, "The shared memory segment %s has not been published in time (remove /dev/shm%s to publish it again)\n", name, name);
+      return false;
+    }
+    nanosleep (&interval, NULL);
+  }
+
+  shared->sizeOf_segment = (size_t) segmentStat.st_size;
+  shared->segment = mmap (NULL, shared->sizeOf_segment, PROT_READ, MAP_SHARED, fd, 0);
+  if (shared->segment == MAP_FAILED)
+  {
+    errorHandler_print (errorType_Error, "Unable to map the shared memory segment %s (%s)\n", name, strerror (errno));
+    shared->segment = NULL;
+    return false;
+  }
+
+  while (!__atomic_load_n (&(((sharedModel_header *) shared->segment)->ready), __ATOMIC_ACQUIRE))
+  {
+    if (polls-- == 0)
+    {
+      errorHandler_print (errorType_Error, "The shared memory segment %s has not been published in time (remove /dev/shm%s to publish it again)\n", name, name);
+      return false;
+    }
+    nanosleep (&interval, NULL);
+  }
+  return true;
+}                               // map_segment
+
+// attaches (and publishes) the shared model
+bool sharedModel_attach (sharedModel_struct ** shared, const char *name, struct nGram_struct * nGramLevel, struct alphabet_struct * alphabet, struct filename_struct * filenames, int *maxLevel, struct sortedLastGram_struct ** sortedLastGram, struct sortedIP_struct ** sortedIP)
+{
+  struct stat configStat;
+  sharedModel_header *header = NULL;
+  char *segment = NULL;
+  int fd = -1;
+
+  if (stat (filenames->cfg, &configStat) != 0)
+  {
+    errorHandler_print (errorType_Error, "Could not open file (%s)\n", filenames->cfg);
+    return false;
+  }
+
+  (*shared) = (sharedModel_struct *) malloc (sizeof (sharedModel_struct));
+  EXIT_IF_NULL ((*shared));
+  (*shared)->segment = NULL;
+  (*shared)->sizeOf_segment = 0;
+  (*shared)->sortedAttached = false;
+
+  // the first process publishes the model
+  fd = shm_open (name, O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd != -1)
+  {
+    bool published = publish_segment (fd, nGramLevel, alphabet, filenames, maxLevel, &configStat);
+
+    close (fd);
+    if (!published)
+    {
+      shm_unlink (name);
+      return false;
+    }
+  }
+  else if (errno != EEXIST)
+  {
+    errorHandler_print (errorType_Error, "Unable to create the shared memory segment %s (%s)\n", name, strerror (errno));
+    return false;
+  }
+  else if (!read_configFile (nGramLevel, alphabet, filenames, maxLevel))
+  {
+    return false;
+  }
+
+  // attach the published segment (read-only)
+  fd = shm_open (name, O_RDONLY, 0);
+  if (fd == -1)
+  {
+    errorHandler_print (errorType_Error, "Unable to open the shared memory segment %s (%s)\n", name, strerror (errno));
+    return false;
+  }
+  if (!map_segment (fd, name, *shared))
+  {
+    close (fd);
+    return false;
+  }
+  close (fd);
+
+  segment = (char *) (*shared)->segment;
+  header = (sharedModel_header *) segment;
+  if (header->magic != SHAREDMODEL_MAGIC || header->version != SHAREDMODEL_VERSION || header->sizeOf_segment != (*shared)->sizeOf_segment)
+  {
+    errorHandler_print (errorType_Error, "The shared memory segment %s doesn't contain a model (remove /dev/shm%s to publish it again)\n", name, name);
+    return false;
+  }
+  if (header->configSize != (int64_t) configStat.st_size || header->configMTime != (int64_t) configStat.st_mtime || header->sizeOf_N != nGramLevel->sizeOf_N || header->maxLevel != *maxLevel || header->sizeOf_alphabet != alphabet->sizeOf_alphabet || strcmp (header->alphabet, alphabet->alphabet) != 0)
+  {
+    errorHandler_print (errorType_Error, "The shared memory segment %s contains a different model than %s (remove /dev/shm%s to publish it again)\n", name, filenames->cfg, name);
+    return false;
+  }
+
+  // the arrays are read-only, the segment is never modified after publishing
+  nGramLevel->cP = (int *) (segment + header->offset_cP);
+  nGramLevel->iP = (int *) (segment + header->offset_iP);
+  nGramLevel->eP = (int *) (segment + header->offset_eP);
+  nGramLevel->len = (int *) (segment + header->offset_len);
+  nGramLevel->sizeOf_cP = header->sizeOf_cP;
+  nGramLevel->sizeOf_iP = header->sizeOf_iP;
+  nGramLevel->sizeOf_eP = header->sizeOf_eP;
+  nGramLevel->sizeOf_len = header->sizeOf_len;
+
+  if (header->hasSorted && sortedLastGram != NULL && sortedIP != NULL)
+  {
+    (*sortedLastGram) = (sortedLastGram_struct *) malloc (sizeof (sortedLastGram_struct) * (*maxLevel));
+    EXIT_IF_NULL ((*sortedLastGram));
+    (*sortedIP) = (sortedIP_struct *) malloc (sizeof (sortedIP_struct) * (*maxLevel));
+    EXIT_IF_NULL ((*sortedIP));
+    for (int level = 0; level < *maxLevel; level++)
+    {
+      (*sortedLastGram)[level].indexStart = (int *) (segment + header->offset_indexStart[level]);
+      (*sortedLastGram)[level].lastGrams = (int *) (segment + header->offset_lastGrams[level]);
+      (*sortedLastGram)[level].sizeOf_mGram = header->sizeOf_mGram;
+      (*sortedIP)[level].iP = (int *) (segment + header->offset_sortedIP[level]);
+      (*sortedIP)[level].indexCur = header->sizeOf_sortedIP[level];
+      (*sortedIP)[level].indexMax = header->sizeOf_sortedIP[level];
+    }
+    (*shared)->sortedAttached = true;
+  }
+
+  return true;
+}                               // sharedModel_attach
+
+// detaches the shared model
+void sharedModel_detach (sharedModel_struct ** shared, struct nGram_struct *nGramLevel, int maxLevel, struct sortedLastGram_struct *sortedLastGram, struct sortedIP_struct *sortedIP)
+{
+  if ((*shared) == NULL)
+    return;
+
+  if ((*shared)->segment != NULL)
+  {
+    if (nGramLevel != NULL)
+    {
+      nGramLevel->cP = NULL;
+      nGramLevel->iP = NULL;
+      nGramLevel->eP = NULL;
+      nGramLevel->len = NULL;
+    }
+    if ((*shared)->sortedAttached)
+    {
+      for (int level = 0; level < maxLevel; level++)
+      {
+        if (sortedLastGram != NULL)
+        {
+          sortedLastGram[level].indexStart = NULL;
+          sortedLastGram[level].lastGrams = NULL;
+        }
+        if (sortedIP != NULL)
+          sortedIP[level].iP = NULL;
+      }
+    }
+    munmap ((*shared)->segment, (*shared)->sizeOf_segment);
+  }
+  free (*shared);
+  (*shared) = NULL;
+}                               // sharedModel_detach
@@ -0,0 +1,73 @@
+/*
+ * sharedModel.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Shares a model created by createNG between processes running on the same
+ * host (enumNG and evalPW --shm). The first process attaching to a named
+ * POSIX shared memory segment reads the level files, sorts them (lastGrams
+ * and initialProbs by level, as done by enumNG) and publishes the result in
+ * the segment. Any further process only checks that the segment matches its
+ * config and maps it read-only, so neither the files are read again nor the
+ * arrays are sorted again, while the memory is used only once.
+ * The segment is kept until it is removed (e.g. rm /dev/shm/<name>). If the
+ * config has been modified since publishing (e.g. by running createNG again),
+ * attaching fails until the segment is removed.
+ * The arrays are mapped read-only, therefore the levels can't be modified
+ * (i.e. no boosting).
+ *
+ */
+
+#ifndef SHAREDMODEL_H_
+#define SHAREDMODEL_H_
+
+#include "common.h"
+#include "commonStructs.h"
+
+// === Defines ===
+#define SHAREDMODEL_MAGIC 0x4e454d4f  // "OMEN"
+#define SHAREDMODEL_VERSION 1
+#define SHAREDMODEL_TIMEOUT 600 // seconds to wait for another process publishing the segment
+
+/*
+ * Segment attached by sharedModel_attach.
+ */
+typedef struct sharedModel_struct
+{
+  void *segment;                // mapped segment (read-only)
+  size_t sizeOf_segment;        // size of the mapped segment
+  bool sortedAttached;          // TRUE, if the sorted lastGrams and initialProbs point into the segment
+} sharedModel_struct;
+
+/*
+ * Attaches the shared memory segment @name (e.g. "/omen"), publishing the
+ * model of the config set in @filenames first, if the segment doesn't exist
+ * yet. Afterwards @nGramLevel, @alphabet, @filenames and @maxLevel are set
+ * like read_inputFiles does, but the nGram arrays point into the segment.
+ * If @sortedLastGram and @sortedIP are not NULL, they are set to the arrays
+ * sorted by level stored in the segment (only stored for maxLevel <= MAX_LEVEL,
+ * otherwise they are left unchanged).
+ * Returns FALSE if the model can't be read or published or the segment
+ * doesn't match the config.
+ */
+bool sharedModel_attach (sharedModel_struct ** shared,  // attached segment (set by this function)
+                         const char *name,  // name of the shared memory segment
+                         struct nGram_struct *nGramLevel, // nGram struct (must be initialized, the arrays must not be allocated)
+                         struct alphabet_struct *alphabet,  // alphabet (must be initialized)
+                         struct filename_struct *filenames, // filenames (must contain a set config file name!)
+                         int *maxLevel, // max level
+                         struct sortedLastGram_struct **sortedLastGram, // sorted lastGrams (may be NULL)
+                         struct sortedIP_struct **sortedIP);  // sorted initialProbs (may be NULL)
+
+/*
+ * Detaches the given segment (if not NULL). Any array pointing into the
+ * segment is set to NULL, so the structs can be freed as usual afterwards.
+ * The segment itself is kept for other processes.
+ */
+void sharedModel_detach (sharedModel_struct ** shared,  // attached segment
+                         struct nGram_struct *nGramLevel, // nGram struct used to attach the segment
+                         int maxLevel,  // max level
+                         struct sortedLastGram_struct *sortedLastGram,  // sorted lastGrams used to attach the segment (may be NULL)
+                         struct sortedIP_struct *sortedIP); // sorted initialProbs used to attach the segment (may be NULL)
+
+#endif /* SHAREDMODEL_H_ */
@@ -50,14 +50,52 @@ void smoo_additive_init ()
   smoo_additive_vars.levelAdjustFactor[arrayType_length] = 1;
 }
 
+// (intern) smoothed probability for non conditional probabilities (IP, EP and LN)
+double smoo_additive_prob_nonConditional (int position, // current position in given array
+                                          const int *nGramArray,  // current array
+                                          int sizeOf_alphabet,  // size of alphabet
+                                          int sumTotal, // sum of all elements in array
+                                          int delta)  // delta for additive smoothing
+{
+  sumTotal += (sizeOf_alphabet * sizeOf_alphabet * delta);
+
+  if (sumTotal == 0)
+    sumTotal = 1;
+
+  return (double) (nGramArray[position] + delta) / (double) (sumTotal);
+}
+
+// (intern) smoothed probability with conditional probabilities (NG)
+double smoo_additive_prob_conditional (int position,  // current position in given array
+                                       const int *nGramArray, // current array
+                                       int sizeOf_alphabet, // size of alphabet
+                                       int delta) // delta for additive smoothing
+{
+  long sumTotal = 0;
+  int position_mGram = position - (position % sizeOf_alphabet);
+
+  // calculate sum for condition probability
+  for (size_t i = 0; i < sizeOf_alphabet; i++)
+    sumTotal += nGramArray[position_mGram + i];
+
+  // apply delta
+  sumTotal += (sizeOf_alphabet * delta);
+
+  if (sumTotal == 0)
+    sumTotal = 1;
+
+  return (double) (nGramArray[position] + delta) / (double) (sumTotal);
+}
+
 // (intern) actual smoothing function for non conditional probabilities (IP, EP and LN)
-void smoo_additive_funct_nonConditional (char *level, // level to be set
+void smoo_additive_funct_nonConditional (int *level,  // level to be set
                                          int position,  // current position in given array
                                          const int *nGramArray, // current array
                                          int sizeOf_nGramArray, // size of given array
                                          int sizeOf_N,  // size of N
                                          int sizeOf_alphabet, // size of alphabet
-                                         char maxLevel, // max level
+                                         int maxLevel,  // max level
+                                         double levelScale, // levels per unit of -ln(p)
                                          int sumTotal,  // sum of all elements in array
                                          int delta, // delta for additive smoothing
                                          int levelAdjustFactor) // factor to avoid to small level
@@ -79,7 +117,7 @@ void smoo_additive_funct_nonConditional (char *level, // level to be set
   if (curValue > 1)
     curValue = 1;
 
-  *level = (char) (log (curValue));
+  *level = (int) (log (curValue) * levelScale);
   // invert sign
   *level *= -1;
   // if larger the max level, set to max level
@@ -88,13 +126,14 @@ void smoo_additive_funct_nonConditional (char *level, // level to be set
 }
 
 // (intern) actual smoothing function with conditional probabilities (NG)
-void smoo_additive_funct_conditional (char *level,  // level to be set
+void smoo_additive_funct_conditional (int *level,   // level to be set
                                       int position, // current position in given array
                                       const int *nGramArray,  // current array
                                       int sizeOf_nGramArray,  // size of given array
                                       int sizeOf_N, // size of N
                                       int sizeOf_alphabet,  // size of alphabet
-                                      char maxLevel,  // max level
+                                      int maxLevel, // max level
+                                      double levelScale,  // levels per unit of -ln(p)
                                       int delta,  // delta for additive smoothing
                                       int levelAdjustFactor)  // factor to avoid to small level
 {
@@ -123,7 +162,7 @@ void smoo_additive_funct_conditional (char *level,  // level to be set
   if (curValue > 1)
     curValue = 1;
 
-  *level = (char) (log (curValue));
+  *level = (int) (log (curValue) * levelScale);
   // invert sign
   *level *= -1;
   // if larger the max level, set to max level
@@ -137,27 +176,48 @@ void smoo_additive_funct_conditional (char *level,  // level to be set
  * smoothing function selecting thchare according parameter.
  */
 // wrapper for iP
-void smoo_additive_funct_iP (char *level, int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, char maxLevel, int sumTotal)
+void smoo_additive_funct_iP (int *level, int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, int maxLevel, double levelScale, int sumTotal)
 {
-  smoo_additive_funct_nonConditional (level, position, nGramArray, sizeOf_nGramArray, sizeOf_N, sizeOf_alphabet, maxLevel, sumTotal, smoo_additive_vars.delta[arrayType_initialProb], smoo_additive_vars.levelAdjustFactor[arrayType_initialProb]);
+  smoo_additive_funct_nonConditional (level, position, nGramArray, sizeOf_nGramArray, sizeOf_N, sizeOf_alphabet, maxLevel, levelScale, sumTotal, smoo_additive_vars.delta[arrayType_initialProb], smoo_additive_vars.levelAdjustFactor[arrayType_initialProb]);
 }
 
 // wrapper for cP
-void smoo_additive_funct_cP (char *level, int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, char maxLevel, int sumTotal)
+void smoo_additive_funct_cP (int *level, int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, int maxLevel, double levelScale, int sumTotal)
 {
-  smoo_additive_funct_conditional (level, position, nGramArray, sizeOf_nGramArray, sizeOf_N, sizeOf_alphabet, maxLevel, smoo_additive_vars.delta[arrayType_conditionalProb], smoo_additive_vars.levelAdjustFactor[arrayType_conditionalProb]);
+  smoo_additive_funct_conditional (level, position, nGramArray, sizeOf_nGramArray, sizeOf_N, sizeOf_alphabet, maxLevel, levelScale, smoo_additive_vars.delta[arrayType_conditionalProb], smoo_additive_vars.levelAdjustFactor[arrayType_conditionalProb]);
 }
 
 // wrapper for eP
-void smoo_additive_funct_eP (char *level, int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, char maxLevel, int sumTotal)
+void smoo_additive_funct_eP (int *level, int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, int maxLevel, double levelScale, int sumTotal)
 {
-  smoo_additive_funct_nonConditional (level, position, nGramArray, sizeOf_nGramArray, sizeOf_N, sizeOf_alphabet, maxLevel, sumTotal, smoo_additive_vars.delta[arrayType_endProb], smoo_additive_vars.levelAdjustFactor[arrayType_endProb]);
+  smoo_additive_funct_nonConditional (level, position, nGramArray, sizeOf_nGramArray, sizeOf_N, sizeOf_alphabet, maxLevel, levelScale, sumTotal, smoo_additive_vars.delta[arrayType_endProb], smoo_additive_vars.levelAdjustFactor[arrayType_endProb]);
 }
 
 // wrapper for length
-void smoo_additive_funct_len (char *level, int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, char maxLevel, int sumTotal)
+void smoo_additive_funct_len (int *level, int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, int maxLevel, double levelScale, int sumTotal)
+{
+  smoo_additive_funct_nonConditional (level, position, nGramArray, sizeOf_nGramArray, sizeOf_N, sizeOf_alphabet, maxLevel, levelScale, sumTotal, smoo_additive_vars.delta[arrayType_length], smoo_additive_vars.levelAdjustFactor[arrayType_length]);
+}
+
+// wrapper for the probabilities of iP, cP, eP and length
+double smoo_additive_prob_iP (int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, int sumTotal)
+{
+  return smoo_additive_prob_nonConditional (position, nGramArray, sizeOf_alphabet, sumTotal, smoo_additive_vars.delta[arrayType_initialProb]);
+}
+
+double smoo_additive_prob_cP (int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, int sumTotal)
+{
+  return smoo_additive_prob_conditional (position, nGramArray, sizeOf_alphabet, smoo_additive_vars.delta[arrayType_conditionalProb]);
+}
+
+double smoo_additive_prob_eP (int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, int sumTotal)
+{
+  return smoo_additive_prob_nonConditional (position, nGramArray, sizeOf_alphabet, sumTotal, smoo_additive_vars.delta[arrayType_endProb]);
+}
+
+double smoo_additive_prob_len (int position, const int *nGramArray, int sizeOf_nGramArray, int sizeOf_N, int sizeOf_alphabet, int sumTotal)
 {
-  smoo_additive_funct_nonConditional (level, position, nGramArray, sizeOf_nGramArray, sizeOf_N, sizeOf_alphabet, maxLevel, sumTotal, smoo_additive_vars.delta[arrayType_length], smoo_additive_vars.levelAdjustFactor[arrayType_length]);
+  return smoo_additive_prob_nonConditional (position, nGramArray, sizeOf_alphabet, sumTotal, smoo_additive_vars.delta[arrayType_length]);
 }
 
 // (intern) evaluate input file and set values
@@ -172,6 +232,10 @@ void smoo_additive_apply (FILE * fp)
   smoo_selection.nG = &smoo_additive_funct_cP;
   smoo_selection.eP = &smoo_additive_funct_eP;
   smoo_selection.len = &smoo_additive_funct_len;
+  smoo_selection.iP_prob = &smoo_additive_prob_iP;
+  smoo_selection.nG_prob = &smoo_additive_prob_cP;
+  smoo_selection.eP_prob = &smoo_additive_prob_eP;
+  smoo_selection.len_prob = &smoo_additive_prob_len;
 
   smoo_selection.type = smooType_additive;
 
@@ -278,6 +342,10 @@ void smoo_initialize ()
   smoo_selection.nG = &smoo_additive_funct_cP;
   smoo_selection.eP = &smoo_additive_funct_eP;
   smoo_selection.len = &smoo_additive_funct_len;
+  smoo_selection.iP_prob = &smoo_additive_prob_iP;
+  smoo_selection.nG_prob = &smoo_additive_prob_cP;
+  smoo_selection.eP_prob = &smoo_additive_prob_eP;
+  smoo_selection.len_prob = &smoo_additive_prob_len;
   // and set all variables their default values
   smoo_additive_init ();
 }                               // smoo_initialize
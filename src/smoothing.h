@@ -21,6 +21,7 @@
  * and the following function (the names are arbitrary):
  *  - smoo_name_init()  -> initializes the corresponding struct with its default values
  *  - smoo_name_funct_Type() -> actual smoothing function (one for each arrayType)
+ *  - smoo_name_prob_Type()  -> smoothed probability without level adjustment (one for each arrayType)
  *  - smoo_name_read()  -> evaluates given file, adjust struct values and sets smoo_selection accordingly
  *  - smoo_name_print() -> prints the name of the smoothing and the current values
  * The smoo_name_funct must be have the following parameters:
@@ -29,6 +30,9 @@
  *                               const int *nGramArray, // target nGram array
  *                               int sizeOf_nGramArray, // size of the nGram array
  *                               int sizeOf_N,              // size of the nGram N
+ *                               int sizeOf_alphabet,       // size of the alphabet
+ *                               int maxLevel,              // max level (the level must be smaller)
+ *                               double levelScale,         // levels per unit of -ln(p)
  *                               int sumTotal,               // sum of all elements in nGram array
  * Any arrayType has his own smoothing function!
  *
@@ -46,11 +50,17 @@
  * The allowed tags should be added as commentary and added to the documentation!
  */
 
-/* smoothing caller function structer & parameters. void smoo_fct ( char* level, int position // level to be set and current position in given array const char* array, int size_array, // current array and its size int size_N, int size_alphabet, int maxLevel, // size of N and alphabet and the max level int totalSum) // sum of all elements in array (only needed for non condition probabilites) */
-#define SMOOTHING_CALLER(name) void (*name)(char *, int,       \
+/* smoothing caller function structer & parameters. void smoo_fct ( int* level, int position // level to be set and current position in given array const char* array, int size_array, // current array and its size int size_N, int size_alphabet, int maxLevel, // size of N and alphabet and the max level double levelScale, // levels per unit of -ln(p) (1.0 for the default level scale) int totalSum) // sum of all elements in array (only needed for non condition probabilites) */
+#define SMOOTHING_CALLER(name) void (*name)(int *, int,       \
                                             const int *, int, \
-                                            int, int, char,    \
-                                            int)
+                                            int, int, int,    \
+                                            double, int)
+
+/* smoothing probability function structure & parameters, returns the smoothed probability of the element at position double smoo_prob ( int position, // current position in given array const int* array, int size_array, // current array and its size int size_N, int size_alphabet, // size of N and alphabet int totalSum) // sum of all elements in array (only needed for non condition probabilites) */
+#define SMOOTHING_PROB_CALLER(name) double (*name)(int,        \
+                                                   const int *, int, \
+                                                   int, int,   \
+                                                   int)
 
 /*
  * enum used to identify the selected smoothing function
@@ -68,6 +78,10 @@ typedef struct smoo_selection_struct
   SMOOTHING_CALLER (eP);
   SMOOTHING_CALLER (nG);
   SMOOTHING_CALLER (len);
+  SMOOTHING_PROB_CALLER (iP_prob);
+  SMOOTHING_PROB_CALLER (eP_prob);
+  SMOOTHING_PROB_CALLER (nG_prob);
+  SMOOTHING_PROB_CALLER (len_prob);
 
   enum smooTypes type;
 } smoo_selection_struct;
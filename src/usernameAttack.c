@@ -0,0 +1,609 @@
+/*
+ * usernameAttack.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <pthread.h>
+
+#include "usernameAttack.h"
+#include "errorHandler.h"
+#include "levelChain.h"
+
+// flags of an (n-1)-gram position: its initialProb, endProb or any conditionalProb starting with it is boosted
+#define USER_BOOSTED_IP 1
+#define USER_BOOSTED_EP 2
+#define USER_BOOSTED_CP 4
+
+/*
+ * Single boosted entry of a user.
+ */
+typedef struct usernameAttack_boost
+{
+  int position;                 // position of the nGram
+  int level;                    // boosted level
+} usernameAttack_boost;
+
+/*
+ * Users handled by the threads at once.
+ */
+typedef struct usernameAttack_batch
+{
+  char lines[USERNAMEATTACK_BATCH_SIZE][MAX_LINE_LENGTH]; // username and password (separated by '\0')
+  int passwordStart[USERNAMEATTACK_BATCH_SIZE]; // index of the password in each line
+  uint64_t guessNumbers[USERNAMEATTACK_BATCH_SIZE]; // guess number of each user (0 if not guessed)
+  int count;                    // amount of users in the batch
+  int next;                     // index of the next user handed to a thread (accessed atomically)
+} usernameAttack_batch;
+
+/*
+ * State of a single thread, including the boosted entries and the target
+ * password of its current user.
+ */
+typedef struct usernameAttack_thread
+{
+  const usernameAttack_struct *attack;
+  usernameAttack_batch *batch;
+  pthread_t thread;
+
+  unsigned char *boostedFlags;  // USER_BOOSTED_* of each (n-1)-gram position (reset after each user)
+  usernameAttack_boost boostedIP[USERNAMEATTACK_MAX_BOOSTED]; // boosted entries (sorted by position)
+  int sizeOf_boostedIP;
+  usernameAttack_boost boostedCP[USERNAMEATTACK_MAX_BOOSTED];
+  int sizeOf_boostedCP;
+  usernameAttack_boost boostedEP[USERNAMEATTACK_MAX_BOOSTED];
+  int sizeOf_boostedEP;
+
+  int target[MAX_PASSWORD_LENGTH];  // password of the current user as positions in the alphabet
+  int targetIP;                 // position of its initialProb
+  int targetChain[MAX_PASSWORD_LENGTH + 1]; // its levelChain
+  uint64_t count;               // passwords counted for the current user
+  bool found;                   // TRUE, once the password of the current user has been counted
+  uint64_t attemptsCount;       // overall amount of passwords counted
+} usernameAttack_thread;
+
+// === boosting ===
+
+/* (intern function) Decreases the level of the entry at @position (with the level @level in the model) by @alpha, adding it to the @boosted entries if needed */
+void user_boostEntry (usernameAttack_boost * boosted, int *sizeOf_boosted, int position, int level, int alpha)
+{
+  for (int i = 0; i < *sizeOf_boosted; i++)
+  {
+    if (boosted[i].position == position)
+    {
+      boosted[i].level = (boosted[i].level > alpha) ? boosted[i].level - alpha : 0;
+      return;
+    }
+  }
+  if (*sizeOf_boosted == USERNAMEATTACK_MAX_BOOSTED)
+    return;
+  boosted[*sizeOf_boosted].position = position;
+  boosted[*sizeOf_boosted].level = (level > alpha) ? level - alpha : 0;
+  (*sizeOf_boosted)++;
+}                               // (intern) user_boostEntry
+
+/* (intern function) Boosts the nGrams of the given @hint like boost() does */
+void user_boostHint (usernameAttack_thread * thread, const char *hint, int length)
+{
+  const usernameAttack_struct *attack = thread->attack;
+  int sizeOf_N = attack->nGrams->sizeOf_N;
+  int sizeOf_alphabet = attack->alphabet->sizeOf_alphabet;
+  int position = 0;
+
+  // boost iP
+  if (get_positionFromNGram (&position, hint, sizeOf_N - 1, sizeOf_alphabet, attack->alphabet->alphabet))
+    user_boostEntry (thread->boostedIP, &(thread->sizeOf_boostedIP), position, attack->nGrams->iP[position], attack->alpha);
+  // boost eP
+  if (attack->boostEP && get_positionFromNGram (&position, hint + length - (sizeOf_N - 1), sizeOf_N - 1, sizeOf_alphabet, attack->alphabet->alphabet))
+    user_boostEntry (thread->boostedEP, &(thread->sizeOf_boostedEP), position, attack->nGrams->eP[position], attack->alpha);
+  // boost cPs
+  for (int i = 0; i + sizeOf_N <= length; i++)
+  {
+    if (get_positionFromNGram (&position, hint + i, sizeOf_N, sizeOf_alphabet, attack->alphabet->alphabet))
+      user_boostEntry (thread->boostedCP, &(thread->sizeOf_boostedCP), position, attack->nGrams->cP[position], attack->alpha);
+  }
+}                               // (intern) user_boostHint
+
+/* (intern function) Adds @hint (of @length) and its lowercased version to the @hints, unless it is too short or already known */
+void user_addHint (char hints[USERNAMEATTACK_MAX_HINTS][MAX_LINE_LENGTH], int *sizeOf_hints, const char *hint, int length, int lengthMin)
+{
+  char lowercase[MAX_LINE_LENGTH];
+
+  if (length < lengthMin || length >= MAX_LINE_LENGTH)
+    return;
+  for (int lower = 0; lower < 2; lower++)
+  {
+    if (*sizeOf_hints == USERNAMEATTACK_MAX_HINTS)
+      return;
+    for (int i = 0; i < length; i++)
+      lowercase[i] = lower ? tolower ((unsigned char) hint[i]) : hint[i];
+    lowercase[length] = '\0';
+    for (int i = 0; i < *sizeOf_hints && lowercase[0] != '\0'; i++)
+    {
+      if (strcmp (hints[i], lowercase) == 0)
+        lowercase[0] = '\0';    // already known
+    }
+    if (lowercase[0] != '\0')
+      strcpy (hints[(*sizeOf_hints)++], lowercase);
+  }
+}                               // (intern) user_addHint
+
+/* (intern function) Returns 0 for separators, 1 for letters and 2 for digits */
+int user_charClass (char c)
+{
+  if (isalpha ((unsigned char) c))
+    return 1;
+  if (isdigit ((unsigned char) c))
+    return 2;
+  return 0;
+}                               // (intern) user_charClass
+
+/* (intern function) Compares two boosted entries by position (used by qsort) */
+int user_compareBoost (const void *a, const void *b)
+{
+  return ((const usernameAttack_boost *) a)->position - ((const usernameAttack_boost *) b)->position;
+}                               // (intern) user_compareBoost
+
+/* (intern function) Boosts the hints derived from @username: the username (or the local part of an email address), its tokens separated by any other char than letters and digits and their letter and digit runs */
+void user_boostUsername (usernameAttack_thread * thread, const char *username)
+{
+  char hints[USERNAMEATTACK_MAX_HINTS][MAX_LINE_LENGTH];
+  int sizeOf_hints = 0;
+  int lengthMin = thread->attack->nGrams->sizeOf_N - 1;  // shorter hints have no initialProb
+  int sizeOf_alphabet = thread->attack->alphabet->sizeOf_alphabet;
+  int length = strlen (username);
+  const char *at = strrchr (username, '@');
+  int start = 0;
+
+  if (at != NULL)
+    length = at - username;
+  user_addHint (hints, &sizeOf_hints, username, length, lengthMin);
+  // tokens separated by any other char than letters and digits
+  for (int i = 0; i <= length; i++)
+  {
+    if (i == length || user_charClass (username[i]) == 0)
+    {
+      if (i - start < length)
+        user_addHint (hints, &sizeOf_hints, username + start, i - start, lengthMin);
+      start = i + 1;
+    }
+  }
+  // runs of letters or digits
+  start = 0;
+  for (int i = 1; i <= length; i++)
+  {
+    if (i == length || user_charClass (username[i]) != user_charClass (username[start]))
+    {
+      if (user_charClass (username[start]) != 0 && i - start < length)
+        user_addHint (hints, &sizeOf_hints, username + start, i - start, lengthMin);
+      start = i;
+    }
+  }
+
+  for (int i = 0; i < sizeOf_hints; i++)
+    user_boostHint (thread, hints[i], strlen (hints[i]));
+
+  // sort the boosted entries and flag their (n-1)-gram positions
+  qsort (thread->boostedIP, thread->sizeOf_boostedIP, sizeof (usernameAttack_boost), user_compareBoost);
+  qsort (thread->boostedCP, thread->sizeOf_boostedCP, sizeof (usernameAttack_boost), user_compareBoost);
+  qsort (thread->boostedEP, thread->sizeOf_boostedEP, sizeof (usernameAttack_boost), user_compareBoost);
+  for (int i = 0; i < thread->sizeOf_boostedIP; i++)
+    thread->boostedFlags[thread->boostedIP[i].position] |= USER_BOOSTED_IP;
+  for (int i = 0; i < thread->sizeOf_boostedEP; i++)
+    thread->boostedFlags[thread->boostedEP[i].position] |= USER_BOOSTED_EP;
+  for (int i = 0; i < thread->sizeOf_boostedCP; i++)
+    thread->boostedFlags[thread->boostedCP[i].position / sizeOf_alphabet] |= USER_BOOSTED_CP;
+}                               // (intern) user_boostUsername
+
+/* (intern function) Removes all boosted entries of the current user */
+void user_resetBoost (usernameAttack_thread * thread)
+{
+  int sizeOf_alphabet = thread->attack->alphabet->sizeOf_alphabet;
+
+  for (int i = 0; i < thread->sizeOf_boostedIP; i++)
+    thread->boostedFlags[thread->boostedIP[i].position] = 0;
+  for (int i = 0; i < thread->sizeOf_boostedEP; i++)
+    thread->boostedFlags[thread->boostedEP[i].position] = 0;
+  for (int i = 0; i < thread->sizeOf_boostedCP; i++)
+    thread->boostedFlags[thread->boostedCP[i].position / sizeOf_alphabet] = 0;
+  thread->sizeOf_boostedIP = 0;
+  thread->sizeOf_boostedCP = 0;
+  thread->sizeOf_boostedEP = 0;
+}                               // (intern) user_resetBoost
+
+/* (intern function) Returns the level of the entry at @position: its boosted level if it is one of the @boosted entries, else @level */
+int user_boostedLevel (const usernameAttack_boost * boosted, int sizeOf_boosted, int position, int level)
+{
+  int low = 0;
+  int high = sizeOf_boosted - 1;
+  int middle = 0;
+
+  while (low <= high)
+  {
+    middle = (low + high) / 2;
+    if (boosted[middle].position == position)
+      return boosted[middle].level;
+    if (boosted[middle].position < position)
+      low = middle + 1;
+    else
+      high = middle - 1;
+  }
+  return level;
+}                               // (intern) user_boostedLevel
+
+/* (intern function) Returns the level of the conditionalProb at @position for the current user, limited to maxLevel - 1 like struct_sortedLastGram_fill does */
+int user_levelCP (const usernameAttack_thread * thread, int position)
+{
+  const usernameAttack_struct *attack = thread->attack;
+  int level = attack->nGrams->cP[position];
+
+  if (thread->boostedFlags[position / attack->alphabet->sizeOf_alphabet] & USER_BOOSTED_CP)
+    level = user_boostedLevel (thread->boostedCP, thread->sizeOf_boostedCP, position, level);
+  return (level > attack->maxLevel - 1) ? attack->maxLevel - 1 : level;
+}                               // (intern) user_levelCP
+
+/* (intern function) Returns the level of the endProb at @position for the current user */
+int user_levelEP (const usernameAttack_thread * thread, int position)
+{
+  int level = thread->attack->nGrams->eP[position];
+
+  if (thread->boostedFlags[position] & USER_BOOSTED_EP)
+    level = user_boostedLevel (thread->boostedEP, thread->sizeOf_boostedEP, position, level);
+  return level;
+}                               // (intern) user_levelEP
+
+// === counting ===
+
+/* (intern function) Counts the passwords enumerate_password_recursivly (see enumNG) creates below the prefix of length @lengthCur, whose last (n-1) chars are at @position. If @onTarget, the prefix is a prefix of the target password, which stops the counting. Returns FALSE once the target password has been counted or the maximal attempts are reached. */
+bool user_countSubtree (usernameAttack_thread * thread, const int levelChain[MAX_PASSWORD_LENGTH + 1], int lengthCur, int lengthMax, int position, bool onTarget)
+{
+  const usernameAttack_struct *attack = thread->attack;
+  const sortedLastGram_struct *sorted = NULL;
+  int sizeOf_alphabet = attack->alphabet->sizeOf_alphabet;
+  int level = levelChain[lengthCur - (attack->nGrams->sizeOf_N - 2)];
+  int positionNext = (position % (attack->nGrams->sizeOf_iP / sizeOf_alphabet)) * sizeOf_alphabet;
+  int lastGram = 0;
+
+  // length of new PW equals max length
+  if (lengthCur == lengthMax)
+  {
+    // check if the level match the endProb
+    if (!attack->ignoreEP && level != user_levelEP (thread, position))
+      return true;
+    thread->count++;
+    if (onTarget)
+    {
+      thread->found = true;
+      return false;
+    }
+    return thread->count < attack->attemptsMax;
+  }
+
+  if (thread->boostedFlags[position] & USER_BOOSTED_CP)
+  {
+    // some lastGrams moved to another level: check each lastGram (ascending, like the sorted arrays)
+    for (lastGram = 0; lastGram < sizeOf_alphabet; lastGram++)
+    {
+      if (user_levelCP (thread, position * sizeOf_alphabet + lastGram) != level)
+        continue;
+      if (!user_countSubtree (thread, levelChain, lengthCur + 1, lengthMax, positionNext + lastGram, onTarget && lastGram == thread->target[lengthCur]))
+        return false;
+    }
+    return true;
+  }
+
+  // for each lastGram with current @level and @position
+  sorted = attack->sortedLastGram + level;
+  for (int i = sorted->indexStart[position]; i < sorted->indexStart[position + 1]; i++)
+  {
+    lastGram = sorted->lastGrams[i];
+    if (!user_countSubtree (thread, levelChain, lengthCur + 1, lengthMax, positionNext + lastGram, onTarget && lastGram == thread->target[lengthCur]))
+      return false;
+  }
+  return true;
+}                               // (intern) user_countSubtree
+
+/* (intern function) Counts the passwords of the given @levelChain like enumerate_password (see enumNG) creates them. The boosted initialProbs are merged into the initialProbs of their new level. Returns FALSE once the target password has been counted or the maximal attempts are reached. */
+bool user_countChain (usernameAttack_thread * thread, const int levelChain[MAX_PASSWORD_LENGTH + 1], int lengthPW, bool onTarget)
+{
+  const usernameAttack_struct *attack = thread->attack;
+  const sortedIP_struct *sorted = attack->sortedIP + levelChain[0];
+  int lengthCur = attack->nGrams->sizeOf_N - 1;
+  const usernameAttack_boost *boosted = NULL;
+  int boostedNext = 0;          // next boosted initialProb
+  int position = 0;
+
+  for (int i = 0; i <= sorted->indexCur; i++)
+  {
+    position = (i < sorted->indexCur) ? sorted->iP[i] : attack->nGrams->sizeOf_iP;
+    // boosted initialProbs with this level in front of @position
+    while (boostedNext < thread->sizeOf_boostedIP && thread->boostedIP[boostedNext].position < position)
+    {
+      boosted = thread->boostedIP + boostedNext;
+      boostedNext++;
+      if (((boosted->level > attack->maxLevel - 1) ? attack->maxLevel - 1 : boosted->level) != levelChain[0])
+        continue;
+      if (!user_countSubtree (thread, levelChain, lengthCur, lengthPW, boosted->position, onTarget && boosted->position == thread->targetIP))
+        return false;
+    }
+    // boosted initialProbs are counted at their new level only
+    if (i == sorted->indexCur || (thread->boostedFlags[position] & USER_BOOSTED_IP))
+      continue;
+    if (!user_countSubtree (thread, levelChain, lengthCur, lengthPW, position, onTarget && position == thread->targetIP))
+      return false;
+  }
+  return true;
+}                               // (intern) user_countChain
+
+/* (intern function) Counts the passwords with a length of @lengthPW and the @level (without the level of the length) like enumerate_level (see enumNG). If @targetStep, the target password has this length and level. Returns FALSE once the target password has been counted or the maximal attempts are reached. */
+bool user_countLevel (usernameAttack_thread * thread, int lengthLC, int lengthPW, int level, bool targetStep)
+{
+  int levelChain[MAX_PASSWORD_LENGTH + 1];
+  bool newChain = true;
+
+  memset (levelChain, 0, sizeof (levelChain));
+  while (levelChain_getNext (levelChain, lengthLC, level, thread->attack->maxLevel, newChain))
+  {
+    newChain = false;
+    if (!user_countChain (thread, levelChain, lengthPW, targetStep && memcmp (levelChain, thread->targetChain, lengthLC * sizeof (int)) == 0))
+      return false;
+  }
+  return true;
+}                               // (intern) user_countLevel
+
+/* (intern function) Sets the target password of the current user and its levelChain. Returns the level of the password (without the level of the length) or -1 if it is never created. */
+int user_setTarget (usernameAttack_thread * thread, const char *password)
+{
+  const usernameAttack_struct *attack = thread->attack;
+  int sizeOf_N = attack->nGrams->sizeOf_N;
+  int sizeOf_alphabet = attack->alphabet->sizeOf_alphabet;
+  int length = strlen (password);
+  int position = 0;
+  int level = 0;
+  int sum = 0;
+
+  if (length < sizeOf_N || length >= MAX_PASSWORD_LENGTH || (attack->fixedLength != 0 && length != attack->fixedLength))
+    return -1;
+  for (int i = 0; i < length; i++)
+  {
+    if (!get_positionInAlphabet (thread->target + i, password[i], attack->alphabet->alphabet, sizeOf_alphabet))
+      return -1;
+  }
+
+  // initialProb
+  get_positionFromNGramAsInt (&(thread->targetIP), thread->target, sizeOf_N - 1, sizeOf_alphabet);
+  level = user_boostedLevel (thread->boostedIP, thread->sizeOf_boostedIP, thread->targetIP, attack->nGrams->iP[thread->targetIP]);
+  thread->targetChain[0] = (level > attack->maxLevel - 1) ? attack->maxLevel - 1 : level;
+  sum = thread->targetChain[0];
+  // conditionalProbs
+  for (int i = sizeOf_N - 1; i < length; i++)
+  {
+    get_positionFromNGramAsInt (&position, thread->target + i - (sizeOf_N - 1), sizeOf_N, sizeOf_alphabet);
+    thread->targetChain[i - (sizeOf_N - 2)] = user_levelCP (thread, position);
+    sum += thread->targetChain[i - (sizeOf_N - 2)];
+  }
+  // endProb (an endProb above the levelChains is never matched)
+  if (!attack->ignoreEP)
+  {
+    get_positionFromNGramAsInt (&position, thread->target + length - (sizeOf_N - 1), sizeOf_N - 1, sizeOf_alphabet);
+    level = user_levelEP (thread, position);
+    if (level > attack->maxLevel - 1)
+      return -1;
+    thread->targetChain[length - (sizeOf_N - 2)] = level;
+    sum += level;
+  }
+  return sum;
+}                               // (intern) user_setTarget
+
+/* (intern function) Returns the guess number of the given user (0 if not guessed within the maximal attempts) */
+uint64_t user_guessNumber (usernameAttack_thread * thread, const char *username, const char *password)
+{
+  const usernameAttack_struct *attack = thread->attack;
+  int lengthLCModifier = (attack->ignoreEP ? 2 : 3) - attack->nGrams->sizeOf_N;
+  int lengthPW = strlen (password);
+  int level = 0;
+  int levelOverall = 0;
+  int lengthIndex = 0;
+  bool running = true;
+
+  thread->count = 0;
+  thread->found = false;
+  user_boostUsername (thread, username);
+  level = user_setTarget (thread, password);
+
+  if (level < 0)
+    running = false;
+  else if (attack->fixedLength != 0)
+  {
+    // each level of the fixed length up to the level of the password
+    for (int i = 0; i <= level && running; i++)
+      running = user_countLevel (thread, lengthPW + lengthLCModifier, lengthPW, i, i == level);
+  }
+  else
+  {
+    // each overall level up to the one of the password, the lengths of each level ordered like run_enumeration
+    for (int i = 0; i < MAX_PASSWORD_LENGTH - attack->sortedLength->lengthMin; i++)
+    {
+      if (attack->sortedLength->length[i] == lengthPW)
+        levelOverall = level + attack->sortedLength->level[i];
+    }
+    for (int i = 0; i <= levelOverall && running; i++)
+    {
+      lengthIndex = struct_sortedLength_getMaxIndexForLevel (attack->sortedLength, i);
+      for (int j = 0; j < lengthIndex && running; j++)
+        running = user_countLevel (thread, attack->sortedLength->length[j] + lengthLCModifier, attack->sortedLength->length[j], i - attack->sortedLength->level[j], attack->sortedLength->length[j] == lengthPW && i == levelOverall);
+    }
+  }
+
+  user_resetBoost (thread);
+  thread->attemptsCount += thread->count;
+  return thread->found ? thread->count : 0;
+}                               // (intern) user_guessNumber
+
+// === threads ===
+
+/* (intern function) main function of each thread: handles the users of its batch until all are done */
+void *user_runThread (void *arg)
+{
+  usernameAttack_thread *thread = (usernameAttack_thread *) arg;
+  usernameAttack_batch *batch = thread->batch;
+  int index = 0;
+
+  while ((index = __atomic_fetch_add (&(batch->next), 1, __ATOMIC_RELAXED)) < batch->count)
+    batch->guessNumbers[index] = user_guessNumber (thread, batch->lines[index], batch->lines[index] + batch->passwordStart[index]);
+  return NULL;
+}                               // (intern) user_runThread
+
+/* (intern function) Reads the next line of @fp into the batch. Returns FALSE at the end of the file. */
+bool user_readLine (usernameAttack_struct * attack, usernameAttack_batch * batch, FILE * fp)
+{
+  char *line = batch->lines[batch->count];
+  size_t length = 0;
+  size_t separator = 0;
+  int c = 0;
+
+  if (fgets (line, MAX_LINE_LENGTH, fp) == NULL)
+    return false;
+  length = strlen (line);
+  if (length > 0 && line[length - 1] != '\n' && !feof (fp))
+  {
+    // too long: skip the rest of the line
+    while ((c = fgetc (fp)) != EOF && c != '\n');
+    attack->ignoredCount++;
+    return true;
+  }
+  while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+    line[--length] = '\0';
+  separator = strcspn (line, " \t");
+  if (length == 0 || separator == 0 || separator + 1 >= length)
+  {
+    // no username or password
+    attack->ignoredCount++;
+    return true;
+  }
+  line[separator] = '\0';
+  batch->passwordStart[batch->count] = separator + 1;
+  batch->count++;
+  return true;
+}                               // (intern) user_readLine
+
+// initializes the username mode
+void usernameAttack_initialize (usernameAttack_struct ** attack, const nGram_struct * nGrams, const alphabet_struct * alphabet, const sortedLastGram_struct * sortedLastGram, const sortedIP_struct * sortedIP, sortedLength_struct * sortedLength, int maxLevel, int alpha, bool boostEP, bool ignoreEP, int fixedLength, uint64_t attemptsMax, int threads)
+{
+  (*attack) = (usernameAttack_struct *) calloc (1, sizeof (usernameAttack_struct));
+  EXIT_IF_NULL ((*attack));
+  (*attack)->nGrams = nGrams;
+  (*attack)->alphabet = alphabet;
+  (*attack)->sortedLastGram = sortedLastGram;
+  (*attack)->sortedIP = sortedIP;
+  (*attack)->sortedLength = sortedLength;
+  (*attack)->maxLevel = maxLevel;
+  (*attack)->alpha = alpha;
+  (*attack)->boostEP = boostEP;
+  (*attack)->ignoreEP = ignoreEP;
+  (*attack)->fixedLength = fixedLength;
+  (*attack)->attemptsMax = attemptsMax;
+  (*attack)->sizeOf_threads = threads;
+}                               // usernameAttack_initialize
+
+// handles all users of the file
+bool usernameAttack_run (usernameAttack_struct * attack, const char *filename, FILE * fp)
+{
+  FILE *fpUsers = NULL;
+  usernameAttack_batch *batch = NULL;
+  usernameAttack_thread *threads = NULL;
+  bool reading = true;
+  uint64_t limit = 1;
+
+  if (!open_file (&fpUsers, filename, NULL, "r"))
+  {
+    errorHandler_print (errorType_Error, "Could not open file (%s)\n", filename);
+    return false;
+  }
+  batch = (usernameAttack_batch *) malloc (sizeof (usernameAttack_batch));
+  EXIT_IF_NULL (batch);
+  threads = (usernameAttack_thread *) calloc (attack->sizeOf_threads, sizeof (usernameAttack_thread));
+  EXIT_IF_NULL (threads);
+  for (int i = 0; i < attack->sizeOf_threads; i++)
+  {
+    threads[i].attack = attack;
+    threads[i].batch = batch;
+    threads[i].boostedFlags = (unsigned char *) calloc (attack->nGrams->sizeOf_iP, sizeof (unsigned char));
+    EXIT_IF_NULL (threads[i].boostedFlags);
+  }
+
+  while (reading)
+  {
+    // read the next batch
+    batch->count = 0;
+    batch->next = 0;
+    while (batch->count < USERNAMEATTACK_BATCH_SIZE && (reading = user_readLine (attack, batch, fpUsers)));
+    if (batch->count == 0)
+      break;
+
+    // hand it to the threads
+    for (int i = 0; i < attack->sizeOf_threads; i++)
+    {
+      if (pthread_create (&(threads[i].thread), NULL, user_runThread, threads + i) != 0)
+      {
+        errorHandler_print (errorType_Error, "Unable to start the threads of the username mode\n");
+        exit (EXIT_FAILURE);
+      }
+    }
+    for (int i = 0; i < attack->sizeOf_threads; i++)
+      pthread_join (threads[i].thread, NULL);
+
+    // write the guess numbers (in the order of the file)
+    for (int i = 0; i < batch->count; i++)
+    {
+      fprintf (fp, "%s\t%" PRIu64 "\n", batch->lines[i], batch->guessNumbers[i]);
+      attack->userCount++;
+      if (batch->guessNumbers[i] == 0)
+        continue;
+      attack->guessedCount++;
+      limit = 1;
+      for (int j = 0; j < USERNAMEATTACK_MAX_POWER; j++, limit *= 10)
+      {
+        if (batch->guessNumbers[i] <= limit)
+          attack->guessedWithin[j]++;
+      }
+    }
+  }
+
+  for (int i = 0; i < attack->sizeOf_threads; i++)
+  {
+    attack->attemptsCount += threads[i].attemptsCount;
+    free (threads[i].boostedFlags);
+  }
+  free (threads);
+  free (batch);
+  fclose (fpUsers);
+  return true;
+}                               // usernameAttack_run
+
+// prints the results
+void usernameAttack_printResults (const usernameAttack_struct * attack, FILE * fp)
+{
+  uint64_t limit = 1;
+
+  fprintf (fp, "username mode: %" PRIu64 " of %" PRIu64 " users guessed within %" PRIu64 " guesses", attack->guessedCount, attack->userCount, attack->attemptsMax);
+  if (attack->ignoredCount > 0)
+    fprintf (fp, " (%" PRIu64 " lines ignored)", attack->ignoredCount);
+  fprintf (fp, "\n\nguessed users (guesses - users)\n");
+  for (int i = 0; i < USERNAMEATTACK_MAX_POWER && limit <= attack->attemptsMax; i++, limit *= 10)
+    fprintf (fp, "%16" PRIu64 " - %9" PRIu64 "\n", limit, attack->guessedWithin[i]);
+}                               // usernameAttack_printResults
+
+// frees the username mode
+void usernameAttack_free (usernameAttack_struct ** attack)
+{
+  if (*attack == NULL)
+    return;
+  free (*attack);
+  (*attack) = NULL;
+}                               // usernameAttack_free
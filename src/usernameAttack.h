@@ -0,0 +1,104 @@
+/*
+ * usernameAttack.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Username mode of enumNG (-u): targeted online guessing against the users
+ * of a file with a single "username password" per line. The hints of each
+ * user are derived from the username (the username itself, the local part
+ * of an email address and its letter and digit runs, each also lowercased)
+ * and boosted like boost() does (-a and -H), i.e. the level of each of
+ * their nGrams is decreased by alpha. The guess number of the password is
+ * the amount of passwords enumNG would create with the boosted model up to
+ * and including the password (default or fixed length order, at most
+ * --maxattempts).
+ *
+ * Instead of boosting and sorting the whole model for each user (like the
+ * boosting mode does), the boosted entries of a user are kept in small
+ * sorted lists on top of the shared sorted arrays, which are never changed.
+ * The passwords are counted instead of being created: only the levelChains
+ * up to the level of the password are visited, the search stops at the
+ * password itself. This way, the users are handled independently by a pool
+ * of threads, in batches of USERNAMEATTACK_BATCH_SIZE users.
+ *
+ */
+
+#ifndef USERNAMEATTACK_H_
+#define USERNAMEATTACK_H_
+
+#include <stdint.h>
+
+#include "common.h"
+
+// === Defines ===
+#define USERNAMEATTACK_BATCH_SIZE 4096  // users handled by the threads at once
+#define USERNAMEATTACK_MAX_HINTS 16 // hints derived from a single username
+#define USERNAMEATTACK_MAX_BOOSTED 512  // boosted entries of a single user (any further nGram is not boosted)
+#define USERNAMEATTACK_MAX_THREADS 256
+#define USERNAMEATTACK_MAX_POWER 16 // guess numbers are counted up to 10^(USERNAMEATTACK_MAX_POWER - 1)
+
+/*
+ * Settings and results of the username mode. The model and the sorted
+ * arrays are shared by all threads and only read.
+ */
+typedef struct usernameAttack_struct
+{
+  const nGram_struct *nGrams;   // levels of the model
+  const alphabet_struct *alphabet;
+  const sortedLastGram_struct *sortedLastGram;
+  const sortedIP_struct *sortedIP;
+  sortedLength_struct *sortedLength;
+  int maxLevel;
+  int alpha;                    // level decrease per hint
+  bool boostEP;                 // TRUE, if the endProbs are boosted as well
+  bool ignoreEP;                // TRUE, if the endProbs are not used
+  int fixedLength;              // if != 0, only passwords of this length are created
+  uint64_t attemptsMax;         // maximal guess number
+  int sizeOf_threads;
+
+  uint64_t userCount;           // amount of users read
+  uint64_t ignoredCount;        // amount of lines without a password
+  uint64_t guessedCount;        // amount of users whose password has been guessed
+  uint64_t guessedWithin[USERNAMEATTACK_MAX_POWER]; // amount of users guessed within 10^i guesses
+  uint64_t attemptsCount;       // overall amount of guesses
+} usernameAttack_struct;
+
+/*
+ * Initializes the username mode based on the given model and its sorted
+ * arrays (see enumNG), using @threads threads.
+ */
+void usernameAttack_initialize (usernameAttack_struct ** attack, // username mode to be initialized
+                                const nGram_struct * nGrams,  // model
+                                const alphabet_struct * alphabet, // alphabet of the model
+                                const sortedLastGram_struct * sortedLastGram, // lastGrams sorted by level
+                                const sortedIP_struct * sortedIP, // initialProbs sorted by level
+                                sortedLength_struct * sortedLength, // lengths sorted by level
+                                int maxLevel, // amount of levels
+                                int alpha,  // level decrease per hint
+                                bool boostEP, // boost the endProbs
+                                bool ignoreEP,  // endProbs are not used
+                                int fixedLength,  // fixed length (0 if disabled)
+                                uint64_t attemptsMax, // maximal guess number
+                                int threads); // amount of threads
+
+/*
+ * Reads the users of @filename ("username password", separated by the
+ * first space or tab) and writes "username<TAB>guess number" for each of
+ * them to @fp (in the order of the file), with a guess number of 0 if the
+ * password is not guessed within the maximal attempts.
+ * Returns FALSE if the file can't be read.
+ */
+bool usernameAttack_run (usernameAttack_struct * attack, const char *filename, FILE * fp);
+
+/*
+ * Prints the amount of users and the amount of users guessed within each
+ * power of ten to the given file pointer @fp.
+ */
+void usernameAttack_printResults (const usernameAttack_struct * attack, FILE * fp);
+
+/*
+ * Frees the given username mode (if not NULL).
+ */
+void usernameAttack_free (usernameAttack_struct ** attack);
+
+#endif /* USERNAMEATTACK_H_ */
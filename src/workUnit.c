@@ -0,0 +1,227 @@
+/*
+ * workUnit.c
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "errorHandler.h"
+#include "workUnit.h"
+
+/* (intern function) Fills @unixAddress if the given @address is a Unix domain socket ("unix:PATH"). Returns FALSE (printing an error) if the path is too long. */
+bool work_unixAddress (const char *address, struct sockaddr_un *unixAddress)
+{
+  const char *path = address + strlen ("unix:");
+
+  memset (unixAddress, 0, sizeof (struct sockaddr_un));
+  unixAddress->sun_family = AF_UNIX;
+  if (strlen (path) == 0 || strlen (path) >= sizeof (unixAddress->sun_path))
+  {
+    errorHandler_print (errorType_Error, "Invalid socket filename (%s, at most %zu chars).\n", path, sizeof (unixAddress->sun_path) - 1);
+    return false;
+  }
+  strcpy (unixAddress->sun_path, path);
+  return true;
+}                               // (intern) work_unixAddress
+
+/* (intern function) Resolves the TCP @address ("HOST:PORT") into @addresses (freed by freeaddrinfo), for listening if @passive is TRUE. Returns FALSE (printing an error) if the address is invalid. */
+bool work_tcpAddress (const char *address, bool passive, struct addrinfo **addresses)
+{
+  char host[WORKUNIT_SIZEOF_LINE];
+  const char *port = strrchr (address, ':');
+  struct addrinfo hints;
+  int result = 0;
+
+  if (port == NULL || port == address || port - address >= WORKUNIT_SIZEOF_LINE || port[1] == '\0')
+  {
+    errorHandler_print (errorType_Error, "Invalid address %s (expected unix:PATH or HOST:PORT).\n", address);
+    return false;
+  }
+  memcpy (host, address, port - address);
+  host[port - address] = '\0';
+
+  memset (&hints, 0, sizeof (hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  if (passive)
+    hints.ai_flags = AI_PASSIVE;
+  result = getaddrinfo (host, port + 1, &hints, addresses);
+  if (result != 0)
+  {
+    errorHandler_print (errorType_Error, "Unable to resolve the address %s: %s\n", address, gai_strerror (result));
+    return false;
+  }
+  return true;
+}                               // (intern) work_tcpAddress
+
+// creates the listening socket
+int workUnit_listen (const char *address)
+{
+  int fd = -1;
+
+  if (strncmp (address, "unix:", strlen ("unix:")) == 0)
+  {
+    struct sockaddr_un unixAddress;
+    struct stat fileStat;
+
+    if (!work_unixAddress (address, &unixAddress))
+      return -1;
+    // remove a socket left over by a previous coordinator (but never any other file)
+    if (stat (unixAddress.sun_path, &fileStat) == 0 && S_ISSOCK (fileStat.st_mode))
+      unlink (unixAddress.sun_path);
+    fd = socket (AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && (bind (fd, (struct sockaddr *) &unixAddress, sizeof (unixAddress)) != 0 || listen (fd, SOMAXCONN) != 0))
+    {
+      close (fd);
+      fd = -1;
+    }
+  }
+  else
+  {
+    struct addrinfo *addresses = NULL;
+    int reuse = 1;
+
+    if (!work_tcpAddress (address, true, &addresses))
+      return -1;
+    for (struct addrinfo * cur = addresses; cur != NULL && fd < 0; cur = cur->ai_next)
+    {
+      fd = socket (cur->ai_family, cur->ai_socktype, cur->ai_protocol);
+      if (fd < 0)
+        continue;
+      setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof (reuse));
+      if (bind (fd, cur->ai_addr, cur->ai_addrlen) != 0 || listen (fd, SOMAXCONN) != 0)
+      {
+        close (fd);
+        fd = -1;
+      }
+    }
+    freeaddrinfo (addresses);
+  }
+
+  if (fd < 0)
+    errorHandler_print (errorType_Error, "Unable to listen on %s: %s\n", address, strerror (errno));
+  return fd;
+}                               // workUnit_listen
+
+// connects to the coordinator
+int workUnit_connect (const char *address)
+{
+  int fd = -1;
+
+  if (strncmp (address, "unix:", strlen ("unix:")) == 0)
+  {
+    struct sockaddr_un unixAddress;
+
+    if (!work_unixAddress (address, &unixAddress))
+      return -1;
+    fd = socket (AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect (fd, (struct sockaddr *) &unixAddress, sizeof (unixAddress)) != 0)
+    {
+      close (fd);
+      fd = -1;
+    }
+  }
+  else
+  {
+    struct addrinfo *addresses = NULL;
+
+    if (!work_tcpAddress (address, false, &addresses))
+      return -1;
+    for (struct addrinfo * cur = addresses; cur != NULL && fd < 0; cur = cur->ai_next)
+    {
+      fd = socket (cur->ai_family, cur->ai_socktype, cur->ai_protocol);
+      if (fd >= 0 && connect (fd, cur->ai_addr, cur->ai_addrlen) != 0)
+      {
+        close (fd);
+        fd = -1;
+      }
+    }
+    freeaddrinfo (addresses);
+  }
+
+  if (fd < 0)
+    errorHandler_print (errorType_Error, "Unable to connect to the coordinator %s: %s\n", address, strerror (errno));
+  return fd;
+}                               // workUnit_connect
+
+// reads the next line of the connection
+int workUnit_readLine (workUnit_reader * reader, char line[WORKUNIT_SIZEOF_LINE], bool wait)
+{
+  while (true)
+  {
+    char *lineEnd = memchr (reader->buffer, '\n', reader->sizeOf_buffer);
+    struct pollfd readable = { reader->fd, POLLIN, 0 };
+    ssize_t result = 0;
+
+    if (lineEnd != NULL)
+    {
+      size_t length = (size_t) (lineEnd - reader->buffer);
+
+      memcpy (line, reader->buffer, length);
+      line[length] = '\0';
+      memmove (reader->buffer, lineEnd + 1, reader->sizeOf_buffer - length - 1);
+      reader->sizeOf_buffer -= length + 1;
+      return 1;
+    }
+    if (reader->sizeOf_buffer == WORKUNIT_SIZEOF_LINE)
+      return -1;
+    if (!wait && poll (&readable, 1, 0) <= 0)
+      return 0;
+    result = recv (reader->fd, reader->buffer + reader->sizeOf_buffer, WORKUNIT_SIZEOF_LINE - reader->sizeOf_buffer, 0);
+    if (result < 0 && errno == EINTR)
+      continue;
+    if (result <= 0)
+      return -1;
+    reader->sizeOf_buffer += (size_t) result;
+  }
+}                               // workUnit_readLine
+
+// writes the UNIT line
+void workUnit_format (const workUnit_struct * unit, char line[WORKUNIT_SIZEOF_LINE])
+{
+  int used = snprintf (line, WORKUNIT_SIZEOF_LINE, "UNIT %" PRIu64 " %i %i %" PRIu64 " %" PRIu64 " %i %i %i %i %i", unit->id, unit->levelOverall, unit->lengthIndex, unit->chainIndex, unit->chainCount, unit->lengthPW, unit->lengthLC, unit->depth, unit->start, unit->end);
+
+  for (int i = 0; i < unit->lengthLC; i++)
+    used += snprintf (line + used, WORKUNIT_SIZEOF_LINE - used, " %i", unit->levelChain[i]);
+  for (int i = 0; i < unit->depth; i++)
+    used += snprintf (line + used, WORKUNIT_SIZEOF_LINE - used, " %i", unit->path[i]);
+  snprintf (line + used, WORKUNIT_SIZEOF_LINE - used, " %" PRIu64 "\n", unit->budget);
+}                               // workUnit_format
+
+// reads a UNIT line
+bool workUnit_parse (const char *line, workUnit_struct * unit)
+{
+  int read = 0;
+  int used = 0;
+
+  if (sscanf (line, "UNIT %" SCNu64 " %d %d %" SCNu64 " %" SCNu64 " %d %d %d %d %d%n", &(unit->id), &(unit->levelOverall), &(unit->lengthIndex), &(unit->chainIndex), &(unit->chainCount), &(unit->lengthPW), &(unit->lengthLC), &(unit->depth), &(unit->start), &(unit->end), &read) != 10)
+    return false;
+  if (unit->lengthPW < 1 || unit->lengthPW >= MAX_PASSWORD_LENGTH || unit->lengthLC < 1 || unit->lengthLC > MAX_PASSWORD_LENGTH || unit->depth < 0 || unit->depth >= MAX_PASSWORD_LENGTH || unit->chainCount < 1 || (unit->depth > 0 && unit->chainCount != 1) || unit->start < 0 || unit->end < unit->start)
+    return false;
+  for (int i = 0; i < unit->lengthLC + unit->depth; i++)
+  {
+    int *value = (i < unit->lengthLC) ? unit->levelChain + i : unit->path + (i - unit->lengthLC);
+
+    line += read;
+    if (sscanf (line, " %d%n", value, &used) != 1 || *value < 0)
+      return false;
+    read = used;
+  }
+  // sent by newer coordinators only
+  if (sscanf (line + read, " %" SCNu64, &(unit->budget)) != 1)
+    unit->budget = 0;
+  return true;
+}                               // workUnit_parse
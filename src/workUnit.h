@@ -0,0 +1,132 @@
+/*
+ * workUnit.h
+ * @authors: Fabian Angelstorf, Franziska Juckel
+ * @copyright: Horst Goertz Institute for IT-Security, Ruhr-University Bochum
+ *
+ * Work units handed out by omenCoord to the workers (enumNG --worker) and
+ * the connection between both. A work unit is a run of consecutive
+ * levelChains (in the order of levelChain_getNext) of a single length and
+ * level, identified by the overall level, the index of the length (in the
+ * sorted lengths) and the index of its first levelChain. Only a part of the
+ * subtree of the first levelChain is part of the unit, given by a path of
+ * @depth fixed indices followed by a range of indices at @depth: depth 0
+ * are the initialProbs (indices in the initialProbs of the first level of
+ * the levelChain, sorted like enumNG does), depth d > 0 the lastGrams
+ * appended to a prefix of (n - 2 + d) chars (indices in the bucket of the
+ * sorted lastGrams of the prefix). The following levelChains (only if
+ * @depth is 0) are enumerated completely. The first levelChain itself is
+ * part of the unit, so a worker doesn't need to create the levelChains
+ * before it.
+ *
+ * Address of the coordinator: "unix:PATH" (Unix domain socket) or
+ * "HOST:PORT" (TCP, e.g. localhost:7474).
+ *
+ * Protocol (lines of text):
+ *  - worker: "GET" requests the next unit
+ *  - coordinator: "UNIT id levelOverall lengthIndex chainIndex chainCount
+ *    lengthPW lengthLC depth start end level_0 ... level_(lengthLC-1)
+ *    index_0 ... index_(depth-1) budget" or "END" if there is no further
+ *    unit (the worker stops). @budget is the amount of passwords left until
+ *    the coordinator's --maxattempts (0: no limit, optional for older
+ *    coordinators); the worker stops the unit once it created as many.
+ *  - worker: "PROGRESS id count" every WORKUNIT_CHECK_INTERVAL nodes, @count
+ *    is the amount of passwords created by the unit so far
+ *  - coordinator: "STOP id" once the workers created --maxattempts
+ *    passwords (including the progress of the busy ones), the worker stops
+ *    the unit @id at its next check (ignored if it's no longer the current
+ *    one)
+ *  - worker: "DONE id count cracked" once all passwords of the unit have
+ *    been handled (or the unit has been stopped), @count is the amount of
+ *    passwords created and @cracked the amount of them cracked (simulated
+ *    attack or hash checking, 0 without them; optional for older workers)
+ * A worker requests the next unit only after reporting the current one. A
+ * unit not reported when the connection closes is handed out again.
+ *
+ * Work stealing: if a worker waits while no unit is left, the coordinator
+ * sends "SPLIT" to a busy worker. It answers with a UNIT line (the id of
+ * its own unit) containing the part of its unit it gives away, which is
+ * handed out to the waiting worker, or "NOSPLIT" if it can't split its
+ * unit (e.g. because it has been completed already). The parts given away
+ * are the largest ones left: the following levelChains of the unit first,
+ * then the upper half of the remaining indices at the smallest depth.
+ *
+ */
+
+#ifndef WORKUNIT_H_
+#define WORKUNIT_H_
+
+#include <stdint.h>
+
+#include "common.h"
+
+// === Defines ===
+#define WORKUNIT_SIZEOF_LINE 512 // longest line of the protocol (including '\n')
+#define WORKUNIT_CHECK_INTERVAL 16384 // nodes a worker enumerates between two checks for split requests
+
+/*
+ * Single work unit: the indices @start to @end - 1 at @depth (following the
+ * indices @path at the smaller depths) of the subtree of the levelChain
+ * @levelChain and all passwords of the following @chainCount - 1
+ * levelChains (of the same length and level) of passwords of @lengthPW.
+ */
+typedef struct workUnit_struct
+{
+  uint64_t id;                  // sequence number of the unit (shared by all parts split off it)
+  int levelOverall;             // overall level (including the level of the length)
+  int lengthIndex;              // index of the length in the sorted lengths
+  uint64_t chainIndex;          // index of the levelChain for this length and level
+  uint64_t chainCount;          // amount of levelChains (including the first one)
+  int lengthPW;                 // length of the passwords
+  int lengthLC;                 // length of the levelChain
+  int depth;                    // depth of the range (0: initialProbs)
+  int start;                    // first index of the range
+  int end;                      // index following the last index of the range
+  int levelChain[MAX_PASSWORD_LENGTH + 1];  // levelChain of the passwords
+  int path[MAX_PASSWORD_LENGTH];  // fixed indices at the depths smaller than @depth
+  uint64_t budget;              // max amount of passwords created by the unit (0: no limit)
+} workUnit_struct;
+
+/*
+ * Creates a socket listening on the given @address.
+ * Returns the socket or -1 (printing an error).
+ */
+int workUnit_listen (const char *address);
+
+/*
+ * Connects to the coordinator listening on the given @address.
+ * Returns the socket or -1 (printing an error).
+ */
+int workUnit_connect (const char *address);
+
+/*
+ * Buffer of the lines received by a connection.
+ */
+typedef struct workUnit_reader
+{
+  int fd;                       // socket of the connection
+  char buffer[WORKUNIT_SIZEOF_LINE];  // received chars not yet read
+  size_t sizeOf_buffer;
+} workUnit_reader;
+
+/*
+ * Reads the next line (without '\n') of @reader into @line. If @wait is
+ * FALSE, it returns at once if no complete line has been received yet.
+ * Returns 1 if a line has been read, 0 if none is available (only if @wait
+ * is FALSE) and -1 if the connection has been closed or the line is too
+ * long.
+ */
+int workUnit_readLine (workUnit_reader * reader, char line[WORKUNIT_SIZEOF_LINE], bool wait);
+
+/*
+ * Writes the given @unit as UNIT line (including '\n') to @line of
+ * WORKUNIT_SIZEOF_LINE chars.
+ */
+void workUnit_format (const workUnit_struct * unit, char line[WORKUNIT_SIZEOF_LINE]);
+
+/*
+ * Reads the UNIT @line into @unit.
+ * Returns FALSE if the line is no valid UNIT line.
+ */
+bool workUnit_parse (const char *line, workUnit_struct * unit);
+
+#endif /* WORKUNIT_H_ */